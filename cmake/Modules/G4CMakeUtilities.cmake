@@ -304,5 +304,52 @@ function(geant4_add_unit_tests)
     add_test(NAME ${name} COMMAND ${name})
     set_property(TEST ${name} PROPERTY LABELS UnitTests)
     set_property(TEST ${name} PROPERTY TIMEOUT 60)
+    if(GEANT4_TEST_ENVIRONMENT)
+      set_property(TEST ${name} PROPERTY ENVIRONMENT ${GEANT4_TEST_ENVIRONMENT})
+    endif()
+  endforeach()
+endfunction()
+
+#-----------------------------------------------------------------------
+# function geant4_add_benchmarks(bench1 bench2 ...
+#                                INCLUDE_DIRS dir1 dir2 ...
+#                                LIBRARIES library1 library2 ...)
+#
+# Benchmarks are built by the 'benchmarks' target, default bench*.cc.
+# They report timings and are not registered with CTest.
+#
+function(geant4_add_benchmarks)
+  cmake_parse_arguments(ARG "" "" "INCLUDE_DIRS;LIBRARIES" ${ARGN})
+
+  foreach(incdir ${ARG_INCLUDE_DIRS})
+    if(IS_ABSOLUTE ${incdir})
+      include_directories(${incdir})
+    else()
+      include_directories(${PROJECT_SOURCE_DIR}/source/${incdir})
+    endif()
+  endforeach()
+
+  if(ARG_UNPARSED_ARGUMENTS)
+    set(bnames ${ARG_UNPARSED_ARGUMENTS})
+  else()
+    set(bnames bench*.cc)
+  endif()
+
+  set(allbenchs)
+  foreach(bname ${bnames})
+    file(GLOB benchs RELATIVE ${CMAKE_CURRENT_SOURCE_DIR} ${bname})
+    set(allbenchs ${allbenchs} ${benchs})
+  endforeach()
+
+  if(NOT TARGET benchmarks)
+    add_custom_target(benchmarks)
+  endif()
+
+  foreach(bench ${allbenchs})
+    get_filename_component(name ${bench} NAME_WE)
+    add_executable(${name} EXCLUDE_FROM_ALL ${bench})
+    target_link_libraries(${name} ${ARG_LIBRARIES})
+    set_target_properties(${name} PROPERTIES OUTPUT_NAME ${name})
+    add_dependencies(benchmarks ${name})
   endforeach()
 endfunction()
@@ -33,11 +33,11 @@
 #include "PhysicsList.hh"
 
 #include "PhysicsListEmSpecialized.hh"
-#include "PhysicsListEmStandardTracking.hh"
 #include "PhysicsListMessenger.hh"
 
 #include "G4BaryonConstructor.hh"
 #include "G4BosonConstructor.hh"
+#include "G4EmParameters.hh"
 #include "G4EmStandardPhysics.hh"
 #include "G4IonConstructor.hh"
 #include "G4LeptonConstructor.hh"
@@ -83,13 +83,21 @@ void PhysicsList::SetMode(const G4String& name)
     G4cout << "PhysicsList::SetMode: <" << name << ">" << G4endl;
   }
 
+  // The "tracking" mode uses the same G4EmStandardPhysics constructor, which
+  // then registers the kernel G4EmStandardTrackingManager for e-, e+ and
+  // gammas instead of their processes. This is equivalent to the UI command
+  // /process/em/UseEmTrackingManager true.
+  G4EmParameters* param = G4EmParameters::Instance();
   if (name == "processes") {
+    param->SetEmTrackingManagerActive(false);
     fEmPhysicsList.reset(new G4EmStandardPhysics(GetVerboseLevel()));
   }
   else if (name == "tracking") {
-    fEmPhysicsList.reset(new PhysicsListEmStandardTracking(GetVerboseLevel()));
+    param->SetEmTrackingManagerActive(true);
+    fEmPhysicsList.reset(new G4EmStandardPhysics(GetVerboseLevel()));
   }
   else if (name == "specialized") {
+    param->SetEmTrackingManagerActive(false);
     fEmPhysicsList.reset(new PhysicsListEmSpecialized(GetVerboseLevel()));
   }
   else {
@@ -46,6 +46,7 @@
 #include "globals.hh"
 #include "evtdefs.hh"
 #include "G4Allocator.hh"
+#include "G4EventArena.hh"
 #include "G4PrimaryVertex.hh"
 #include "G4HCofThisEvent.hh"
 #include "G4DCofThisEvent.hh"
@@ -182,6 +183,12 @@ class G4Event
       { return userInfo; }
       //  Set and Get method of G4VUserEventInformation
 
+    inline G4EventArena* GetEventArena()
+      { return &eventArena; }
+      //  Arena of the objects with the lifetime of this event, current
+      //  while the event is processed and released when the event is
+      //  deleted. See G4EventArenaAllocator.
+
     inline const G4String& GetRandomNumberStatus() const 
       {
         if(!validRandomNumberStatus)
@@ -237,6 +244,10 @@ class G4Event
     mutable G4bool keepTheEvent = false;
     mutable G4int grips = 0;
 
+    // Memory of the objects allocated with G4EventArenaAllocator,
+    // released after the deletion of the contained objects
+    G4EventArena eventArena;
+
   //========================= for sub-event parallelism
   // following methods should be used only within the master thread
 
@@ -168,6 +168,11 @@ class G4EventManager
       // deleted after this method. All necessary information in "evt" must
       // be copied into the corresponding master G4Event object.
 
+    void MergeSubEvent(const G4SubEvent* se,const G4Event* evt);
+      // Merge the results "evt" of a part of the sub-event "se" without
+      // terminating the sub-event. Used when a sub-event is processed in
+      // several pieces; the last piece is passed to TerminateSubEvent().
+
     G4int StoreSubEvent(G4Event*, G4int&, G4SubEvent*);
       // This method is exclusively used by G4SubEventTrackStack class to 
       // store a new G4SubEevnt into the current G4Event, with Mutex lock
@@ -0,0 +1,123 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// G4ParticleGroupedTrackStack
+//
+// Class description:
+//
+// An alternative urgent stack for G4StackManager. Tracks are stored in
+// buckets, one per particle type and, optionally, per region of the
+// volume in which they are created. Tracks are popped from one bucket
+// until it is empty, so that consecutive tracks share the same process
+// vector, cross-section tables and models; the next bucket is the most
+// populated one. To bound the memory, once the number of stacked tracks
+// exceeds a given limit the most recently pushed track of all buckets is
+// popped, i.e. the stack reverts to the depth-first order of G4TrackStack,
+// until the number of tracks falls below the limit again.
+// Within a bucket tracks are popped in LIFO order.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4ParticleGroupedTrackStack_hh
+#define G4ParticleGroupedTrackStack_hh 1
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "G4StackedTrack.hh"
+#include "G4TrackStack.hh"
+#include "globals.hh"
+
+class G4ParticleDefinition;
+class G4Region;
+class G4SmartTrackStack;
+
+class G4ParticleGroupedTrackStack
+{
+  public:
+
+    explicit G4ParticleGroupedTrackStack(std::size_t maxNTracks = 100000);
+   ~G4ParticleGroupedTrackStack();
+
+    G4ParticleGroupedTrackStack&
+      operator=(const G4ParticleGroupedTrackStack&) = delete;
+    G4bool operator==(const G4ParticleGroupedTrackStack&) const = delete;
+    G4bool operator!=(const G4ParticleGroupedTrackStack&) const = delete;
+
+    void PushToStack(const G4StackedTrack& aStackedTrack);
+    G4StackedTrack PopFromStack();
+    void TransferTo(G4TrackStack* aStack);
+    void TransferTo(G4SmartTrackStack* aStack);
+    void clear();
+    void clearAndDestroy();
+    void dumpStatistics() const;
+
+    inline std::size_t GetNTrack() const { return nTracks; }
+    inline std::size_t GetMaxNTrack() const { return maxEntry; }
+
+    inline void SetGroupByRegion(G4bool val) { groupByRegion = val; }
+    inline G4bool GetGroupByRegion() const { return groupByRegion; }
+      // Group also by the region of the volume where the track is.
+      // Must be set while the stack is empty.
+
+    inline void SetMaxNTrack(std::size_t n) { maxNTracks = n; }
+    inline std::size_t GetMaxNTrackLimit() const { return maxNTracks; }
+      // Number of stacked tracks above which depth-first order is used.
+
+    inline std::size_t GetNBuckets() const { return buckets.size(); }
+    inline std::size_t GetNBucketSwitches() const { return nSwitches; }
+    inline std::size_t GetNPopped() const { return nPopped; }
+    void ResetStatistics();
+      // Number of buckets and of bucket changes while popping tracks;
+      // the average number of tracks processed per bucket switch is
+      // GetNPopped()/GetNBucketSwitches().
+
+  private:
+
+    G4int FindBucket(const G4StackedTrack& aStackedTrack);
+    G4int SelectBucket() const;
+
+  private:
+
+    using BucketKey = std::pair<const G4ParticleDefinition*, const G4Region*>;
+
+    std::vector<G4TrackStack*> buckets;
+    std::vector<std::vector<std::size_t>> pushOrder;
+      // Push sequence number of every track in each bucket
+    std::map<BucketKey, G4int> bucketIndex;
+    G4int current = -1;
+    G4int lastPushed = -1;
+    BucketKey lastKey{nullptr, nullptr};
+
+    G4bool groupByRegion = false;
+    std::size_t maxNTracks;
+    std::size_t nTracks = 0;
+    std::size_t nPushed = 0;
+    std::size_t maxEntry = 0;
+    std::size_t nSwitches = 0;
+    std::size_t nPopped = 0;
+};
+
+#endif
@@ -54,6 +54,7 @@
 #include "G4StackedTrack.hh"
 #include "G4TrackStack.hh"
 #include "G4SmartTrackStack.hh"
+#include "G4ParticleGroupedTrackStack.hh"
 #include "G4SubEventTrackStack.hh"
 #include "G4ClassificationOfNewTrack.hh"
 #include "G4Track.hh"
@@ -133,6 +134,26 @@ class G4StackManager
     inline G4ClassificationOfNewTrack GetDefaultClassification()
     { return fDefaultClassification; }
 
+    void SetParticleGroupedStack(G4bool val);
+    void SetGroupByRegion(G4bool val);
+    void SetGroupedStackLimit(G4int maxNTracks);
+      // Select the particle-grouped urgent stack, where tracks are popped
+      // one particle type (and optionally one region) at a time, instead
+      // of in LIFO order. Tracks present in the urgent stack are kept.
+      // Must be invoked at PreInit, Init or Idle states.
+
+    inline G4ParticleGroupedTrackStack* GetParticleGroupedStack() const
+    { return groupedStack; }
+
+    void ReserveTracks(G4int nTracks);
+      // Pre-allocates, in one page each, the storage of nTracks G4Track
+      // and G4DynamicParticle objects in the allocators of this thread,
+      // so that the secondaries of large showers are created without
+      // growing the pools by small pages. Only the storage exceeding the
+      // previous reservation is added.
+    inline G4int GetNumberOfReservedTracks() const
+    { return numberOfReservedTracks; }
+
   public:
     void ReleaseSubEvent(G4int ty);
     inline std::size_t GetNSubEventTypes()
@@ -154,6 +175,7 @@ class G4StackManager
   private:
     void DefineDefaultClassification(const G4Track* aTrack);
     void SortOut(G4StackedTrack&,G4ClassificationOfNewTrack);
+    void FlushGroupedStack();
 
   private:
 
@@ -164,11 +186,15 @@ class G4StackManager
 #else
     G4TrackStack* urgentStack = nullptr;
 #endif
+    G4ParticleGroupedTrackStack* groupedStack = nullptr;
+      // If set, urgent tracks are pushed here; urgentStack receives
+      // only the tracks transferred explicitly between the stacks
     G4TrackStack* waitingStack = nullptr;
     G4TrackStack* postponeStack = nullptr;
     G4StackingMessenger* theMessenger = nullptr;
     std::vector<G4TrackStack*> additionalWaitingStacks;
     G4int numberOfAdditionalWaitingStacks = 0;
+    G4int numberOfReservedTracks = 0;
 
     std::map<G4TrackStatus,
              std::pair<G4ClassificationOfNewTrack,G4ExceptionSeverity>>
@@ -33,6 +33,9 @@
 //   /event/stack/status
 //   /event/stack/clear
 //   /event/stack/verbose
+//   /event/stack/groupByParticle
+//   /event/stack/groupByRegion
+//   /event/stack/groupLimit
 
 // Author: Makoto Asai, 1996
 // --------------------------------------------------------------------
@@ -45,6 +48,7 @@ class G4StackManager;
 class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
 
 class G4StackingMessenger : public G4UImessenger
 {
@@ -61,6 +65,10 @@ class G4StackingMessenger : public G4UImessenger
     G4UIcmdWithoutParameter* statusCmd;
     G4UIcmdWithAnInteger* clearCmd;
     G4UIcmdWithAnInteger* verboseCmd;
+    G4UIcmdWithABool* groupCmd;
+    G4UIcmdWithABool* groupRegCmd;
+    G4UIcmdWithAnInteger* groupLimCmd;
+    G4UIcmdWithAnInteger* reserveCmd;
 };
 
 #endif
@@ -40,6 +40,7 @@
 #include "G4Types.hh"
 
 class G4SmartTrackStack;
+class G4ParticleGroupedTrackStack;
 
 class G4TrackStack : public std::vector<G4StackedTrack>
 {
@@ -64,6 +65,7 @@ class G4TrackStack : public std::vector<G4StackedTrack>
       { G4StackedTrack st = back(); pop_back(); return st; }
     void TransferTo(G4TrackStack* aStack);
     void TransferTo(G4SmartTrackStack* aStack);
+    void TransferTo(G4ParticleGroupedTrackStack* aStack);
   
     void clearAndDestroy();
 
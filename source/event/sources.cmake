@@ -15,6 +15,7 @@ geant4_add_module(G4event
     G4GeneralParticleSourceMessenger.hh
     G4HEPEvtInterface.hh
     G4HEPEvtParticle.hh
+    G4ParticleGroupedTrackStack.hh
     G4ParticleGun.hh
     G4ParticleGunMessenger.hh
     G4PrimaryTransformer.hh
@@ -51,6 +52,7 @@ geant4_add_module(G4event
     G4GeneralParticleSourceMessenger.cc
     G4HEPEvtInterface.cc
     G4HEPEvtParticle.cc
+    G4ParticleGroupedTrackStack.cc
     G4ParticleGun.cc
     G4ParticleGunMessenger.cc
     G4PrimaryTransformer.cc
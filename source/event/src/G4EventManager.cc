@@ -100,6 +100,8 @@ void G4EventManager::DoProcessing(G4Event* anEvent,
     return;
   }
   currentEvent = anEvent;
+  G4EventArena* previousArena
+    = G4EventArena::SetCurrentArena(currentEvent->GetEventArena());
   if(!subEventParaWorker) stateManager->SetNewState(G4State_EventProc);
   if(storetRandomNumberStatusToG4Event > 1)
   {
@@ -342,6 +344,7 @@ void G4EventManager::DoProcessing(G4Event* anEvent,
   }
 
   if(!subEventParaWorker) stateManager->SetNewState(G4State_GeomClosed);
+  G4EventArena::SetCurrentArena(previousArena);
   currentEvent = nullptr;
   abortRequested = false;
 }
@@ -353,6 +356,14 @@ G4SubEvent* G4EventManager::PopSubEvent(G4int ty)
   return currentEvent->PopSubEvent(ty);
 }
 
+void G4EventManager::MergeSubEvent(const G4SubEvent* se,const G4Event* evt)
+{
+  G4AutoLock lock(&EventMgrMutex);
+  auto ev = se->GetEvent();
+  ev->MergeSubEventResults(evt);
+  if(!subEventParaWorker && userEventAction!=nullptr) userEventAction->MergeSubEvent(ev,evt);
+}
+
 void G4EventManager::TerminateSubEvent(const G4SubEvent* se,const G4Event* evt)
 {
   G4AutoLock lock(&EventMgrMutex);
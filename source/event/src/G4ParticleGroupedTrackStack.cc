@@ -0,0 +1,233 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// G4ParticleGroupedTrackStack class implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4ParticleGroupedTrackStack.hh"
+#include "G4SmartTrackStack.hh"
+#include "G4VTrajectory.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
+#include "G4ParticleDefinition.hh"
+
+G4ParticleGroupedTrackStack::G4ParticleGroupedTrackStack(std::size_t maxN)
+  : maxNTracks(maxN)
+{
+}
+
+G4ParticleGroupedTrackStack::~G4ParticleGroupedTrackStack()
+{
+  for (auto* bucket : buckets)
+  {
+    delete bucket;
+  }
+}
+
+G4int
+G4ParticleGroupedTrackStack::FindBucket(const G4StackedTrack& aStackedTrack)
+{
+  const G4Track* aTrack = aStackedTrack.GetTrack();
+  const G4Region* region = nullptr;
+  if (groupByRegion)
+  {
+    const G4VPhysicalVolume* pv = aTrack->GetVolume();
+    if (pv != nullptr) { region = pv->GetLogicalVolume()->GetRegion(); }
+  }
+  BucketKey key(aTrack->GetParticleDefinition(), region);
+
+  // Secondaries of the same type are often pushed one after the other
+  //
+  if (lastPushed >= 0 && key == lastKey) { return lastPushed; }
+
+  G4int index;
+  auto pos = bucketIndex.find(key);
+  if (pos != bucketIndex.cend())
+  {
+    index = pos->second;
+  }
+  else
+  {
+    index = (G4int)buckets.size();
+    buckets.push_back(new G4TrackStack(100));
+    pushOrder.emplace_back();
+    bucketIndex.emplace(key, index);
+  }
+  lastKey = key;
+  return index;
+}
+
+G4int G4ParticleGroupedTrackStack::SelectBucket() const
+{
+  // Take the newest track when the stack grows too large, otherwise
+  // continue with the current bucket or take the most populated one
+  //
+  if (nTracks > maxNTracks)
+  {
+    G4int newest = -1;
+    for (G4int i=0; i<(G4int)buckets.size(); ++i)
+    {
+      if (!pushOrder[i].empty()
+          && (newest < 0 || pushOrder[i].back() > pushOrder[newest].back()))
+      {
+        newest = i;
+      }
+    }
+    return newest;
+  }
+  if (current >= 0 && buckets[current]->GetNTrack() != 0u)
+  {
+    return current;
+  }
+  G4int best = -1;
+  std::size_t bestN = 0;
+  for (G4int i=0; i<(G4int)buckets.size(); ++i)
+  {
+    if (buckets[i]->GetNTrack() > bestN)
+    {
+      best = i;
+      bestN = buckets[i]->GetNTrack();
+    }
+  }
+  return best;
+}
+
+void G4ParticleGroupedTrackStack::
+PushToStack(const G4StackedTrack& aStackedTrack)
+{
+  lastPushed = FindBucket(aStackedTrack);
+  buckets[lastPushed]->PushToStack(aStackedTrack);
+  pushOrder[lastPushed].push_back(nPushed++);
+  ++nTracks;
+  if (nTracks > maxEntry) { maxEntry = nTracks; }
+}
+
+G4StackedTrack G4ParticleGroupedTrackStack::PopFromStack()
+{
+  G4StackedTrack aStackedTrack;
+  if (nTracks == 0) { return aStackedTrack; }
+
+  G4int next = SelectBucket();
+  if (next != current)
+  {
+    current = next;
+    ++nSwitches;
+  }
+  aStackedTrack = buckets[current]->PopFromStack();
+  pushOrder[current].pop_back();
+  --nTracks;
+  ++nPopped;
+  return aStackedTrack;
+}
+
+void G4ParticleGroupedTrackStack::TransferTo(G4TrackStack* aStack)
+{
+  for (auto* bucket : buckets)
+  {
+    bucket->TransferTo(aStack);
+  }
+  for (auto& order : pushOrder)
+  {
+    order.clear();
+  }
+  nTracks = 0;
+  current = -1;
+}
+
+void G4ParticleGroupedTrackStack::TransferTo(G4SmartTrackStack* aStack)
+{
+  for (auto* bucket : buckets)
+  {
+    bucket->TransferTo(aStack);
+  }
+  for (auto& order : pushOrder)
+  {
+    order.clear();
+  }
+  nTracks = 0;
+  current = -1;
+}
+
+void G4ParticleGroupedTrackStack::clear()
+{
+  for (auto* bucket : buckets)
+  {
+    bucket->clear();
+  }
+  for (auto& order : pushOrder)
+  {
+    order.clear();
+  }
+  nTracks = 0;
+  current = -1;
+}
+
+void G4ParticleGroupedTrackStack::clearAndDestroy()
+{
+  for (auto* bucket : buckets)
+  {
+    bucket->clearAndDestroy();
+  }
+  for (auto& order : pushOrder)
+  {
+    order.clear();
+  }
+  nTracks = 0;
+  current = -1;
+}
+
+void G4ParticleGroupedTrackStack::ResetStatistics()
+{
+  maxEntry = nTracks;
+  nSwitches = 0;
+  nPopped = 0;
+}
+
+void G4ParticleGroupedTrackStack::dumpStatistics() const
+{
+  G4cout << " G4ParticleGroupedTrackStack: " << buckets.size()
+         << " buckets, " << nPopped << " tracks popped with "
+         << nSwitches << " bucket switches";
+  if (nSwitches > 0)
+  {
+    G4cout << " (" << G4double(nPopped)/nSwitches << " tracks per switch)";
+  }
+  G4cout << ", maximum " << maxEntry << " stacked tracks." << G4endl;
+  for (const auto& entry : bucketIndex)
+  {
+    const G4TrackStack* bucket = buckets[entry.second];
+    if (bucket->GetMaxNTrack() == 0u) { continue; }
+    G4cout << "   " << entry.first.first->GetParticleName();
+    if (entry.first.second != nullptr)
+    {
+      G4cout << " in " << entry.first.second->GetName();
+    }
+    G4cout << " : " << bucket->GetNTrack() << " tracks (max "
+           << bucket->GetMaxNTrack() << ")" << G4endl;
+  }
+}
@@ -36,6 +36,9 @@
 #include "G4Event.hh"
 #include "G4ios.hh"
 
+#include <algorithm>
+
+#include "G4DynamicParticle.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4VProcess.hh"
 
@@ -68,10 +71,12 @@ G4StackManager::~G4StackManager()
   {
     G4cout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << G4endl;
     G4cout << " Maximum number of tracks in the urgent stack : " << urgentStack->GetMaxNTrack() << G4endl;
+    if(groupedStack != nullptr) { groupedStack->dumpStatistics(); }
     G4cout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << G4endl;
   }
 #endif
   delete urgentStack;
+  delete groupedStack;
   delete waitingStack;
   delete postponeStack;
   delete theMessenger;
@@ -182,7 +187,8 @@ G4Track* G4StackManager::PopNextTrack(G4VTrajectory** newTrajectory)
              << " waiting tracks are re-classified to" << G4endl;
     }
 #endif
-    waitingStack->TransferTo(urgentStack);
+    if(groupedStack != nullptr) { waitingStack->TransferTo(groupedStack); }
+    else                        { waitingStack->TransferTo(urgentStack); }
     if(numberOfAdditionalWaitingStacks>0)
     {
       for(G4int i=0; i<numberOfAdditionalWaitingStacks; ++i)
@@ -212,7 +218,9 @@ G4Track* G4StackManager::PopNextTrack(G4VTrajectory** newTrajectory)
       return nullptr;
   }
 
-  G4StackedTrack selectedStackedTrack = urgentStack->PopFromStack();
+  G4StackedTrack selectedStackedTrack =
+    (groupedStack != nullptr && groupedStack->GetNTrack() != 0u)
+    ? groupedStack->PopFromStack() : urgentStack->PopFromStack();
   G4Track * selectedTrack = selectedStackedTrack.GetTrack();
   *newTrajectory = selectedStackedTrack.GetTrajectory();
 
@@ -238,6 +246,7 @@ void G4StackManager::ReClassify()
   if( userStackingAction == nullptr ) return;
   if( GetNUrgentTrack() == 0 ) return;
   
+  FlushGroupedStack();
   urgentStack->TransferTo(&tmpStack);
   while( tmpStack.GetNTrack() > 0 )
   {
@@ -278,6 +287,7 @@ G4int G4StackManager::PrepareNewEvent(G4Event* currentEvent)
   // affect reproducibility
   //
   urgentStack->clearAndDestroy();
+  if(groupedStack != nullptr) { groupedStack->clearAndDestroy(); }
   
   G4int n_passedFromPrevious = 0;
   
@@ -359,7 +369,10 @@ void G4StackManager::SortOut(G4StackedTrack& aStackedTrack, G4ClassificationOfNe
     switch (classification)
     {
       case fUrgent:
-        urgentStack->PushToStack( aStackedTrack );
+        if(groupedStack != nullptr)
+        { groupedStack->PushToStack( aStackedTrack ); }
+        else
+        { urgentStack->PushToStack( aStackedTrack ); }
         break;
       case fWaiting:
         waitingStack->PushToStack( aStackedTrack );
@@ -432,6 +445,7 @@ TransferStackedTracks(G4ClassificationOfNewTrack origin,
 {
   if(origin==destination) return;
   if(origin==fKill) return;
+  FlushGroupedStack();
   G4TrackStack* originStack = nullptr;
   switch(origin)
   {
@@ -525,6 +539,7 @@ TransferOneStackedTrack(G4ClassificationOfNewTrack origin,
 {
   if(origin==destination) return;
   if(origin==fKill) return;
+  FlushGroupedStack();
   G4TrackStack* originStack = nullptr;
   switch(origin)
   {
@@ -627,6 +642,7 @@ void G4StackManager::clear()
 void G4StackManager::ClearUrgentStack()
 {
   urgentStack->clearAndDestroy();
+  if(groupedStack != nullptr) { groupedStack->clearAndDestroy(); }
 }
 
 void G4StackManager::ClearWaitingStack(G4int i)
@@ -651,7 +667,7 @@ void G4StackManager::ClearPostponeStack()
 
 G4int G4StackManager::GetNTotalTrack() const
 {
-  std::size_t n = urgentStack->GetNTrack()
+  std::size_t n = GetNUrgentTrack()
                 + waitingStack->GetNTrack()
                 + postponeStack->GetNTrack();
   for(G4int i=1; i<=numberOfAdditionalWaitingStacks; ++i)
@@ -663,7 +679,9 @@ G4int G4StackManager::GetNTotalTrack() const
 
 G4int G4StackManager::GetNUrgentTrack() const
 {
-  return (G4int)urgentStack->GetNTrack();
+  std::size_t n = urgentStack->GetNTrack();
+  if(groupedStack != nullptr) { n += groupedStack->GetNTrack(); }
+  return (G4int)n;
 }
 
 G4int G4StackManager::GetNWaitingTrack(int i) const
@@ -686,6 +704,61 @@ G4int G4StackManager::GetNPostponedTrack() const
   return (G4int)postponeStack->GetNTrack();
 }
 
+void G4StackManager::FlushGroupedStack()
+{
+  // Move the grouped tracks to the ordinary urgent stack, for the
+  // operations acting on the urgent stack as a whole
+  //
+  if(groupedStack != nullptr) { groupedStack->TransferTo(urgentStack); }
+}
+
+void G4StackManager::SetParticleGroupedStack(G4bool val)
+{
+  if(val == (groupedStack != nullptr)) return;
+  if(val)
+  {
+    groupedStack = new G4ParticleGroupedTrackStack;
+  }
+  else
+  {
+    FlushGroupedStack();
+    delete groupedStack;
+    groupedStack = nullptr;
+  }
+}
+
+void G4StackManager::SetGroupByRegion(G4bool val)
+{
+  if(groupedStack == nullptr) { SetParticleGroupedStack(true); }
+  if(val != groupedStack->GetGroupByRegion())
+  {
+    FlushGroupedStack();
+    groupedStack->SetGroupByRegion(val);
+  }
+}
+
+void G4StackManager::SetGroupedStackLimit(G4int maxNTracks)
+{
+  if(groupedStack == nullptr) { SetParticleGroupedStack(true); }
+  groupedStack->SetMaxNTrack(std::size_t(std::max(maxNTracks, 1)));
+}
+
+void G4StackManager::ReserveTracks(G4int nTracks)
+{
+  if(nTracks <= numberOfReservedTracks) { return; }
+  auto n = std::size_t(nTracks - numberOfReservedTracks);
+
+  // the allocators are thread-local and created at the first use
+  if(aTrackAllocator() == nullptr)
+  { aTrackAllocator() = new G4Allocator<G4Track>; }
+  aTrackAllocator()->Reserve(n);
+  if(pDynamicParticleAllocator() == nullptr)
+  { pDynamicParticleAllocator() = new G4Allocator<G4DynamicParticle>; }
+  pDynamicParticleAllocator()->Reserve(n);
+
+  numberOfReservedTracks = nTracks;
+}
+
 void G4StackManager::SetVerboseLevel( G4int const value )
 {
   verboseLevel = value;
@@ -33,6 +33,7 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
 #include "G4ios.hh"
 
 G4StackingMessenger::G4StackingMessenger(G4StackManager* fCont)
@@ -62,6 +63,38 @@ G4StackingMessenger::G4StackingMessenger(G4StackManager* fCont)
   verboseCmd->SetGuidance(" 1 : Minimum statistics");
   verboseCmd->SetGuidance(" 2 : Detailed reports");
   verboseCmd->SetGuidance("Note - this value is overwritten by /event/verbose command.");
+
+  groupCmd = new G4UIcmdWithABool("/event/stack/groupByParticle",this);
+  groupCmd->SetGuidance("Group the urgent tracks by particle type.");
+  groupCmd->SetGuidance("Tracks of one particle type are processed one after");
+  groupCmd->SetGuidance("the other, instead of in last-in-first-out order.");
+  groupCmd->SetParameterName("flag",true);
+  groupCmd->SetDefaultValue(true);
+  groupCmd->AvailableForStates(G4State_PreInit,G4State_Init,G4State_Idle);
+
+  groupRegCmd = new G4UIcmdWithABool("/event/stack/groupByRegion",this);
+  groupRegCmd->SetGuidance("Group the urgent tracks also by region.");
+  groupRegCmd->SetGuidance("Enables the grouping by particle type if needed.");
+  groupRegCmd->SetParameterName("flag",true);
+  groupRegCmd->SetDefaultValue(true);
+  groupRegCmd->AvailableForStates(G4State_PreInit,G4State_Init,G4State_Idle);
+
+  groupLimCmd = new G4UIcmdWithAnInteger("/event/stack/groupLimit",this);
+  groupLimCmd->SetGuidance("Number of urgent tracks above which the grouped");
+  groupLimCmd->SetGuidance("stack follows the most recent tracks, to bound");
+  groupLimCmd->SetGuidance("the memory. Enables the grouping if needed.");
+  groupLimCmd->SetParameterName("nTracks",false);
+  groupLimCmd->SetRange("nTracks>0");
+  groupLimCmd->AvailableForStates(G4State_PreInit,G4State_Init,G4State_Idle);
+
+  reserveCmd = new G4UIcmdWithAnInteger("/event/stack/reserveTracks",this);
+  reserveCmd->SetGuidance("Pre-allocate the storage of tracks and dynamic");
+  reserveCmd->SetGuidance("particles of each thread in one page, to avoid");
+  reserveCmd->SetGuidance("the growth of the allocators during the showers.");
+  reserveCmd->SetGuidance("Only the storage exceeding the previous value is added.");
+  reserveCmd->SetParameterName("nTracks",false);
+  reserveCmd->SetRange("nTracks>0 && nTracks<=1000000");
+  reserveCmd->AvailableForStates(G4State_PreInit,G4State_Init,G4State_Idle);
 }
 
 G4StackingMessenger::~G4StackingMessenger()
@@ -69,6 +102,10 @@ G4StackingMessenger::~G4StackingMessenger()
   delete statusCmd;
   delete clearCmd;
   delete verboseCmd;
+  delete groupCmd;
+  delete groupRegCmd;
+  delete groupLimCmd;
+  delete reserveCmd;
   delete stackDir;
 }
 
@@ -86,6 +123,10 @@ void G4StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValues)
            << G4endl;
     G4cout << "    Postponed stack : " << fContainer->GetNPostponedTrack()
            << G4endl;
+    if( fContainer->GetParticleGroupedStack() != nullptr )
+    {
+      fContainer->GetParticleGroupedStack()->dumpStatistics();
+    }
   }
   else if( command==clearCmd )
   {
@@ -113,4 +154,20 @@ void G4StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValues)
   {
     fContainer->SetVerboseLevel(verboseCmd->GetNewIntValue(newValues));
   }
+  else if( command==groupCmd )
+  {
+    fContainer->SetParticleGroupedStack(groupCmd->GetNewBoolValue(newValues));
+  }
+  else if( command==groupRegCmd )
+  {
+    fContainer->SetGroupByRegion(groupRegCmd->GetNewBoolValue(newValues));
+  }
+  else if( command==groupLimCmd )
+  {
+    fContainer->SetGroupedStackLimit(groupLimCmd->GetNewIntValue(newValues));
+  }
+  else if( command==reserveCmd )
+  {
+    fContainer->ReserveTracks(reserveCmd->GetNewIntValue(newValues));
+  }
 }
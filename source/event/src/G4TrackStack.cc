@@ -30,6 +30,7 @@
 
 #include "G4TrackStack.hh"
 #include "G4SmartTrackStack.hh"
+#include "G4ParticleGroupedTrackStack.hh"
 #include "G4VTrajectory.hh"
 #include "G4Track.hh"
 
@@ -65,6 +66,15 @@ void G4TrackStack::TransferTo(G4SmartTrackStack* aStack)
   }
 }
 
+void G4TrackStack::TransferTo(G4ParticleGroupedTrackStack* aStack)
+{
+  for(auto & i : *this)
+  {
+    aStack->PushToStack(i);
+  }
+  clear();
+}
+
 G4double G4TrackStack::getTotalEnergy() const
 {
   G4double totalEnergy = 0.0;
@@ -52,6 +52,11 @@ class G4CachedMagneticField : public G4MagneticField
 
     void GetFieldValue( const G4double Point[4],
                               G4double* Bfield ) const override;
+    void GetFieldValues( const G4double* points,
+                               G4double* fields, G4int n ) const override;
+      // Points within the constant distance of the cached location take
+      // the cached value; the others are passed in one batch to the
+      // underlying field and the last of them becomes the cached location.
      
     G4double GetConstDistance() const { return fDistanceConst; } 
     void SetConstDistance( G4double dist ) { fDistanceConst= dist;}
@@ -65,6 +65,15 @@ class G4ClassicalRK4 : public G4MagErrorStepper
       // which returns derivatives dydx at x. The source is routine rk4 from
       // NRC p. 712-713 .
 
+    void DumbStepperPair( const G4double yIn[],
+                          const G4double dydx[],
+                                G4double h1,
+                                G4double yOut1[],
+                                G4double h2,
+                                G4double yOut2[] ) override;
+      // Two RK4 steps from the same state, with the field at the
+      // corresponding stage points of both steps requested together.
+
     G4int IntegratorOrder() const override { return 4; }
 
   private:
@@ -82,6 +91,7 @@ class G4ClassicalRK4 : public G4MagErrorStepper
   private:
 
     G4double *dydxm, *dydxt, *yt; // scratch space - not state 
+    G4double *dydxm2, *dydxt2, *yt2; // scratch for the second step of a pair
 };
 
 #endif
@@ -40,6 +40,8 @@
 
 #include "G4ChargeState.hh"
 
+#include <algorithm>
+
 class G4EquationOfMotion 
 {
   public:  // with description
@@ -70,6 +72,13 @@ class G4EquationOfMotion
        // ---------------------------
        // (It is not virtual, but calls the virtual function above.)
 
+     inline void RightHandSides( const G4double* const y[],
+                                       G4double* const dydx[],
+                                       G4int n ) const;
+       // Derivatives at 'n' independent states y[i], returned in dydx[i].
+       // The field is requested for all the states at once, through
+       // G4Field::GetFieldValues(), in batches of up to kMaxBatchSize.
+
      inline void EvaluateRhsReturnB( const G4double y[],
                                            G4double dydx[],
                                            G4double Field[] ) const;
@@ -85,6 +94,8 @@ class G4EquationOfMotion
      inline G4Field* GetFieldObj();
      inline void SetFieldObj(G4Field* pField);
 
+     static constexpr G4int kMaxBatchSize = 4;
+
   private:
 
      G4Field* itsField = nullptr;
@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4ExactHelixDriver
+//
+// Class description:
+//
+// Integration driver for a pure and uniform magnetic field, where the
+// trajectory of a charged particle is an exact helix. Each advance is
+// computed analytically, without any Runge-Kutta stepper, and the
+// chord-limited step is obtained directly from the helix radius and the
+// allowed chord distance. The equation of motion (usually that of the
+// chord finder being replaced) is not owned; the field value is taken at
+// the start of each advance and assumed constant along it.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4EXACTHELIXDRIVER_HH
+#define G4EXACTHELIXDRIVER_HH
+
+#include "G4VIntegrationDriver.hh"
+#include "G4Mag_EqRhs.hh"
+
+class G4ExactHelixDriver : public G4VIntegrationDriver
+{
+  public:
+
+    explicit G4ExactHelixDriver(G4Mag_EqRhs* equation);
+   ~G4ExactHelixDriver() override = default;
+
+    G4ExactHelixDriver(const G4ExactHelixDriver&) = delete;
+    G4ExactHelixDriver& operator=(const G4ExactHelixDriver&) = delete;
+
+    G4double AdvanceChordLimited(G4FieldTrack& track,
+                                 G4double hstep,
+                                 G4double eps,
+                                 G4double chordDistance) override;
+      // Advance along the helix by hstep, or less if the distance between
+      // the helix and its chord would exceed chordDistance.
+      // Returns the length advanced.
+
+    G4bool AccurateAdvance(G4FieldTrack& track,
+                           G4double hstep,
+                           G4double eps,
+                           G4double hinitial = 0) override;
+      // Advance along the helix by hstep. Always succeeds.
+
+    G4bool DoesReIntegrate() const override { return true; }
+
+    void SetEquationOfMotion(G4EquationOfMotion* equation) override;
+    G4EquationOfMotion* GetEquationOfMotion() override { return fEquation; }
+
+    void SetVerboseLevel(G4int level) override { fVerboseLevel = level; }
+    G4int GetVerboseLevel() const override { return fVerboseLevel; }
+
+    void OnComputeStep(const G4FieldTrack* /*track*/ = nullptr) override {}
+    void OnStartTracking() override {}
+
+    void GetDerivatives(const G4FieldTrack& track,
+                              G4double dydx[]) const override;
+    void GetDerivatives(const G4FieldTrack& track,
+                              G4double dydx[],
+                              G4double field[]) const override;
+
+    const G4MagIntegratorStepper* GetStepper() const override
+      { return nullptr; }
+    G4MagIntegratorStepper* GetStepper() override { return nullptr; }
+      // No stepper is used.
+
+    G4double ComputeNewStepSize(G4double /*errMaxNorm*/,
+                                G4double hstepCurrent) override
+      { return hstepCurrent; }
+      // The advance is exact, the step is not changed.
+
+    void StreamInfo(std::ostream& os) const override;
+
+  private:
+
+    G4double AdvanceHelix(G4FieldTrack& track, G4double hstep,
+                          G4double chordDistance) const;
+      // Advance the track along the helix by hstep, limited by the chord
+      // distance if positive. Returns the length advanced.
+
+  private:
+
+    G4Mag_EqRhs* fEquation = nullptr;
+    G4int fVerboseLevel = 0;
+};
+
+#endif
@@ -35,6 +35,7 @@
 //                    *************         double *fieldArr ) 
 // Given an input position/time vector 'Point', 
 // this method must return the value of the field in "fieldArr".
+// Several points can be evaluated in one call with GetFieldValues().
 //
 // A field must also specify whether it changes a track's energy:
 //                    DoesFieldChangeEnergy() 
@@ -75,6 +76,16 @@ class G4Field
        //      array 'fieldArr' are determined by the type of field.
        //      See for example the class G4ElectroMagneticField.
 
+      virtual void GetFieldValues( const G4double* points,
+                                         G4double* fields,
+                                         G4int n ) const;
+       // Batched version of GetFieldValue() for 'n' points.
+       // 'points' holds n consecutive position/time vectors (4 values each,
+       // same structure as 'Point' above); the field of point i is returned
+       // in fields[i*MAX_NUMBER_OF_COMPONENTS ...]. The default implementation
+       // loops over GetFieldValue(); fields computed by interpolation or
+       // caching can override it to process the points together.
+
       virtual G4bool DoesFieldChangeEnergy() const = 0;
         // Each type/class of field should respond this accordingly
         // For example:
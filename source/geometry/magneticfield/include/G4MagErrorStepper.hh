@@ -68,6 +68,17 @@ class G4MagErrorStepper : public G4MagIntegratorStepper
                                      G4double yout[] ) = 0;
       // Performs a 'dump' Step without error calculation.
 
+    virtual void DumbStepperPair( const G4double y[],
+                                  const G4double dydx[],
+                                        G4double h1,
+                                        G4double yout1[],
+                                        G4double h2,
+                                        G4double yout2[] );
+      // Performs two 'dumb' Steps of lengths h1 and h2 from the same
+      // starting state; yout1 and yout2 must be distinct from y.
+      // The default calls DumbStepper() twice; steppers can override it
+      // to evaluate the stages of both steps together.
+
     G4double DistChord() const override;
 
   private:
@@ -92,6 +92,12 @@ class G4MagIntegratorStepper
                                       G4double field[] ) const;
        // Calculate dydx and field at point y. 
 
+     inline void RightHandSides( const G4double* const y[],
+                                       G4double* const dydx[],
+                                       G4int n ) const;
+       // Evaluate the right hand side for 'n' independent states at once,
+       // so that the field is requested for all the points in one call.
+
      inline G4int  GetNumberOfVariables() const;
        // Get the number of variables that the stepper will integrate over.
 
@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// G4TrilinearMagField
+//
+// Class description:
+//
+// Magnetic field map defined on a regular Cartesian grid of nx*ny*nz
+// nodes, starting at a given corner with a given spacing along each axis.
+// The field is interpolated trilinearly between the nodes and is zero
+// outside the grid. The three components are stored in separate arrays,
+// so that the batched GetFieldValues() processes several points with a
+// branch-free loop the compiler can vectorise.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4TRILINEARMAGFIELD_HH
+#define G4TRILINEARMAGFIELD_HH
+
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "G4MagneticField.hh"
+
+class G4TrilinearMagField : public G4MagneticField
+{
+  public:
+
+    G4TrilinearMagField(const G4ThreeVector& minCorner,
+                        const G4ThreeVector& spacing,
+                        G4int nx, G4int ny, G4int nz);
+      // Grid of nx*ny*nz nodes (at least 2 per axis), with node (i,j,k)
+      // at minCorner + (i*spacing.x(), j*spacing.y(), k*spacing.z()).
+      // The field is initialised to zero at all nodes.
+
+    ~G4TrilinearMagField() override = default;
+
+    G4TrilinearMagField(const G4TrilinearMagField&) = default;
+    G4TrilinearMagField& operator=(const G4TrilinearMagField&) = default;
+
+    void GetFieldValue(const G4double Point[4],
+                             G4double* Bfield) const override;
+    void GetFieldValues(const G4double* points,
+                              G4double* fields, G4int n) const override;
+
+    void SetFieldValue(G4int i, G4int j, G4int k, const G4ThreeVector& B);
+    G4ThreeVector GetNodeValue(G4int i, G4int j, G4int k) const;
+      // Set/get the field at node (i,j,k).
+
+    inline G4int GetNumberOfNodes(G4int axis) const;
+    inline G4ThreeVector GetMinCorner() const;
+    inline G4ThreeVector GetSpacing() const;
+
+    G4Field* Clone() const override;
+
+  private:
+
+    inline G4int Index(G4int i, G4int j, G4int k) const;
+
+  private:
+
+    G4double fMin[3];
+    G4double fInvSpacing[3];
+    G4double fSpacing[3];
+    G4int fN[3];
+
+    std::vector<G4double> fBx, fBy, fBz;
+      // Field components at the nodes, index i + nx*(j + ny*k)
+};
+
+inline G4int G4TrilinearMagField::Index(G4int i, G4int j, G4int k) const
+{
+  return i + fN[0]*(j + fN[1]*k);
+}
+
+inline G4int G4TrilinearMagField::GetNumberOfNodes(G4int axis) const
+{
+  return fN[axis];
+}
+
+inline G4ThreeVector G4TrilinearMagField::GetMinCorner() const
+{
+  return { fMin[0], fMin[1], fMin[2] };
+}
+
+inline G4ThreeVector G4TrilinearMagField::GetSpacing() const
+{
+  return { fSpacing[0], fSpacing[1], fSpacing[2] };
+}
+
+#endif
@@ -39,6 +39,7 @@ geant4_add_module(G4magneticfield
     G4EquationOfMotion.hh
     G4EquationOfMotion.icc
     G4ErrorMag_UsualEqRhs.hh
+    G4ExactHelixDriver.hh
     G4ExactHelixStepper.hh
     G4ExplicitEuler.hh
     G4Field.hh
@@ -117,6 +118,7 @@ geant4_add_module(G4magneticfield
     G4TCachedMagneticField.hh
     G4TrialsCounter.hh
     G4TrialsCounter.icc
+    G4TrilinearMagField.hh
     G4TsitourasRK45.hh
     G4UniformElectricField.hh
     G4UniformGravityField.hh
@@ -159,6 +161,7 @@ geant4_add_module(G4magneticfield
     G4EqMagElectricField.cc
     G4EquationOfMotion.cc
     G4ErrorMag_UsualEqRhs.cc
+    G4ExactHelixDriver.cc
     G4ExactHelixStepper.cc
     G4ExplicitEuler.cc
     G4Field.cc
@@ -207,6 +210,7 @@ geant4_add_module(G4magneticfield
     G4SimpleHeum.cc
     G4SimpleRunge.cc
     G4TrialsCounter.cc
+    G4TrilinearMagField.cc
     G4TsitourasRK45.cc
     G4UniformElectricField.cc
     G4UniformGravityField.cc
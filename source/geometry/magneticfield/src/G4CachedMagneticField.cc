@@ -28,6 +28,8 @@
 // Author: J.Apostolakis, 20 July 2009.
 // --------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "G4CachedMagneticField.hh"
 
 G4CachedMagneticField::G4CachedMagneticField(G4MagneticField* pMagField, 
@@ -106,3 +108,55 @@ G4CachedMagneticField::GetFieldValue( const G4double Point[4],
      fLastValue    = G4ThreeVector( Bfield[0], Bfield[1], Bfield[2] );
   }
 }
+
+void
+G4CachedMagneticField::GetFieldValues( const G4double* points,
+                                             G4double* fields,
+                                             G4int n ) const
+{
+  constexpr G4int nmax = 8;
+  constexpr G4int ncomp = G4Field::MAX_NUMBER_OF_COMPONENTS;
+  G4double missPoints[4*nmax];
+  G4double missFields[ncomp*nmax];
+  G4int missIndex[nmax];
+
+  const G4double distConstSq = fDistanceConst*fDistanceConst;
+  for (G4int first=0; first<n; first+=nmax)
+  {
+    G4int nbatch = std::min(n-first, nmax);
+    G4int nmiss = 0;
+    for (G4int i=first; i<first+nbatch; ++i)
+    {
+      const G4double* point = points + 4*i;
+      G4double* Bfield = fields + i*ncomp;
+      G4ThreeVector newLocation( point[0], point[1], point[2] );
+      if( (newLocation-fLastLocation).mag2() < distConstSq )
+      {
+        Bfield[0] = fLastValue.x();
+        Bfield[1] = fLastValue.y();
+        Bfield[2] = fLastValue.z();
+      }
+      else
+      {
+        for (G4int k=0; k<4; ++k) { missPoints[4*nmiss+k] = point[k]; }
+        missIndex[nmiss++] = i;
+      }
+    }
+    fCountCalls += nbatch;
+    if (nmiss == 0) { continue; }
+
+    fpMagneticField->GetFieldValues( missPoints, missFields, nmiss );
+    fCountEvaluations += nmiss;
+    for (G4int m=0; m<nmiss; ++m)
+    {
+      G4double* Bfield = fields + missIndex[m]*ncomp;
+      Bfield[0] = missFields[m*ncomp];
+      Bfield[1] = missFields[m*ncomp+1];
+      Bfield[2] = missFields[m*ncomp+2];
+    }
+    const G4double* last = missPoints + 4*(nmiss-1);
+    const G4double* lastB = missFields + (nmiss-1)*ncomp;
+    fLastLocation = G4ThreeVector( last[0],  last[1],  last[2] );
+    fLastValue    = G4ThreeVector( lastB[0], lastB[1], lastB[2] );
+  }
+}
@@ -44,6 +44,9 @@ G4ClassicalRK4(G4EquationOfMotion* EqRhs, G4int numberOfVariables)
    dydxm = new G4double[noVariables];
    dydxt = new G4double[noVariables]; 
    yt    = new G4double[noVariables]; 
+   dydxm2 = new G4double[noVariables];
+   dydxt2 = new G4double[noVariables]; 
+   yt2    = new G4double[noVariables]; 
 }
 
 ////////////////////////////////////////////////////////////////
@@ -55,6 +58,9 @@ G4ClassicalRK4::~G4ClassicalRK4()
   delete [] dydxm;
   delete [] dydxt;
   delete [] yt;
+  delete [] dydxm2;
+  delete [] dydxt2;
+  delete [] yt2;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -110,6 +116,68 @@ G4ClassicalRK4::DumbStepper( const G4double yIn[],
   
 }  // end of DumbStepper ....................................................
 
+//////////////////////////////////////////////////////////////////////
+//
+// Same as DumbStepper() for two steps of lengths h1 and h2 starting
+// from the same state. The stages of the two steps are evaluated side
+// by side, so that the field at each pair of stage points is obtained
+// with a single call to G4Field::GetFieldValues().
+//
+void
+G4ClassicalRK4::DumbStepperPair( const G4double yIn[],
+                                 const G4double dydx[],
+                                       G4double h1,
+                                       G4double yOut1[],
+                                       G4double h2,
+                                       G4double yOut2[] )
+{
+  const G4int nvar = GetNumberOfVariables();
+  G4int i;
+  G4double hh1 = h1*0.5, h61 = h1/6.0;
+  G4double hh2 = h2*0.5, h62 = h2/6.0;
+
+  const G4double* yts[2] = { yt, yt2 };
+  G4double* dydxts[2] = { dydxt, dydxt2 };
+  G4double* dydxms[2] = { dydxm, dydxm2 };
+
+  yt[7] = yt2[7] = yIn[7];
+  yOut1[7] = yOut2[7] = yIn[7];
+
+  for(i=0; i<nvar; ++i)
+  {
+    yt[i]  = yIn[i] + hh1*dydx[i];          // 1st Step K1=h*dydx
+    yt2[i] = yIn[i] + hh2*dydx[i];
+  }
+  RightHandSides(yts, dydxts, 2);           // 2nd Step K2=h*dydxt
+
+  for(i=0; i<nvar; ++i)
+  { 
+    yt[i]  = yIn[i] + hh1*dydxt[i];
+    yt2[i] = yIn[i] + hh2*dydxt2[i];
+  }
+  RightHandSides(yts, dydxms, 2);           // 3rd Step K3=h*dydxm
+
+  for(i=0; i<nvar; ++i)
+  {
+    yt[i]  = yIn[i] + h1*dydxm[i];
+    yt2[i] = yIn[i] + h2*dydxm2[i];
+    dydxm[i]  += dydxt[i];                  // now dydxm=(K2+K3)/h
+    dydxm2[i] += dydxt2[i];
+  }
+  RightHandSides(yts, dydxts, 2);           // 4th Step K4=h*dydxt
+ 
+  for(i=0; i<nvar; ++i)    // Final RK4 outputs
+  {
+    yOut1[i] = yIn[i]+h61*(dydx[i]+dydxt[i]+2.0*dydxm[i]);
+    yOut2[i] = yIn[i]+h62*(dydx[i]+dydxt2[i]+2.0*dydxm2[i]);
+  }
+  if ( nvar == 12 )
+  {
+    NormalisePolarizationVector ( yOut1 );
+    NormalisePolarizationVector ( yOut2 );
+  }
+}
+
 ////////////////////////////////////////////////////////////////////
 //
 // StepWithEst
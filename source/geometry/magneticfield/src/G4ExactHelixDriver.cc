@@ -0,0 +1,179 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4ExactHelixDriver implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4ExactHelixDriver.hh"
+
+#include "G4FieldTrack.hh"
+#include "G4Field.hh"
+#include "G4Exception.hh"
+#include "G4PhysicalConstants.hh"
+
+namespace
+{
+  // Below this deflection angle the helix is taken as a straight line
+  //
+  const G4double kMinAngle = 1.0e-12;
+}
+
+// --------------------------------------------------------------------
+//
+G4ExactHelixDriver::G4ExactHelixDriver(G4Mag_EqRhs* equation)
+  : fEquation(equation)
+{
+}
+
+// --------------------------------------------------------------------
+//
+void G4ExactHelixDriver::SetEquationOfMotion(G4EquationOfMotion* equation)
+{
+  auto magEquation = dynamic_cast<G4Mag_EqRhs*>(equation);
+  if (magEquation == nullptr)
+  {
+    G4Exception("G4ExactHelixDriver::SetEquationOfMotion()",
+                "GeomField0003", FatalErrorInArgument,
+                "Works only with G4Mag_EqRhs");
+  }
+  fEquation = magEquation;
+}
+
+// --------------------------------------------------------------------
+//
+G4double G4ExactHelixDriver::AdvanceChordLimited(G4FieldTrack& track,
+                                                 G4double hstep,
+                                                 G4double /*eps*/,
+                                                 G4double chordDistance)
+{
+  return AdvanceHelix(track, hstep, chordDistance);
+}
+
+// --------------------------------------------------------------------
+//
+G4bool G4ExactHelixDriver::AccurateAdvance(G4FieldTrack& track,
+                                           G4double hstep,
+                                           G4double /*eps*/,
+                                           G4double /*hinitial*/)
+{
+  AdvanceHelix(track, hstep, -1.0);
+  return true;
+}
+
+// --------------------------------------------------------------------
+//
+G4double G4ExactHelixDriver::AdvanceHelix(G4FieldTrack& track,
+                                          G4double hstep,
+                                          G4double chordDistance) const
+{
+  G4double y[G4FieldTrack::ncompSVEC];
+  track.DumpToArray(y);
+
+  G4double field[G4Field::MAX_NUMBER_OF_COMPONENTS];
+  const G4double point[4] = { y[0], y[1], y[2], y[7] };
+  fEquation->GetFieldValue(point, field);
+
+  G4ThreeVector position(y[0], y[1], y[2]);
+  G4ThreeVector momentum(y[3], y[4], y[5]);
+  G4ThreeVector bfield(field[0], field[1], field[2]);
+  G4double pmag = momentum.mag();
+  G4double bmag = bfield.mag();
+  G4ThreeVector u = momentum/pmag;
+
+  // Signed rate of rotation per unit length, around the field direction
+  //
+  G4double omega = fEquation->FCof()*bmag/pmag;
+
+  G4double step = hstep;
+  if (std::fabs(omega*hstep) < kMinAngle)
+  {
+    position += step*u;
+  }
+  else
+  {
+    G4ThreeVector b = bfield/bmag;
+    G4ThreeVector uPar = u.dot(b)*b;
+    G4ThreeVector uPerp = u - uPar;
+    G4ThreeVector uCross = uPerp.cross(b);
+
+    // The distance between the helix and its chord, over an angle phi, is
+    // that of the projected circle of radius R, i.e. R*(1-cos(phi/2)).
+    // Chords longer than half a turn are not allowed
+    //
+    G4double radius = uPerp.mag()/std::fabs(omega);
+    if (chordDistance > 0.0)
+    {
+      G4double maxAngle = (chordDistance < radius)
+                        ? 2.0*std::acos(1.0 - chordDistance/radius) : pi;
+      step = std::min(step, maxAngle/std::fabs(omega));
+    }
+
+    G4double phi = omega*step;
+    G4double sinPhi = std::sin(phi);
+    G4double cosPhi = std::cos(phi);
+    position += step*uPar + (sinPhi/omega)*uPerp
+              + ((1.0 - cosPhi)/omega)*uCross;
+    u = uPar + cosPhi*uPerp + sinPhi*uCross;
+  }
+
+  y[0] = position.x(); y[1] = position.y(); y[2] = position.z();
+  y[3] = pmag*u.x();   y[4] = pmag*u.y();   y[5] = pmag*u.z();
+  track.LoadFromArray(y, G4FieldTrack::ncompSVEC);
+  track.SetCurveLength(track.GetCurveLength() + step);
+
+  return step;
+}
+
+// --------------------------------------------------------------------
+//
+void G4ExactHelixDriver::GetDerivatives(const G4FieldTrack& track,
+                                              G4double dydx[]) const
+{
+  G4double y[G4FieldTrack::ncompSVEC];
+  track.DumpToArray(y);
+  fEquation->RightHandSide(y, dydx);
+}
+
+// --------------------------------------------------------------------
+//
+void G4ExactHelixDriver::GetDerivatives(const G4FieldTrack& track,
+                                              G4double dydx[],
+                                              G4double field[]) const
+{
+  G4double y[G4FieldTrack::ncompSVEC];
+  track.DumpToArray(y);
+  fEquation->EvaluateRhsReturnB(y, dydx, field);
+}
+
+// --------------------------------------------------------------------
+//
+void G4ExactHelixDriver::StreamInfo(std::ostream& os) const
+{
+  os << "State of G4ExactHelixDriver: " << std::endl;
+  os << "  Analytic helix, no stepper used" << std::endl;
+  os << "  Verbose level = " << fVerboseLevel << std::endl;
+}
@@ -46,6 +46,15 @@ G4Field& G4Field::operator = (const G4Field& p)
 
 G4Field::G4Field (const G4Field &p) = default;
 
+void G4Field::GetFieldValues( const G4double* points,
+                                    G4double* fields, G4int n ) const
+{
+   for (G4int i=0; i<n; ++i)
+   {
+     GetFieldValue(points + 4*i, fields + i*MAX_NUMBER_OF_COMPONENTS);
+   }
+}
+
 G4Field* G4Field::Clone() const
 {
     G4ExceptionDescription msg;
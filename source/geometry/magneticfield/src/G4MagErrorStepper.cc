@@ -71,9 +71,10 @@ void G4MagErrorStepper::Stepper( const G4double yInput[],
 
    G4double halfStep = hstep * 0.5; 
 
-   // Do two half steps
+   // Do the first half step together with the full step, as both
+   // start from the initial state, then the second half step
    //
-   DumbStepper  (yInitial,  dydx,   halfStep, yMiddle);
+   DumbStepperPair(yInitial, dydx, halfStep, yMiddle, hstep, yOneStep);
    RightHandSide(yMiddle, dydxMid);    
    DumbStepper  (yMiddle, dydxMid, halfStep, yOutput); 
 
@@ -81,9 +82,6 @@ void G4MagErrorStepper::Stepper( const G4double yInput[],
    //
    fMidPoint = G4ThreeVector( yMiddle[0],  yMiddle[1],  yMiddle[2]); 
 
-   // Do a full Step
-   //
-   DumbStepper(yInitial, dydx, hstep, yOneStep);
    for(G4int i=0; i<nvar; ++i)
    {
       yError [i] = yOutput[i] - yOneStep[i] ;
@@ -97,6 +95,17 @@ void G4MagErrorStepper::Stepper( const G4double yInput[],
    return;
 }
 
+void G4MagErrorStepper::DumbStepperPair( const G4double yIn[],
+                                         const G4double dydx[],
+                                               G4double h1,
+                                               G4double yOut1[],
+                                               G4double h2,
+                                               G4double yOut2[] )
+{
+   DumbStepper(yIn, dydx, h1, yOut1);
+   DumbStepper(yIn, dydx, h2, yOut2);
+}
+
 G4double G4MagErrorStepper::DistChord() const 
 {
   // Estimate the maximum distance from the curve to the chord
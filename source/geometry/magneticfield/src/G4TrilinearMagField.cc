@@ -0,0 +1,152 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// G4TrilinearMagField implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "G4TrilinearMagField.hh"
+
+G4TrilinearMagField::G4TrilinearMagField(const G4ThreeVector& minCorner,
+                                         const G4ThreeVector& spacing,
+                                         G4int nx, G4int ny, G4int nz)
+{
+  const G4int n[3] = { nx, ny, nz };
+  for (G4int k=0; k<3; ++k)
+  {
+    if (n[k] < 2 || spacing[k] <= 0)
+    {
+      G4ExceptionDescription msg;
+      msg << "Invalid grid: " << nx << " x " << ny << " x " << nz
+          << " nodes with spacing " << spacing << G4endl
+          << "At least 2 nodes and a positive spacing are required "
+          << "along each axis.";
+      G4Exception("G4TrilinearMagField::G4TrilinearMagField()",
+                  "GeomField0002", FatalException, msg);
+    }
+    fMin[k] = minCorner[k];
+    fSpacing[k] = spacing[k];
+    fInvSpacing[k] = 1./spacing[k];
+    fN[k] = n[k];
+  }
+  std::size_t size = std::size_t(nx)*ny*nz;
+  fBx.assign(size, 0.);
+  fBy.assign(size, 0.);
+  fBz.assign(size, 0.);
+}
+
+void G4TrilinearMagField::SetFieldValue(G4int i, G4int j, G4int k,
+                                        const G4ThreeVector& B)
+{
+  G4int idx = Index(i, j, k);
+  fBx[idx] = B.x();
+  fBy[idx] = B.y();
+  fBz[idx] = B.z();
+}
+
+G4ThreeVector G4TrilinearMagField::GetNodeValue(G4int i, G4int j,
+                                                G4int k) const
+{
+  G4int idx = Index(i, j, k);
+  return { fBx[idx], fBy[idx], fBz[idx] };
+}
+
+void G4TrilinearMagField::GetFieldValue(const G4double Point[4],
+                                              G4double* Bfield) const
+{
+  G4double field[G4Field::MAX_NUMBER_OF_COMPONENTS];
+  GetFieldValues(Point, field, 1);
+  Bfield[0] = field[0];
+  Bfield[1] = field[1];
+  Bfield[2] = field[2];
+}
+
+void G4TrilinearMagField::GetFieldValues(const G4double* points,
+                                               G4double* fields,
+                                               G4int n) const
+{
+  const G4double* bx = fBx.data();
+  const G4double* by = fBy.data();
+  const G4double* bz = fBz.data();
+  const G4int sy = fN[0], sz = fN[0]*fN[1];
+
+  for (G4int p=0; p<n; ++p)
+  {
+    // Cell index and fractional position along each axis. The cell is
+    // clamped to the grid and points outside get a zero weight, so that
+    // all the points follow the same path through the loop
+    //
+    G4int cell[3];
+    G4double frac[3];
+    G4double weight = 1.;
+    for (G4int k=0; k<3; ++k)
+    {
+      G4double u = (points[4*p+k] - fMin[k])*fInvSpacing[k];
+      weight *= (u >= 0. && u <= fN[k]-1) ? 1. : 0.;
+
+      // Clamp before the conversion to integer, which is undefined for
+      // values out of range; written so that NaN is mapped to 0
+      //
+      u = (u > 0.) ? u : 0.;
+      u = (u < G4double(fN[k]-1)) ? u : G4double(fN[k]-1);
+      cell[k] = std::min(G4int(u), fN[k]-2);
+      frac[k] = u - cell[k];
+    }
+    G4int i000 = cell[0] + sy*cell[1] + sz*cell[2];
+    G4int i100 = i000 + 1;
+    G4int i010 = i000 + sy;
+    G4int i110 = i010 + 1;
+    G4int i001 = i000 + sz;
+    G4int i101 = i001 + 1;
+    G4int i011 = i001 + sy;
+    G4int i111 = i011 + 1;
+
+    G4double fx = frac[0], gx = 1. - fx;
+    G4double fy = frac[1], gy = 1. - fy;
+    G4double fz = frac[2], gz = 1. - fz;
+    G4double w000 = gx*gy*gz, w100 = fx*gy*gz;
+    G4double w010 = gx*fy*gz, w110 = fx*fy*gz;
+    G4double w001 = gx*gy*fz, w101 = fx*gy*fz;
+    G4double w011 = gx*fy*fz, w111 = fx*fy*fz;
+
+    G4double* B = fields + p*G4Field::MAX_NUMBER_OF_COMPONENTS;
+    B[0] = weight*(w000*bx[i000] + w100*bx[i100] + w010*bx[i010]
+                 + w110*bx[i110] + w001*bx[i001] + w101*bx[i101]
+                 + w011*bx[i011] + w111*bx[i111]);
+    B[1] = weight*(w000*by[i000] + w100*by[i100] + w010*by[i010]
+                 + w110*by[i110] + w001*by[i001] + w101*by[i101]
+                 + w011*by[i011] + w111*by[i111]);
+    B[2] = weight*(w000*bz[i000] + w100*bz[i100] + w010*bz[i010]
+                 + w110*bz[i110] + w001*bz[i001] + w101*bz[i101]
+                 + w011*bz[i011] + w111*bz[i111]);
+  }
+}
+
+G4Field* G4TrilinearMagField::Clone() const
+{
+  return new G4TrilinearMagField(*this);
+}
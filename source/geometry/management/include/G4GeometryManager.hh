@@ -39,6 +39,7 @@
 
 // 26.07.95, P.Kent - Initial version, including optimisation build
 // 12.06.24, J.Apostolakis - Added parallel optimisation in workers
+// 18.10.26 - Added persistent cache of voxel optimisations
 // --------------------------------------------------------------------
 #ifndef G4GEOMETRYMANAGER_HH
 #define G4GEOMETRYMANAGER_HH 1
@@ -46,6 +47,7 @@
 #include <vector>
 
 #include "G4Types.hh"
+#include "G4String.hh"
 #include "G4SmartVoxelStat.hh"
 #include "G4ios.hh"
 
@@ -70,6 +72,11 @@ class G4GeometryManager
     inline G4bool IsGeometryClosed() { return fIsClosed; }
       // Return true/false according to state of optimised geometry.
 
+    static G4int GetClosureCount() { return fClosureCount; }
+      // Return the number of times the geometry was closed. Clients which
+      // keep data derived from the closed geometry compare it to know
+      // whether the geometry may have changed.
+
     void SetWorldMaximumExtent(G4double worldExtent);
       // Set the maximum extent of the world volume. The operation is
       // allowed only if NO solids have been created already.
@@ -102,6 +109,13 @@ class G4GeometryManager
       // Check whether parallel optimisation was requested.
     G4bool IsParallelOptimisationFinished();
       // Report whether parallel optimisation is done.
+
+    void SetVoxelCacheFile(const G4String& fileName);
+    const G4String& GetVoxelCacheFile() const;
+      // Set/get the file used to cache the voxel optimisations (an empty
+      // name, the default, disables caching). When closing the geometry,
+      // voxels are restored from the file if it was written for the same
+      // geometry; otherwise they are rebuilt and the file is (re)written.
   
     ~G4GeometryManager();
       // Destructor; called by G4RunManagerKernel.
@@ -158,6 +172,7 @@ class G4GeometryManager
 
     static G4ThreadLocal G4GeometryManager* fgInstance;
     G4bool fIsClosed = false;
+    static G4int fClosureCount;
 
     static std::vector<G4LogicalVolume*> fVolumesToOptimise;
       // The list of volumes which threads need to optimise.
@@ -189,6 +204,13 @@ class G4GeometryManager
     //
     static G4Timer* fWallClockTimer;   // Owned by master thread
     static G4bool fWallClockStarted;
+
+    // Persistent cache of voxel optimisations
+    // ---------------------------------------
+    static G4String fVoxelCacheFile;
+      // File for caching; caching is disabled if empty.
+    static G4bool fVoxelCacheAllOpts;
+      // Optimisation option the voxels being built refer to.
 };
 
 #endif
@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SmartVoxelCache
+//
+// Class description:
+//
+// Utility class for persistency of the smart voxel optimisation
+// structures (G4SmartVoxelHeader/G4SmartVoxelNode trees) built when
+// closing the geometry. The voxel trees of all logical volumes are
+// written to a single, versioned binary file, tagged with a hash of the
+// geometry (solids, placements, replication/parameterisation data,
+// smartless and optimisation settings, surface tolerance).
+// When restoring, the file is read in one go and the trees are rebuilt
+// in memory only if the hash matches the current geometry; otherwise
+// nothing is modified and the caller is expected to build the
+// optimisations from scratch.
+// The cache is activated through G4GeometryManager::SetVoxelCacheFile().
+
+// 18.10.26, Initial version
+// --------------------------------------------------------------------
+#ifndef G4SMARTVOXELCACHE_HH
+#define G4SMARTVOXELCACHE_HH 1
+
+#include <cstdint>
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4String.hh"
+
+class G4LogicalVolume;
+class G4SmartVoxelHeader;
+
+class G4SmartVoxelCache
+{
+  public:
+
+    static G4bool Store(const G4String& fileName, G4bool allOpts,
+                        G4bool verbose = false);
+      // Write the voxel headers currently attached to the logical volumes
+      // in the store to file. The file is written as <fileName>.tmp.<pid>
+      // and renamed over fileName, so that concurrent jobs never read a
+      // partial file. Returns false if the file cannot be written.
+
+    static G4bool Restore(const G4String& fileName, G4bool allOpts,
+                          G4bool verbose = false);
+      // Read the voxel headers from file and attach them to the logical
+      // volumes, replacing any existing optimisation. Returns false, leaving
+      // the geometry untouched, if the file is missing, corrupted, of a
+      // different format version or built for a different geometry.
+
+    static std::uint64_t ComputeGeometryHash(G4bool allOpts);
+      // Return the hash identifying the current geometry setup for the
+      // purpose of voxel optimisation.
+
+    static constexpr std::uint32_t kFormatVersion = 1;
+      // Version of the file format; to be increased at any change in
+      // layout or in the voxelisation algorithm/constants.
+
+  private:
+
+    static void WriteHeader(const G4SmartVoxelHeader* head,
+                            std::vector<char>& buffer);
+    static G4SmartVoxelHeader* ReadHeader(const char*& pos, const char* end,
+                                          std::size_t nDaughters,
+                                          G4int depth = 0);
+      // (De)serialise one header and its sub-tree. ReadHeader() returns
+      // a null pointer if the data are inconsistent.
+};
+
+#endif
@@ -193,6 +193,14 @@ class G4SmartVoxelHeader
 
     G4ProxyVector fslices;
       // Slices along axis.
+
+  private:
+
+    G4SmartVoxelHeader();
+      // Constructor for an empty header, to be filled in by
+      // G4SmartVoxelCache when restoring voxels from file.
+
+    friend class G4SmartVoxelCache;
 };
 
 #include "G4SmartVoxelHeader.icc"
@@ -23,75 +23,56 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-// EmStandardPhysicsTrackingManager
+// class G4ThreeVectorSoA
 //
 // Class description:
 //
-// An implementation of the G4VTrackingManager interface for e-/e+ and gamma
-// with the same processes as G4EmStandardPhysics.
-//
-// Original author: Jonas Hahnfeld, 2021
-
-#ifndef EmStandardPhysicsTrackingManager_h
-#define EmStandardPhysicsTrackingManager_h 1
+// A simple container of three-vectors, storing each component in a
+// separate contiguous array (`structure of arrays'), so that a block of
+// points or directions can be processed component-wise by batched
+// navigation and by the batched methods of solids.
 
-#include "G4VTrackingManager.hh"
-#include "globals.hh"
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4THREEVECTORSOA_HH
+#define G4THREEVECTORSOA_HH 1
 
-class G4eMultipleScattering;
-class G4CoulombScattering;
-class G4eIonisation;
-class G4eBremsstrahlung;
-class G4eplusAnnihilation;
+#include <vector>
 
-class G4ComptonScattering;
-class G4GammaConversion;
-class G4PhotoElectricEffect;
-class G4RayleighScattering;
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
 
-class EmStandardPhysicsTrackingManager : public G4VTrackingManager
+class G4ThreeVectorSoA
 {
   public:
-    EmStandardPhysicsTrackingManager();
-    ~EmStandardPhysicsTrackingManager();
 
-    void BuildPhysicsTable(const G4ParticleDefinition&) override;
+    G4ThreeVectorSoA() = default;
+    explicit G4ThreeVectorSoA(std::size_t n);
+      // Constructors, creating an empty container or one of n null vectors.
 
-    void PreparePhysicsTable(const G4ParticleDefinition&) override;
+    inline std::size_t Size() const;
+    inline void Resize(std::size_t n);
+    inline void Clear();
+      // Size of the container and its modifiers.
 
-    void HandOverOneTrack(G4Track* aTrack) override;
-
-  private:
-    void TrackElectron(G4Track* aTrack);
-    void TrackPositron(G4Track* aTrack);
-    void TrackGamma(G4Track* aTrack);
+    inline void PushBack(const G4ThreeVector& v);
+    inline void Set(std::size_t i, const G4ThreeVector& v);
+    inline G4ThreeVector Get(std::size_t i) const;
+      // Append, set or return the i-th vector (no bounds checking).
 
-    struct
-    {
-        G4eMultipleScattering* msc;
-        G4eIonisation* ioni;
-        G4eBremsstrahlung* brems;
-        G4CoulombScattering* ss;
-    } fElectronProcs;
+    inline G4double* X();
+    inline G4double* Y();
+    inline G4double* Z();
+    inline const G4double* X() const;
+    inline const G4double* Y() const;
+    inline const G4double* Z() const;
+      // Direct access to the arrays of components.
 
-    struct
-    {
-        G4eMultipleScattering* msc;
-        G4eIonisation* ioni;
-        G4eBremsstrahlung* brems;
-        G4eplusAnnihilation* annihilation;
-        G4CoulombScattering* ss;
-    } fPositronProcs;
-
-    struct
-    {
-        G4PhotoElectricEffect* pe;
-        G4ComptonScattering* compton;
-        G4GammaConversion* conversion;
-        G4RayleighScattering* rayleigh;
-    } fGammaProcs;
+  private:
 
-    static EmStandardPhysicsTrackingManager* fMasterTrackingManager;
+    std::vector<G4double> fX, fY, fZ;
 };
 
+#include "G4ThreeVectorSoA.icc"
+
 #endif
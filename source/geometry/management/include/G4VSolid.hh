@@ -64,6 +64,7 @@
 
 class G4AffineTransform;
 class G4VoxelLimits;
+class G4ThreeVectorSoA;
 
 class G4VPVParameterisation;
 class G4VPhysicalVolume;
@@ -157,6 +158,36 @@ class G4VSolid
       // Calculate the distance to the nearest surface of a shape from an
       // inside point. The distance can be an underestimate.
 
+    // Batched interface: the methods below evaluate the corresponding
+    // scalar method for each of the points (and directions) in the
+    // structure-of-arrays blocks p (and v), writing the results in the
+    // provided arrays, which must hold at least p.Size() elements.
+    // The default implementations loop over the scalar methods; solids
+    // may specialise them to process several points at once.
+
+    virtual void InsideBatch(const G4ThreeVectorSoA& p,
+                             EInside* result) const;
+      // Batched version of Inside(p).
+
+    virtual void DistanceToInBatch(const G4ThreeVectorSoA& p,
+                                   const G4ThreeVectorSoA& v,
+                                   G4double* dist) const;
+      // Batched version of DistanceToIn(p,v).
+
+    virtual void SafetyToInBatch(const G4ThreeVectorSoA& p,
+                                 G4double* safety) const;
+      // Batched version of DistanceToIn(p).
+
+    virtual void DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                                    const G4ThreeVectorSoA& v,
+                                    G4double* dist) const;
+      // Batched version of DistanceToOut(p,v), without computation
+      // of the exit normal.
+
+    virtual void SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                                  G4double* safety) const;
+      // Batched version of DistanceToOut(p).
+
 
     virtual void ComputeDimensions(G4VPVParameterisation* p,
 	                           const G4int n,
@@ -43,6 +43,7 @@ geant4_add_module(G4geometrymng
     G4RegionStore.hh
     G4ScaleTransform.hh
     G4ScaleTransform.icc
+    G4SmartVoxelCache.hh
     G4SmartVoxelHeader.hh
     G4SmartVoxelHeader.icc
     G4SmartVoxelNode.hh
@@ -51,6 +52,8 @@ geant4_add_module(G4geometrymng
     G4SmartVoxelProxy.icc
     G4SmartVoxelStat.hh
     G4SolidStore.hh
+    G4ThreeVectorSoA.hh
+    G4ThreeVectorSoA.icc
     G4TouchableHandle.hh
     G4TouchableHistory.hh
     G4TouchableHistory.icc
@@ -96,6 +99,7 @@ geant4_add_module(G4geometrymng
     G4ReflectedSolid.cc
     G4Region.cc
     G4RegionStore.cc
+    G4SmartVoxelCache.cc
     G4SmartVoxelHeader.cc
     G4SmartVoxelNode.cc
     G4SmartVoxelStat.cc
@@ -27,6 +27,7 @@
 //
 // 26.07.95, P.Kent - Initial version, including optimisation build
 // 12.06.24, J.Apostolakis - Added parallel optimisation in workers
+// 18.10.26 - Added persistent cache of voxel optimisations
 // --------------------------------------------------------------------
 
 #include <iomanip>
@@ -42,6 +43,7 @@
 #include "G4LogicalVolumeStore.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4SmartVoxelHeader.hh"
+#include "G4SmartVoxelCache.hh"
 #include "voxeldefs.hh"
 
 // Needed for setting the extent for tolerance value
@@ -76,6 +78,7 @@ namespace  // Data structures / mutexes for parallel optimisation
 // ***************************************************************************
 //
 G4ThreadLocal G4GeometryManager* G4GeometryManager::fgInstance = nullptr;
+G4int G4GeometryManager::fClosureCount = 0;
 
 // Static *global* class data
 G4bool G4GeometryManager::fParallelVoxelOptimisationRequested = false;
@@ -104,6 +107,10 @@ unsigned int G4GeometryManager::fTotalNumberVolumesOptimised = 0U;
 G4Timer* G4GeometryManager::fWallClockTimer = nullptr;
 G4bool G4GeometryManager::fWallClockStarted = false;
 
+// For persistent cache of voxels
+G4String G4GeometryManager::fVoxelCacheFile = "";
+G4bool G4GeometryManager::fVoxelCacheAllOpts = true;
+
 // ***************************************************************************
 // Destructor
 // ***************************************************************************
@@ -141,6 +148,7 @@ G4bool G4GeometryManager::CloseGeometry(G4bool pOptimise, G4bool verbose,
       BuildOptimisations(pOptimise, verbose);
     }
     fIsClosed = true;
+    ++fClosureCount;
   }
   return true;
 }
@@ -236,6 +244,16 @@ G4GeometryManager::ReportVoxelInfo(G4LogicalVolume* logVolume, std::ostream& os)
 G4bool G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
 {
   G4bool finishedOptimisation = false;
+
+  // Try first to restore optimisations from the cache, if enabled
+  //
+  fVoxelCacheAllOpts = allOpts;
+  if ( !fVoxelCacheFile.empty()
+    && G4SmartVoxelCache::Restore(fVoxelCacheFile, allOpts, verbose) )
+  {
+    fOptimiseInParallelConfigured = false;
+    return true;
+  }
   
   fOptimiseInParallelConfigured = fParallelVoxelOptimisationRequested
                                && G4Threading::IsMultithreadedApplication();
@@ -357,6 +375,10 @@ void G4GeometryManager::BuildOptimisationsSequential(G4bool allOpts,
     ReportVoxelStats( stats, allTimer.GetSystemElapsed()
                      + allTimer.GetUserElapsed() );
   }
+  if (!fVoxelCacheFile.empty())
+  {
+    G4SmartVoxelCache::Store(fVoxelCacheFile, allOpts, verbose);
+  }
 }
 
 // ***************************************************************************
@@ -603,6 +625,10 @@ void G4GeometryManager::UndertakeOptimisation()
       G4Exception("G4GeometryManager::UndertakeOptimisation()",
                   "GeomMng002", FatalException, errmsg);
     }
+    if (!fVoxelCacheFile.empty())
+    {
+      G4SmartVoxelCache::Store(fVoxelCacheFile, fVoxelCacheAllOpts, verbose);
+    }
     
     // Create report
 
@@ -984,3 +1010,17 @@ G4bool G4GeometryManager::IsParallelOptimisationFinished()
 {
   return fParallelVoxelOptimisationFinished;
 }
+
+// ***************************************************************************
+// Set/get the file for caching voxel optimisations -- static (class) data.
+// ***************************************************************************
+//
+void G4GeometryManager::SetVoxelCacheFile(const G4String& fileName)
+{
+  fVoxelCacheFile = fileName;
+}
+
+const G4String& G4GeometryManager::GetVoxelCacheFile() const
+{
+  return fVoxelCacheFile;
+}
@@ -0,0 +1,535 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// Class G4SmartVoxelCache implementation
+//
+// 18.10.26, Initial version
+// --------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#if !defined(WIN32)
+#  include <unistd.h>
+#endif
+
+#include "G4SmartVoxelCache.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "G4SmartVoxelNode.hh"
+#include "G4SmartVoxelProxy.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VPVParameterisation.hh"
+#include "G4VSolid.hh"
+#include "G4GeometryTolerance.hh"
+#include "voxeldefs.hh"
+#include "G4ios.hh"
+
+namespace
+{
+  const char kMagic[8] = { 'G','4','V','O','X','E','L','S' };
+  const std::uint32_t kByteOrderMark = 0x01020304;
+
+  // Slice tags in the serialised header
+  //
+  const char kSameAsPrevious = 0;
+  const char kNodeSlice = 1;
+  const char kHeaderSlice = 2;
+
+  // Simple 64-bit FNV-1a hash
+  //
+  class G4VoxelHasher
+  {
+    public:
+
+      void Add(const void* data, std::size_t size)
+      {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i=0; i<size; ++i)
+        {
+          fHash ^= bytes[i];
+          fHash *= 0x100000001b3ULL;
+        }
+      }
+      template <class T> void Add(const T& value) { Add(&value, sizeof(T)); }
+      void AddString(const G4String& str) { Add(str.data(), str.size()); }
+      void AddVector(const G4ThreeVector& v)
+      {
+        Add(v.x()); Add(v.y()); Add(v.z());
+      }
+      void AddRotation(const G4RotationMatrix* rot)
+      {
+        G4bool isRotated = (rot != nullptr) && !rot->isIdentity();
+        Add(isRotated);
+        if (isRotated)
+        {
+          Add(rot->xx()); Add(rot->xy()); Add(rot->xz());
+          Add(rot->yx()); Add(rot->yy()); Add(rot->yz());
+          Add(rot->zx()); Add(rot->zy()); Add(rot->zz());
+        }
+      }
+      std::uint64_t Value() const { return fHash; }
+
+    private:
+
+      std::uint64_t fHash = 0xcbf29ce484222325ULL;
+  };
+
+  using G4SolidHashMap = std::unordered_map<const G4VSolid*, std::uint64_t>;
+
+  // Hash of the shape of a solid: type, printout of its parameters
+  // and bounding limits. Evaluated only once for shared solids, unless
+  // the solid is modified by a parameterisation (noCache=true).
+  //
+  std::uint64_t HashSolid(const G4VSolid* solid, G4SolidHashMap& done,
+                          G4bool noCache = false)
+  {
+    if (!noCache)
+    {
+      auto pos = done.find(solid);
+      if (pos != done.cend()) { return pos->second; }
+    }
+    G4VoxelHasher hasher;
+    G4ThreeVector pMin, pMax;
+    solid->BoundingLimits(pMin, pMax);
+    hasher.AddString(solid->GetEntityType());
+    hasher.AddVector(pMin);
+    hasher.AddVector(pMax);
+    if (!noCache)
+    {
+      std::ostringstream os;
+      os << std::setprecision(17);
+      solid->StreamInfo(os);
+      hasher.AddString(os.str());
+      done[solid] = hasher.Value();
+    }
+    return hasher.Value();
+  }
+
+  void HashVolume(const G4LogicalVolume* volume, G4VoxelHasher& hasher,
+                  G4SolidHashMap& done)
+  {
+    std::size_t nDaughters = volume->GetNoDaughters();
+    hasher.AddString(volume->GetName());
+    hasher.Add(volume->GetSmartless());
+    hasher.Add(volume->IsToOptimise());
+    hasher.Add(nDaughters);
+    hasher.Add(HashSolid(volume->GetSolid(), done));
+
+    for (std::size_t i=0; i<nDaughters; ++i)
+    {
+      G4VPhysicalVolume* daughter = volume->GetDaughter(i);
+      hasher.Add(daughter->IsReplicated());
+      hasher.Add(daughter->GetRegularStructureId());
+      if (!daughter->IsReplicated())
+      {
+        hasher.AddRotation(daughter->GetRotation());
+        hasher.AddVector(daughter->GetTranslation());
+        hasher.Add(HashSolid(daughter->GetLogicalVolume()->GetSolid(), done));
+        continue;
+      }
+      EAxis axis;
+      G4int nReplicas;
+      G4double width, offset;
+      G4bool consuming;
+      daughter->GetReplicationData(axis, nReplicas, width, offset, consuming);
+      hasher.Add(axis); hasher.Add(nReplicas);
+      hasher.Add(width); hasher.Add(offset); hasher.Add(consuming);
+      hasher.Add(HashSolid(daughter->GetLogicalVolume()->GetSolid(), done));
+
+      // For parameterised volumes (not regular structures), the extent of
+      // each copy enters the voxelisation; the same setup of solid and
+      // transformation as in G4SmartVoxelHeader::BuildNodes() is applied
+      //
+      G4VPVParameterisation* pParam = daughter->GetParameterisation();
+      if ( (pParam != nullptr) && (daughter->GetRegularStructureId() != 1) )
+      {
+        for (G4int copyNo=0; copyNo<nReplicas; ++copyNo)
+        {
+          G4VSolid* solid = pParam->ComputeSolid(copyNo, daughter);
+          solid->ComputeDimensions(pParam, copyNo, daughter);
+          pParam->ComputeTransformation(copyNo, daughter);
+          hasher.AddRotation(daughter->GetRotation());
+          hasher.AddVector(daughter->GetTranslation());
+          hasher.Add(HashSolid(solid, done, true));
+        }
+      }
+    }
+  }
+
+  template <class T> void Write(std::vector<char>& buffer, const T& value)
+  {
+    const char* data = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), data, data+sizeof(T));
+  }
+
+  template <class T> G4bool Read(const char*& pos, const char* end, T& value)
+  {
+    if (end-pos < (std::ptrdiff_t)sizeof(T)) { return false; }
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+}
+
+// ***************************************************************************
+// Computes the hash of the current geometry setup, i.e. of all the
+// information in the logical volume store determining the voxelisation.
+// ***************************************************************************
+//
+std::uint64_t G4SmartVoxelCache::ComputeGeometryHash(G4bool allOpts)
+{
+  G4VoxelHasher hasher;
+  G4SolidHashMap solidHashes;
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+
+  hasher.Add(kFormatVersion);
+  hasher.Add(allOpts);
+  hasher.Add(kMaxVoxelNodes);
+  hasher.Add(kMinVoxelVolumesLevel1);
+  hasher.Add(kMinVoxelVolumesLevel2);
+  hasher.Add(kMinVoxelVolumesLevel3);
+  hasher.Add(G4GeometryTolerance::GetInstance()->GetSurfaceTolerance());
+  hasher.Add(store->size());
+  for (const auto* volume : *store)
+  {
+    HashVolume(volume, hasher, solidHashes);
+  }
+  return hasher.Value();
+}
+
+// ***************************************************************************
+// Writes the voxel headers of all logical volumes to file.
+// Layout: magic, format version, byte-order mark, geometry hash, number
+// of records; then, for each voxelised volume, its index in the store
+// followed by the serialised header tree.
+// ***************************************************************************
+//
+G4bool G4SmartVoxelCache::Store(const G4String& fileName, G4bool allOpts,
+                                G4bool verbose)
+{
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  std::vector<char> buffer;
+  std::uint32_t nRecords = 0;
+
+  buffer.insert(buffer.end(), kMagic, kMagic+sizeof(kMagic));
+  Write(buffer, kFormatVersion);
+  Write(buffer, kByteOrderMark);
+  Write(buffer, ComputeGeometryHash(allOpts));
+  std::size_t recordsPos = buffer.size();
+  Write(buffer, nRecords);
+
+  for (std::size_t i=0; i<store->size(); ++i)
+  {
+    const G4SmartVoxelHeader* head = (*store)[i]->GetVoxelHeader();
+    if (head == nullptr) { continue; }
+    Write(buffer, (std::uint32_t)i);
+    WriteHeader(head, buffer);
+    ++nRecords;
+  }
+  std::memcpy(&buffer[recordsPos], &nRecords, sizeof(nRecords));
+
+  // The cache is written to a temporary file in the same directory and
+  // renamed over the target, so that a job restoring the cache of the
+  // same name never reads a partially written file
+  //
+  G4String tmpName = fileName + ".tmp";
+#if !defined(WIN32)
+  tmpName += "." + std::to_string(getpid());
+#endif
+  std::ofstream out(tmpName, std::ios::out | std::ios::binary);
+  G4bool ok = out.is_open();
+  if (ok)
+  {
+    out.write(buffer.data(), (std::streamsize)buffer.size());
+    out.close();
+    ok = !out.fail();
+  }
+  if (ok)
+  {
+#if defined(WIN32)
+    std::remove(fileName.c_str());
+#endif
+    ok = (std::rename(tmpName.c_str(), fileName.c_str()) == 0);
+  }
+  if (!ok)
+  {
+    std::ostringstream message;
+    message << "Cannot write file " << fileName << "." << G4endl
+            << "Voxel optimisations not cached.";
+    G4Exception("G4SmartVoxelCache::Store()", "GeomMgt1002",
+                JustWarning, message);
+    std::remove(tmpName.c_str());
+    return false;
+  }
+
+  if (verbose)
+  {
+    G4cout << "G4SmartVoxelCache::Store() - Cached voxels of " << nRecords
+           << " volumes to file " << fileName << " ("
+           << buffer.size()/1024 << " kByte)." << G4endl;
+  }
+  return true;
+}
+
+// ***************************************************************************
+// Reads the voxel headers from file and attaches them to the logical
+// volumes. All headers are first rebuilt and validated; the geometry is
+// modified only if the whole file is consistent with it.
+// ***************************************************************************
+//
+G4bool G4SmartVoxelCache::Restore(const G4String& fileName, G4bool allOpts,
+                                  G4bool verbose)
+{
+  std::ifstream in(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in) { return false; }
+
+  // Read the whole file in a single operation
+  //
+  std::vector<char> buffer((std::size_t)in.tellg());
+  in.seekg(0);
+  in.read(buffer.data(), (std::streamsize)buffer.size());
+  if (!in) { return false; }
+  in.close();
+
+  const char* pos = buffer.data();
+  const char* end = pos + buffer.size();
+  std::uint32_t version = 0, byteOrder = 0, nRecords = 0;
+  std::uint64_t hash = 0;
+
+  if ( (buffer.size() < sizeof(kMagic))
+    || (std::memcmp(pos, kMagic, sizeof(kMagic)) != 0) )
+  {
+    std::ostringstream message;
+    message << "File " << fileName << " is not a voxel cache file." << G4endl
+            << "Voxel optimisations will be rebuilt.";
+    G4Exception("G4SmartVoxelCache::Restore()", "GeomMgt1002",
+                JustWarning, message);
+    return false;
+  }
+  pos += sizeof(kMagic);
+  if ( !Read(pos, end, version) || (version != kFormatVersion)
+    || !Read(pos, end, byteOrder) || (byteOrder != kByteOrderMark)
+    || !Read(pos, end, hash) || !Read(pos, end, nRecords) )
+  {
+    if (verbose)
+    {
+      G4cout << "G4SmartVoxelCache::Restore() - Incompatible format in file "
+             << fileName << ". Voxels will be rebuilt." << G4endl;
+    }
+    return false;
+  }
+  if (hash != ComputeGeometryHash(allOpts))
+  {
+    if (verbose)
+    {
+      G4cout << "G4SmartVoxelCache::Restore() - Geometry changed since file "
+             << fileName << " was written. Voxels will be rebuilt." << G4endl;
+    }
+    return false;
+  }
+
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  std::vector<G4SmartVoxelHeader*> headers(store->size(), nullptr);
+  G4bool valid = true;
+
+  for (std::uint32_t n=0; n<nRecords && valid; ++n)
+  {
+    std::uint32_t index = 0;
+    valid = Read(pos, end, index) && (index < headers.size())
+         && (headers[index] == nullptr);
+    if (!valid) { break; }
+
+    // Node contents are daughter numbers, or copy numbers for volumes
+    // containing a single replica
+    //
+    const G4LogicalVolume* volume = (*store)[index];
+    std::size_t nVolumes = volume->GetNoDaughters();
+    if ( (nVolumes == 1) && volume->GetDaughter(0)->IsReplicated() )
+    {
+      nVolumes = volume->GetDaughter(0)->GetMultiplicity();
+    }
+    headers[index] = ReadHeader(pos, end, nVolumes);
+    valid = (headers[index] != nullptr);
+  }
+  if (!valid || (pos != end))
+  {
+    for (auto head : headers) { delete head; }
+    std::ostringstream message;
+    message << "Corrupted voxel cache file " << fileName << "." << G4endl
+            << "Voxel optimisations will be rebuilt.";
+    G4Exception("G4SmartVoxelCache::Restore()", "GeomMgt1002",
+                JustWarning, message);
+    return false;
+  }
+
+  for (std::size_t i=0; i<headers.size(); ++i)
+  {
+    G4LogicalVolume* volume = (*store)[i];
+    delete volume->GetVoxelHeader();
+    volume->SetVoxelHeader(headers[i]);
+  }
+
+  if (verbose)
+  {
+    G4cout << "G4SmartVoxelCache::Restore() - Restored voxels of "
+           << nRecords << " volumes from file " << fileName << "." << G4endl;
+  }
+  return true;
+}
+
+// ***************************************************************************
+// Serialises a header: axes, equivalent slice numbers, extents and slices.
+// Slices sharing the proxy of the previous one (collected equivalent
+// nodes/headers) are written as a single tag, so that sharing is preserved.
+// ***************************************************************************
+//
+void G4SmartVoxelCache::WriteHeader(const G4SmartVoxelHeader* head,
+                                    std::vector<char>& buffer)
+{
+  Write(buffer, (G4int)head->faxis);
+  Write(buffer, (G4int)head->fparamAxis);
+  Write(buffer, head->fminEquivalent);
+  Write(buffer, head->fmaxEquivalent);
+  Write(buffer, head->fminExtent);
+  Write(buffer, head->fmaxExtent);
+  Write(buffer, (std::uint32_t)head->fslices.size());
+
+  const G4SmartVoxelProxy* lastProxy = nullptr;
+  for (const auto proxy : head->fslices)
+  {
+    if (proxy == lastProxy)
+    {
+      Write(buffer, kSameAsPrevious);
+      continue;
+    }
+    lastProxy = proxy;
+    if (proxy->IsHeader())
+    {
+      Write(buffer, kHeaderSlice);
+      WriteHeader(proxy->GetHeader(), buffer);
+    }
+    else
+    {
+      const G4SmartVoxelNode* node = proxy->GetNode();
+      std::size_t nContained = node->GetNoContained();
+      Write(buffer, kNodeSlice);
+      Write(buffer, node->GetMinEquivalentSliceNo());
+      Write(buffer, node->GetMaxEquivalentSliceNo());
+      Write(buffer, (std::uint32_t)nContained);
+      for (std::size_t i=0; i<nContained; ++i)
+      {
+        Write(buffer, node->GetVolume((G4int)i));
+      }
+    }
+  }
+}
+
+// ***************************************************************************
+// Rebuilds a header from its serialised form, checking consistency of
+// the data (slice tags, volume numbers, depth of refinement).
+// ***************************************************************************
+//
+G4SmartVoxelHeader*
+G4SmartVoxelCache::ReadHeader(const char*& pos, const char* end,
+                              std::size_t nVolumes, G4int depth)
+{
+  G4int axis, paramAxis;
+  std::uint32_t nSlices;
+  auto head = new G4SmartVoxelHeader();
+
+  G4bool valid = (depth < 3)
+              && Read(pos, end, axis) && Read(pos, end, paramAxis)
+              && Read(pos, end, head->fminEquivalent)
+              && Read(pos, end, head->fmaxEquivalent)
+              && Read(pos, end, head->fminExtent)
+              && Read(pos, end, head->fmaxExtent)
+              && Read(pos, end, nSlices)
+              && (nSlices > 0) && (nSlices <= (std::uint32_t)kMaxVoxelNodes)
+              && (axis >= kXAxis) && (axis <= kUndefined)
+              && (paramAxis >= kXAxis) && (paramAxis <= kUndefined);
+  if (!valid)
+  {
+    delete head;
+    return nullptr;
+  }
+  head->faxis = (EAxis)axis;
+  head->fparamAxis = (EAxis)paramAxis;
+  head->fslices.reserve(nSlices);
+
+  for (std::uint32_t slice=0; slice<nSlices && valid; ++slice)
+  {
+    char tag = -1;
+    valid = Read(pos, end, tag);
+    if (!valid) { break; }
+    if (tag == kSameAsPrevious)
+    {
+      valid = !head->fslices.empty();
+      if (valid) { head->fslices.push_back(head->fslices.back()); }
+    }
+    else if (tag == kHeaderSlice)
+    {
+      G4SmartVoxelHeader* subHead = ReadHeader(pos, end, nVolumes, depth+1);
+      valid = (subHead != nullptr);
+      if (valid) { head->fslices.push_back(new G4SmartVoxelProxy(subHead)); }
+    }
+    else if (tag == kNodeSlice)
+    {
+      G4int minEq, maxEq;
+      std::uint32_t nContained;
+      valid = Read(pos, end, minEq) && Read(pos, end, maxEq)
+           && Read(pos, end, nContained) && (nContained <= nVolumes);
+      if (!valid) { break; }
+      auto node = new G4SmartVoxelNode((G4int)slice);
+      node->SetMinEquivalentSliceNo(minEq);
+      node->SetMaxEquivalentSliceNo(maxEq);
+      node->Reserve((G4int)nContained);
+      for (std::uint32_t i=0; i<nContained && valid; ++i)
+      {
+        G4int volNo;
+        valid = Read(pos, end, volNo) && (volNo >= 0)
+             && ((std::size_t)volNo < nVolumes);
+        if (valid) { node->Insert(volNo); }
+      }
+      node->Shrink();
+      head->fslices.push_back(new G4SmartVoxelProxy(node));
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+  if (!valid)
+  {
+    delete head;  // Deletes the slices read so far
+    return nullptr;
+  }
+  return head;
+}
@@ -111,6 +111,22 @@ G4SmartVoxelHeader::G4SmartVoxelHeader(G4LogicalVolume* pVolume,
   BuildVoxelsWithinLimits(pVolume,pLimits,pCandidates);
 }
 
+// ***************************************************************************
+// Private constructor:
+// creates an empty header with no slices, used when restoring voxels
+// from file (see G4SmartVoxelCache).
+// ***************************************************************************
+//
+G4SmartVoxelHeader::G4SmartVoxelHeader()
+  : fminEquivalent(0),
+    fmaxEquivalent(0),
+    faxis(kUndefined),
+    fparamAxis(kUndefined),
+    fmaxExtent(0.),
+    fminExtent(0.)
+{
+}
+
 // ***************************************************************************
 // Destructor:
 // deletes all proxies and underlying objects.
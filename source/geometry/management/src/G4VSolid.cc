@@ -37,6 +37,7 @@
 
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
+#include "G4ThreeVectorSoA.hh"
 #include "G4VisExtent.hh"
 
 //////////////////////////////////////////////////////////////////////////
@@ -130,6 +131,62 @@ void G4VSolid::SetName(const G4String& name)
   G4SolidStore::GetInstance()->SetMapValid(false);
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Default implementations of the batched methods: loop over the
+// corresponding scalar methods
+
+void G4VSolid::InsideBatch(const G4ThreeVectorSoA& p, EInside* result) const
+{
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    result[i] = Inside(p.Get(i));
+  }
+}
+
+void G4VSolid::DistanceToInBatch(const G4ThreeVectorSoA& p,
+                                 const G4ThreeVectorSoA& v,
+                                 G4double* dist) const
+{
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    dist[i] = DistanceToIn(p.Get(i), v.Get(i));
+  }
+}
+
+void G4VSolid::SafetyToInBatch(const G4ThreeVectorSoA& p,
+                               G4double* safety) const
+{
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    safety[i] = DistanceToIn(p.Get(i));
+  }
+}
+
+void G4VSolid::DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                                  const G4ThreeVectorSoA& v,
+                                  G4double* dist) const
+{
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    dist[i] = DistanceToOut(p.Get(i), v.Get(i));
+  }
+}
+
+void G4VSolid::SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                                G4double* safety) const
+{
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    safety[i] = DistanceToOut(p.Get(i));
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // Throw exception if ComputeDimensions called for illegal derived class
@@ -0,0 +1,135 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4FlatGeometry
+//
+// Class description:
+//
+// Compact, index-based image of the placed geometry tree, to be used by
+// G4FlatNavigator. Every touchable reachable through placements is
+// expanded into a node; nodes are stored breadth-first in arrays, so that
+// the daughters of a node are contiguous and in the same order as in
+// their logical mother volume. For each node the global-to-local
+// transformation is precomputed, together with the solid and its local
+// bounding box, so that locating a point requires no recomputation of
+// the transformations along the path and no pointer chasing through the
+// volume tree.
+// Replicated and parameterised daughters are not expanded: nodes holding
+// them are flagged as not flattened, and the points located there must
+// be completed by the standard navigator.
+// The image refers to the volumes and solids of the geometry, which must
+// not be modified after the build.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4FLATGEOMETRY_HH
+#define G4FLATGEOMETRY_HH 1
+
+#include <vector>
+#include <unordered_map>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "G4AffineTransform.hh"
+
+class G4VPhysicalVolume;
+class G4VSolid;
+class G4TouchableHistory;
+class G4NavigationHistory;
+
+class G4FlatGeometry
+{
+  public:  // with description
+
+    G4FlatGeometry() = default;
+   ~G4FlatGeometry() = default;
+
+    void Build(G4VPhysicalVolume* world);
+      // Build the image of the geometry below the given world volume.
+      // The geometry should be closed, so that the smart voxels of the
+      // mother volumes can be used by the navigator.
+    void Clear();
+      // Release the image.
+
+    inline void SetMaxNumberOfNodes(G4int max);
+    inline G4int GetMaxNumberOfNodes() const;
+      // Limit on the number of nodes; beyond it daughters are no longer
+      // expanded and their mothers are flagged as not flattened.
+
+    inline G4int GetNumberOfNodes() const;
+    inline G4VPhysicalVolume* GetWorldVolume() const;
+
+    inline G4VPhysicalVolume* GetPhysicalVolume(G4int node) const;
+    inline G4VSolid* GetSolid(G4int node) const;
+    inline G4int GetCopyNo(G4int node) const;
+    inline G4int GetParent(G4int node) const;
+      // Index of the mother node, -1 for the world.
+    inline G4int GetFirstDaughter(G4int node) const;
+    inline G4int GetNumberOfDaughters(G4int node) const;
+      // Daughters of a node, stored contiguously.
+    inline G4int GetDepth(G4int node) const;
+    inline G4bool IsFlattened(G4int node) const;
+      // Whether all the daughters of the node have been expanded.
+    inline const G4AffineTransform& GetGlobalToLocal(G4int node) const;
+    inline const G4double* GetExtent(G4int node) const;
+      // Local bounding box of the solid: xmin,ymin,zmin,xmax,ymax,zmax.
+
+    G4int GetNode(const G4NavigationHistory& history) const;
+      // Return the node of the volume at the top of the history, -1 if
+      // the history does not correspond to a node (volumes not expanded,
+      // or history of another geometry).
+
+    G4TouchableHistory* CreateTouchableHistory(G4int node) const;
+      // Create the touchable for the node: caller has deletion
+      // responsibility.
+
+    std::size_t AllocatedMemory() const;
+
+  private:
+
+    G4int AddNode(G4VPhysicalVolume* pVol, G4int parent, G4int depth,
+                  const G4AffineTransform& globalToLocal);
+
+  private:
+
+    G4int fMaxNodes = 1000000;
+
+    std::vector<G4VPhysicalVolume*> fPhysical;
+    std::vector<G4VSolid*> fSolid;
+    std::vector<G4int> fCopyNo;
+    std::vector<G4int> fParent;
+    std::vector<G4int> fFirstDaughter;
+    std::vector<G4int> fNumberOfDaughters;
+    std::vector<G4int> fDepth;
+    std::vector<G4bool> fFlattened;
+    std::vector<G4AffineTransform> fGlobalToLocal;
+    std::vector<G4double> fExtent;
+    std::unordered_map<const G4VPhysicalVolume*, G4int> fDaughterIndex;
+      // Index of the expanded volumes in their logical mother.
+};
+
+#include "G4FlatGeometry.icc"
+
+#endif
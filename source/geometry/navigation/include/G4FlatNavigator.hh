@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4FlatNavigator
+//
+// Class description:
+//
+// Navigator working on the flat image of the geometry built by
+// G4FlatGeometry. Volumes are identified by node indices; the local
+// frame of any node is obtained directly from its precomputed global
+// transformation, and daughters are rejected on their local bounding
+// boxes before the solids are queried. The smart voxels of the mother
+// logical volumes are used, when available, to select the candidate
+// daughters while locating points.
+// The navigator holds no state: the node where a point was located is
+// returned to the caller and passed back to the following queries.
+// The point location follows the conventions of G4NormalNavigation
+// (points on the surface of a daughter are located in the daughter,
+// daughters are checked in reverse order); nodes which are not fully
+// flattened must be completed by the standard G4Navigator.
+// G4Navigator uses it, when enabled by G4Navigator::EnableFlatGeometry(),
+// to descend through the levels of placements while locating points.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4FLATNAVIGATOR_HH
+#define G4FLATNAVIGATOR_HH 1
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+
+class G4FlatGeometry;
+class G4VPhysicalVolume;
+
+class G4FlatNavigator
+{
+  public:  // with description
+
+    explicit G4FlatNavigator(const G4FlatGeometry* geometry);
+   ~G4FlatNavigator() = default;
+
+    G4int LocateGlobalPoint(const G4ThreeVector& globalPoint,
+                            G4int hint = -1) const;
+      // Return the deepest node containing the point, -1 if the point is
+      // outside the world. If given, the search starts from the node
+      // 'hint', typically the node of the previous point of the track,
+      // going up only as far as needed.
+
+    G4int LocateDaughter(G4int node, const G4ThreeVector& globalPoint,
+                         const G4ThreeVector* globalDirection = nullptr,
+                         const G4bool locatedOnEdge = false,
+                         const G4VPhysicalVolume* blockedVol = nullptr) const;
+      // Return the daughter of the node containing the point, -1 if none.
+      // As in G4NormalNavigation::LevelLocate(), the direction is used to
+      // decide whether a point on the surface of a daughter enters it, if
+      // the point is located on an edge, and the blocked volume is skipped.
+      // Used by G4Navigator to descend through the expanded levels.
+
+    G4double ComputeStep(const G4ThreeVector& globalPoint,
+                         const G4ThreeVector& globalDirection,
+                               G4int node,
+                               G4double proposedStepLength,
+                               G4double& newSafety,
+                               G4int& enteredNode,
+                               G4bool& exiting) const;
+      // Return the distance to the next boundary along the direction,
+      // for a point located in the given node, or proposedStepLength if
+      // no boundary is closer. enteredNode is the daughter node entered
+      // (-1 if none) and exiting is true if the step leaves the node.
+      // newSafety is the isotropic safety at the start point.
+
+    G4double ComputeSafety(const G4ThreeVector& globalPoint,
+                                 G4int node) const;
+      // Return the isotropic safety for a point located in the node.
+
+    inline const G4FlatGeometry* GetGeometry() const;
+
+  private:
+
+    G4bool IsInside(G4int node, const G4ThreeVector& globalPoint,
+                    const G4ThreeVector* globalDirection = nullptr,
+                    const G4bool locatedOnEdge = false) const;
+
+    G4double DistanceToExtent(const G4double* extent,
+                              const G4ThreeVector& localPoint) const;
+    G4double DistanceToExtent(const G4double* extent,
+                              const G4ThreeVector& localPoint,
+                              const G4ThreeVector& localDirection) const;
+      // Isotropic distance and distance along the direction to the local
+      // bounding box of a node, enlarged by the tolerance.
+
+  private:
+
+    const G4FlatGeometry* fGeometry = nullptr;
+    G4double fTolerance;
+};
+
+inline const G4FlatGeometry* G4FlatNavigator::GetGeometry() const
+{
+  return fGeometry;
+}
+
+#endif
@@ -36,6 +36,7 @@
 #define G4GeomTestVolume_hh
 
 #include "G4ThreeVector.hh"
+#include "G4String.hh"
 
 class G4VPhysicalVolume;
 class G4GeomTestLogger;
@@ -64,6 +65,20 @@ class G4GeomTestVolume
     void SetErrorsThreshold(G4int max);
       // Get/Set maximum number of errors to report (default set to 1)
 
+    G4bool GetParallel() const;
+    void SetParallel(G4bool parallel);
+      // Get/Set whether TestOverlapInTree() checks the daughters of
+      // different mother volumes in concurrent tasks of the PTL thread
+      // pool (default set to false). Only effective in MT builds with a
+      // task-based run manager, otherwise the check is sequential
+    const G4String& GetReportFile() const;
+    void SetReportFile(const G4String& fileName);
+      // Get/Set the report file for incremental checks (default empty,
+      // i.e. all volumes are checked). If set, TestOverlapInTree() skips
+      // the mother volumes found without overlaps in the report, whose
+      // solid and daughters (solids and placements) did not change since,
+      // and then updates the report
+
     void TestOverlapInTree() const;
       // Check overlaps in the volume tree without
       // dublication in identical logical volumes
@@ -82,6 +97,8 @@ class G4GeomTestVolume
     G4int resolution;                 // Number of points to test
     G4int maxErr = 1;                 // Maximum number of errors to report
     G4bool verbosity;                 // Verbosity level for overlaps check
+    G4bool parallel = false;          // Check mother volumes in tasks
+    G4String reportFile;              // Report for incremental checks
 };
 
 #endif
@@ -43,6 +43,7 @@ class G4UIdirectory;
 class G4UIcommand;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithABool;
+class G4UIcmdWithAString;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithADoubleAndUnit;
 class G4TransportationManager;
@@ -69,11 +70,19 @@ class G4GeometryMessenger : public G4UImessenger
     void SetVerbosity(const G4String& newValue);
     void SetCheckMode(const G4String& newValue);
     void SetPushFlag(const G4String& newValue);
+    void SetSafetyCache(const G4String& newValue);
+    void SetFlatGeometry(const G4String& newValue);
+    void SetHelixForUniformField(const G4String& newValue);
+    void PrintHelixStatistics();
     void RecursiveOverlapTest();
+    void TreeOverlapTest();
 
     G4UIdirectory             *geodir, *navdir, *testdir;
-    G4UIcmdWithABool          *chkCmd, *pchkCmd, *verCmd, *parCmd;
-    G4UIcmdWithoutParameter   *recCmd, *resCmd;
+    G4UIcmdWithABool          *chkCmd, *pchkCmd, *verCmd, *parCmd, *scCmd,
+                              *tskCmd, *hlxCmd, *fltCmd;
+    G4UIcmdWithoutParameter   *recCmd, *resCmd, *scsCmd, *scrCmd, *treCmd,
+                              *hlsCmd;
+    G4UIcmdWithAString        *repCmd;
     G4UIcmdWithADoubleAndUnit *tolCmd;
     G4UIcmdWithAnInteger      *verbCmd, *rslCmd, *rcsCmd, *rcdCmd, *errCmd;
 
@@ -0,0 +1,184 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4NavigationBatch
+//
+// Class description:
+//
+// A block of tracks located in the same volume, to be navigated
+// together through G4Navigator::ComputeStepBatch(). Points and
+// directions are stored as structures of arrays, together with the
+// per-track navigation state (entering/exiting flags, candidate volume,
+// exit normal) and the results (step and safety), so that the
+// navigation classes can share the cost of the transformations and
+// of the calls to the solids among all the tracks of the block.
+//
+// The methods in the second part of the interface are the building
+// blocks used by the navigation classes for the batched computation
+// of steps; they reproduce the logic of the scalar ComputeStep().
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4NAVIGATIONBATCH_HH
+#define G4NAVIGATIONBATCH_HH 1
+
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "G4ThreeVectorSoA.hh"
+
+class G4AffineTransform;
+class G4NavigationHistory;
+class G4VNavigation;
+class G4ReplicaNavigation;
+class G4VPhysicalVolume;
+class G4VSolid;
+
+class G4NavigationBatch
+{
+  public:  // with description
+
+    G4NavigationBatch() = default;
+    explicit G4NavigationBatch(std::size_t nTracks);
+      // Constructors, for an empty block or for nTracks tracks.
+
+    void Resize(std::size_t nTracks);
+      // Set the number of tracks in the block and reset the navigation
+      // state of all tracks: not entering/exiting, no candidate volume.
+    inline std::size_t Size() const;
+      // Number of tracks in the block.
+
+    inline void SetTrack(std::size_t i, const G4ThreeVector& globalPoint,
+                         const G4ThreeVector& globalDirection,
+                         G4double proposedStepLength);
+      // Set point, direction and proposed step length of track i.
+
+    inline void SetExitedVolume(std::size_t i,
+                                G4VPhysicalVolume* exitedVolume,
+                                const G4ThreeVector& exitNormal);
+      // Optionally, for a track which has just exited a daughter volume,
+      // record the volume and the exit normal (in the local frame of the
+      // current volume) so that the daughter can be excluded when moving
+      // away from it, as done by G4Navigator in scalar mode.
+
+    inline G4double GetStep(std::size_t i) const;
+      // Step to the next boundary for track i, kInfinity if no boundary
+      // is found within the proposed step (physics limited).
+    inline G4double GetSafety(std::size_t i) const;
+      // Isotropic safety at the point of track i.
+    inline G4bool IsEntering(std::size_t i) const;
+    inline G4bool IsExiting(std::size_t i) const;
+      // Whether the step of track i ends entering a daughter or
+      // exiting the current volume.
+    inline G4VPhysicalVolume* GetCandidateVolume(std::size_t i) const;
+    inline G4int GetCandidateReplicaNo(std::size_t i) const;
+      // Daughter volume (and copy number) entered, if entering.
+    inline G4bool IsExitNormalValid(std::size_t i) const;
+    inline G4ThreeVector GetExitNormal(std::size_t i) const;
+      // Exit normal, if exiting, in the frame of the mother volume of
+      // the current volume.
+
+  public:  // without description
+
+    inline const G4ThreeVectorSoA& GetGlobalPoints() const;
+    inline const G4ThreeVectorSoA& GetGlobalDirections() const;
+    inline const G4ThreeVectorSoA& GetLocalPoints() const;
+    inline const G4ThreeVectorSoA& GetLocalDirections() const;
+    inline const std::vector<std::size_t>& GetAllTracks() const;
+
+    void SetLocalFrame(const G4AffineTransform& globalToLocal);
+      // Compute local points and directions, given the transformation
+      // from the global frame to the frame of the current volume.
+
+    void ComputeStep(std::size_t i, G4VNavigation& navigation,
+                     G4NavigationHistory& history);
+      // Compute the step of track i with the scalar method of the
+      // navigation class, using and updating the state of the track.
+    void ComputeReplicaStep(std::size_t i, G4ReplicaNavigation& navigation,
+                            G4NavigationHistory& history);
+      // Same as above, when the current volume is a replica.
+
+    void StartStep(const G4VSolid* motherSolid);
+      // Initialise the batched computation of steps: save the state,
+      // compute the mother safeties, apply the exiting normal
+      // optimisation and reset the entering/exiting flags.
+    void RestoreState(std::size_t i);
+      // Restore the state of track i as it was before StartStep().
+
+    void IntersectDaughter(G4VPhysicalVolume* samplePhysical,
+                     const std::size_t* tracks, std::size_t nTracks);
+      // Update safety and step of the listed tracks with the safety and
+      // intersection of a placed daughter volume.
+
+    inline void LimitSafety(std::size_t i, G4double safety);
+      // Limit the safety of track i to the given value.
+
+    G4bool ComputeMotherStep(std::size_t i,
+                             const G4VPhysicalVolume* motherPhysical);
+      // Finalise the step of track i, checking whether it is physics
+      // limited and computing, if required, the intersection with the
+      // mother solid. Returns true if the step is fully determined,
+      // i.e. physics limited or the point is found outside the mother.
+
+    void FinishSteps();
+      // Set the step to kInfinity for the tracks whose step is not
+      // limited by the geometry, as done by G4Navigator::ComputeStep().
+
+  private:
+
+    // Input
+    //
+    G4ThreeVectorSoA fGlobalPoints, fGlobalDirections;
+    G4ThreeVectorSoA fLocalPoints, fLocalDirections;
+    std::vector<G4double> fProposedSteps;
+    std::vector<std::size_t> fAllTracks;
+
+    // State and results
+    //
+    std::vector<G4double> fSteps, fSafeties, fMotherSafeties;
+    std::vector<char> fEntering, fExiting, fValidExitNormal;
+    G4ThreeVectorSoA fExitNormals;
+    std::vector<G4VPhysicalVolume*> fBlockedPhysical;
+    std::vector<G4int> fBlockedReplicaNo;
+    std::vector<const G4VPhysicalVolume*> fBlockedExited;
+
+    // Saved state, for recomputation of single tracks
+    //
+    std::vector<char> fSavedExiting, fSavedValidExitNormal;
+    G4ThreeVectorSoA fSavedExitNormals;
+    std::vector<G4VPhysicalVolume*> fSavedBlockedPhysical;
+    std::vector<G4int> fSavedBlockedReplicaNo;
+
+    // Work space for the daughter being sampled
+    //
+    G4ThreeVectorSoA fSamplePoints, fSampleDirections;
+    std::vector<G4double> fSampleValues;
+    std::vector<std::size_t> fSampleTracks;
+};
+
+#include "G4NavigationBatch.icc"
+
+#endif
@@ -57,11 +57,14 @@
 #include "G4ReplicaNavigation.hh"
 #include "G4RegularNavigation.hh"
 #include "G4VExternalNavigation.hh"
+#include "G4NavigationBatch.hh"
 
 #include <iostream>
 
 class G4VPhysicalVolume;
 class G4SafetyCalculator;
+class G4FlatGeometry;
+class G4FlatNavigator;
 
 class G4Navigator
 {
@@ -102,6 +105,14 @@ class G4Navigator
                                  G4double& pNewSafety); 
       // Same as above, but do not disturb the state of the Navigator.
 
+    void ComputeStepBatch(G4NavigationBatch& batch);
+      // Compute the steps for a block of tracks, all located in the
+      // current volume (i.e. the volume found by the last call to
+      // LocateGlobalPointAndSetup or LocateGlobalPointWithinVolume),
+      // storing steps, safeties and entering/exiting information in the
+      // block. The state of the Navigator is not modified. Tracks leaving
+      // the current volume must be relocated individually.
+
     virtual
     G4VPhysicalVolume* ResetHierarchyAndLocate(const G4ThreeVector& point,
                                                const G4ThreeVector& direction,
@@ -198,6 +209,9 @@ class G4Navigator
     inline G4TouchableHistory* CreateTouchableHistory(const G4NavigationHistory*) const;
       // `Touchable' creation methods: caller has deletion responsibility.
 
+    inline const G4NavigationHistory* GetCurrentHistory() const;
+      // Return the navigation history of the current location.
+
     virtual G4TouchableHandle CreateTouchableHistoryHandle() const;
       // Returns a reference counted handle to a touchable history.
 
@@ -293,6 +307,14 @@ class G4Navigator
     void SetVoxelNavigation(G4VoxelNavigation* voxelNav);
       // Alternative navigator for voxel volumes.
 
+    void EnableFlatGeometry(G4bool value = true);
+    inline G4bool IsFlatGeometryEnabled() const;
+    inline const G4FlatGeometry* GetFlatGeometry() const;
+      // Enable/disable the location of points through the flat image of
+      // the placements (G4FlatGeometry), built by each navigator at the
+      // first location after the geometry is closed. Replicated and
+      // parameterised levels are located as usual. Disabled by default.
+
     inline G4Navigator* Clone() const;
       // Cloning feature for use in MT applications to clone
       // navigator, including external sub-navigator.
@@ -361,6 +383,13 @@ class G4Navigator
                               G4double moveLenSq) const;
       // Log and checks for steps larger than the tolerance.
 
+    void LocateFlatDaughters(const G4ThreeVector& globalPoint,
+                             const G4ThreeVector* pGlobalDirection,
+                             const G4bool considerDirection,
+                                   G4ThreeVector& localPoint);
+      // Descend from the top of the history through the levels of the
+      // flat image, as the LevelLocate() loop of LocateGlobalPointAndSetup().
+
   protected:
 
     G4double kCarTolerance, fMinStep, fSqTol;
@@ -515,6 +544,11 @@ class G4Navigator
     G4VExternalNavigation* fpExternalNav = nullptr;
     G4VoxelSafety* fpVoxelSafety;
     G4SafetyCalculator* fpSafetyCalculator = nullptr;
+    G4FlatGeometry* fpFlatGeometry = nullptr;
+    G4FlatNavigator* fpFlatNavigator = nullptr;
+    G4int fFlatGeometryClosure = -1;
+      // Flat image of the geometry, when enabled, and the closure of the
+      // geometry it was built for.
 
     // Utility information
     //
@@ -85,6 +85,11 @@ class G4NormalNavigation : public G4VNavigation
                                 G4VPhysicalVolume *(*pBlockedPhysical),
                                 G4int &blockedReplicaNo ) final;
 
+    void ComputeStepBatch( G4NavigationBatch& batch,
+                           G4NavigationHistory& history ) final;
+      // Compute steps for a block of tracks, looping over the daughters
+      // once for all tracks and using the batched methods of the solids.
+
     G4double ComputeSafety( const G4ThreeVector &globalpoint,
                             const G4NavigationHistory &history,
                             const G4double pMaxLength=DBL_MAX ) final;
@@ -81,6 +81,10 @@ class G4ParameterisedNavigation : public G4VoxelNavigation
                                 G4VPhysicalVolume *(*pBlockedPhysical),
                                 G4int& blockedReplicaNo ) override;
 
+    void ComputeStepBatch( G4NavigationBatch& batch,
+                           G4NavigationHistory& history ) override;
+      // Compute steps for a block of tracks, one track at a time.
+
     G4double ComputeSafety( const G4ThreeVector& localPoint,
                             const G4NavigationHistory& history,
                             const G4double pProposedMaxLength=DBL_MAX ) override;
@@ -87,6 +87,12 @@ class G4PartialPhantomParameterisation : public G4PhantomParameterisation
 
     void BuildContainerWalls();
 
+    void CompactMaterialIndices() override;
+    void BuildHomogeneousRegions() override;
+      // Not supported: the indices refer to the filled voxels only and
+      // the regions assume the full voxel grid. A warning is issued and
+      // the user indices are kept.
+
   private:
 
     void ComputeVoxelIndices(const G4int copyNo, std::size_t& nx,
@@ -38,6 +38,7 @@
 #ifndef G4PhantomParameterisation_HH
 #define G4PhantomParameterisation_HH
 
+#include <cstdint>
 #include <vector>
 
 #include "G4Types.hh"
@@ -154,6 +155,31 @@ class G4PhantomParameterisation : public G4VPVParameterisation
                                    G4double contZ ) const;
       // Check that the voxels fill it completely.
 
+    virtual void CompactMaterialIndices();
+      // Replace the indices given with SetMaterialIndices() by an internal
+      // copy using 8 or 16 bits per voxel, according to the number of
+      // materials. The user array is no longer referenced afterwards (and
+      // GetMaterialIndices() returns null), so it can be deleted.
+    inline G4bool HasCompactMaterialIndices() const;
+
+    virtual void BuildHomogeneousRegions();
+    void ClearHomogeneousRegions();
+    inline G4bool HasHomogeneousRegions() const;
+      // Build (or release) an implicit octree over the voxels, flagging the
+      // blocks of 2^L x 2^L x 2^L voxels that share the same material.
+      // When built, G4RegularNavigation crosses such a block in one step
+      // instead of voxel by voxel; the step lengths stored in
+      // G4RegularNavigationHelper then refer to the first voxel crossed in
+      // each block. Must be called after setting materials and indices.
+      // Compaction and homogeneous regions are not available for
+      // G4PartialPhantomParameterisation.
+
+    G4bool GetHomogeneousBlock( const G4int copyNo, G4ThreeVector& blockMin,
+                                G4ThreeVector& blockMax ) const;
+      // Get the limits, in the container frame, of the largest homogeneous
+      // block containing the voxel. Returns false if the voxel is not part
+      // of any homogeneous block.
+
   private:
 
     void ComputeVoxelIndices(const G4int copyNo, std::size_t& nx,
@@ -191,6 +217,14 @@ class G4PhantomParameterisation : public G4VPVParameterisation
 
     G4bool bSkipEqualMaterials = true;
       // Flag to skip surface when two voxel have same material or not
+
+    std::vector<std::uint8_t> fMaterialIndices8;
+    std::vector<std::uint16_t> fMaterialIndices16;
+      // Compact copy of the material indices, only one of them is filled.
+
+    std::vector<std::vector<std::uint16_t>> fHomogeneousLevels;
+      // For each level L>0 of the octree, material index plus one of each
+      // block of 2^L voxels per side, or 0 if the block is not homogeneous.
 };
 
 #include "G4PhantomParameterisation.icc"
@@ -42,6 +42,7 @@
 
 #include "G4Types.hh"
 
+#include <map>
 #include <vector>
 
 #include "G4FieldTrack.hh"
@@ -187,6 +188,19 @@ class G4PropagatorInField
      // Note: delta-chord is reset to its original value at the end of
      //   each call to ComputeStep.
 
+   void SetUseHelixForUniformField( G4bool val );
+   inline G4bool GetUseHelixForUniformField() const;
+     // Enable/disable the fast path for volumes whose field manager holds
+     // a G4UniformMagField with the usual equation of motion (default
+     // false). The trajectory is then advanced along the exact helix,
+     // both for the chord steps and for locating the intersections with
+     // the boundaries, without calling the integration driver.
+   inline G4long GetNumberOfHelixSteps() const;
+   inline G4long GetNumberOfIntegratedSteps() const;
+   inline void   ResetStepCounters();
+     // Number of calls to ComputeStep() which used the helix fast path
+     // or the integration driver of the field manager, since last reset.
+
  public:  // without description
 
    inline G4double GetDeltaIntersection() const;
@@ -225,6 +239,12 @@ class G4PropagatorInField
    void ReportStuckParticle(G4int noZeroSteps, G4double proposedStep,
                             G4double lastTriedStep, G4VPhysicalVolume* physVol);
 
+ private:
+
+   G4ChordFinder* FindHelixChordFinder( G4FieldManager* fieldMgr );
+     // Return the chord finder using the exact helix for the field manager,
+     // created if needed, or null if its field is not a pure uniform one.
+
  private:
 
    // ----------------------------------------------------------------------
@@ -316,6 +336,22 @@ class G4PropagatorInField
    G4bool fFirstStepInVolume = true; 
    G4bool fLastStepInVolume = true; 
    G4bool fNewTrack = true;
+
+   // Fast path for uniform magnetic fields
+   G4bool fUseHelixForUniformField = false;
+   G4ChordFinder* fHelixChordFinder = nullptr;
+     // Helix chord finder of the current field manager, if any
+   struct G4HelixChordFinderEntry
+   {
+     const G4Field* fField = nullptr;
+     const G4ChordFinder* fChordFinder = nullptr;
+     G4ChordFinder* fHelixChordFinder = nullptr;   // Owned
+   };
+   std::map<const G4FieldManager*, G4HelixChordFinderEntry> fHelixChordFinders;
+     // Helix chord finders, for the field and chord finder with which each
+     // field manager was last found
+   G4long fNoHelixSteps = 0;
+   G4long fNoIntegratedSteps = 0;
 };
 
 // Inline methods
@@ -98,6 +98,8 @@ class G4RegularNavigation : public G4VNavigation
       // equal materials. Loop to voxels until a different material is found:
       // invokes G4NormalNavigation::ComputeStep() in each voxel and move the
       // point to the next voxel.
+      // If the parameterisation has built its homogeneous regions, whole
+      // blocks of voxels with equal material are crossed in a single step.
 
     G4double ComputeSafety( const G4ThreeVector& localPoint,
                             const G4NavigationHistory& history,
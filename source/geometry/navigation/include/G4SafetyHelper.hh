@@ -28,7 +28,12 @@
 // Class description:
 //
 // This class is a helper for physics processes which require 
-// knowledge of the safety, and the step size for the 'mass' geometry
+// knowledge of the safety, and the step size for the 'mass' geometry.
+// The last safety computed is kept as a sphere of validity, tagged with
+// the touchable where it was computed; if enabled, it is reused for nearby
+// points while the remaining safety covers the radius of interest requested.
+// The cache is disabled by default, since the reused value is smaller than
+// the safety computed by the navigator.
 
 // First version:  J.Apostolakis,  July 5th, 2006
 // --------------------------------------------------------------------
@@ -84,10 +89,26 @@ class G4SafetyHelper
     inline G4VPhysicalVolume* GetWorldVolume();
     inline void SetCurrentSafety(G4double val, const G4ThreeVector& pos);
 
+    inline void EnableSafetyCache(G4bool flag);
+    inline G4bool IsSafetyCacheEnabled() const;
+      // Enable/disable reuse of the last safety sphere (disabled by default)
+    inline G4long GetSafetyCacheHits() const;
+    inline G4long GetSafetyCacheMisses() const;
+    void PrintSafetyCacheStatistics() const;
+    void ResetSafetyCacheStatistics();
+      // Get/print/reset the counters of safety requests served from the
+      // last safety sphere (hits) or computed by navigation (misses)
+
   public: // without description
 
     void InitialiseHelper();
 
+  private:
+
+    inline void SetSafetyTouchable();
+    inline G4bool IsSafetyTouchable() const;
+      // Record/check the touchable in which the last safety was computed
+
   private:
 
     G4PathFinder* fpPathFinder = nullptr;
@@ -106,6 +127,15 @@ class G4SafetyHelper
     G4ThreeVector fLastSafetyPosition;
     G4double fLastSafety = 0.0;
 
+    const G4VPhysicalVolume* fLastSafetyVolume = nullptr;
+    G4int fLastSafetyReplicaNo = -1;
+    std::size_t fLastSafetyDepth = 0;
+      // Touchable of the last safety sphere
+
+    G4bool fUseSafetyCache = false;
+    G4long fSafetyCacheHits = 0;
+    G4long fSafetyCacheMisses = 0;
+
     // const G4double fRecomputeFactor = 0.0;
        // parameter for further optimisation: 
        // if ( move < fact*safety )  do fast recomputation of safety
@@ -141,6 +171,50 @@ void G4SafetyHelper::SetCurrentSafety(G4double val, const G4ThreeVector& pos)
 {
   fLastSafety = val;
   fLastSafetyPosition = pos;
+  SetSafetyTouchable();
+}
+
+inline
+void G4SafetyHelper::EnableSafetyCache(G4bool flag)
+{
+  fUseSafetyCache = flag;
+}
+
+inline
+G4bool G4SafetyHelper::IsSafetyCacheEnabled() const
+{
+  return fUseSafetyCache;
+}
+
+inline
+G4long G4SafetyHelper::GetSafetyCacheHits() const
+{
+  return fSafetyCacheHits;
+}
+
+inline
+G4long G4SafetyHelper::GetSafetyCacheMisses() const
+{
+  return fSafetyCacheMisses;
+}
+
+inline
+void G4SafetyHelper::SetSafetyTouchable()
+{
+  if (fpMassNavigator == nullptr) { return; }
+  const G4NavigationHistory* history = fpMassNavigator->GetCurrentHistory();
+  fLastSafetyVolume = history->GetTopVolume();
+  fLastSafetyReplicaNo = history->GetTopReplicaNo();
+  fLastSafetyDepth = history->GetDepth();
+}
+
+inline
+G4bool G4SafetyHelper::IsSafetyTouchable() const
+{
+  const G4NavigationHistory* history = fpMassNavigator->GetCurrentHistory();
+  return fLastSafetyVolume == history->GetTopVolume()
+      && fLastSafetyReplicaNo == history->GetTopReplicaNo()
+      && fLastSafetyDepth == history->GetDepth();
 }
 
 #endif
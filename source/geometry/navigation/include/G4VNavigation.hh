@@ -35,6 +35,8 @@
 #define G4VNAVIGATION_HH
 
 #include "G4ThreeVector.hh"
+#include "G4NavigationBatch.hh"
+#include "G4NavigationHistory.hh"
 
 class G4LogicalVolume;
 class G4VPhysicalVolume;
@@ -105,6 +107,31 @@ class G4VNavigation
                                G4VPhysicalVolume*(*pBlockedPhysical),
                                G4int& blockedReplicaNo) = 0;
 
+  /**
+   * Compute the length of the steps to the next boundary for a block of
+   * tracks located in the current volume (top of @p history), given the
+   * local points and directions held in @p batch. Results and the updated
+   * state of each track are stored in @p batch, with the same meaning as
+   * for ComputeStep(). The default implementation relocates each point
+   * and calls ComputeStep() track by track; navigation types may provide
+   * specialisations sharing transformations and solid calls across tracks.
+   * The internal state of the navigation (e.g. the current voxel) is
+   * left undefined and must be reset by the caller through
+   * RelocateWithinVolume().
+   * @param[in,out] batch Block of tracks.
+   * @param[in,out] history Navigation history.
+   */
+  virtual void ComputeStepBatch(G4NavigationBatch& batch,
+                                G4NavigationHistory& history)
+  {
+    G4VPhysicalVolume* motherPhysical = history.GetTopVolume();
+    for (std::size_t i = 0; i < batch.Size(); ++i)
+    {
+      RelocateWithinVolume(motherPhysical, batch.GetLocalPoints().Get(i));
+      batch.ComputeStep(i, *this, history);
+    }
+  }
+
   /**
    * Compute the distance to the closest surface.
    * @param[in] globalPoint Global point.
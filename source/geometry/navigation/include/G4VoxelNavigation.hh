@@ -91,6 +91,14 @@ class G4VoxelNavigation : public G4VNavigation
                                 G4VPhysicalVolume* (*pBlockedPhysical),
                                 G4int& blockedReplicaNo ) override;
 
+    void ComputeStepBatch( G4NavigationBatch& batch,
+                           G4NavigationHistory& history ) override;
+      // Compute steps for a block of tracks. Tracks are grouped by the
+      // voxel node containing their point, and the candidate daughters of
+      // each node are checked once for all tracks of the group with the
+      // batched methods of the solids. Tracks whose step crosses into
+      // further voxels are completed with the scalar ComputeStep().
+
     G4double ComputeSafety( const G4ThreeVector& globalpoint,
                             const G4NavigationHistory& history,
                             const G4double pMaxLength = DBL_MAX ) override;
@@ -185,6 +193,10 @@ class G4VoxelNavigation : public G4VNavigation
 
     G4NavigationLogger* fLogger;
       // Verbosity logger
+
+    std::vector<std::pair<G4SmartVoxelNode*,std::size_t>> fBatchNodes;
+    std::vector<std::size_t> fBatchTracks;
+      // Work space for batched navigation
 };
 
 #include "G4VoxelNavigation.icc"
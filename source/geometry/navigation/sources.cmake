@@ -8,6 +8,9 @@ geant4_add_module(G4navigation
     G4BrentLocator.hh
     G4DrawVoxels.hh
     G4ErrorPropagationNavigator.hh
+    G4FlatGeometry.hh
+    G4FlatGeometry.icc
+    G4FlatNavigator.hh
     G4GeomTestVolume.hh
     G4GeometryMessenger.hh
     G4GlobalMagFieldMessenger.hh
@@ -15,6 +18,8 @@ geant4_add_module(G4navigation
     G4LocatorChangeLogger.hh
     G4MultiLevelLocator.hh
     G4MultiNavigator.hh
+    G4NavigationBatch.hh
+    G4NavigationBatch.icc
     G4NavigationLogger.hh
     G4Navigator.hh
     G4Navigator.icc
@@ -49,6 +54,8 @@ geant4_add_module(G4navigation
     G4BrentLocator.cc
     G4DrawVoxels.cc
     G4ErrorPropagationNavigator.cc
+    G4FlatGeometry.cc
+    G4FlatNavigator.cc
     G4GeomTestVolume.cc
     G4GeometryMessenger.cc
     G4GlobalMagFieldMessenger.cc
@@ -56,6 +63,7 @@ geant4_add_module(G4navigation
     G4LocatorChangeLogger.cc
     G4MultiLevelLocator.cc
     G4MultiNavigator.cc
+    G4NavigationBatch.cc
     G4NavigationLogger.cc
     G4Navigator.cc
     G4NormalNavigation.cc
@@ -0,0 +1,219 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4FlatGeometry implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4FlatGeometry.hh"
+
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4NavigationHistory.hh"
+#include "G4TouchableHistory.hh"
+
+// ********************************************************************
+// Build
+//
+// Breadth-first expansion of the placements: the daughters of a node
+// are appended together when the node is processed, so that they are
+// contiguous. The global-to-local transformations are computed as in
+// G4NavigationHistory::SetFirstEntry() and NewLevel().
+// ********************************************************************
+//
+void G4FlatGeometry::Build(G4VPhysicalVolume* world)
+{
+  Clear();
+  if (world == nullptr)
+  {
+    G4Exception("G4FlatGeometry::Build()", "GeomNav0002",
+                FatalException, "World volume is not defined.");
+    return;
+  }
+
+  AddNode(world, -1, 0, G4AffineTransform(world->GetTranslation()));
+
+  G4bool truncated = false;
+  for (G4int node=0; node<GetNumberOfNodes(); ++node)
+  {
+    G4LogicalVolume* logical = fPhysical[node]->GetLogicalVolume();
+    auto nDaughters = (G4int)logical->GetNoDaughters();
+    if (nDaughters == 0) continue;
+
+    G4bool placements = (logical->CharacteriseDaughters() == kNormal);
+    for (G4int i=0; placements && i<nDaughters; ++i)
+    {
+      if (logical->GetDaughter(i)->VolumeType() != kNormal)
+      {
+        placements = false;
+        break;
+      }
+    }
+    if (!placements) continue;
+    if (GetNumberOfNodes() + nDaughters > fMaxNodes)
+    {
+      truncated = true;
+      continue;
+    }
+
+    fFirstDaughter[node] = GetNumberOfNodes();
+    fNumberOfDaughters[node] = nDaughters;
+    fFlattened[node] = true;
+    G4AffineTransform motherTransform = fGlobalToLocal[node];
+    for (G4int i=0; i<nDaughters; ++i)
+    {
+      G4VPhysicalVolume* daughter = logical->GetDaughter(i);
+      G4AffineTransform transform;
+      transform.InverseProduct(motherTransform,
+                               G4AffineTransform(daughter->GetRotation(),
+                                                 daughter->GetTranslation()));
+      AddNode(daughter, node, fDepth[node]+1, transform);
+      fDaughterIndex[daughter] = i;
+    }
+  }
+
+  if (truncated)
+  {
+    std::ostringstream message;
+    message << "Maximum number of nodes reached: " << fMaxNodes << G4endl
+            << "          The geometry below world volume "
+            << world->GetName() << " is only partially flattened.";
+    G4Exception("G4FlatGeometry::Build()", "GeomNav1002",
+                JustWarning, message);
+  }
+}
+
+// ********************************************************************
+// AddNode
+// ********************************************************************
+//
+G4int G4FlatGeometry::AddNode(G4VPhysicalVolume* pVol, G4int parent,
+                              G4int depth,
+                              const G4AffineTransform& globalToLocal)
+{
+  G4VSolid* solid = pVol->GetLogicalVolume()->GetSolid();
+  G4ThreeVector pMin, pMax;
+  solid->BoundingLimits(pMin, pMax);
+
+  fPhysical.push_back(pVol);
+  fSolid.push_back(solid);
+  fCopyNo.push_back(pVol->GetCopyNo());
+  fParent.push_back(parent);
+  fFirstDaughter.push_back(-1);
+  fNumberOfDaughters.push_back(0);
+  fDepth.push_back(depth);
+  fFlattened.push_back(pVol->GetLogicalVolume()->GetNoDaughters() == 0);
+  fGlobalToLocal.push_back(globalToLocal);
+  fExtent.insert(fExtent.end(), { pMin.x(), pMin.y(), pMin.z(),
+                                  pMax.x(), pMax.y(), pMax.z() });
+  return GetNumberOfNodes() - 1;
+}
+
+// ********************************************************************
+// Clear
+// ********************************************************************
+//
+void G4FlatGeometry::Clear()
+{
+  std::vector<G4VPhysicalVolume*>().swap(fPhysical);
+  std::vector<G4VSolid*>().swap(fSolid);
+  std::vector<G4int>().swap(fCopyNo);
+  std::vector<G4int>().swap(fParent);
+  std::vector<G4int>().swap(fFirstDaughter);
+  std::vector<G4int>().swap(fNumberOfDaughters);
+  std::vector<G4int>().swap(fDepth);
+  std::vector<G4bool>().swap(fFlattened);
+  std::vector<G4AffineTransform>().swap(fGlobalToLocal);
+  std::vector<G4double>().swap(fExtent);
+  std::unordered_map<const G4VPhysicalVolume*, G4int>().swap(fDaughterIndex);
+}
+
+// ********************************************************************
+// GetNode
+//
+// A placement belongs to a single logical mother, so the node of each
+// level is found from the node of the level above and the index of the
+// placement in its mother.
+// ********************************************************************
+//
+G4int G4FlatGeometry::GetNode(const G4NavigationHistory& history) const
+{
+  if (fPhysical.empty() || history.GetVolume(0) != fPhysical[0])
+  {
+    return -1;
+  }
+  G4int node = 0;
+  auto depth = (G4int)history.GetDepth();
+  for (G4int level=1; level<=depth; ++level)
+  {
+    if (!fFlattened[node] || history.GetVolumeType(level) != kNormal)
+    {
+      return -1;
+    }
+    auto it = fDaughterIndex.find(history.GetVolume(level));
+    if (it == fDaughterIndex.cend()) { return -1; }
+    node = fFirstDaughter[node] + it->second;
+  }
+  return node;
+}
+
+// ********************************************************************
+// CreateTouchableHistory
+// ********************************************************************
+//
+G4TouchableHistory* G4FlatGeometry::CreateTouchableHistory(G4int node) const
+{
+  std::vector<G4int> path;
+  for (G4int n=node; n>0; n=fParent[n]) { path.push_back(n); }
+
+  G4NavigationHistory history;
+  history.SetFirstEntry(fPhysical[0]);
+  for (auto it=path.crbegin(); it!=path.crend(); ++it)
+  {
+    history.NewLevel(fPhysical[*it], kNormal, fCopyNo[*it]);
+  }
+  return new G4TouchableHistory(history);
+}
+
+// ********************************************************************
+// AllocatedMemory
+// ********************************************************************
+//
+std::size_t G4FlatGeometry::AllocatedMemory() const
+{
+  std::size_t size = sizeof(*this);
+  size += fPhysical.capacity()*sizeof(G4VPhysicalVolume*);
+  size += fSolid.capacity()*sizeof(G4VSolid*);
+  size += (fCopyNo.capacity() + fParent.capacity() + fFirstDaughter.capacity()
+         + fNumberOfDaughters.capacity() + fDepth.capacity())*sizeof(G4int);
+  size += fFlattened.capacity()/8;
+  size += fGlobalToLocal.capacity()*sizeof(G4AffineTransform);
+  size += fExtent.capacity()*sizeof(G4double);
+  size += fDaughterIndex.size()*(sizeof(const G4VPhysicalVolume*)
+                               + sizeof(G4int) + sizeof(void*));
+  return size;
+}
@@ -0,0 +1,314 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4FlatNavigator implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4FlatNavigator.hh"
+#include "G4FlatGeometry.hh"
+
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "G4SmartVoxelProxy.hh"
+#include "G4SmartVoxelNode.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4AuxiliaryNavServices.hh"
+
+// ********************************************************************
+// Constructor
+// ********************************************************************
+//
+G4FlatNavigator::G4FlatNavigator(const G4FlatGeometry* geometry)
+  : fGeometry(geometry)
+{
+  fTolerance = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+}
+
+// ********************************************************************
+// LocateGlobalPoint
+// ********************************************************************
+//
+G4int G4FlatNavigator::LocateGlobalPoint(const G4ThreeVector& globalPoint,
+                                         G4int hint) const
+{
+  if (fGeometry->GetNumberOfNodes() == 0) { return -1; }
+
+  // Go up from the hint, until the point is inside the node
+  //
+  G4int node = (hint < 0) ? 0 : hint;
+  while (node >= 0 && !IsInside(node, globalPoint))
+  {
+    node = fGeometry->GetParent(node);
+  }
+  if (node < 0) { return -1; }
+
+  // Go down to the deepest node containing the point
+  //
+  for (G4int daughter = LocateDaughter(node, globalPoint); daughter >= 0;
+       daughter = LocateDaughter(node, globalPoint))
+  {
+    node = daughter;
+  }
+  return node;
+}
+
+// ********************************************************************
+// IsInside
+//
+// Same test as G4AuxiliaryNavServices::CheckPointOnSurface(), preceded
+// by the rejection on the bounding box.
+// ********************************************************************
+//
+G4bool G4FlatNavigator::IsInside(G4int node,
+                                 const G4ThreeVector& globalPoint,
+                                 const G4ThreeVector* globalDirection,
+                                 const G4bool locatedOnEdge) const
+{
+  const G4AffineTransform& transform = fGeometry->GetGlobalToLocal(node);
+  G4ThreeVector localPoint = transform.TransformPoint(globalPoint);
+  if (DistanceToExtent(fGeometry->GetExtent(node), localPoint) > 0.)
+  {
+    return false;
+  }
+  return G4AuxiliaryNavServices::CheckPointOnSurface(fGeometry->GetSolid(node),
+                                                     localPoint,
+                                                     globalDirection,
+                                                     transform,
+                                                     locatedOnEdge);
+}
+
+// ********************************************************************
+// LocateDaughter
+//
+// Return the daughter node containing the point, -1 if none.
+// ********************************************************************
+//
+G4int G4FlatNavigator::LocateDaughter(G4int node,
+                                const G4ThreeVector& globalPoint,
+                                const G4ThreeVector* globalDirection,
+                                const G4bool locatedOnEdge,
+                                const G4VPhysicalVolume* blockedVol) const
+{
+  G4int nDaughters = fGeometry->GetNumberOfDaughters(node);
+  if (nDaughters == 0) { return -1; }
+  G4int first = fGeometry->GetFirstDaughter(node);
+
+  G4LogicalVolume* logical = fGeometry->GetPhysicalVolume(node)
+                                      ->GetLogicalVolume();
+  G4SmartVoxelHeader* header = logical->GetVoxelHeader();
+  if (header == nullptr)
+  {
+    for (G4int i=nDaughters-1; i>=0; --i)
+    {
+      if (fGeometry->GetPhysicalVolume(first+i) == blockedVol) { continue; }
+      if (IsInside(first+i, globalPoint, globalDirection, locatedOnEdge))
+      {
+        return first+i;
+      }
+    }
+    return -1;
+  }
+
+  // Select the candidates from the voxel containing the point, as in
+  // G4VoxelNavigation::VoxelLocate()
+  //
+  G4ThreeVector localPoint =
+    fGeometry->GetGlobalToLocal(node).TransformPoint(globalPoint);
+  G4SmartVoxelNode* voxelNode = nullptr;
+  while (voxelNode == nullptr)
+  {
+    auto nSlices = G4int(header->GetNoSlices());
+    G4double minExtent = header->GetMinExtent();
+    G4double width = (header->GetMaxExtent() - minExtent)/nSlices;
+    auto slice = G4int((localPoint(header->GetAxis()) - minExtent)/width);
+    slice = std::min(std::max(slice, 0), nSlices-1);
+    G4SmartVoxelProxy* proxy = header->GetSlice(slice);
+    if (proxy->IsNode())
+    {
+      voxelNode = proxy->GetNode();
+    }
+    else
+    {
+      header = proxy->GetHeader();
+    }
+  }
+  for (auto i=G4int(voxelNode->GetNoContained())-1; i>=0; --i)
+  {
+    G4int daughter = first + voxelNode->GetVolume(i);
+    if (fGeometry->GetPhysicalVolume(daughter) == blockedVol) { continue; }
+    if (IsInside(daughter, globalPoint, globalDirection, locatedOnEdge))
+    {
+      return daughter;
+    }
+  }
+  return -1;
+}
+
+// ********************************************************************
+// ComputeStep
+//
+// Same logic as G4NormalNavigation::ComputeStep(): daughters first, in
+// reverse order, then the mother. The safety of the mother is computed
+// first, so that daughters whose bounding box is neither closer than the
+// current safety nor crossed within the current step can be skipped.
+// ********************************************************************
+//
+G4double G4FlatNavigator::ComputeStep(const G4ThreeVector& globalPoint,
+                                      const G4ThreeVector& globalDirection,
+                                            G4int node,
+                                            G4double proposedStepLength,
+                                            G4double& newSafety,
+                                            G4int& enteredNode,
+                                            G4bool& exiting) const
+{
+  G4double ourStep = proposedStepLength;
+  enteredNode = -1;
+  exiting = false;
+
+  const G4AffineTransform& motherTransform = fGeometry->GetGlobalToLocal(node);
+  G4ThreeVector localPoint = motherTransform.TransformPoint(globalPoint);
+  G4VSolid* motherSolid = fGeometry->GetSolid(node);
+  G4double motherSafety = motherSolid->DistanceToOut(localPoint);
+  G4double ourSafety = motherSafety;
+
+  G4int first = fGeometry->GetFirstDaughter(node);
+  for (G4int i=fGeometry->GetNumberOfDaughters(node)-1; i>=0; --i)
+  {
+    G4int daughter = first+i;
+    const G4AffineTransform& transform = fGeometry->GetGlobalToLocal(daughter);
+    G4ThreeVector samplePoint = transform.TransformPoint(globalPoint);
+    G4ThreeVector sampleDirection = transform.TransformAxis(globalDirection);
+    const G4double* extent = fGeometry->GetExtent(daughter);
+    if (DistanceToExtent(extent, samplePoint) > ourSafety
+     && DistanceToExtent(extent, samplePoint, sampleDirection) > ourStep)
+    {
+      continue;
+    }
+
+    G4VSolid* sampleSolid = fGeometry->GetSolid(daughter);
+    G4double sampleSafety = sampleSolid->DistanceToIn(samplePoint);
+    if (sampleSafety < ourSafety) { ourSafety = sampleSafety; }
+    if (sampleSafety <= ourStep)
+    {
+      G4double sampleStep = sampleSolid->DistanceToIn(samplePoint,
+                                                      sampleDirection);
+      if (sampleStep <= ourStep)
+      {
+        ourStep = sampleStep;
+        enteredNode = daughter;
+      }
+    }
+  }
+
+  if (motherSafety <= ourStep)
+  {
+    G4ThreeVector localDirection =
+      motherTransform.TransformAxis(globalDirection);
+    G4double motherStep = motherSolid->DistanceToOut(localPoint,
+                                                     localDirection);
+    if (motherStep <= ourStep)
+    {
+      ourStep = motherStep;
+      enteredNode = -1;
+      exiting = true;
+    }
+  }
+  newSafety = ourSafety;
+  return ourStep;
+}
+
+// ********************************************************************
+// ComputeSafety
+// ********************************************************************
+//
+G4double G4FlatNavigator::ComputeSafety(const G4ThreeVector& globalPoint,
+                                              G4int node) const
+{
+  G4ThreeVector localPoint =
+    fGeometry->GetGlobalToLocal(node).TransformPoint(globalPoint);
+  G4double ourSafety = fGeometry->GetSolid(node)->DistanceToOut(localPoint);
+
+  G4int first = fGeometry->GetFirstDaughter(node);
+  for (G4int i=fGeometry->GetNumberOfDaughters(node)-1; i>=0; --i)
+  {
+    G4int daughter = first+i;
+    G4ThreeVector samplePoint =
+      fGeometry->GetGlobalToLocal(daughter).TransformPoint(globalPoint);
+    if (DistanceToExtent(fGeometry->GetExtent(daughter), samplePoint)
+        >= ourSafety)
+    {
+      continue;
+    }
+    G4double sampleSafety =
+      fGeometry->GetSolid(daughter)->DistanceToIn(samplePoint);
+    if (sampleSafety < ourSafety) { ourSafety = sampleSafety; }
+  }
+  return ourSafety;
+}
+
+// ********************************************************************
+// DistanceToExtent
+// ********************************************************************
+//
+G4double G4FlatNavigator::DistanceToExtent(const G4double* extent,
+                                           const G4ThreeVector& p) const
+{
+  G4double dist2 = 0.;
+  for (G4int k=0; k<3; ++k)
+  {
+    G4double d = std::max(extent[k] - p[k], p[k] - extent[k+3]) - fTolerance;
+    if (d > 0.) { dist2 += d*d; }
+  }
+  return std::sqrt(dist2);
+}
+
+G4double G4FlatNavigator::DistanceToExtent(const G4double* extent,
+                                           const G4ThreeVector& p,
+                                           const G4ThreeVector& v) const
+{
+  G4double tmin = 0., tmax = kInfinity;
+  for (G4int k=0; k<3; ++k)
+  {
+    G4double bmin = extent[k] - fTolerance;
+    G4double bmax = extent[k+3] + fTolerance;
+    if (v[k] == 0.)
+    {
+      if (p[k] < bmin || p[k] > bmax) { return kInfinity; }
+      continue;
+    }
+    G4double invDir = 1./v[k];
+    G4double t0 = (bmin - p[k])*invDir;
+    G4double t1 = (bmax - p[k])*invDir;
+    if (t0 > t1) { std::swap(t0, t1); }
+    tmin = std::max(tmin, t0);
+    tmax = std::min(tmax, t1);
+    if (tmin > tmax) { return kInfinity; }
+  }
+  return tmin;
+}
@@ -28,8 +28,12 @@
 // Author: G.Cosmo, CERN
 // --------------------------------------------------------------------
 
+#include <cstdint>
+#include <fstream>
+#include <map>
 #include <queue>
 #include <set>
+#include <sstream>
 
 #include "G4GeomTestVolume.hh"
 #include "G4PhysicalConstants.hh"
@@ -37,6 +41,12 @@
 #include "G4LogicalVolume.hh"
 #include "G4VSolid.hh"
 
+#ifdef G4MULTITHREADED
+#include "G4TaskGroup.hh"
+#include "PTL/TaskRunManager.hh"
+#include "PTL/ThreadPool.hh"
+#endif
+
 //
 // Constructor
 //
@@ -117,11 +127,123 @@ void G4GeomTestVolume::SetErrorsThreshold(G4int max)
   maxErr = max;
 }
 
+//
+// Get parallel mode
+//
+G4bool G4GeomTestVolume::GetParallel() const
+{
+  return parallel;
+}
+
+//
+// Set parallel mode
+//
+void G4GeomTestVolume::SetParallel(G4bool val)
+{
+  parallel = val;
+}
+
+//
+// Get report file for incremental checks
+//
+const G4String& G4GeomTestVolume::GetReportFile() const
+{
+  return reportFile;
+}
+
+//
+// Set report file for incremental checks
+//
+void G4GeomTestVolume::SetReportFile(const G4String& fileName)
+{
+  reportFile = fileName;
+}
+
+namespace
+{
+  // Signature of the content of a mother volume: its solid and, for each
+  // daughter, its solid, placement and copy number. Parameterised and
+  // replicated daughters cannot be described statically, so a mother
+  // holding them is given no signature and is always checked.
+  // The description is hashed with 64-bit FNV-1a, so that the signatures
+  // written in the report do not depend on the platform or the compiler
+  //
+  std::uint64_t HashDescription(const std::string& description)
+  {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char c : description)
+    {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  G4bool ComputeSignature(const G4LogicalVolume* logical,
+                          std::uint64_t& signature)
+  {
+    std::ostringstream os;
+    os.precision(17);
+    logical->GetSolid()->StreamInfo(os);
+    std::size_t ndaughters = logical->GetNoDaughters();
+    for (std::size_t i=0; i<ndaughters; ++i)
+    {
+      const G4VPhysicalVolume* daughter = logical->GetDaughter(i);
+      if (daughter->VolumeType() != kNormal) { return false; }
+      os << daughter->GetName() << ' ' << daughter->GetCopyNo() << ' '
+         << daughter->GetObjectTranslation() << ' '
+         << daughter->GetObjectRotationValue() << '\n';
+      daughter->GetLogicalVolume()->GetSolid()->StreamInfo(os);
+    }
+    signature = HashDescription(os.str());
+    return true;
+  }
+
+  // The report holds one line per mother volume checked, with its key,
+  // signature and number of daughters found overlapping
+  //
+  using G4GeomTestReport = std::map<G4String, std::pair<std::uint64_t,G4int>>;
+
+  void ReadReport(const G4String& fileName, G4GeomTestReport& report)
+  {
+    std::ifstream in(fileName);
+    G4String key;
+    std::uint64_t signature;
+    G4int noverlaps;
+    while (in >> key >> signature >> noverlaps)
+    {
+      report[key] = std::make_pair(signature, noverlaps);
+    }
+  }
+
+  void WriteReport(const G4String& fileName, const G4GeomTestReport& report)
+  {
+    std::ofstream out(fileName);
+    if (!out)
+    {
+      std::ostringstream message;
+      message << "Cannot write overlaps report file: " << fileName;
+      G4Exception("G4GeomTestVolume::TestOverlapInTree()",
+                  "GeomNav1002", JustWarning, message);
+      return;
+    }
+    for (const auto& entry : report)
+    {
+      out << entry.first << ' ' << entry.second.first << ' '
+          << entry.second.second << '\n';
+    }
+  }
+}
+
 //
 // Test overlap in tree
 //
 void G4GeomTestVolume::TestOverlapInTree() const
 {
+  // Collect the mother volumes whose daughters are to be checked,
+  // without duplication of identical logical volumes
+  //
+  std::vector<G4VPhysicalVolume*> mothers;
   std::queue<G4VPhysicalVolume*> volumes;
   std::set<G4LogicalVolume*> checked;
 
@@ -130,17 +252,11 @@ void G4GeomTestVolume::TestOverlapInTree() const
   {
     G4VPhysicalVolume* current = volumes.front();
     volumes.pop();
+    mothers.push_back(current);
 
-    // check overlaps for daughters
+    // append the queue of volumes
     G4LogicalVolume* logical = current->GetLogicalVolume();
     std::size_t ndaughters = logical->GetNoDaughters();
-    for (std::size_t i=0; i<ndaughters; ++i)
-    {
-      G4VPhysicalVolume* daughter = logical->GetDaughter(i);
-      daughter->CheckOverlaps(resolution, tolerance, verbosity, maxErr);
-    }
-
-    // append the queue of volumes
     G4LogicalVolume* previousLogical = nullptr;
     for (std::size_t i=0; i<ndaughters; ++i)
     {
@@ -166,6 +282,147 @@ void G4GeomTestVolume::TestOverlapInTree() const
       }
     }
   }
+
+  // Select the mothers to check, skipping in incremental mode those
+  // unchanged and without overlaps in the report
+  //
+  std::size_t nmothers = mothers.size();
+  std::vector<G4String> keys(nmothers);
+  std::vector<std::uint64_t> signatures(nmothers, 0);
+  std::vector<G4bool> hasSignature(nmothers, false);
+  std::vector<G4int> noverlaps(nmothers, 0);
+  std::vector<std::size_t> selected;
+  G4GeomTestReport report;
+  G4bool incremental = !reportFile.empty();
+  if (incremental) { ReadReport(reportFile, report); }
+
+  std::map<G4String, G4int> occurrences;
+  for (std::size_t im=0; im<nmothers; ++im)
+  {
+    if (incremental)
+    {
+      const G4LogicalVolume* logical = mothers[im]->GetLogicalVolume();
+      G4String name = logical->GetName();
+      G4int n = occurrences[name]++;
+      keys[im] = (n == 0) ? name : name + "#" + std::to_string(n);
+      hasSignature[im] = ComputeSignature(logical, signatures[im]);
+      auto entry = report.find(keys[im]);
+      if (hasSignature[im] && entry != report.cend()
+       && entry->second.first == signatures[im] && entry->second.second == 0)
+      {
+        if (verbosity)
+        {
+          G4cout << "Checking overlaps for daughters of volume "
+                 << mothers[im]->GetName()
+                 << " is omitted, unchanged since last report" << G4endl;
+        }
+        continue;
+      }
+    }
+    selected.push_back(im);
+  }
+
+  // check overlaps for daughters, all of them or either the placements
+  // or the other ones
+  auto checkDaughters = [this, &mothers, &noverlaps](std::size_t im,
+                                                     G4bool all,
+                                                     G4bool placements,
+                                                     G4bool verbose)
+  {
+    G4LogicalVolume* logical = mothers[im]->GetLogicalVolume();
+    std::size_t ndaughters = logical->GetNoDaughters();
+    for (std::size_t i=0; i<ndaughters; ++i)
+    {
+      G4VPhysicalVolume* daughter = logical->GetDaughter(i);
+      if (!all && (daughter->VolumeType() == kNormal) != placements)
+      {
+        continue;
+      }
+      if (daughter->CheckOverlaps(resolution, tolerance, verbose, maxErr))
+      {
+        ++noverlaps[im];
+      }
+    }
+  };
+
+#ifdef G4MULTITHREADED
+  // Tasks need the thread pool of the task-based run manager; with other
+  // run managers the mothers are checked sequentially
+  //
+  G4bool useTasks = false;
+  if (parallel && selected.size() > 1)
+  {
+    auto mrm = PTL::TaskRunManager::GetMasterRunManager();
+    useTasks = (mrm != nullptr && mrm->GetThreadPool() != nullptr
+                && mrm->GetThreadPool()->size() > 1);
+    if (!useTasks && verbosity)
+    {
+      G4cout << "No thread pool available, overlaps are checked sequentially"
+             << G4endl;
+    }
+  }
+  if (useTasks)
+  {
+    // Placements of the different mothers are checked concurrently, each
+    // task writing only its own counter. The solids may be shared, so
+    // their lazily initialised data are set up first by sampling once
+    // their surface. Parameterised and replicated daughters, which are
+    // modified while checked, are then checked sequentially
+    //
+    for (auto im : selected)
+    {
+      G4LogicalVolume* logical = mothers[im]->GetLogicalVolume();
+      logical->GetSolid()->GetPointOnSurface();
+      for (std::size_t i=0; i<logical->GetNoDaughters(); ++i)
+      {
+        logical->GetDaughter(i)->GetLogicalVolume()->GetSolid()
+               ->GetPointOnSurface();
+      }
+    }
+    G4TaskGroup<void> tasks;
+    for (auto im : selected)
+    {
+      tasks.exec([&checkDaughters, im]() { checkDaughters(im, false, true, false); });
+    }
+    tasks.join();
+    for (auto im : selected)
+    {
+      checkDaughters(im, false, false, verbosity);
+      if (verbosity)
+      {
+        G4cout << "Checked overlaps for daughters of volume "
+               << mothers[im]->GetName() << ": ";
+        if (noverlaps[im] == 0) { G4cout << "OK! " << G4endl; }
+        else { G4cout << noverlaps[im] << " overlapping" << G4endl; }
+      }
+    }
+  }
+  else
+#endif
+  {
+    for (auto im : selected)
+    {
+      checkDaughters(im, true, true, verbosity);
+    }
+  }
+
+  // Update the report
+  //
+  if (incremental)
+  {
+    for (auto im : selected)
+    {
+      if (hasSignature[im])
+      {
+        report[keys[im]] = std::make_pair(signatures[im], noverlaps[im]);
+      }
+      else
+      {
+        report.erase(keys[im]);
+      }
+    }
+    WriteReport(reportFile, report);
+  }
 }
 
 //
@@ -37,11 +37,13 @@
 #include "G4VPhysicalVolume.hh"
 #include "G4Navigator.hh"
 #include "G4PropagatorInField.hh"
+#include "G4SafetyHelper.hh"
 
 #include "G4UIdirectory.hh"
 #include "G4UIcommand.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
 
@@ -105,6 +107,59 @@ G4GeometryMessenger::G4GeometryMessenger(G4TransportationManager* tman)
   pchkCmd->SetDefaultValue(true);
   pchkCmd->AvailableForStates(G4State_Idle);
 
+  scCmd = new G4UIcmdWithABool( "/geometry/navigator/safety_cache", this );
+  scCmd->SetGuidance( "Enable/disable the safety cache of the safety helper." );
+  scCmd->SetGuidance( "The last isotropic safety computed is reused for" );
+  scCmd->SetGuidance( "points within its sphere, in the same touchable, as" );
+  scCmd->SetGuidance( "long as the remaining safety covers the radius of" );
+  scCmd->SetGuidance( "interest requested. The reused safety is smaller than" );
+  scCmd->SetGuidance( "the one computed by navigation, therefore results of" );
+  scCmd->SetGuidance( "safety based step limitation may change." );
+  scCmd->SetGuidance( "The cache is disabled by default." );
+  scCmd->SetParameterName("cacheFlag",true);
+  scCmd->SetDefaultValue(true);
+  scCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  scsCmd = new G4UIcmdWithoutParameter(
+                 "/geometry/navigator/safety_cache_stats", this );
+  scsCmd->SetGuidance( "Print the hit/miss counters of the safety cache." );
+  scsCmd->SetGuidance( "Counters are per thread, printed by each thread." );
+  scsCmd->AvailableForStates(G4State_Idle);
+
+  scrCmd = new G4UIcmdWithoutParameter(
+                 "/geometry/navigator/safety_cache_reset", this );
+  scrCmd->SetGuidance( "Reset the hit/miss counters of the safety cache." );
+  scrCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fltCmd = new G4UIcmdWithABool( "/geometry/navigator/flat_geometry", this );
+  fltCmd->SetGuidance( "Enable/disable point location through the flat image" );
+  fltCmd->SetGuidance( "of the geometry. The placements are expanded into" );
+  fltCmd->SetGuidance( "arrays of nodes with precomputed transformations," );
+  fltCmd->SetGuidance( "which are used to descend the levels of placed" );
+  fltCmd->SetGuidance( "volumes. Levels of replicated and parameterised" );
+  fltCmd->SetGuidance( "volumes are located as usual." );
+  fltCmd->SetGuidance( "The flat image is disabled by default." );
+  fltCmd->SetParameterName("flatFlag",true);
+  fltCmd->SetDefaultValue(true);
+  fltCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  hlxCmd = new G4UIcmdWithABool( "/geometry/navigator/helix_uniform_field", this );
+  hlxCmd->SetGuidance( "Enable/disable the exact helix fast path in uniform" );
+  hlxCmd->SetGuidance( "magnetic fields. In volumes whose field is a pure" );
+  hlxCmd->SetGuidance( "G4UniformMagField the trajectory is then computed" );
+  hlxCmd->SetGuidance( "analytically instead of being integrated." );
+  hlxCmd->SetGuidance( "The fast path is disabled by default." );
+  hlxCmd->SetParameterName("helixFlag",true);
+  hlxCmd->SetDefaultValue(true);
+  hlxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  hlsCmd = new G4UIcmdWithoutParameter(
+                 "/geometry/navigator/helix_stats", this );
+  hlsCmd->SetGuidance( "Print the number of steps in field which used the" );
+  hlsCmd->SetGuidance( "exact helix fast path or the integration driver." );
+  hlsCmd->SetGuidance( "Counters are per thread, printed by each thread." );
+  hlsCmd->AvailableForStates(G4State_Idle);
+
   //
   // Geometry verification test commands
   //
@@ -171,6 +226,28 @@ G4GeometryMessenger::G4GeometryMessenger(G4TransportationManager* tman)
   recCmd->SetGuidance( "NOTE: it may take a very long time," );
   recCmd->SetGuidance( "      depending on the geometry complexity !");
   recCmd->AvailableForStates(G4State_Idle);
+
+  tskCmd = new G4UIcmdWithABool( "/geometry/test/parallel_tasks", this );
+  tskCmd->SetGuidance( "Check in parallel tasks the daughters of different" );
+  tskCmd->SetGuidance( "mother volumes, using the thread pool of tasking." );
+  tskCmd->SetGuidance( "Only affects /geometry/test/run_tree (default FALSE)." );
+  tskCmd->SetParameterName("parallel_tasks",true);
+  tskCmd->SetDefaultValue(true);
+
+  repCmd = new G4UIcmdWithAString( "/geometry/test/report_file", this );
+  repCmd->SetGuidance( "Set the report file for incremental overlaps check." );
+  repCmd->SetGuidance( "/geometry/test/run_tree then skips the mother volumes" );
+  repCmd->SetGuidance( "unchanged and without overlaps since the report, which" );
+  repCmd->SetGuidance( "is then updated. Empty name to check all volumes." );
+  repCmd->SetParameterName("report_file",true);
+  repCmd->SetDefaultValue("");
+
+  treCmd = new G4UIcmdWithoutParameter( "/geometry/test/run_tree", this );
+  treCmd->SetGuidance( "Start running the overlap check of the volume tree." );
+  treCmd->SetGuidance( "As /geometry/test/run, but daughters of identical" );
+  treCmd->SetGuidance( "logical volumes are checked only once and the" );
+  treCmd->SetGuidance( "recursion start and depth are ignored." );
+  treCmd->AvailableForStates(G4State_Idle);
 }
 
 //
@@ -182,6 +259,9 @@ G4GeometryMessenger::~G4GeometryMessenger()
   delete resCmd; delete rcsCmd; delete rcdCmd;
   delete errCmd; delete parCmd; delete tolCmd;
   delete verbCmd; delete pchkCmd; delete chkCmd;
+  delete scCmd; delete scsCmd; delete scrCmd;
+  delete tskCmd; delete repCmd; delete treCmd;
+  delete hlxCmd; delete hlsCmd; delete fltCmd;
   delete geodir; delete navdir; delete testdir;
   for(auto* tvolume: tvolumes) {
       delete tvolume;
@@ -229,6 +309,24 @@ G4GeometryMessenger::SetNewValue( G4UIcommand* command, G4String newValues )
   else if (command == pchkCmd) {
     SetPushFlag( newValues );
   }
+  else if (command == scCmd) {
+    SetSafetyCache( newValues );
+  }
+  else if (command == scsCmd) {
+    tmanager->GetSafetyHelper()->PrintSafetyCacheStatistics();
+  }
+  else if (command == scrCmd) {
+    tmanager->GetSafetyHelper()->ResetSafetyCacheStatistics();
+  }
+  else if (command == fltCmd) {
+    SetFlatGeometry( newValues );
+  }
+  else if (command == hlxCmd) {
+    SetHelixForUniformField( newValues );
+  }
+  else if (command == hlsCmd) {
+    PrintHelixStatistics();
+  }
   else if (command == tolCmd) {
     Init();
     tol = tolCmd->GetNewDoubleValue( newValues )
@@ -274,6 +372,33 @@ G4GeometryMessenger::SetNewValue( G4UIcommand* command, G4String newValues )
     RecursiveOverlapTest();
     G4cout << "Geometry overlaps check completed !" << G4endl;
   }
+  else if (command == tskCmd) {
+    Init();
+    for(auto* tvolume: tvolumes)
+    {
+      tvolume->SetParallel(tskCmd->GetNewBoolValue( newValues ));
+    }
+  }
+  else if (command == repCmd) {
+    Init();
+    // One report per world, suffixed by the name of the parallel worlds
+    //
+    for(std::size_t i=0; i<tvolumes.size(); ++i)
+    {
+      G4String fileName = newValues;
+      if (i > 0 && !fileName.empty())
+      {
+        fileName += "_" + tmanager->GetWorldsIterator()[i]->GetName();
+      }
+      tvolumes[i]->SetReportFile(fileName);
+    }
+  }
+  else if (command == treCmd) {
+    Init();
+    G4cout << "Running geometry overlaps check..." << G4endl;
+    TreeOverlapTest();
+    G4cout << "Geometry overlaps check completed !" << G4endl;
+  }
 }
 
 //
@@ -358,6 +483,52 @@ G4GeometryMessenger::SetPushFlag(const G4String& input)
   navigator->SetPushVerbosity(mode);
 }
 
+//
+// Enable/disable the safety cache
+//
+void
+G4GeometryMessenger::SetSafetyCache(const G4String& input)
+{
+  G4bool mode = scCmd->GetNewBoolValue(input);
+  tmanager->GetSafetyHelper()->EnableSafetyCache(mode);
+}
+
+//
+// Enable/disable the flat image of the geometry
+//
+void
+G4GeometryMessenger::SetFlatGeometry(const G4String& input)
+{
+  G4bool mode = fltCmd->GetNewBoolValue(input);
+  G4Navigator* navigator = tmanager->GetNavigatorForTracking();
+  navigator->EnableFlatGeometry(mode);
+}
+
+//
+// Enable/disable the helix fast path in uniform fields
+//
+void
+G4GeometryMessenger::SetHelixForUniformField(const G4String& input)
+{
+  G4bool mode = hlxCmd->GetNewBoolValue(input);
+  G4PropagatorInField* pField = tmanager->GetPropagatorInField();
+  if (pField != nullptr)  { pField->SetUseHelixForUniformField(mode); }
+}
+
+//
+// Print the counters of the helix fast path
+//
+void
+G4GeometryMessenger::PrintHelixStatistics()
+{
+  G4PropagatorInField* pField = tmanager->GetPropagatorInField();
+  if (pField == nullptr)  { return; }
+  G4cout << "Steps in field using the exact helix: "
+         << pField->GetNumberOfHelixSteps()
+         << ", using the integration driver: "
+         << pField->GetNumberOfIntegratedSteps() << G4endl;
+}
+
 //
 // Recursive Overlap Test
 //
@@ -382,3 +553,26 @@ G4GeometryMessenger::RecursiveOverlapTest()
     tvolumes.front()->TestRecursiveOverlap( recLevel, recDepth );
   }
 }
+
+//
+// Tree Overlap Test
+//
+void
+G4GeometryMessenger::TreeOverlapTest()
+{
+  // Close geometry if necessary
+  //
+  CheckGeometry();
+
+  if (checkParallelWorlds)
+  {
+    for(auto* tvolume: tvolumes)
+    {
+      tvolume->TestOverlapInTree();
+    }
+  }
+  else
+  {
+    tvolumes.front()->TestOverlapInTree();
+  }
+}
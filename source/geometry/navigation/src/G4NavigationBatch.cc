@@ -0,0 +1,377 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4NavigationBatch Implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include <numeric>
+
+#include "G4NavigationBatch.hh"
+#include "G4VNavigation.hh"
+#include "G4ReplicaNavigation.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "geomdefs.hh"
+
+// ********************************************************************
+// Constructor
+// ********************************************************************
+//
+G4NavigationBatch::G4NavigationBatch(std::size_t nTracks)
+{
+  Resize(nTracks);
+}
+
+// ********************************************************************
+// Resize
+// ********************************************************************
+//
+void G4NavigationBatch::Resize(std::size_t nTracks)
+{
+  fGlobalPoints.Resize(nTracks);
+  fGlobalDirections.Resize(nTracks);
+  fLocalPoints.Resize(nTracks);
+  fLocalDirections.Resize(nTracks);
+  fExitNormals.Resize(nTracks);
+  fProposedSteps.resize(nTracks);
+  fSteps.resize(nTracks);
+  fSafeties.resize(nTracks);
+  fMotherSafeties.resize(nTracks);
+  fBlockedExited.resize(nTracks);
+
+  fAllTracks.resize(nTracks);
+  std::iota(fAllTracks.begin(), fAllTracks.end(), std::size_t(0));
+
+  fEntering.assign(nTracks, 0);
+  fExiting.assign(nTracks, 0);
+  fValidExitNormal.assign(nTracks, 0);
+  fBlockedPhysical.assign(nTracks, nullptr);
+  fBlockedReplicaNo.assign(nTracks, -1);
+}
+
+// ********************************************************************
+// SetLocalFrame
+// ********************************************************************
+//
+void G4NavigationBatch::SetLocalFrame(const G4AffineTransform& globalToLocal)
+{
+  std::size_t nTracks = Size();
+  for (std::size_t i=0; i<nTracks; ++i)
+  {
+    fLocalPoints.Set(i, globalToLocal.TransformPoint(fGlobalPoints.Get(i)));
+    fLocalDirections.Set(i,
+                     globalToLocal.TransformAxis(fGlobalDirections.Get(i)));
+  }
+}
+
+// ********************************************************************
+// ComputeStep
+// ********************************************************************
+//
+void G4NavigationBatch::ComputeStep(std::size_t i, G4VNavigation& navigation,
+                                    G4NavigationHistory& history)
+{
+  G4bool validExitNormal = (fValidExitNormal[i] != 0);
+  G4bool exiting = (fExiting[i] != 0);
+  G4bool entering = (fEntering[i] != 0);
+  G4ThreeVector exitNormal = fExitNormals.Get(i);
+
+  fSteps[i] = navigation.ComputeStep(fLocalPoints.Get(i),
+                                     fLocalDirections.Get(i),
+                                     fProposedSteps[i],
+                                     fSafeties[i],
+                                     history,
+                                     validExitNormal,
+                                     exitNormal,
+                                     exiting,
+                                     entering,
+                                    &fBlockedPhysical[i],
+                                     fBlockedReplicaNo[i]);
+  fValidExitNormal[i] = static_cast<char>(validExitNormal);
+  fExiting[i] = static_cast<char>(exiting);
+  fEntering[i] = static_cast<char>(entering);
+  fExitNormals.Set(i, exitNormal);
+}
+
+// ********************************************************************
+// ComputeReplicaStep
+// ********************************************************************
+//
+void G4NavigationBatch::ComputeReplicaStep(std::size_t i,
+                                           G4ReplicaNavigation& navigation,
+                                           G4NavigationHistory& history)
+{
+  G4bool validExitNormal = (fValidExitNormal[i] != 0);
+  G4bool calculatedExitNormal = false;
+  G4bool exiting = (fExiting[i] != 0);
+  G4bool entering = (fEntering[i] != 0);
+  G4ThreeVector exitNormal = fExitNormals.Get(i);
+
+  fSteps[i] = navigation.ComputeStep(fGlobalPoints.Get(i),
+                                     fGlobalDirections.Get(i),
+                                     fLocalPoints.Get(i),
+                                     fLocalDirections.Get(i),
+                                     fProposedSteps[i],
+                                     fSafeties[i],
+                                     history,
+                                     validExitNormal,
+                                     calculatedExitNormal,
+                                     exitNormal,
+                                     exiting,
+                                     entering,
+                                    &fBlockedPhysical[i],
+                                     fBlockedReplicaNo[i]);
+  fValidExitNormal[i] = static_cast<char>(validExitNormal);
+  fExiting[i] = static_cast<char>(exiting);
+  fEntering[i] = static_cast<char>(entering);
+  fExitNormals.Set(i, exitNormal);
+}
+
+// ********************************************************************
+// StartStep
+// ********************************************************************
+//
+void G4NavigationBatch::StartStep(const G4VSolid* motherSolid)
+{
+  std::size_t nTracks = Size();
+
+  fSavedExiting = fExiting;
+  fSavedValidExitNormal = fValidExitNormal;
+  fSavedExitNormals = fExitNormals;
+  fSavedBlockedPhysical = fBlockedPhysical;
+  fSavedBlockedReplicaNo = fBlockedReplicaNo;
+
+  // Compute mother safeties
+  //
+  motherSolid->SafetyToOutBatch(fLocalPoints, fMotherSafeties.data());
+
+  for (std::size_t i=0; i<nTracks; ++i)
+  {
+    fSteps[i] = fProposedSteps[i];
+    fSafeties[i] = fMotherSafeties[i];   // Working isotropic safety
+    fBlockedExited[i] = nullptr;
+
+    // Exiting normal optimisation
+    //
+    if ( (fExiting[i] != 0) && (fValidExitNormal[i] != 0) )
+    {
+      if ( fLocalDirections.Get(i).dot(fExitNormals.Get(i))
+           >= kMinExitingNormalCosine )
+      {
+        // Block exited daughter volume
+        //
+        fBlockedExited[i] = fBlockedPhysical[i];
+        fSafeties[i] = 0;
+      }
+    }
+    fExiting[i] = 0;
+    fEntering[i] = 0;
+  }
+}
+
+// ********************************************************************
+// RestoreState
+// ********************************************************************
+//
+void G4NavigationBatch::RestoreState(std::size_t i)
+{
+  fExiting[i] = fSavedExiting[i];
+  fEntering[i] = 0;
+  fValidExitNormal[i] = fSavedValidExitNormal[i];
+  fExitNormals.Set(i, fSavedExitNormals.Get(i));
+  fBlockedPhysical[i] = fSavedBlockedPhysical[i];
+  fBlockedReplicaNo[i] = fSavedBlockedReplicaNo[i];
+}
+
+// ********************************************************************
+// IntersectDaughter
+//
+// Same logic as in the loop over daughters of the scalar ComputeStep(),
+// with the transformation computed once and the solid queried for all
+// the relevant tracks at once.
+// ********************************************************************
+//
+void G4NavigationBatch::IntersectDaughter(G4VPhysicalVolume* samplePhysical,
+                                          const std::size_t* tracks,
+                                          std::size_t nTracks)
+{
+  G4AffineTransform sampleTf(samplePhysical->GetRotation(),
+                             samplePhysical->GetTranslation());
+  sampleTf.Invert();
+  const G4VSolid* sampleSolid = samplePhysical->GetLogicalVolume()->GetSolid();
+
+  // Collect the tracks for which the daughter is not blocked
+  //
+  fSampleTracks.clear();
+  fSamplePoints.Clear();
+  for (std::size_t k=0; k<nTracks; ++k)
+  {
+    std::size_t i = tracks[k];
+    if (fBlockedExited[i] != samplePhysical)
+    {
+      fSampleTracks.push_back(i);
+      fSamplePoints.PushBack(sampleTf.TransformPoint(fLocalPoints.Get(i)));
+    }
+  }
+  std::size_t nSample = fSampleTracks.size();
+  if (nSample == 0) { return; }
+
+  // Safeties, and selection of the tracks to intersect
+  //
+  fSampleValues.resize(nSample);
+  fSampleDirections.Resize(nSample);
+  sampleSolid->SafetyToInBatch(fSamplePoints, fSampleValues.data());
+
+  std::size_t nStep = 0;
+  for (std::size_t k=0; k<nSample; ++k)
+  {
+    std::size_t i = fSampleTracks[k];
+    const G4double sampleSafety = fSampleValues[k];
+    if ( sampleSafety<fSafeties[i] )
+    {
+      fSafeties[i] = sampleSafety;
+    }
+    if ( sampleSafety<=fSteps[i] )
+    {
+      fSampleTracks[nStep] = i;
+      fSamplePoints.Set(nStep, fSamplePoints.Get(k));
+      fSampleDirections.Set(nStep,
+                            sampleTf.TransformAxis(fLocalDirections.Get(i)));
+      ++nStep;
+    }
+  }
+  if (nStep == 0) { return; }
+
+  // Intersections
+  //
+  fSamplePoints.Resize(nStep);
+  fSampleDirections.Resize(nStep);
+  sampleSolid->DistanceToInBatch(fSamplePoints, fSampleDirections,
+                                 fSampleValues.data());
+  for (std::size_t k=0; k<nStep; ++k)
+  {
+    std::size_t i = fSampleTracks[k];
+    const G4double sampleStep = fSampleValues[k];
+    if ( sampleStep<=fSteps[i] )
+    {
+      fSteps[i] = sampleStep;
+      fEntering[i] = 1;
+      fExiting[i] = 0;
+      fBlockedPhysical[i] = samplePhysical;
+      fBlockedReplicaNo[i] = -1;
+    }
+  }
+}
+
+// ********************************************************************
+// ComputeMotherStep
+// ********************************************************************
+//
+G4bool
+G4NavigationBatch::ComputeMotherStep(std::size_t i,
+                                     const G4VPhysicalVolume* motherPhysical)
+{
+  if ( fProposedSteps[i]<fSafeties[i] )
+  {
+    // Guaranteed physics limited
+    //
+    fEntering[i] = 0;
+    fExiting[i] = 0;
+    fBlockedPhysical[i] = nullptr;
+    fSteps[i] = kInfinity;
+    return true;
+  }
+
+  // Consider intersection with mother solid
+  //
+  if ( fMotherSafeties[i]<=fSteps[i] )
+  {
+    const G4VSolid* motherSolid =
+          motherPhysical->GetLogicalVolume()->GetSolid();
+    G4bool motherValidExitNormal = false;
+    G4ThreeVector motherExitNormal(0.0, 0.0, 0.0);
+    G4double motherStep = motherSolid->DistanceToOut(fLocalPoints.Get(i),
+                                                     fLocalDirections.Get(i),
+                                                     true,
+                                                    &motherValidExitNormal,
+                                                    &motherExitNormal);
+    if ( (motherStep >= kInfinity) || (motherStep < 0.0) )
+    {
+      // Point is outside the mother solid
+      //
+      fSteps[i] = 0.0;
+      fExiting[i] = 1;
+      fEntering[i] = 0;
+      fValidExitNormal[i] = 0;
+      fBlockedPhysical[i] = nullptr;
+      fBlockedReplicaNo[i] = 0;
+      fSafeties[i] = 0.0;
+      return true;
+    }
+    if ( motherStep<=fSteps[i] )
+    {
+      fSteps[i] = motherStep;
+      fExiting[i] = 1;
+      fEntering[i] = 0;
+      fValidExitNormal[i] = static_cast<char>(motherValidExitNormal);
+      if ( motherValidExitNormal )
+      {
+        const G4RotationMatrix* rot = motherPhysical->GetRotation();
+        if (rot != nullptr)
+        {
+          motherExitNormal *= rot->inverse();
+        }
+      }
+      fExitNormals.Set(i, motherExitNormal);
+    }
+    else
+    {
+      fValidExitNormal[i] = 0;
+    }
+  }
+  return false;
+}
+
+// ********************************************************************
+// FinishSteps
+// ********************************************************************
+//
+void G4NavigationBatch::FinishSteps()
+{
+  std::size_t nTracks = Size();
+  for (std::size_t i=0; i<nTracks; ++i)
+  {
+    if ( (fSteps[i]==fProposedSteps[i])
+      && (fExiting[i] == 0) && (fEntering[i] == 0) )
+    {
+      fSteps[i] = kInfinity;
+    }
+  }
+}
@@ -40,6 +40,9 @@
 
 #include "G4VoxelSafety.hh"
 #include "G4SafetyCalculator.hh"
+#include "G4FlatGeometry.hh"
+#include "G4FlatNavigator.hh"
+#include "G4GeometryManager.hh"
 
 // Constant determining how precise normals should be (how close to unit
 // vectors). If exceeded, warnings will be issued.
@@ -92,6 +95,8 @@ G4Navigator::~G4Navigator()
   delete fpExternalNav;
   delete fpvoxelNav;
   delete fpSafetyCalculator;
+  delete fpFlatNavigator;
+  delete fpFlatGeometry;
 }
 
 // ********************************************************************
@@ -441,6 +446,15 @@ G4Navigator::LocateGlobalPointAndSetup( const G4ThreeVector& globalPoint,
   // o Positioned daughters & voxels
   // o Positioned daughters & no voxels
 
+  if ( fpFlatNavigator != nullptr )
+  {
+    // Levels of placements are descended through the flat image; the
+    // loop below completes the location from the volume reached
+    //
+    LocateFlatDaughters(globalPoint, pGlobalDirection,
+                        considerDirection, localPoint);
+  }
+
   noResult = true;  // noResult should be renamed to
                     // something like enteredLevel, as that is its meaning.
   do
@@ -1250,6 +1264,96 @@ G4double G4Navigator::CheckNextStep( const G4ThreeVector& pGlobalpoint,
   return step; 
 }
 
+// ********************************************************************
+// ComputeStepBatch
+//
+// Compute the steps of a block of tracks located in the current volume,
+// without altering the navigator state
+// ********************************************************************
+//
+void G4Navigator::ComputeStepBatch( G4NavigationBatch& batch )
+{
+  G4VPhysicalVolume* motherPhysical = fHistory.GetTopVolume();
+  if ( motherPhysical == nullptr )
+  {
+    G4Exception("G4Navigator::ComputeStepBatch()", "GeomNav0003",
+                FatalException, "No current volume. Call one of the "
+                "Locate methods before computing steps.");
+    return;
+  }
+  G4LogicalVolume* motherLogical = motherPhysical->GetLogicalVolume();
+
+  batch.SetLocalFrame(GetGlobalToLocalTransform());
+
+  if ( fHistory.GetTopVolumeType() != kReplica )
+  {
+    switch( CharacteriseDaughters(motherLogical) )
+    {
+      case kNormal:
+        if ( motherLogical->GetVoxelHeader() != nullptr )
+        {
+          GetVoxelNavigator().ComputeStepBatch(batch, fHistory);
+        }
+        else  // Also for regular (non-voxelised) structures
+        {
+          fnormalNav.ComputeStepBatch(batch, fHistory);
+        }
+        break;
+      case kParameterised:
+        if( GetDaughtersRegularStructureId(motherLogical) != 1 )
+        {
+          fparamNav.ComputeStepBatch(batch, fHistory);
+        }
+        else  // Regular structure
+        {
+          fregularNav.ComputeStepBatch(batch, fHistory);
+        }
+        break;
+      case kReplica:
+        G4Exception("G4Navigator::ComputeStepBatch()", "GeomNav0001",
+                    FatalException, "Not applicable for replicated volumes.");
+        break;
+      case kExternal:
+        fpExternalNav->ComputeStepBatch(batch, fHistory);
+        break;
+    }
+  }
+  else
+  {
+    // The replica navigation is not voxel based: compute the steps
+    // one track at a time
+    //
+    for (std::size_t i=0; i<batch.Size(); ++i)
+    {
+      batch.ComputeReplicaStep(i, freplicaNav, fHistory);
+    }
+  }
+
+  // Steps not limited by the geometry are returned as infinite
+  //
+  batch.FinishSteps();
+
+  // Restore the state of the sub-navigators to the last located point
+  //
+  switch( CharacteriseDaughters(motherLogical) )
+  {
+    case kNormal:
+      GetVoxelNavigator().RelocateWithinVolume( motherPhysical,
+                                                fLastLocatedPointLocal );
+      break;
+    case kParameterised:
+      fparamNav.RelocateWithinVolume( motherPhysical, fLastLocatedPointLocal );
+      break;
+    case kReplica:
+      // Nothing to do
+      break;
+    case kExternal:
+      fpExternalNav->RelocateWithinVolume( motherPhysical,
+                                           fLastLocatedPointLocal );
+      break;
+  }
+}
+
 // ********************************************************************
 // ResetState
 //
@@ -2089,6 +2193,82 @@ void G4Navigator::SetVoxelNavigation(G4VoxelNavigation* voxelNav)
   fpvoxelNav = voxelNav;
 }
 
+// ********************************************************************
+// EnableFlatGeometry
+// ********************************************************************
+//
+void G4Navigator::EnableFlatGeometry(G4bool value)
+{
+  if ( value == IsFlatGeometryEnabled() )  { return; }
+  delete fpFlatNavigator;
+  delete fpFlatGeometry;
+  fpFlatNavigator = nullptr;
+  fpFlatGeometry = nullptr;
+  fFlatGeometryClosure = -1;
+  if ( value )
+  {
+    fpFlatGeometry = new G4FlatGeometry();
+    fpFlatNavigator = new G4FlatNavigator(fpFlatGeometry);
+  }
+}
+
+// ********************************************************************
+// LocateFlatDaughters
+//
+// The image is (re)built if the geometry was closed again or the world
+// changed since it was built. The daughters are selected as by the
+// LevelLocate() of the voxel and normal navigations, and the state is
+// updated as in the search loop of LocateGlobalPointAndSetup() for each
+// level entered.
+// ********************************************************************
+//
+void G4Navigator::LocateFlatDaughters(const G4ThreeVector& globalPoint,
+                                      const G4ThreeVector* pGlobalDirection,
+                                      const G4bool considerDirection,
+                                            G4ThreeVector& localPoint)
+{
+  G4int closure = G4GeometryManager::GetClosureCount();
+  if ( (fFlatGeometryClosure != closure)
+    || (fpFlatGeometry->GetWorldVolume() != fTopPhysical) )
+  {
+    fpFlatGeometry->Build(fTopPhysical);
+    fFlatGeometryClosure = closure;
+  }
+
+  G4int node = fpFlatGeometry->GetNode(fHistory);
+  if ( node < 0 )  { return; }
+
+  while ( fpFlatGeometry->IsFlattened(node) )
+  {
+    G4int daughter = fpFlatNavigator->LocateDaughter(node, globalPoint,
+                                                     pGlobalDirection,
+                                                     considerDirection,
+                                                     fBlockedPhysicalVolume);
+    if ( daughter < 0 )  { break; }
+
+    G4VPhysicalVolume* enteredPhysical =
+      fpFlatGeometry->GetPhysicalVolume(daughter);
+    fHistory.NewLevel(enteredPhysical, kNormal,
+                      fpFlatGeometry->GetCopyNo(daughter));
+    localPoint = fHistory.GetTopTransform().TransformPoint(globalPoint);
+
+    fBlockedPhysicalVolume = nullptr;
+    fBlockedReplicaNo = -1;
+    fEntering = false;
+    fEnteredDaughter = true;
+    if( fExitedMother )
+    {
+      const G4RotationMatrix* mRot = enteredPhysical->GetRotation();
+      if( mRot != nullptr )
+      {
+        fGrandMotherExitNormal *= (*mRot);
+        fChangedGrandMotherRefFrame= true;
+      }
+    }
+    node = daughter;
+  }
+}
+
 // ********************************************************************
 // InformLastStep: derived navigators can inform of its step
 //                 used to update fLastStepWasZero
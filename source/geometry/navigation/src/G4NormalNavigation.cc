@@ -32,6 +32,7 @@
 #include "G4NormalNavigation.hh"
 #include "G4NavigationLogger.hh"
 #include "G4AffineTransform.hh"
+#include "G4NavigationBatch.hh"
 
 // ********************************************************************
 // Constructor
@@ -327,6 +328,46 @@ G4NormalNavigation::ComputeStep(const G4ThreeVector& localPoint,
   return ourStep;
 }
 
+// ********************************************************************
+// ComputeStepBatch
+// ********************************************************************
+//
+// Same algorithm as ComputeStep(), with the loop over daughters outside
+// the loop over tracks. In check mode, the scalar method is used for
+// each track, so that all verifications and logging are applied.
+//
+void G4NormalNavigation::ComputeStepBatch(G4NavigationBatch& batch,
+                                          G4NavigationHistory& history)
+{
+  if ( fCheck )
+  {
+    G4VNavigation::ComputeStepBatch(batch, history);
+    return;
+  }
+
+  G4VPhysicalVolume* motherPhysical = history.GetTopVolume();
+  G4LogicalVolume* motherLogical = motherPhysical->GetLogicalVolume();
+  const std::vector<std::size_t>& tracks = batch.GetAllTracks();
+
+  batch.StartStep(motherLogical->GetSolid());
+
+  // Compute daughter safeties & intersections
+  //
+  for ( auto sampleNo=(G4long)motherLogical->GetNoDaughters()-1;
+        sampleNo>=0; sampleNo-- )
+  {
+    batch.IntersectDaughter(motherLogical->GetDaughter(sampleNo),
+                            tracks.data(), tracks.size());
+  }
+
+  // Consider intersection with mother solid
+  //
+  for ( auto i : tracks )
+  {
+    batch.ComputeMotherStep(i, motherPhysical);
+  }
+}
+
 // ********************************************************************
 // ComputeSafety
 // ********************************************************************
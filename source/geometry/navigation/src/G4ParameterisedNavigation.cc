@@ -396,6 +396,20 @@ G4double G4ParameterisedNavigation::
   return ourStep;
 }
 
+// ***************************************************************************
+// ComputeStepBatch
+//
+// The voxel-grouped batched navigation inherited from G4VoxelNavigation
+// does not apply to parameterised daughters: revert to the track-by-track
+// computation of the base interface.
+// ***************************************************************************
+//
+void G4ParameterisedNavigation::ComputeStepBatch(G4NavigationBatch& batch,
+                                                 G4NavigationHistory& history)
+{
+  G4VNavigation::ComputeStepBatch(batch, history);
+}
+
 // ***************************************************************************
 // ComputeSafety
 // ***************************************************************************
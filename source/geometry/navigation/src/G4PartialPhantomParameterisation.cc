@@ -115,6 +115,26 @@ GetMaterial( std::size_t copyNo ) const
 }
 
 
+//------------------------------------------------------------------
+void G4PartialPhantomParameterisation::CompactMaterialIndices()
+{
+  G4Exception("G4PartialPhantomParameterisation::CompactMaterialIndices()",
+              "GeomNav1002", JustWarning,
+              "Compaction of material indices is not supported for partial "
+              "phantoms. The material indices are not changed.");
+}
+
+
+//------------------------------------------------------------------
+void G4PartialPhantomParameterisation::BuildHomogeneousRegions()
+{
+  G4Exception("G4PartialPhantomParameterisation::BuildHomogeneousRegions()",
+              "GeomNav1002", JustWarning,
+              "Homogeneous regions are not supported for partial phantoms. "
+              "Voxels are navigated one by one.");
+}
+
+
 //------------------------------------------------------------------
 void G4PartialPhantomParameterisation::
 ComputeVoxelIndices(const G4int copyNo, std::size_t& nx,
@@ -131,6 +131,8 @@ GetMaterialIndex( std::size_t copyNo ) const
 {
   CheckCopyNo( copyNo );
 
+  if( !fMaterialIndices8.empty() )  { return fMaterialIndices8[copyNo]; }
+  if( !fMaterialIndices16.empty() ) { return fMaterialIndices16[copyNo]; }
   if( fMaterialIndices == nullptr ) { return 0; }
   return *(fMaterialIndices+copyNo);
 }
@@ -160,6 +162,164 @@ G4Material* G4PhantomParameterisation::GetMaterial( std::size_t copyNo ) const
 }
 
 
+//------------------------------------------------------------------
+void G4PhantomParameterisation::CompactMaterialIndices()
+{
+  if( fMaterialIndices == nullptr ) { return; }
+
+  if( fMaterials.size() <= 256 )
+  {
+    fMaterialIndices8.resize(fNoVoxels);
+    for( std::size_t ii = 0; ii < fNoVoxels; ++ii )
+    {
+      fMaterialIndices8[ii] = std::uint8_t(fMaterialIndices[ii]);
+    }
+  }
+  else if( fMaterials.size() <= 65536 )
+  {
+    fMaterialIndices16.resize(fNoVoxels);
+    for( std::size_t ii = 0; ii < fNoVoxels; ++ii )
+    {
+      fMaterialIndices16[ii] = std::uint16_t(fMaterialIndices[ii]);
+    }
+  }
+  else
+  {
+    std::ostringstream message;
+    message << "Too many materials to compact the indices: "
+            << fMaterials.size() << G4endl
+            << "        Maximum number of materials is 65536.";
+    G4Exception("G4PhantomParameterisation::CompactMaterialIndices()",
+                "GeomNav1002", JustWarning, message);
+    return;
+  }
+  fMaterialIndices = nullptr;
+}
+
+
+//------------------------------------------------------------------
+void G4PhantomParameterisation::BuildHomogeneousRegions()
+{
+  ClearHomogeneousRegions();
+  if( fNoVoxels == 0 ) { return; }
+  if( fMaterials.size() >= 65535 )
+  {
+    std::ostringstream message;
+    message << "Too many materials to build the homogeneous regions: "
+            << fMaterials.size();
+    G4Exception("G4PhantomParameterisation::BuildHomogeneousRegions()",
+                "GeomNav1002", JustWarning, message);
+    return;
+  }
+
+  // Each level halves the number of blocks along each axis. A block is
+  // homogeneous if all its (up to eight) children are homogeneous and
+  // share the same material; voxels are the homogeneous children of the
+  // first level
+  //
+  std::size_t nchild[3] = { fNoVoxelsX, fNoVoxelsY, fNoVoxelsZ };
+  while( nchild[0] > 1 || nchild[1] > 1 || nchild[2] > 1 )
+  {
+    std::size_t nblock[3];
+    for( auto k = 0; k < 3; ++k ) { nblock[k] = (nchild[k]+1)/2; }
+    std::vector<std::uint16_t> level(nblock[0]*nblock[1]*nblock[2], 0);
+    const std::vector<std::uint16_t>* children =
+      fHomogeneousLevels.empty() ? nullptr : &fHomogeneousLevels.back();
+    G4bool anyHomogeneous = false;
+
+    std::size_t ib = 0;
+    for( std::size_t bz = 0; bz < nblock[2]; ++bz )
+    {
+      for( std::size_t by = 0; by < nblock[1]; ++by )
+      {
+        for( std::size_t bx = 0; bx < nblock[0]; ++bx, ++ib )
+        {
+          G4int mate = -1;
+          G4bool homogeneous = true;
+          for( std::size_t cz = 2*bz; cz < std::min(2*bz+2,nchild[2])
+                                      && homogeneous; ++cz )
+          {
+            for( std::size_t cy = 2*by; cy < std::min(2*by+2,nchild[1])
+                                        && homogeneous; ++cy )
+            {
+              for( std::size_t cx = 2*bx; cx < std::min(2*bx+2,nchild[0])
+                                          && homogeneous; ++cx )
+              {
+                G4int childMate = (children == nullptr)
+                  ? G4int(GetMaterialIndex(cx,cy,cz))
+                  : G4int((*children)[cx+nchild[0]*(cy+nchild[1]*cz)]) - 1;
+                if( childMate < 0 || (mate >= 0 && childMate != mate) )
+                {
+                  homogeneous = false;
+                }
+                mate = childMate;
+              }
+            }
+          }
+          if( homogeneous )
+          {
+            level[ib] = std::uint16_t(mate+1);
+            anyHomogeneous = true;
+          }
+        }
+      }
+    }
+    if( !anyHomogeneous ) { break; }
+
+    fHomogeneousLevels.push_back(std::move(level));
+    for( auto k = 0; k < 3; ++k ) { nchild[k] = nblock[k]; }
+  }
+}
+
+
+//------------------------------------------------------------------
+void G4PhantomParameterisation::ClearHomogeneousRegions()
+{
+  std::vector<std::vector<std::uint16_t>>().swap(fHomogeneousLevels);
+}
+
+
+//------------------------------------------------------------------
+G4bool G4PhantomParameterisation::
+GetHomogeneousBlock( const G4int copyNo, G4ThreeVector& blockMin,
+                     G4ThreeVector& blockMax ) const
+{
+  std::size_t nx;
+  std::size_t ny;
+  std::size_t nz;
+  ComputeVoxelIndices( copyNo, nx, ny, nz );
+
+  // Climb the levels while the block containing the voxel is homogeneous:
+  // blocks of a level are only homogeneous if their children are
+  //
+  std::size_t nblock[3] = { fNoVoxelsX, fNoVoxelsY, fNoVoxelsZ };
+  std::size_t level = 0;
+  for( ; level < fHomogeneousLevels.size(); ++level )
+  {
+    for( auto k = 0; k < 3; ++k ) { nblock[k] = (nblock[k]+1)/2; }
+    std::size_t ib = (nx >> (level+1))
+                   + nblock[0]*((ny >> (level+1)) + nblock[1]*(nz >> (level+1)));
+    if( fHomogeneousLevels[level][ib] == 0 ) { break; }
+  }
+  if( level == 0 ) { return false; }
+
+  const std::size_t size = std::size_t(1) << level;
+  const std::size_t nvox[3] = { fNoVoxelsX, fNoVoxelsY, fNoVoxelsZ };
+  const std::size_t nvoxel[3] = { nx, ny, nz };
+  const G4double half[3] = { fVoxelHalfX, fVoxelHalfY, fVoxelHalfZ };
+  const G4double wall[3] = { fContainerWallX, fContainerWallY,
+                             fContainerWallZ };
+  for( auto k = 0; k < 3; ++k )
+  {
+    std::size_t first = (nvoxel[k] >> level) << level;
+    std::size_t last = std::min(first+size, nvox[k]);
+    blockMin[k] = 2*first*half[k] - wall[k];
+    blockMax[k] = 2*last*half[k] - wall[k];
+  }
+  return true;
+}
+
+
 //------------------------------------------------------------------
 void G4PhantomParameterisation::
 ComputeVoxelIndices(const G4int copyNo, std::size_t& nx,
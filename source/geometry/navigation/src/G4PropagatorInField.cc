@@ -36,6 +36,7 @@
 // ---------------------------------------------------------------------------
 
 #include <iomanip>
+#include <typeinfo>
 
 #include "G4PropagatorInField.hh"
 #include "G4ios.hh"
@@ -48,6 +49,9 @@
 #include "G4VCurvedTrajectoryFilter.hh"
 #include "G4ChordFinder.hh"
 #include "G4MultiLevelLocator.hh"
+#include "G4UniformMagField.hh"
+#include "G4Mag_UsualEqRhs.hh"
+#include "G4ExactHelixDriver.hh"
 
 
 // ---------------------------------------------------------------------------
@@ -103,6 +107,10 @@ G4PropagatorInField::G4PropagatorInField( G4Navigator* theNavigator,
 G4PropagatorInField::~G4PropagatorInField()
 {
   if(fAllocatedLocator)  { delete  fIntersectionLocator; }
+  for (const auto& entry : fHelixChordFinders)
+  {
+    delete entry.second.fHelixChordFinder;
+  }
 }
 
 // ---------------------------------------------------------------------------
@@ -126,6 +134,17 @@ G4double G4PropagatorInField::ComputeStep(
                 G4VPhysicalVolume* pPhysVol,
                 G4bool             canRelaxDeltaChord)
 {  
+  // If not yet done, 
+  //   Set the field manager to the local  one if the volume has one, 
+  //                      or to the global one if not.
+  // This also selects the chord finder (helix or integrated) used below
+  //
+  if( !fSetFieldMgr )
+  {
+    fCurrentFieldMgr = FindAndSetFieldManager( pPhysVol );
+  }
+  fSetFieldMgr = false; // For next call, the field manager must be set again
+
   GetChordFinder()->OnComputeStep(&pFieldTrack);
   const G4double deltaChord = GetChordFinder()->GetDeltaChord();
 
@@ -178,15 +197,8 @@ G4double G4PropagatorInField::ComputeStep(
   G4double NewSafety;
   fParticleIsLooping = false;
 
-  // If not yet done, 
-  //   Set the field manager to the local  one if the volume has one, 
-  //                      or to the global one if not
-  //
-  if( !fSetFieldMgr )
-  {
-    fCurrentFieldMgr = FindAndSetFieldManager( pPhysVol );
-  }
-  fSetFieldMgr = false; // For next call, the field manager must be set again
+  if( fHelixChordFinder != nullptr ) { ++fNoHelixSteps; }
+  else                               { ++fNoIntegratedSteps; }
 
   G4FieldTrack CurrentState(pFieldTrack);
   G4FieldTrack OriginalState = CurrentState;
@@ -736,6 +748,8 @@ FindAndSetFieldManager( G4VPhysicalVolume* pCurrentPhysicalVolume )
      }
   }
   fCurrentFieldMgr = currentFieldMgr;
+  fHelixChordFinder = fUseHelixForUniformField
+                    ? FindHelixChordFinder(currentFieldMgr) : nullptr;
 
   // Flag that field manager has been set
   //
@@ -744,6 +758,53 @@ FindAndSetFieldManager( G4VPhysicalVolume* pCurrentPhysicalVolume )
   return currentFieldMgr;
 }
 
+// ---------------------------------------------------------------------------
+//
+void G4PropagatorInField::SetUseHelixForUniformField( G4bool val )
+{
+  fUseHelixForUniformField = val;
+  if( !val ) { fHelixChordFinder = nullptr; }
+}
+
+// ---------------------------------------------------------------------------
+// The helix is exact only for a uniform and purely magnetic field, with
+// the equation of motion not including spin, EDM, etc.
+//
+G4ChordFinder*
+G4PropagatorInField::FindHelixChordFinder( G4FieldManager* fieldMgr )
+{
+  if( fieldMgr == nullptr ) { return nullptr; }
+  const G4Field* field = fieldMgr->GetDetectorField();
+  G4ChordFinder* chordFinder = fieldMgr->GetChordFinder();
+
+  G4HelixChordFinderEntry& entry = fHelixChordFinders[fieldMgr];
+  if( entry.fField != field || entry.fChordFinder != chordFinder )
+  {
+    delete entry.fHelixChordFinder;
+    entry.fHelixChordFinder = nullptr;
+    entry.fField = field;
+    entry.fChordFinder = chordFinder;
+
+    if( dynamic_cast<const G4UniformMagField*>(field) != nullptr
+     && chordFinder != nullptr )
+    {
+      G4EquationOfMotion* equation =
+        chordFinder->GetIntegrationDriver()->GetEquationOfMotion();
+      if( equation != nullptr && typeid(*equation) == typeid(G4Mag_UsualEqRhs) )
+      {
+        auto driver =
+          new G4ExactHelixDriver(static_cast<G4Mag_EqRhs*>(equation));
+        entry.fHelixChordFinder = new G4ChordFinder(driver);
+      }
+    }
+  }
+  if( entry.fHelixChordFinder != nullptr )
+  {
+    entry.fHelixChordFinder->SetDeltaChord(chordFinder->GetDeltaChord());
+  }
+  return entry.fHelixChordFinder;
+}
+
 // ---------------------------------------------------------------------------
 //
 G4int G4PropagatorInField::SetVerboseLevel( G4int level )
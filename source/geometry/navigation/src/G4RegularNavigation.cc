@@ -189,6 +189,8 @@ G4double G4RegularNavigation::ComputeStepSkippingEqualMaterials(
   G4bool bFirstStep = true;
   G4double newStep;
   G4double totalNewStep = 0.;
+  G4bool useBlocks = param->HasHomogeneousRegions();
+  G4ThreeVector blockMin, blockMax;
 
   // Loop while same material is found 
   //
@@ -214,7 +216,34 @@ G4double G4RegularNavigation::ComputeStepSkippingEqualMaterials(
       EventMustBeAborted,
       message);
     }
-    newStep = voxelBox->DistanceToOut( localPoint, localDirection );
+    if( useBlocks
+     && param->GetHomogeneousBlock( copyNo, blockMin, blockMax ) )
+    {
+      // Cross the whole homogeneous block: distance to its exit along the
+      // direction, in the frame of the current voxel
+      //
+      newStep = kInfinity;
+      for( auto k = 0; k < 3; ++k )
+      {
+        if( localDirection[k] > 0. )
+        {
+          newStep = std::min(newStep,
+            (blockMax[k] - prevVoxelTranslation[k] - localPoint[k])
+            / localDirection[k]);
+        }
+        else if( localDirection[k] < 0. )
+        {
+          newStep = std::min(newStep,
+            (blockMin[k] - prevVoxelTranslation[k] - localPoint[k])
+            / localDirection[k]);
+        }
+      }
+      newStep = std::max(newStep, 0.);
+    }
+    else
+    {
+      newStep = voxelBox->DistanceToOut( localPoint, localDirection );
+    }
     fLastStepWasZero = (newStep<fMinStep);
     if( fLastStepWasZero )
     {
@@ -67,6 +67,7 @@ void G4SafetyHelper::InitialiseHelper()
 {
   fLastSafetyPosition = G4ThreeVector(0.0,0.0,0.0);
   fLastSafety         = 0.0;
+  fLastSafetyVolume   = nullptr;
   if (fFirstCall) { InitialiseNavigator(); }
   fFirstCall = false;
 }
@@ -87,6 +88,7 @@ G4SafetyHelper::CheckNextStep(const G4ThreeVector& position,
                                                      newSafety);
   fLastSafetyPosition = position;
   fLastSafety         = newSafety;
+  SetSafetyTouchable();
 
   // TO-DO: Can replace this with a call to PathFinder 
   //        giving id of Mass Geometry --> this avoid doing the work twice
@@ -106,6 +108,24 @@ G4double G4SafetyHelper::ComputeSafety( const G4ThreeVector& position,
   G4double moveLengthSq = (position-fLastSafetyPosition).mag2();
   if(   (moveLengthSq > 0.0 ) )
   {
+    if( fUseSafetyCache )
+    {
+      // The last safety sphere is free of boundaries in all geometries:
+      // inside it the remaining safety is a valid underestimate, which
+      // is sufficient if it covers the radius of interest
+      //
+      if( moveLengthSq < sqr(fLastSafety) && IsSafetyTouchable() )
+      {
+        G4double remainingSafety = fLastSafety - std::sqrt(moveLengthSq);
+        if( remainingSafety >= maxLength )
+        {
+          ++fSafetyCacheHits;
+          return remainingSafety;
+        }
+      }
+      ++fSafetyCacheMisses;
+    }
+
     if( !fUseParallelGeometries )
     {
       // Safety for mass geometry
@@ -116,6 +136,7 @@ G4double G4SafetyHelper::ComputeSafety( const G4ThreeVector& position,
       {
          fLastSafety= newSafety;
          fLastSafetyPosition = position;
+         SetSafetyTouchable();
       }
     }
     else
@@ -125,6 +146,7 @@ G4double G4SafetyHelper::ComputeSafety( const G4ThreeVector& position,
 
       fLastSafety= newSafety;
       fLastSafetyPosition = position;
+      SetSafetyTouchable();
     } 
  
   }
@@ -140,6 +162,29 @@ G4double G4SafetyHelper::ComputeSafety( const G4ThreeVector& position,
   return newSafety;
 }
 
+// --------------------------------------------------------------------
+void G4SafetyHelper::PrintSafetyCacheStatistics() const
+{
+  G4long requests = fSafetyCacheHits + fSafetyCacheMisses;
+  G4cout << "G4SafetyHelper - safety cache "
+         << (fUseSafetyCache ? "enabled" : "disabled") << G4endl
+         << "    Requests: " << requests
+         << ", hits: " << fSafetyCacheHits
+         << ", misses: " << fSafetyCacheMisses;
+  if( requests > 0 )
+  {
+    G4cout << " (hit rate " << 100.*fSafetyCacheHits/requests << " %)";
+  }
+  G4cout << G4endl;
+}
+
+// --------------------------------------------------------------------
+void G4SafetyHelper::ResetSafetyCacheStatistics()
+{
+  fSafetyCacheHits = 0;
+  fSafetyCacheMisses = 0;
+}
+
 // --------------------------------------------------------------------
 void G4SafetyHelper::ReLocateWithinVolume( const G4ThreeVector& newPosition )
 {
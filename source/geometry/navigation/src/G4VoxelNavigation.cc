@@ -31,9 +31,11 @@
 #include "G4VoxelNavigation.hh"
 #include "G4GeometryTolerance.hh"
 #include "G4VoxelSafety.hh"
+#include "G4NavigationBatch.hh"
 
 #include "G4AuxiliaryNavServices.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <ostream>
 
@@ -634,6 +636,90 @@ G4VoxelNavigation::LocateNextVoxel(const G4ThreeVector& localPoint,
   return isNewVoxel;        
 }
 
+// ********************************************************************
+// ComputeStepBatch
+//
+// Same algorithm as ComputeStep() for the voxel containing the starting
+// point of each track: tracks sharing the same voxel node are checked
+// together against its candidate daughters. The step of a track is
+// final if it ends within that voxel (or it is physics limited);
+// otherwise it is recomputed with the scalar ComputeStep(), which
+// continues into the next voxels. In check mode, the scalar method is
+// used for all tracks.
+// ********************************************************************
+//
+void G4VoxelNavigation::ComputeStepBatch(G4NavigationBatch& batch,
+                                         G4NavigationHistory& history)
+{
+  G4VPhysicalVolume* motherPhysical = history.GetTopVolume();
+  G4LogicalVolume* motherLogical = motherPhysical->GetLogicalVolume();
+  G4SmartVoxelHeader* motherVoxelHeader = motherLogical->GetVoxelHeader();
+
+  if ( fCheck || (motherVoxelHeader == nullptr) )
+  {
+    G4VNavigation::ComputeStepBatch(batch, history);
+    return;
+  }
+
+  const G4ThreeVectorSoA& localPoints = batch.GetLocalPoints();
+  const G4ThreeVectorSoA& localDirections = batch.GetLocalDirections();
+  std::size_t nTracks = batch.Size();
+
+  batch.StartStep(motherLogical->GetSolid());
+
+  // Group tracks by voxel node, preserving the order within each group
+  //
+  fBatchNodes.clear();
+  for (std::size_t i=0; i<nTracks; ++i)
+  {
+    fBatchNodes.emplace_back(VoxelLocate(motherVoxelHeader,
+                                         localPoints.Get(i)), i);
+  }
+  std::sort(fBatchNodes.begin(), fBatchNodes.end());
+
+  // Compute daughter safeties & intersections for each group
+  //
+  std::size_t first = 0;
+  while (first < nTracks)
+  {
+    G4SmartVoxelNode* curVoxelNode = fBatchNodes[first].first;
+    fBatchTracks.clear();
+    std::size_t last = first;
+    while ( (last < nTracks) && (fBatchNodes[last].first == curVoxelNode) )
+    {
+      fBatchTracks.push_back(fBatchNodes[last].second);
+      ++last;
+    }
+    for (auto contentNo=(G4long)curVoxelNode->GetNoContained()-1;
+         contentNo>=0; contentNo--)
+    {
+      G4int sampleNo = curVoxelNode->GetVolume((G4int)contentNo);
+      batch.IntersectDaughter(motherLogical->GetDaughter(sampleNo),
+                              fBatchTracks.data(), fBatchTracks.size());
+    }
+    first = last;
+  }
+
+  // Voxel safety, intersection with mother solid and check whether
+  // the step ends in the initial voxel
+  //
+  for (std::size_t i=0; i<nTracks; ++i)
+  {
+    const G4ThreeVector localPoint = localPoints.Get(i);
+    VoxelLocate(motherVoxelHeader, localPoint);
+    batch.LimitSafety(i, ComputeVoxelSafety(localPoint));
+    if ( batch.ComputeMotherStep(i, motherPhysical) ) { continue; }
+
+    if ( LocateNextVoxel(localPoint, localDirections.Get(i),
+                         batch.GetStep(i)) )
+    {
+      batch.RestoreState(i);
+      VoxelLocate(motherVoxelHeader, localPoint);
+      batch.ComputeStep(i, *this, history);
+    }
+  }
+}
+
 // ********************************************************************
 // ComputeSafety
 //
@@ -47,6 +47,7 @@
 #include "G4Vector3D.hh"
 #include "G4SurfBits.hh"
 #include "G4Voxelizer.hh"
+#include "G4BoundingVolumeHierarchy.hh"
 
 class G4Polyhedron;
 
@@ -127,6 +128,11 @@ class G4MultiUnion : public G4VSolid
       // Finalize and prepare for use. User MUST call it once before
       // navigation use.
 
+    inline void SetUseBVH(G4bool flag);
+    inline G4bool GetUseBVH() const;
+      // Organise the constituents in a bounding volume hierarchy instead
+      // of voxels (off by default). Must be set before Voxelize().
+
     EInside InsideNoVoxels(const G4ThreeVector& aPoint) const;
     inline G4Voxelizer& GetVoxels() const;
 
@@ -153,6 +159,12 @@ class G4MultiUnion : public G4VSolid
                                     const G4ThreeVector& aDirection,
                                      std::vector<G4int>& candidates,
                                     G4SurfBits& bits) const;
+    G4double DistanceToInBVH(const G4ThreeVector& aPoint,
+                             const G4ThreeVector& aDirection) const;
+    G4int GetCandidates(const G4ThreeVector& aPoint,
+                        std::vector<G4int>& candidates,
+                        G4SurfBits* exclusion = nullptr) const;
+      // Candidates for the point, from the hierarchy or the voxels.
 
     // Conversion utilities
     inline G4ThreeVector GetLocalPoint(const G4Transform3D& trans,
@@ -176,10 +188,12 @@ class G4MultiUnion : public G4VSolid
     std::vector<G4VSolid*> fSolids;
     std::vector<G4Transform3D> fTransformObjs;
     G4Voxelizer fVoxels;              // Vozelizer for the solid
+    G4BoundingVolumeHierarchy fBVH;   // Alternative to voxels, if requested
     G4double fCubicVolume = 0.0;      // Cubic Volume
     G4double fSurfaceArea = 0.0;      // Surface Area
     G4double kRadTolerance;           // Cached radial tolerance
     mutable G4bool fAccurate = false; // Accurate safety (off by default)
+    G4bool fUseBVH = false;           // Use of BVH (off by default)
 
     mutable G4bool fRebuildPolyhedron = false;
     mutable G4Polyhedron* fpPolyhedron = nullptr;
@@ -191,6 +205,18 @@ inline G4Voxelizer& G4MultiUnion::GetVoxels() const
   return (G4Voxelizer&)fVoxels;
 }
 
+//______________________________________________________________________________
+inline void G4MultiUnion::SetUseBVH(G4bool flag)
+{
+  fUseBVH = flag;
+}
+
+//______________________________________________________________________________
+inline G4bool G4MultiUnion::GetUseBVH() const
+{
+  return fUseBVH;
+}
+
 //______________________________________________________________________________
 inline const G4Transform3D& G4MultiUnion::GetTransformation(G4int index) const
 {
@@ -92,7 +92,8 @@ G4VSolid* G4MultiUnion::Clone() const
 G4MultiUnion::G4MultiUnion(const G4MultiUnion& rhs)
   : G4VSolid(rhs), fCubicVolume(rhs.fCubicVolume),
     fSurfaceArea(rhs.fSurfaceArea),
-    kRadTolerance(rhs.kRadTolerance), fAccurate(rhs.fAccurate)
+    kRadTolerance(rhs.kRadTolerance), fAccurate(rhs.fAccurate),
+    fUseBVH(rhs.fUseBVH)
 {
 }
 
@@ -117,6 +118,7 @@ G4MultiUnion& G4MultiUnion::operator = (const G4MultiUnion& rhs)
   // Copy base class data
   //
   G4VSolid::operator=(rhs);
+  fUseBVH = rhs.fUseBVH;
 
   return *this;
 }
@@ -181,6 +183,49 @@ G4double G4MultiUnion::DistanceToInCandidates(const G4ThreeVector& aPoint,
   return minDistance;
 }
 
+//______________________________________________________________________________
+G4double G4MultiUnion::DistanceToInBVH(const G4ThreeVector& aPoint,
+                                       const G4ThreeVector& aDirection) const
+{
+  // Constituents are visited approximately in order of distance along the
+  // ray; those whose boxes lie beyond the closest hit found are skipped
+
+  G4ThreeVector direction = aDirection.unit();
+  G4ThreeVector localPoint, localDirection;
+  G4double minDistance = kInfinity;
+
+  G4double maxDistance = kInfinity;
+  fBVH.TraverseRay(aPoint, direction, 0., maxDistance,
+                   [&](G4int candidate, G4double& tmax)
+  {
+    G4VSolid& solid = *fSolids[candidate];
+    const G4Transform3D& transform = fTransformObjs[candidate];
+
+    localPoint = GetLocalPoint(transform, aPoint);
+    localDirection = GetLocalVector(transform, direction);
+    G4double distance = solid.DistanceToIn(localPoint, localDirection);
+    if (minDistance > distance)
+    {
+      minDistance = distance;
+      tmax = distance;
+    }
+    return minDistance != 0;
+  });
+  return minDistance;
+}
+
+//______________________________________________________________________________
+G4int G4MultiUnion::GetCandidates(const G4ThreeVector& aPoint,
+                                  std::vector<G4int>& candidates,
+                                  G4SurfBits* exclusion) const
+{
+  if (!fBVH.IsEmpty())
+  {
+    return fBVH.GetCandidates(aPoint, candidates, exclusion);
+  }
+  return fVoxels.GetCandidatesVoxelArray(aPoint, candidates, exclusion);
+}
+
 // Algorithm note: we have to look also for all other objects in next voxels,
 // if the distance is not shorter ... we have to do it because,
 // for example for objects which starts in first voxel in which they
@@ -195,6 +240,8 @@ G4double G4MultiUnion::DistanceToInCandidates(const G4ThreeVector& aPoint,
 G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& aPoint,
                                     const G4ThreeVector& aDirection) const
 {
+  if (!fBVH.IsEmpty()) { return DistanceToInBVH(aPoint, aDirection); }
+
   G4double minDistance = kInfinity;
   G4ThreeVector direction = aDirection.unit();
   G4double shift = fVoxels.DistanceToFirst(aPoint, direction);
@@ -311,7 +358,7 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
   std::size_t numNodes = 2*fSolids.size();
   std::size_t count=0;
 
-  if (fVoxels.GetCandidatesVoxelArray(aPoint, candidates) != 0)
+  if (GetCandidates(aPoint, candidates) != 0)
   {
     // For normal case for which we presume the point is inside
     G4ThreeVector localPoint, localDirection, localNormal;
@@ -398,7 +445,7 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
         // exiting current component along direction)
         candidates.clear();
 
-        fVoxels.GetCandidatesVoxelArray(currentPoint, candidates, &exclusion);
+        GetCandidates(currentPoint, candidates, &exclusion);
         exclusion.ResetBitNumber(maxCandidate);
       }
     }
@@ -436,7 +483,7 @@ EInside G4MultiUnion::InsideWithExclusion(const G4ThreeVector& aPoint,
   // TODO: eventually GetVoxel should be inlined here, early exit if any
   //       binary search is -1
 
-  G4int limit = fVoxels.GetCandidatesVoxelArray(aPoint, candidates, exclusion);
+  G4int limit = GetCandidates(aPoint, candidates, exclusion);
   for (G4int i = 0 ; i < limit ; ++i)
   {
     G4int candidate = candidates[i];
@@ -646,7 +693,7 @@ G4ThreeVector G4MultiUnion::SurfaceNormal(const G4ThreeVector& aPoint) const
   // on a vertice remain to be treated
 
   // determine weather we are in voxel area
-  if (fVoxels.GetCandidatesVoxelArray(aPoint, candidates) != 0)
+  if (GetCandidates(aPoint, candidates) != 0)
   {
     std::size_t limit = candidates.size();
     for (std::size_t i = 0 ; i < limit ; ++i)
@@ -720,7 +767,7 @@ G4double G4MultiUnion::DistanceToOut(const G4ThreeVector& point) const
 
   // In general, the value return by DistanceToIn(p) will not be the exact
   // but only an undervalue (cf. overlaps)
-  fVoxels.GetCandidatesVoxelArray(point, candidates);
+  GetCandidates(point, candidates);
 
   std::size_t limit = candidates.size();
   for (std::size_t i = 0; i < limit; ++i)
@@ -750,7 +797,11 @@ G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& point) const
   // any of its surfaces. The algorithm may be accurate or should provide a fast
   // underestimate.
 
-  if (!fAccurate)  { return fVoxels.DistanceToBoundingBox(point); }
+  if (!fAccurate)
+  {
+    return fBVH.IsEmpty() ? fVoxels.DistanceToBoundingBox(point)
+                          : fBVH.DistanceToBoundingBox(point);
+  }
 
   const std::vector<G4VoxelBox>& boxes = fVoxels.GetBoxes();
   G4double safetyMin = kInfinity;
@@ -822,6 +873,15 @@ G4bool G4MultiUnion::IsFaceted() const
 //______________________________________________________________________________
 void G4MultiUnion::Voxelize()
 {
+  fBVH.Clear();
+  if (fUseBVH)
+  {
+    // The boxes of the constituents are still needed for safety
+    //
+    fVoxels.BuildBoxes(fSolids, fTransformObjs);
+    fBVH.Build(fVoxels.GetBoxes());
+    return;
+  }
   fVoxels.Voxelize(fSolids, fTransformObjs);
 }
 
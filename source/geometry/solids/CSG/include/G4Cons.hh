@@ -144,6 +144,23 @@ class G4Cons : public G4CSGSolid
                                  G4ThreeVector* n = nullptr) const override;
     G4double DistanceToOut(const G4ThreeVector& p) const override;
 
+    void InsideBatch(const G4ThreeVectorSoA& p,
+                     EInside* result) const override;
+    void DistanceToInBatch(const G4ThreeVectorSoA& p,
+                           const G4ThreeVectorSoA& v,
+                           G4double* dist) const override;
+    void SafetyToInBatch(const G4ThreeVectorSoA& p,
+                         G4double* safety) const override;
+    void DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                            const G4ThreeVectorSoA& v,
+                            G4double* dist) const override;
+    void SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                          G4double* safety) const override;
+      // Batched versions of the methods above, for blocks of points
+      // and directions; results are identical to the scalar methods.
+      // The intersections with the cones are completed point by point
+      // with the scalar methods, for the cases listed in the source.
+
     G4GeometryType GetEntityType() const override;
 
     G4ThreeVector GetPointOnSurface() const override;
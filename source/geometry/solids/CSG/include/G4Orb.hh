@@ -100,6 +100,21 @@ class G4Orb : public G4CSGSolid
 
     G4double DistanceToOut(const G4ThreeVector& p) const override;
 
+    void InsideBatch(const G4ThreeVectorSoA& p,
+                     EInside* result) const override;
+    void DistanceToInBatch(const G4ThreeVectorSoA& p,
+                           const G4ThreeVectorSoA& v,
+                           G4double* dist) const override;
+    void SafetyToInBatch(const G4ThreeVectorSoA& p,
+                         G4double* safety) const override;
+    void DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                            const G4ThreeVectorSoA& v,
+                            G4double* dist) const override;
+    void SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                          G4double* safety) const override;
+      // Batched versions of the methods above, for blocks of points
+      // and directions; results are identical to the scalar methods.
+
     G4GeometryType GetEntityType() const override;
 
     G4ThreeVector GetPointOnSurface() const override;
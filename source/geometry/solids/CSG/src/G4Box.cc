@@ -35,6 +35,7 @@
 #if !defined(G4GEOM_USE_UBOX)
 
 #include "G4SystemOfUnits.hh"
+#include "G4ThreeVectorSoA.hh"
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
 #include "G4BoundingEnvelope.hh"
@@ -459,6 +460,144 @@ G4double G4Box::DistanceToOut(const G4ThreeVector& p) const
   return (dist > 0) ? dist : 0.;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Batched methods
+// - same algorithms as the scalar methods, written without early returns
+//   and with the box parameters held in local variables, so that the
+//   loops can be vectorised by the compiler
+
+void G4Box::InsideBatch(const G4ThreeVectorSoA& p, EInside* result) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double dx = fDx, dy = fDy, dz = fDz, tol = delta;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double dist = std::max(std::max(
+                    std::abs(px[i])-dx,
+                    std::abs(py[i])-dy),
+                    std::abs(pz[i])-dz);
+    result[i] = (dist > tol) ? kOutside :
+      ((dist > -tol) ? kSurface : kInside);
+  }
+}
+
+void G4Box::DistanceToInBatch(const G4ThreeVectorSoA& p,
+                              const G4ThreeVectorSoA& v,
+                              G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double dx = fDx, dy = fDy, dz = fDz, tol = delta;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    // Check if point is on the surface and traveling away
+    //
+    G4bool away = ((std::abs(px[i]) - dx) >= -tol && px[i]*vx[i] >= 0) ||
+                  ((std::abs(py[i]) - dy) >= -tol && py[i]*vy[i] >= 0) ||
+                  ((std::abs(pz[i]) - dz) >= -tol && pz[i]*vz[i] >= 0);
+
+    // Find intersection
+    //
+    G4double invx = (vx[i] == 0) ? DBL_MAX : -1./vx[i];
+    G4double sx = std::copysign(dx,invx);
+    G4double txmin = (px[i] - sx)*invx;
+    G4double txmax = (px[i] + sx)*invx;
+
+    G4double invy = (vy[i] == 0) ? DBL_MAX : -1./vy[i];
+    G4double sy = std::copysign(dy,invy);
+    G4double tymin = std::max(txmin,(py[i] - sy)*invy);
+    G4double tymax = std::min(txmax,(py[i] + sy)*invy);
+
+    G4double invz = (vz[i] == 0) ? DBL_MAX : -1./vz[i];
+    G4double sz = std::copysign(dz,invz);
+    G4double tmin = std::max(tymin,(pz[i] - sz)*invz);
+    G4double tmax = std::min(tymax,(pz[i] + sz)*invz);
+
+    dist[i] = (away || tmax <= tmin + tol) ? kInfinity :
+      ((tmin < tol) ? 0. : tmin);
+  }
+}
+
+void G4Box::SafetyToInBatch(const G4ThreeVectorSoA& p,
+                            G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double dx = fDx, dy = fDy, dz = fDz;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double dist = std::max(std::max(
+                    std::abs(px[i])-dx,
+                    std::abs(py[i])-dy),
+                    std::abs(pz[i])-dz);
+    safety[i] = (dist > 0) ? dist : 0.;
+  }
+}
+
+void G4Box::DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                               const G4ThreeVectorSoA& v,
+                               G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double dx = fDx, dy = fDy, dz = fDz, tol = delta;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    // Check if point is on the surface and traveling away
+    //
+    G4bool away = ((std::abs(px[i]) - dx) >= -tol && px[i]*vx[i] > 0) ||
+                  ((std::abs(py[i]) - dy) >= -tol && py[i]*vy[i] > 0) ||
+                  ((std::abs(pz[i]) - dz) >= -tol && pz[i]*vz[i] > 0);
+
+    // Find intersection
+    //
+    G4double tx = (vx[i] == 0) ? DBL_MAX
+                : (std::copysign(dx,vx[i]) - px[i])/vx[i];
+    G4double ty = (vy[i] == 0) ? tx
+                : (std::copysign(dy,vy[i]) - py[i])/vy[i];
+    G4double txy = std::min(tx,ty);
+    G4double tz = (vz[i] == 0) ? txy
+                : (std::copysign(dz,vz[i]) - pz[i])/vz[i];
+    G4double tmax = std::min(txy,tz);
+
+    dist[i] = (away) ? 0. : tmax;
+  }
+}
+
+void G4Box::SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                             G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double dx = fDx, dy = fDy, dz = fDz;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double dist = std::min(std::min(
+                    dx-std::abs(px[i]),
+                    dy-std::abs(py[i])),
+                    dz-std::abs(pz[i]));
+    safety[i] = (dist > 0) ? dist : 0.;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // GetEntityType
@@ -39,6 +39,7 @@
 #if !defined(G4GEOM_USE_UCONS)
 
 #include "G4GeomTools.hh"
+#include "G4ThreeVectorSoA.hh"
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
 #include "G4BoundingEnvelope.hh"
@@ -2073,6 +2074,250 @@ G4double G4Cons::DistanceToOut(const G4ThreeVector& p) const
   return safe ;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Batched methods
+// - same algorithms as the scalar methods, written without early returns
+//   and with the cone parameters held in local variables, so that the
+//   loops can be vectorised by the compiler. Inside() is batched only
+//   for cones with full phi section
+
+void G4Cons::InsideBatch(const G4ThreeVectorSoA& p, EInside* result) const
+{
+  if ( !fPhiFullCone )
+  {
+    G4VSolid::InsideBatch(p, result);
+    return;
+  }
+
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double rmin1 = fRmin1, rmin2 = fRmin2;
+  const G4double rmax1 = fRmax1, rmax2 = fRmax2, dz = fDz;
+  const G4double zIn  = fDz - halfCarTolerance;
+  const G4double zOut = fDz + halfCarTolerance;
+  const G4double tolR = halfRadTolerance;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double az = std::fabs(pz[i]);
+    G4double r2 = px[i]*px[i] + py[i]*py[i];
+    G4double rl = 0.5*(rmin2*(pz[i] + dz) + rmin1*(dz - pz[i]))/dz;
+    G4double rh = 0.5*(rmax2*(pz[i]+dz)+rmax1*(dz-pz[i]))/dz;
+
+    // Outer tolerant limits
+    //
+    G4double tolRMin = rl - tolR;
+    if ( tolRMin < 0 )  { tolRMin = 0; }
+    G4double tolRMax = rh + tolR;
+    G4bool outside = (az > zOut)
+                  || (r2 < tolRMin*tolRMin) || (r2 > tolRMax*tolRMax);
+
+    // Inner tolerant limits
+    //
+    tolRMin = (rl != 0.0) ? rl + tolR : 0.0;
+    tolRMax = rh - tolR;
+    G4bool surface = (az >= zIn)
+                  || (r2 < tolRMin*tolRMin) || (r2 >= tolRMax*tolRMax);
+
+    result[i] = (outside) ? kOutside : ((surface) ? kSurface : kInside);
+  }
+}
+
+void G4Cons::SafetyToInBatch(const G4ThreeVectorSoA& p,
+                             G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4bool hasRMin = (fRmin1 != 0.0) || (fRmin2 != 0.0);
+  const G4bool phiCut = !fPhiFullCone;
+  const G4double dz = fDz;
+  const G4double tanRMin = (fRmin2 - fRmin1)*0.5/fDz;
+  const G4double secRMin = std::sqrt(1.0 + tanRMin*tanRMin);
+  const G4double avgRMin = (fRmin1 + fRmin2)*0.5;
+  const G4double tanRMax = (fRmax2 - fRmax1)*0.5/fDz;
+  const G4double secRMax = std::sqrt(1.0 + tanRMax*tanRMax);
+  const G4double avgRMax = (fRmax1 + fRmax2)*0.5;
+  const G4double cosC = cosCPhi, sinC = sinCPhi, cosHD = cosHDPhi;
+  const G4double cosS = cosSPhi, sinS = sinSPhi;
+  const G4double cosE = cosEPhi, sinE = sinEPhi;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rho   = std::sqrt(px[i]*px[i] + py[i]*py[i]);
+    G4double safeZ = std::fabs(pz[i]) - dz;
+    G4double safeR1 = ((tanRMin*pz[i] + avgRMin) - rho)/secRMin;
+    G4double safeR2 = (rho - (tanRMax*pz[i] + avgRMax))/secRMax;
+    G4double safe = (!hasRMin) ? safeR2
+                  : ((safeR1 > safeR2) ? safeR1 : safeR2);
+    if ( safeZ > safe )  { safe = safeZ; }
+
+    if ( phiCut )
+    {
+      // Psi=angle from central phi to point, distance to the closest
+      // phi plane if the point lies outside the phi range
+      //
+      G4double cosPsi = (px[i]*cosC + py[i]*sinC)/((rho != 0.0) ? rho : 1.);
+      G4double safePhi = ( (py[i]*cosC - px[i]*sinC) <= 0.0 )
+                       ? std::fabs(px[i]*sinS-py[i]*cosS)
+                       : std::fabs(px[i]*sinE-py[i]*cosE);
+      if ( (rho != 0.0) && (cosPsi < cosHD) && (safePhi > safe) )
+      {
+        safe = safePhi;
+      }
+    }
+    safety[i] = (safe < 0.0) ? 0.0 : safe;
+  }
+}
+
+void G4Cons::SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                              G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4bool hasRMin = (fRmin1 != 0.0) || (fRmin2 != 0.0);
+  const G4bool phiCut = !fPhiFullCone;
+  const G4double dz = fDz;
+  const G4double tanRMin = (fRmin2 - fRmin1)*0.5/fDz;
+  const G4double secRMin = std::sqrt(1.0 + tanRMin*tanRMin);
+  const G4double avgRMin = (fRmin1 + fRmin2)*0.5;
+  const G4double tanRMax = (fRmax2 - fRmax1)*0.5/fDz;
+  const G4double secRMax = std::sqrt(1.0 + tanRMax*tanRMax);
+  const G4double avgRMax = (fRmax1+fRmax2)*0.5;
+  const G4double cosC = cosCPhi, sinC = sinCPhi;
+  const G4double cosS = cosSPhi, sinS = sinSPhi;
+  const G4double cosE = cosEPhi, sinE = sinEPhi;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rho   = std::sqrt(px[i]*px[i] + py[i]*py[i]);
+    G4double safeZ = dz - std::fabs(pz[i]);
+    G4double safeR1 = (hasRMin) ? (rho - (tanRMin*pz[i] + avgRMin))/secRMin
+                                : kInfinity;
+    G4double safeR2 = ((tanRMax*pz[i] + avgRMax) - rho)/secRMax;
+    G4double safe = (safeR1 < safeR2) ? safeR1 : safeR2;
+    if ( safeZ < safe )  { safe = safeZ; }
+
+    if ( phiCut )
+    {
+      G4double safePhi = ( (py[i]*cosC - px[i]*sinC) <= 0 )
+                       ? -(px[i]*sinS - py[i]*cosS)
+                       : (px[i]*sinE - py[i]*cosE);
+      if ( safePhi < safe )  { safe = safePhi; }
+    }
+    safety[i] = (safe < 0) ? 0 : safe;
+  }
+}
+
+// The intersections with the cones involve many cases of points within
+// tolerance of the surfaces; the batched methods resolve in a first
+// loop the configurations which dominate navigation queries, exactly as
+// the scalar methods do, and mark the other points with a negative
+// value, to be computed with the scalar methods:
+// - DistanceToIn(p,v): points heading away from the z extent, entering
+//   through a z plane, or whose forward ray never comes within the
+//   largest outer radius of the z axis
+// - DistanceToOut(p,v): points on a z plane and heading out of it
+
+void G4Cons::DistanceToInBatch(const G4ThreeVectorSoA& p,
+                               const G4ThreeVectorSoA& v,
+                               G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double dz = fDz;
+  const G4bool phiCut = !fPhiFullCone;
+  const G4double cosC = cosCPhi, sinC = sinCPhi, cosHDIT = cosHDPhiIT;
+
+  // Tolerant radii squared at the z planes, as in DistanceToIn(p,v)
+  //
+  const G4double tanRMin = (fRmin2 - fRmin1)*0.5/fDz;
+  const G4double secRMin = std::sqrt(1.0 + tanRMin*tanRMin);
+  G4double tolIRMin2[2], tolIRMax2[2];
+  const G4double rmin[2] = { fRmin1, fRmin2 }, rmax[2] = { fRmax1, fRmax2 };
+  for (G4int k=0; k<2; ++k)
+  {
+    G4double tolORMin = rmin[k] - halfRadTolerance*secRMin;
+    G4double tolIRMin = rmin[k] + halfRadTolerance*secRMin;
+    G4double tolIRMax = rmax[k] - halfRadTolerance*secRMin;
+    tolIRMin2[k] = (tolORMin > 0) ? tolIRMin*tolIRMin : 0.0;
+    tolIRMax2[k] = (tolIRMax > 0) ? tolIRMax*tolIRMax : 0.0;
+  }
+  const G4double tolIDz = fDz - halfCarTolerance;
+
+  // Envelope of the outer cone, enlarged to cover the tolerance and the
+  // rounding of the distance of closest approach
+  //
+  const G4double rEnv = (1. + 1.e-6)*std::max(fRmax1, fRmax2) + kCarTolerance;
+  const G4double rEnv2 = rEnv*rEnv;
+
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    const G4double x = px[i], y = py[i], z = pz[i];
+    const G4double dx = vx[i], dy = vy[i], dzv = vz[i];
+    const G4double az = std::fabs(z);
+
+    // Z planes
+    //
+    G4bool atZ = (az >= tolIDz);
+    G4bool towardsZ = (z*dzv < 0);
+    G4int k = (dzv > 0) ? 0 : 1;
+    G4double sdZ = (az - dz)/(towardsZ ? std::fabs(dzv) : 1.);
+    if (sdZ < 0.0)  { sdZ = 0.0; }
+    G4double xiZ = x + sdZ*dx;
+    G4double yiZ = y + sdZ*dy;
+    G4double rho2Z = xiZ*xiZ + yiZ*yiZ;
+    G4double cosPsiZ =
+      (xiZ*cosC + yiZ*sinC)/std::sqrt((rho2Z != 0.0) ? rho2Z : 1.);
+    G4bool hitZ = atZ && towardsZ && (tolIRMin2[k] <= rho2Z)
+               && (rho2Z <= tolIRMax2[k])
+               && (!phiCut || (rho2Z == 0.0) || (cosPsiZ >= cosHDIT));
+
+    // Closest approach of the forward ray to the z axis
+    //
+    G4double t1 = 1.0 - dzv*dzv;
+    G4double t2 = x*dx + y*dy;
+    G4double t3 = x*x + y*y;
+    G4double rho2Min = ((t1 > 0) && (t2 < 0)) ? t3 - t2*t2/t1 : t3;
+
+    G4double d = (rho2Min > rEnv2) ? kInfinity : -1.;
+    if (hitZ)              { d = sdZ; }
+    if (atZ && !towardsZ)  { d = kInfinity; }
+    dist[i] = d;
+  }
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (dist[i] < 0) { dist[i] = G4Cons::DistanceToIn(p.Get(i), v.Get(i)); }
+  }
+}
+
+void G4Cons::DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                                const G4ThreeVectorSoA& v,
+                                G4double* dist) const
+{
+  const G4double* pz = p.Z();
+  const G4double* vz = v.Z();
+  const G4double dz = fDz, halfTol = halfCarTolerance;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double pdist = (vz[i] > 0) ? dz - pz[i] : dz + pz[i];
+    dist[i] = ((vz[i] != 0.0) && !(pdist > halfTol)) ? 0.0 : -1.;
+  }
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (dist[i] < 0) { dist[i] = G4Cons::DistanceToOut(p.Get(i), v.Get(i)); }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // GetEntityType
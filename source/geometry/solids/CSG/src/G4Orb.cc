@@ -33,6 +33,7 @@
 #if !defined(G4GEOM_USE_UORB)
 
 #include "G4TwoVector.hh"
+#include "G4ThreeVectorSoA.hh"
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
 #include "G4GeometryTolerance.hh"
@@ -393,6 +394,123 @@ G4double G4Orb::DistanceToOut( const G4ThreeVector& p ) const
   return (dist > 0) ? dist : 0.;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Batched methods
+// - same algorithms as the scalar methods, written without early returns
+//   and with the orb parameters held in local variables, so that the
+//   loops can be vectorised by the compiler
+
+void G4Orb::InsideBatch(const G4ThreeVectorSoA& p, EInside* result) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double rrPlusTol = sqrRmaxPlusTol, rrMinusTol = sqrRmaxMinusTol;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rr = px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+    result[i] = (rr > rrPlusTol) ? kOutside :
+      ((rr > rrMinusTol) ? kSurface : kInside);
+  }
+}
+
+void G4Orb::DistanceToInBatch(const G4ThreeVectorSoA& p,
+                              const G4ThreeVectorSoA& v,
+                              G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double rmax = fRmax, rrMinusTol = sqrRmaxMinusTol;
+  const G4double tol = halfRmaxTol, Dmax = 32*fRmax;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rr = px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+    G4double pv = px[i]*vx[i] + py[i]*vy[i] + pz[i]*vz[i];
+    G4bool away = (rr >= rrMinusTol && pv >= 0);
+
+    G4double D  = pv*pv - rr + rmax*rmax;
+    G4double sqrtD = std::sqrt((D < 0) ? 0. : D);
+    G4double d = -pv - sqrtD;
+
+    // Long distances are marked with a negative value and recomputed
+    // below with the scalar method, to preserve its precision handling
+    //
+    dist[i] = (away || D < 0) ? kInfinity :
+      ((d > Dmax) ? -1. :
+      ((sqrtD*2 <= tol) ? kInfinity : ((d < tol) ? 0. : d)));
+  }
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (dist[i] < 0) { dist[i] = G4Orb::DistanceToIn(p.Get(i), v.Get(i)); }
+  }
+}
+
+void G4Orb::SafetyToInBatch(const G4ThreeVectorSoA& p,
+                            G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double rmax = fRmax;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double dist =
+      std::sqrt(px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i]) - rmax;
+    safety[i] = (dist > 0) ? dist : 0.;
+  }
+}
+
+void G4Orb::DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                               const G4ThreeVectorSoA& v,
+                               G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double rmax = fRmax, rrMinusTol = sqrRmaxMinusTol;
+  const G4double tol = halfRmaxTol;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rr = px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+    G4double pv = px[i]*vx[i] + py[i]*vy[i] + pz[i]*vz[i];
+    G4bool away = (rr >= rrMinusTol && pv > 0);
+
+    G4double D  = pv*pv - rr + rmax*rmax;
+    G4double tmax = (D <= 0) ? 0. : std::sqrt((D <= 0) ? 0. : D) - pv;
+    if (tmax < tol) tmax = 0.;
+
+    dist[i] = (away) ? 0. : tmax;
+  }
+}
+
+void G4Orb::SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                             G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double rmax = fRmax;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double dist =
+      rmax - std::sqrt(px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i]);
+    safety[i] = (dist > 0) ? dist : 0.;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // G4EntityType
@@ -35,6 +35,7 @@
 #if !defined(G4GEOM_USE_UTRD)
 
 #include "G4GeomTools.hh"
+#include "G4ThreeVectorSoA.hh"
 
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
@@ -668,6 +669,165 @@ G4double G4Trd::DistanceToOut( const G4ThreeVector& p ) const
   return (dist < 0) ? -dist : 0.;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Batched methods
+// - same algorithms as the scalar methods, written without early returns
+//   and with the plane coefficients held in local variables, so that the
+//   loops can be vectorised by the compiler
+
+void G4Trd::InsideBatch(const G4ThreeVectorSoA& p, EInside* result) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double xa = fPlanes[3].a, xc = fPlanes[3].c, xd = fPlanes[3].d;
+  const G4double yb = fPlanes[1].b, yc = fPlanes[1].c, yd = fPlanes[1].d;
+  const G4double dz = fDz, tol = halfCarTolerance;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double distx = xa*std::abs(px[i]) + xc*pz[i] + xd;
+    G4double disty = yb*std::abs(py[i]) + yc*pz[i] + yd;
+    G4double dist = std::max(std::abs(pz[i]) - dz, std::max(distx,disty));
+    result[i] = (dist > tol) ? kOutside :
+      ((dist > -tol) ? kSurface : kInside);
+  }
+}
+
+void G4Trd::DistanceToInBatch(const G4ThreeVectorSoA& p,
+                              const G4ThreeVectorSoA& v,
+                              G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double yb = fPlanes[0].b, yc = fPlanes[0].c, yd = fPlanes[0].d;
+  const G4double xa = fPlanes[2].a, xc = fPlanes[2].c, xd = fPlanes[2].d;
+  const G4double dz = fDz, tol = halfCarTolerance;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    // Z intersections
+    //
+    G4bool miss = (std::abs(pz[i]) - dz) >= -tol && pz[i]*vz[i] >= 0;
+    G4double invz = (-vz[i] == 0) ? DBL_MAX : -1./vz[i];
+    G4double sz = (invz < 0) ? dz : -dz;
+    G4double tmin = (pz[i] + sz)*invz;
+    G4double tmax = (pz[i] - sz)*invz;
+
+    // Y and X intersections, pairs of symmetric planes
+    //
+    G4double ya = yb*vy[i], yz = yc*vz[i];
+    G4double yp = yb*py[i], yq = yc*pz[i] + yd;
+    G4double xv = xa*vx[i], xz = xc*vz[i];
+    G4double xp = xa*px[i], xq = xc*pz[i] + xd;
+    const G4double cosa[4] = { yz + ya, yz - ya, xz + xv, xz - xv };
+    const G4double disa[4] = { yq + yp, yq - yp, xq + xp, xq - xp };
+    for (G4int k=0; k<4; ++k)
+    {
+      G4bool out = disa[k] >= -tol;
+      G4bool use = out || cosa[k] > 0;
+      miss = miss || (out && cosa[k] >= 0);
+      G4double tmp = (use && cosa[k] != 0) ? -disa[k]/cosa[k] : 0.;
+      if (out && tmin < tmp) tmin = tmp;
+      if (!out && cosa[k] > 0 && tmax > tmp) tmax = tmp;
+    }
+
+    // Find distance
+    //
+    dist[i] = (miss || tmax <= tmin + tol) ? kInfinity :
+      ((tmin < tol) ? 0. : tmin);
+  }
+}
+
+void G4Trd::SafetyToInBatch(const G4ThreeVectorSoA& p,
+                            G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double xa = fPlanes[3].a, xc = fPlanes[3].c, xd = fPlanes[3].d;
+  const G4double yb = fPlanes[1].b, yc = fPlanes[1].c, yd = fPlanes[1].d;
+  const G4double dz = fDz;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double distx = xa*std::abs(px[i]) + xc*pz[i] + xd;
+    G4double disty = yb*std::abs(py[i]) + yc*pz[i] + yd;
+    G4double dist = std::max(std::abs(pz[i]) - dz, std::max(distx,disty));
+    safety[i] = (dist > 0) ? dist : 0.;
+  }
+}
+
+void G4Trd::DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                               const G4ThreeVectorSoA& v,
+                               G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double y0b = fPlanes[0].b, y0c = fPlanes[0].c, y0d = fPlanes[0].d;
+  const G4double y1b = fPlanes[1].b, y1c = fPlanes[1].c, y1d = fPlanes[1].d;
+  const G4double x2a = fPlanes[2].a, x2c = fPlanes[2].c, x2d = fPlanes[2].d;
+  const G4double x3a = fPlanes[3].a, x3c = fPlanes[3].c, x3d = fPlanes[3].d;
+  const G4double dz = fDz, tol = halfCarTolerance;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    // Z intersections
+    //
+    G4bool away = (std::abs(pz[i]) - dz) >= -tol && pz[i]*vz[i] > 0;
+    G4double tmax = (vz[i] == 0) ? DBL_MAX
+                  : (std::copysign(dz,vz[i]) - pz[i])/vz[i];
+
+    // Y and X intersections
+    //
+    const G4double cosa[4] = { y0b*vy[i] + y0c*vz[i],
+                               y1b*vy[i] + y1c*vz[i],
+                               x2a*vx[i] + x2c*vz[i],
+                               x3a*vx[i] + x3c*vz[i] };
+    const G4double disa[4] = { y0b*py[i] + y0c*pz[i] + y0d,
+                               y1b*py[i] + y1c*pz[i] + y1d,
+                               x2a*px[i] + x2c*pz[i] + x2d,
+                               x3a*px[i] + x3c*pz[i] + x3d };
+    for (G4int k=0; k<4; ++k)
+    {
+      G4bool use = cosa[k] > 0;
+      away = away || (use && disa[k] >= -tol);
+      G4double tmp = (use) ? -disa[k]/cosa[k] : 0.;
+      if (use && tmax > tmp) tmax = tmp;
+    }
+
+    dist[i] = (away) ? 0. : tmax;
+  }
+}
+
+void G4Trd::SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                             G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double xa = fPlanes[3].a, xc = fPlanes[3].c, xd = fPlanes[3].d;
+  const G4double yb = fPlanes[1].b, yc = fPlanes[1].c, yd = fPlanes[1].d;
+  const G4double dz = fDz;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double distx = xa*std::abs(px[i]) + xc*pz[i] + xd;
+    G4double disty = yb*std::abs(py[i]) + yc*pz[i] + yd;
+    G4double dist = std::max(std::abs(pz[i]) - dz, std::max(distx,disty));
+    safety[i] = (dist < 0) ? -dist : 0.;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // GetEntityType
@@ -37,6 +37,7 @@
 #if !defined(G4GEOM_USE_UTUBS)
 
 #include "G4GeomTools.hh"
+#include "G4ThreeVectorSoA.hh"
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
 #include "G4GeometryTolerance.hh"
@@ -1603,6 +1604,448 @@ G4double G4Tubs::DistanceToOut( const G4ThreeVector& p ) const
   return safe ;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Batched methods
+// - same algorithms as the scalar methods, written without early returns
+//   and with the tube parameters held in local variables, so that the
+//   loops can be vectorised by the compiler. Inside() is batched only
+//   for tubes with full phi section
+
+void G4Tubs::InsideBatch(const G4ThreeVectorSoA& p, EInside* result) const
+{
+  if ( !fPhiFullTube )
+  {
+    G4VSolid::InsideBatch(p, result);
+    return;
+  }
+
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+
+  // Inner and outer tolerant limits in z and r^2
+  //
+  const G4double zIn  = fDz - halfCarTolerance;
+  const G4double zOut = fDz + halfCarTolerance;
+  G4double tolRMin = (fRMin != 0.0) ? fRMin + halfRadTolerance : 0.;
+  G4double tolRMax = fRMax - halfRadTolerance;
+  const G4double r2MinIn = tolRMin*tolRMin, r2MaxIn = tolRMax*tolRMax;
+  tolRMin = fRMin - halfRadTolerance;
+  tolRMax = fRMax + halfRadTolerance;
+  if ( tolRMin < 0 )  { tolRMin = 0; }
+  const G4double r2MinOut = tolRMin*tolRMin, r2MaxOut = tolRMax*tolRMax;
+
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double az = std::fabs(pz[i]);
+    G4double r2 = px[i]*px[i] + py[i]*py[i];
+    G4bool inR  = (r2 >= r2MinIn) && (r2 <= r2MaxIn);
+    G4bool onR  = (r2 >= r2MinOut) && (r2 <= r2MaxOut);
+    result[i] = (az <= zIn) ? (inR ? kInside : (onR ? kSurface : kOutside))
+              : ((az <= zOut && onR) ? kSurface : kOutside);
+  }
+}
+
+void G4Tubs::SafetyToInBatch(const G4ThreeVectorSoA& p,
+                             G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double rmin = fRMin, rmax = fRMax, dz = fDz;
+  const G4bool phiCut = !fPhiFullTube;
+  const G4double cosC = cosCPhi, sinC = sinCPhi, cosHD = cosHDPhi;
+  const G4double cosS = cosSPhi, sinS = sinSPhi;
+  const G4double cosE = cosEPhi, sinE = sinEPhi;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rho   = std::sqrt(px[i]*px[i] + py[i]*py[i]);
+    G4double safe1 = rmin - rho;
+    G4double safe2 = rho - rmax;
+    G4double safe3 = std::fabs(pz[i]) - dz;
+    G4double safe  = (safe1 > safe2) ? safe1 : safe2;
+    if ( safe3 > safe )  { safe = safe3; }
+
+    if ( phiCut )
+    {
+      // Psi=angle from central phi to point, distance to the closest
+      // phi plane if the point lies outside the phi range
+      //
+      G4double cosPsi = (px[i]*cosC + py[i]*sinC)/((rho != 0.0) ? rho : 1.);
+      G4double safePhi = ( (py[i]*cosC - px[i]*sinC) <= 0 )
+                       ? std::fabs(px[i]*sinS - py[i]*cosS)
+                       : std::fabs(px[i]*sinE - py[i]*cosE);
+      if ( (rho != 0.0) && (cosPsi < cosHD) && (safePhi > safe) )
+      {
+        safe = safePhi;
+      }
+    }
+    safety[i] = (safe < 0) ? 0 : safe;
+  }
+}
+
+void G4Tubs::SafetyToOutBatch(const G4ThreeVectorSoA& p,
+                              G4double* safety) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double rmin = fRMin, rmax = fRMax, dz = fDz;
+  const G4bool hasRMin = (fRMin != 0.0), phiCut = !fPhiFullTube;
+  const G4double cosC = cosCPhi, sinC = sinCPhi;
+  const G4double cosS = cosSPhi, sinS = sinSPhi;
+  const G4double cosE = cosEPhi, sinE = sinEPhi;
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    G4double rho = std::sqrt(px[i]*px[i] + py[i]*py[i]);
+    G4double safeR1 = rho - rmin;
+    G4double safeR2 = rmax - rho;
+    G4double safe = (!hasRMin) ? safeR2 : ((safeR1 < safeR2) ? safeR1 : safeR2);
+    G4double safeZ = dz - std::fabs(pz[i]);
+    if ( safeZ < safe )  { safe = safeZ; }
+
+    if ( phiCut )
+    {
+      G4double safePhi = ( py[i]*cosC - px[i]*sinC <= 0 )
+                       ? -(px[i]*sinS - py[i]*cosS)
+                       : (px[i]*sinE - py[i]*cosE);
+      if ( safePhi < safe )  { safe = safePhi; }
+    }
+    safety[i] = (safe < 0) ? 0 : safe;
+  }
+}
+
+// Same algorithm as DistanceToIn(p,v): the candidate intersections with
+// the z planes, the outer and inner radii and the phi planes are
+// evaluated for every point and selected in the order in which the
+// scalar method returns them. Distances longer than 100*fRMax, which the
+// scalar method refines recursively, are marked with a negative value
+// and recomputed with the scalar method
+
+void G4Tubs::DistanceToInBatch(const G4ThreeVectorSoA& p,
+                               const G4ThreeVectorSoA& v,
+                               G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double rmin = fRMin, rmax = fRMax, dz = fDz;
+  const G4bool hasRMin = (fRMin != 0.0), phiCut = !fPhiFullTube;
+  const G4double dRmax = 100.*fRMax, halfTol = halfCarTolerance;
+  const G4double cosC = cosCPhi, sinC = sinCPhi, cosHDIT = cosHDPhiIT;
+  const G4double cosS = cosSPhi, sinS = sinSPhi;
+  const G4double cosE = cosEPhi, sinE = sinEPhi;
+  const G4double invRmin = fInvRmin;
+
+  // Tolerant radii squared and z extent, as in DistanceToIn(p,v)
+  //
+  G4double tolORMin2 = 0., tolIRMin2 = 0.;
+  if (fRMin > kRadTolerance)
+  {
+    tolORMin2 = (fRMin - halfRadTolerance)*(fRMin - halfRadTolerance);
+    tolIRMin2 = (fRMin + halfRadTolerance)*(fRMin + halfRadTolerance);
+  }
+  const G4double tolORMax2 = (fRMax + halfRadTolerance)*(fRMax + halfRadTolerance);
+  const G4double tolIRMax2 = (fRMax - halfRadTolerance)*(fRMax - halfRadTolerance);
+  const G4double tolIDz = fDz - halfCarTolerance;
+  const G4double tolODz = fDz + halfCarTolerance;
+
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    const G4double x = px[i], y = py[i], z = pz[i];
+    const G4double dx = vx[i], dy = vy[i], dzv = vz[i];
+    const G4double az = std::fabs(z);
+
+    // Z planes: heading away from the z extent, or entering through
+    // a z plane at valid radius and phi
+    //
+    G4bool atZ = (az >= tolIDz);
+    G4bool towardsZ = (z*dzv < 0);
+    G4bool awayZ = atZ && !towardsZ;
+    G4double sdZ = (az - dz)/(towardsZ ? std::fabs(dzv) : 1.);
+    if (sdZ < 0.0)  { sdZ = 0.0; }
+    G4double xiZ = x + sdZ*dx;
+    G4double yiZ = y + sdZ*dy;
+    G4double rho2Z = xiZ*xiZ + yiZ*yiZ;
+    G4double cosPsiZ =
+      (xiZ*cosC + yiZ*sinC)/std::sqrt((rho2Z != 0.0) ? rho2Z : 1.);
+    G4bool hitZ = atZ && towardsZ && (tolIRMin2 <= rho2Z)
+               && (rho2Z <= tolIRMax2)
+               && (!phiCut || (rho2Z == 0.0) || (cosPsiZ >= cosHDIT));
+
+    // Radial intersections, for directions not parallel to z
+    //
+    G4double t1 = 1.0 - dzv*dzv;
+    G4double t2 = x*dx + y*dy;
+    G4double t3 = x*x + y*y;
+    G4bool radial = (t1 > 0);
+    G4double t1s = radial ? t1 : 1.;
+    G4double b = t2/t1s;
+    G4double c = t3 - rmax*rmax;
+
+    // From outside the outer radius: intersection with rmax
+    //
+    G4bool outside = (t3 >= tolORMax2) && (t2 < 0);
+    G4double cO = c/t1s;
+    G4double dO = b*b - cO;
+    G4double denO = -b + std::sqrt((dO >= 0) ? dO : 0.);
+    G4double sdO = cO/((denO != 0.0) ? denO : 1.);
+    G4bool validO = radial && outside && (dO >= 0) && (sdO >= 0);
+    G4bool longO = validO && (sdO > dRmax);
+    G4double xiO = x + sdO*dx;
+    G4double yiO = y + sdO*dy;
+    G4double cosPsiO = (xiO*cosC + yiO*sinC)/rmax;
+    G4bool hitO = validO && (std::fabs(z + sdO*dzv) <= tolODz)
+               && (!phiCut || (cosPsiO >= cosHDIT));
+
+    // Inside both radii and the z extent, heading inwards: distance to
+    // the outer radius if outside its tolerance, else zero
+    //
+    G4double cosPsiP =
+      (x*cosC + y*sinC)/std::sqrt((t3 > 0.0) ? t3 : 1.);
+    G4bool within = radial && !outside && (t3 > tolIRMin2) && (t2 < 0)
+                 && (az <= tolIDz) && (!phiCut || (cosPsiP >= cosHDIT));
+    G4double sdW = (sdO < halfTol) ? 0 : sdO;
+    G4double distW = (c <= 0.0) ? 0.0 : ((dO >= 0.0) ? sdW : kInfinity);
+
+    // Inner radius, farthest root
+    //
+    G4double cR = (t3 - rmin*rmin)/t1s;
+    G4double dR = b*b - cR;
+    G4double sqrtDR = std::sqrt((dR >= 0.0) ? dR : 0.);
+    G4double denR = -b - sqrtDR;
+    G4double sdR = (b > 0.) ? cR/((denR != 0.0) ? denR : 1.) : (-b + sqrtDR);
+    G4bool validR = radial && hasRMin && (dR >= 0.0) && (sdR >= -halfTol);
+    if (sdR < 0.0)  { sdR = 0.0; }
+    G4bool longR = validR && (sdR > dRmax);
+    G4double xiR = x + sdR*dx;
+    G4double yiR = y + sdR*dy;
+    G4bool hitR = validR && (std::fabs(z + sdR*dzv) <= tolODz)
+               && (!phiCut || ((xiR*cosC + yiR*sinC)*invRmin >= cosHDIT));
+
+    // Phi planes, only closer than the inner radius intersection
+    //
+    G4double snxt = (phiCut && hitR) ? sdR : kInfinity;
+    if (phiCut)
+    {
+      G4double compS = dx*sinS - dy*cosS;
+      G4double distS = y*cosS - x*sinS;
+      G4double sdS = distS/((compS < 0) ? compS : -1.);
+      G4bool candS = (compS < 0) && (distS < halfTol) && (sdS < snxt);
+      if (sdS < 0)  { sdS = 0.0; }
+      G4double xiS = x + sdS*dx;
+      G4double yiS = y + sdS*dy;
+      G4double rho2S = xiS*xiS + yiS*yiS;
+      G4bool rS = ((rho2S >= tolIRMin2) && (rho2S <= tolIRMax2))
+        || ((rho2S > tolORMin2) && (rho2S < tolIRMin2)
+         && (dy*cosS - dx*sinS > 0) && (dx*cosS + dy*sinS >= 0))
+        || ((rho2S > tolIRMax2) && (rho2S < tolORMax2)
+         && (dy*cosS - dx*sinS > 0) && (dx*cosS + dy*sinS < 0));
+      if (candS && (std::fabs(z + sdS*dzv) <= tolODz) && rS
+       && ((yiS*cosC - xiS*sinC) <= halfTol))
+      {
+        snxt = sdS;
+      }
+
+      G4double compE = -(dx*sinE - dy*cosE);
+      G4double distE = -(y*cosE - x*sinE);
+      G4double sdE = distE/((compE < 0) ? compE : -1.);
+      G4bool candE = (compE < 0) && (distE < halfTol) && (sdE < snxt);
+      if (sdE < 0)  { sdE = 0; }
+      G4double xiE = x + sdE*dx;
+      G4double yiE = y + sdE*dy;
+      G4double rho2E = xiE*xiE + yiE*yiE;
+      G4bool rE = ((rho2E >= tolIRMin2) && (rho2E <= tolIRMax2))
+        || ((rho2E > tolORMin2) && (rho2E < tolIRMin2)
+         && (dx*sinE - dy*cosE > 0) && (dx*cosE + dy*sinE >= 0))
+        || ((rho2E > tolIRMax2) && (rho2E < tolORMax2)
+         && (dx*sinE - dy*cosE > 0) && (dx*cosE + dy*sinE < 0));
+      if (candE && (std::fabs(z + sdE*dzv) <= tolODz) && rE
+       && ((yiE*cosC - xiE*sinC) >= 0))
+      {
+        snxt = sdE;
+      }
+    }
+    if (snxt < halfTol)  { snxt = 0; }
+
+    // Select the result in the order of the scalar method
+    //
+    G4double d = snxt;
+    if (!phiCut && hitR)  { d = sdR; }
+    if (longR)            { d = -1.; }
+    if (within)           { d = distW; }
+    if (hitO)             { d = sdO; }
+    if (longO)            { d = -1.; }
+    if (hitZ)             { d = sdZ; }
+    if (awayZ)            { d = kInfinity; }
+    dist[i] = d;
+  }
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (dist[i] < 0) { dist[i] = G4Tubs::DistanceToIn(p.Get(i), v.Get(i)); }
+  }
+}
+
+// Same algorithm as DistanceToOut(p,v) without computation of the
+// normal: the exit distances through the z planes, the radii and the
+// phi planes are evaluated for every point and the smallest is kept,
+// unless the point is leaving immediately
+
+void G4Tubs::DistanceToOutBatch(const G4ThreeVectorSoA& p,
+                                const G4ThreeVectorSoA& v,
+                                G4double* dist) const
+{
+  const G4double* px = p.X();
+  const G4double* py = p.Y();
+  const G4double* pz = p.Z();
+  const G4double* vx = v.X();
+  const G4double* vy = v.Y();
+  const G4double* vz = v.Z();
+  const G4double rmin = fRMin, rmax = fRMax, dz = fDz;
+  const G4bool hasRMin = (fRMin != 0.0), phiCut = !fPhiFullTube;
+  const G4double halfTol = halfCarTolerance, radTol = kRadTolerance;
+  const G4double roiMax2 = fRMax*(fRMax + kRadTolerance);
+  const G4double roMin2Lim = fRMin*(fRMin - kRadTolerance);
+  const G4double longZ = 10*(fDz+fRMax);
+  const G4double cosC = cosCPhi, sinC = sinCPhi;
+  const G4double cosS = cosSPhi, sinS = sinSPhi;
+  const G4double cosE = cosEPhi, sinE = sinEPhi;
+  const G4double phiMin = fSPhi - halfAngTolerance;
+  const G4double phiMax = fSPhi + fDPhi + halfAngTolerance;
+  const G4bool smallPhi = (fDPhi <= pi);
+
+  std::size_t n = p.Size();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    const G4double x = px[i], y = py[i], z = pz[i];
+    const G4double dx = vx[i], dy = vy[i], dzv = vz[i];
+
+    // Z planes
+    //
+    G4double pdist = (dzv > 0) ? dz - z : dz + z;
+    G4double vzs = (dzv != 0.0) ? dzv : 1.;
+    G4bool leaveZ = (dzv != 0.0) && !(pdist > halfTol);
+    G4double snxt = (dzv > 0) ? pdist/vzs
+                  : ((dzv < 0) ? -pdist/vzs : kInfinity);
+
+    // Radial intersections
+    //
+    G4double t1 = 1.0 - dzv*dzv;
+    G4double t2 = x*dx + y*dy;
+    G4double t3 = x*x + y*y;
+    G4bool radial = (t1 > 0);
+    G4double t1s = radial ? t1 : 1.;
+    G4double sz = (snxt > longZ) ? 0. : snxt;
+    G4double roi2 = (snxt > longZ) ? 2*rmax*rmax : sz*sz*t1 + 2*sz*t2 + t3;
+    G4double b = t2/t1s;
+
+    G4double deltaRMax = t3 - rmax*rmax;
+    G4double cMax = deltaRMax/t1s;
+    G4double dMax = b*b - cMax;
+    G4double sqrtDMax = std::sqrt((dMax >= 0) ? dMax : 0.);
+    G4double denMax = -b - sqrtDMax;
+    G4double srdOut = (dMax >= 0) ? cMax/((denMax != 0.0) ? denMax : 1.) : 0.;
+    G4double srdMax = -b + sqrtDMax;
+
+    G4double deltaRMin = t3 - rmin*rmin;
+    G4double cMin = deltaRMin/t1s;
+    G4double dMin = b*b - cMin;
+    G4double denMin = -b + std::sqrt((dMin >= 0) ? dMin : 0.);
+    G4double srdMin = cMin/((denMin != 0.0) ? denMin : 1.);
+    G4double roMin2 = t3 - t2*t2/t1s;
+
+    // Leaving outwards through rmax, or inwards through rmin or rmax
+    //
+    G4bool outwards = (t2 >= 0.0) && (roi2 > roiMax2);
+    G4bool inwards = !outwards && (t2 < 0.);
+    G4bool viaRMin = inwards && hasRMin && (roMin2 < roMin2Lim);
+    G4bool viaRMax = inwards && !viaRMin && (roi2 > roiMax2);
+
+    G4double srd = kInfinity;
+    G4bool leaveR = false;
+    if (outwards)
+    {
+      leaveR = !(deltaRMax < -radTol*rmax);
+      srd = srdOut;
+    }
+    if (viaRMin)
+    {
+      leaveR = (dMin >= 0) ? !(deltaRMin > radTol*rmin) : !(dMax >= 0.);
+      srd = (dMin >= 0) ? srdMin : srdMax;
+    }
+    if (viaRMax)
+    {
+      leaveR = !(dMax >= 0);
+      srd = srdMax;
+    }
+
+    // Phi planes
+    //
+    G4double sphi = kInfinity;
+    if (phiCut)
+    {
+      G4double vphi = std::atan2(dy, dx);
+      if ( vphi < phiMin )       { vphi += twopi; }
+      else if ( vphi > phiMax )  { vphi -= twopi; }
+      G4bool inRange = (phiMin <= vphi) && (vphi <= phiMax);
+
+      G4double pDistS = x*sinS - y*cosS;
+      G4double pDistE = -x*sinE + y*cosE;
+      G4double compS = -sinS*dx + cosS*dy;
+      G4double compE = sinE*dx - cosE*dy;
+      G4bool insidePhi = smallPhi
+        ? ((pDistS <= halfTol) && (pDistE <= halfTol))
+        : ((pDistS <= halfTol) || (pDistE <= halfTol));
+
+      G4double sphiS = pDistS/((compS < 0) ? compS : -1.);
+      G4double xiS = x + sphiS*dx;
+      G4double yiS = y + sphiS*dy;
+      G4bool onAxisS = (std::fabs(xiS) <= kCarTolerance)
+                    && (std::fabs(yiS) <= kCarTolerance);
+      G4double sS = kInfinity;
+      if ((compS < 0) && (sphiS >= -halfTol))
+      {
+        sS = onAxisS ? (inRange ? kInfinity : sphiS)
+           : (((yiS*cosC - xiS*sinC) >= 0) ? kInfinity
+           : ((pDistS > -halfTol) ? 0.0 : sphiS));
+      }
+
+      G4double sphiE = pDistE/((compE < 0) ? compE : -1.);
+      G4double xiE = x + sphiE*dx;
+      G4double yiE = y + sphiE*dy;
+      G4bool onAxisE = (std::fabs(xiE) <= kCarTolerance)
+                    && (std::fabs(yiE) <= kCarTolerance);
+      G4double sE = (pDistE <= -halfTol) ? sphiE : 0.0;
+      G4bool leaveE = (compE < 0) && (sphiE > -halfTol) && (sphiE < sS)
+        && (onAxisE ? !inRange : ((yiE*cosC - xiE*sinC) >= 0));
+
+      sphi = insidePhi ? (leaveE ? sE : sS) : kInfinity;
+      if ((x == 0.0) && (y == 0.0))
+      {
+        sphi = inRange ? kInfinity : 0.0;
+      }
+    }
+
+    G4double d = snxt;
+    if (radial)
+    {
+      if (sphi < d)  { d = sphi; }
+      if (srd < d)   { d = srd; }
+      if (leaveR)    { d = 0.0; }
+    }
+    if (leaveZ)  { d = 0.0; }
+    dist[i] = (d < halfTol) ? 0 : d;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // Stream object contents to an output stream
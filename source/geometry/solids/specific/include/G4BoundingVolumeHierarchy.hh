@@ -0,0 +1,150 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4BoundingVolumeHierarchy
+//
+// Class description:
+//
+// Bounding volume hierarchy (BVH) of axis-aligned boxes, alternative to
+// the regular voxel grid of G4Voxelizer for G4TessellatedSolid and
+// G4MultiUnion. It is better suited to highly non-uniform distributions
+// of facets or constituent solids, for which the grid either degrades
+// to a few crowded voxels or requires a very large number of them.
+// The tree is built top-down with a binned surface area heuristic (SAH)
+// and stored depth-first in a compact array of 32-byte nodes, whose
+// bounds are kept in single precision, rounded outwards. The left child
+// of an internal node immediately follows its parent. Queries traverse
+// the tree with a small fixed-size stack, front-to-back along rays and
+// nearest-first for distances.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4BOUNDINGVOLUMEHIERARCHY_HH
+#define G4BOUNDINGVOLUMEHIERARCHY_HH 1
+
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "G4SurfBits.hh"
+#include "G4Voxelizer.hh"
+
+class G4BoundingVolumeHierarchy
+{
+  public:
+
+    G4BoundingVolumeHierarchy() = default;
+   ~G4BoundingVolumeHierarchy() = default;
+
+    void Build(const std::vector<G4VoxelBox>& boxes);
+      // Build the hierarchy for the given boxes (half lengths and
+      // positions, as computed by G4Voxelizer). Box indices are the
+      // indices returned by the queries.
+    void Clear();
+      // Release the hierarchy.
+
+    inline G4bool IsEmpty() const;
+    inline G4int GetNumberOfNodes() const;
+    inline G4int GetNumberOfBoxes() const;
+    G4int AllocatedMemory() const;
+
+    G4bool Contains(const G4ThreeVector& point) const;
+      // Whether the point is within the bounding box of all the boxes.
+    G4double DistanceToBoundingBox(const G4ThreeVector& point) const;
+      // Distance from the point to the bounding box of all the boxes,
+      // zero if inside.
+
+    G4int GetCandidates(const G4ThreeVector& point,
+                        std::vector<G4int>& list,
+                        const G4SurfBits* excluded = nullptr) const;
+      // Fill list, in increasing order, with the indices of the boxes held
+      // by the leaves whose bounds contain the point, skipping those
+      // flagged in excluded. Returns the number of candidates.
+
+    template <class Visitor>
+    inline void TraverseRay(const G4ThreeVector& point,
+                            const G4ThreeVector& direction,
+                            G4double tmin, G4double& tmax,
+                            Visitor&& visit) const;
+      // Visit, approximately front-to-back, the boxes intersected by the
+      // segment [tmin,tmax] of the ray. The visitor is called as
+      // visit(index, tmax) and may reduce tmax, pruning further boxes;
+      // it returns false to stop the traversal.
+
+    template <class Visitor>
+    inline void TraverseNearest(const G4ThreeVector& point,
+                                G4double& maxDistance,
+                                Visitor&& visit) const;
+      // Visit, approximately nearest-first, the boxes whose distance from
+      // the point is not greater than maxDistance. The visitor is called
+      // as visit(index, maxDistance) and may reduce maxDistance, pruning
+      // further boxes; it returns false to stop the traversal.
+
+  private:
+
+    struct G4BVHNode
+    {
+      G4float fMin[3], fMax[3];
+      G4int fFirst;   // first index (leaf) or right child (internal node)
+      G4int fCount;   // number of boxes (leaf), 0 for internal nodes
+    };
+
+    struct G4BVHBounds
+    {
+      G4double fMin[3] = { kInfinity,  kInfinity,  kInfinity};
+      G4double fMax[3] = {-kInfinity, -kInfinity, -kInfinity};
+      inline void Extend(const G4double pmin[3], const G4double pmax[3]);
+      inline G4double Area() const;
+    };
+
+    G4int BuildNode(G4int begin, G4int end, G4int depth);
+      // Build recursively the node for the boxes fIndices[begin,end),
+      // returning its index.
+
+    inline G4bool IntersectNode(const G4BVHNode& node,
+                                const G4double p[3], const G4double inv[3],
+                                const G4bool parallel[3],
+                                G4double tmin, G4double tmax,
+                                G4double& tnear) const;
+    inline G4double DistanceToNode(const G4BVHNode& node,
+                                   const G4double p[3]) const;
+
+  private:
+
+    static const G4int kMaxDepth = 48;
+    static const G4int kMaxLeafSize = 8;
+    static const G4int kNumberOfBins = 16;
+
+    std::vector<G4BVHNode> fNodes;
+    std::vector<G4int> fIndices;
+
+    // Work space used only during the build
+    //
+    std::vector<G4double> fBoxMin, fBoxMax, fCentroids;
+};
+
+#include "G4BoundingVolumeHierarchy.icc"
+
+#endif
@@ -107,6 +107,7 @@
 #include "G4Types.hh"
 #include "G4VSolid.hh"
 #include "G4Voxelizer.hh"
+#include "G4BoundingVolumeHierarchy.hh"
 #include "G4VFacet.hh"
 
 struct G4VertexInfo
@@ -184,6 +185,12 @@ class G4TessellatedSolid : public G4VSolid
 
     inline G4Voxelizer& GetVoxels();
 
+    void SetUseBVH(G4bool flag);
+    inline G4bool GetUseBVH() const;
+      // Select a bounding volume hierarchy instead of the voxel grid to
+      // speed up the queries (off by default). Must be set before the
+      // solid is closed.
+
     G4bool CalculateExtent(const EAxis pAxis,
                            const G4VoxelLimits& pVoxelLimit,
                            const G4AffineTransform& pTransform,
@@ -232,6 +239,14 @@ class G4TessellatedSolid : public G4VSolid
 
     EInside InsideNoVoxels (const G4ThreeVector& p) const;
     EInside InsideVoxels(const G4ThreeVector& aPoint) const;
+    EInside InsideBVH(const G4ThreeVector& aPoint) const;
+
+    G4double DistanceToInBVH(const G4ThreeVector& aPoint,
+                             const G4ThreeVector& aDirection) const;
+    G4double DistanceToOutBVH(const G4ThreeVector& aPoint,
+                              const G4ThreeVector& aDirection,
+                                    G4ThreeVector& aNormalVector,
+                                    G4bool& aConvex) const;
 
     void Voxelize();
 
@@ -295,6 +310,9 @@ class G4TessellatedSolid : public G4VSolid
 
     G4Voxelizer fVoxels;  // Pointer to the voxelized solid
 
+    G4BoundingVolumeHierarchy fBVH;  // Alternative to voxels, if requested
+    G4bool fUseBVH = false;
+
     G4SurfBits fInsides;
 };
 
@@ -317,6 +335,11 @@ inline G4Voxelizer &G4TessellatedSolid::GetVoxels()
   return fVoxels;
 }
 
+inline G4bool G4TessellatedSolid::GetUseBVH() const
+{
+  return fUseBVH;
+}
+
 inline G4bool G4TessellatedSolid::OutsideOfExtent(const G4ThreeVector& p,
                                                   G4double tolerance) const
 {
@@ -70,6 +70,13 @@ class G4Voxelizer
                   std::vector<G4Transform3D>& transforms);
     void Voxelize(std::vector<G4VFacet*>& facets);
 
+    void BuildBoxes(std::vector<G4VSolid*>& solids,
+                    std::vector<G4Transform3D>& transforms);
+    void BuildBoxes(std::vector<G4VFacet*>& facets);
+      // Compute only the bounding boxes of the nodes, without building
+      // the voxel structure; used when the nodes are instead organised
+      // in a bounding volume hierarchy.
+
     void DisplayVoxelLimits() const;
     void DisplayBoundaries();
     void DisplayListNodes() const;
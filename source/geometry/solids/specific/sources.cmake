@@ -3,6 +3,8 @@
 # Define the Geant4 Module.
 geant4_add_module(G4specsolids
   PUBLIC_HEADERS
+    G4BoundingVolumeHierarchy.hh
+    G4BoundingVolumeHierarchy.icc
     G4ClippablePolygon.hh
     G4ClippablePolygon.icc
     G4Ellipsoid.hh
@@ -75,6 +77,7 @@ geant4_add_module(G4specsolids
     G4VTwistSurface.icc
     G4VTwistedFaceted.hh
   SOURCES
+    G4BoundingVolumeHierarchy.cc
     G4ClippablePolygon.cc
     G4Ellipsoid.cc
     G4EllipticalCone.cc
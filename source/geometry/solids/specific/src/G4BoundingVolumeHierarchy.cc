@@ -0,0 +1,303 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4BoundingVolumeHierarchy implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include <cfloat>
+#include <numeric>
+
+#include "G4BoundingVolumeHierarchy.hh"
+
+namespace
+{
+  // Conversion to single precision, rounding outwards
+  //
+  inline G4float RoundDown(G4double x)
+  {
+    auto f = (G4float)x;
+    return ((G4double)f > x) ? std::nextafter(f, -FLT_MAX) : f;
+  }
+  inline G4float RoundUp(G4double x)
+  {
+    auto f = (G4float)x;
+    return ((G4double)f < x) ? std::nextafter(f, FLT_MAX) : f;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Build
+
+void G4BoundingVolumeHierarchy::Build(const std::vector<G4VoxelBox>& boxes)
+{
+  Clear();
+  auto nBoxes = (G4int)boxes.size();
+  if (nBoxes == 0) return;
+
+  fBoxMin.resize(3*nBoxes);
+  fBoxMax.resize(3*nBoxes);
+  fCentroids.resize(3*nBoxes);
+  for (G4int i=0; i<nBoxes; ++i)
+  {
+    for (G4int k=0; k<3; ++k)
+    {
+      fBoxMin[3*i+k] = boxes[i].pos[k] - boxes[i].hlen[k];
+      fBoxMax[3*i+k] = boxes[i].pos[k] + boxes[i].hlen[k];
+      fCentroids[3*i+k] = boxes[i].pos[k];
+    }
+  }
+  fIndices.resize(nBoxes);
+  std::iota(fIndices.begin(), fIndices.end(), 0);
+
+  fNodes.reserve(2*(nBoxes/2 + 1));
+  BuildNode(0, nBoxes, 0);
+  fNodes.shrink_to_fit();
+
+  std::vector<G4double>().swap(fBoxMin);
+  std::vector<G4double>().swap(fBoxMax);
+  std::vector<G4double>().swap(fCentroids);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// BuildNode
+//
+// Binned SAH: the centroids are distributed in kNumberOfBins bins along
+// each axis and the plane between bins minimising the cost
+// A(left)*N(left) + A(right)*N(right) is selected. A leaf is created if
+// splitting, including the cost of visiting the node taken as the cost
+// of testing one box, is not cheaper than testing all the boxes, unless
+// the node holds more than kMaxLeafSize boxes.
+
+G4int G4BoundingVolumeHierarchy::BuildNode(G4int begin, G4int end,
+                                           G4int depth)
+{
+  auto nodeIndex = (G4int)fNodes.size();
+  fNodes.emplace_back();
+
+  G4BVHBounds bounds, centroidBounds;
+  for (G4int i=begin; i<end; ++i)
+  {
+    G4int b = fIndices[i];
+    bounds.Extend(&fBoxMin[3*b], &fBoxMax[3*b]);
+    centroidBounds.Extend(&fCentroids[3*b], &fCentroids[3*b]);
+  }
+  for (G4int k=0; k<3; ++k)
+  {
+    fNodes[nodeIndex].fMin[k] = RoundDown(bounds.fMin[k]);
+    fNodes[nodeIndex].fMax[k] = RoundUp(bounds.fMax[k]);
+  }
+
+  G4int count = end - begin;
+  auto makeLeaf = [&]()
+  {
+    fNodes[nodeIndex].fFirst = begin;
+    fNodes[nodeIndex].fCount = count;
+    return nodeIndex;
+  };
+  if (count == 1 || depth >= kMaxDepth) return makeLeaf();
+
+  // Find the best split
+  //
+  G4int bestAxis = -1, bestBin = 0;
+  G4double bestCost = kInfinity;
+  for (G4int k=0; k<3; ++k)
+  {
+    G4double cmin = centroidBounds.fMin[k];
+    G4double extent = centroidBounds.fMax[k] - cmin;
+    if (extent <= 0) continue;
+    G4double scale = kNumberOfBins/extent;
+
+    G4BVHBounds binBounds[kNumberOfBins];
+    G4int binCount[kNumberOfBins] = {0};
+    for (G4int i=begin; i<end; ++i)
+    {
+      G4int b = fIndices[i];
+      auto bin = std::min((G4int)((fCentroids[3*b+k] - cmin)*scale),
+                          kNumberOfBins-1);
+      ++binCount[bin];
+      binBounds[bin].Extend(&fBoxMin[3*b], &fBoxMax[3*b]);
+    }
+
+    // Sweep from the right to accumulate the costs of the right sides
+    //
+    G4double rightCost[kNumberOfBins];
+    G4BVHBounds acc;
+    G4int n = 0;
+    for (G4int bin=kNumberOfBins-1; bin>0; --bin)
+    {
+      acc.Extend(binBounds[bin].fMin, binBounds[bin].fMax);
+      n += binCount[bin];
+      rightCost[bin] = n*acc.Area();
+    }
+    acc = G4BVHBounds();
+    n = 0;
+    for (G4int bin=0; bin<kNumberOfBins-1; ++bin)
+    {
+      acc.Extend(binBounds[bin].fMin, binBounds[bin].fMax);
+      n += binCount[bin];
+      if (n == 0 || n == count) continue;
+      G4double cost = n*acc.Area() + rightCost[bin+1];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestAxis = k;
+        bestBin = bin;
+      }
+    }
+  }
+
+  G4int middle;
+  if (bestAxis < 0)
+  {
+    // All the centroids coincide: split in two halves, if needed
+    //
+    if (count <= kMaxLeafSize) return makeLeaf();
+    middle = begin + count/2;
+  }
+  else
+  {
+    G4double area = bounds.Area();
+    if (count <= kMaxLeafSize && bestCost + area >= count*area)
+    {
+      return makeLeaf();
+    }
+    G4double cmin = centroidBounds.fMin[bestAxis];
+    G4double scale = kNumberOfBins/(centroidBounds.fMax[bestAxis] - cmin);
+    auto it = std::partition(fIndices.begin()+begin, fIndices.begin()+end,
+      [&](G4int b)
+      {
+        auto bin = std::min((G4int)((fCentroids[3*b+bestAxis]-cmin)*scale),
+                            kNumberOfBins-1);
+        return bin <= bestBin;
+      });
+    middle = G4int(it - fIndices.begin());
+  }
+
+  BuildNode(begin, middle, depth+1);
+  G4int right = BuildNode(middle, end, depth+1);
+  fNodes[nodeIndex].fFirst = right;
+  fNodes[nodeIndex].fCount = 0;
+  return nodeIndex;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Clear
+
+void G4BoundingVolumeHierarchy::Clear()
+{
+  std::vector<G4BVHNode>().swap(fNodes);
+  std::vector<G4int>().swap(fIndices);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// AllocatedMemory
+
+G4int G4BoundingVolumeHierarchy::AllocatedMemory() const
+{
+  std::size_t size = sizeof(*this);
+  size += fNodes.capacity()*sizeof(G4BVHNode);
+  size += fIndices.capacity()*sizeof(G4int);
+  return (G4int)size;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Contains
+
+G4bool G4BoundingVolumeHierarchy::Contains(const G4ThreeVector& point) const
+{
+  if (fNodes.empty()) return false;
+  const G4BVHNode& root = fNodes[0];
+  for (G4int k=0; k<3; ++k)
+  {
+    if (point[k] < root.fMin[k] || point[k] > root.fMax[k]) return false;
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// DistanceToBoundingBox
+
+G4double
+G4BoundingVolumeHierarchy::DistanceToBoundingBox(const G4ThreeVector& p) const
+{
+  if (fNodes.empty()) return kInfinity;
+  const G4double point[3] = { p.x(), p.y(), p.z() };
+  return DistanceToNode(fNodes[0], point);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// GetCandidates
+
+G4int G4BoundingVolumeHierarchy::GetCandidates(const G4ThreeVector& point,
+                                               std::vector<G4int>& list,
+                                         const G4SurfBits* excluded) const
+{
+  list.clear();
+  if (fNodes.empty()) return 0;
+
+  const G4double p[3] = { point.x(), point.y(), point.z() };
+  auto inside = [&p](const G4BVHNode& node)
+  {
+    return p[0] >= node.fMin[0] && p[0] <= node.fMax[0]
+        && p[1] >= node.fMin[1] && p[1] <= node.fMax[1]
+        && p[2] >= node.fMin[2] && p[2] <= node.fMax[2];
+  };
+  if (!inside(fNodes[0])) return 0;
+
+  G4int stack[kMaxDepth+1];
+  G4int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const G4BVHNode& node = fNodes[stack[--top]];
+    if (node.fCount == 0)
+    {
+      G4int left = G4int(&node - fNodes.data()) + 1;
+      if (inside(fNodes[node.fFirst])) stack[top++] = node.fFirst;
+      if (inside(fNodes[left])) stack[top++] = left;
+      continue;
+    }
+    for (G4int i=node.fFirst; i<node.fFirst+node.fCount; ++i)
+    {
+      // Leaves are tested against their bounds only: the boxes of a leaf
+      // are few and the final selection is done by the caller
+      //
+      G4int b = fIndices[i];
+      if (excluded != nullptr && excluded->TestBitNumber(b)) continue;
+      list.push_back(b);
+    }
+  }
+  std::sort(list.begin(), list.end());
+  return (G4int)list.size();
+}
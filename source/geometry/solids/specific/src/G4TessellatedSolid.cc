@@ -188,6 +188,7 @@ void G4TessellatedSolid::CopyObjects (const G4TessellatedSolid &ts)
     fVoxels.SetMaxVoxels(reductionRatio);
   else
     fVoxels.SetMaxVoxels(fmaxVoxels);
+  fUseBVH = ts.GetUseBVH();
 
   G4int n = ts.GetNumberOfFacets();
   for (G4int i = 0; i < n; ++i)
@@ -366,6 +367,16 @@ void G4TessellatedSolid::Voxelize ()
 #ifdef G4SPECSDEBUG
   G4cout << "Voxelizing..." << G4endl;
 #endif
+  fBVH.Clear();
+  if (fUseBVH)
+  {
+    // Only the bounding boxes of the facets are needed for the hierarchy
+    //
+    G4Voxelizer boxes;
+    boxes.BuildBoxes(fFacets);
+    fBVH.Build(boxes.GetBoxes());
+    return;
+  }
   fVoxels.Voxelize(fFacets);
 
   if (fVoxels.Empty().GetNbits() != 0u)
@@ -646,6 +657,27 @@ void G4TessellatedSolid::SetSolidClosed (const G4bool t)
   fSolidClosed = t;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// SetUseBVH
+//
+// Select the bounding volume hierarchy as acceleration structure; it is
+// built when the solid is closed.
+//
+void G4TessellatedSolid::SetUseBVH (G4bool flag)
+{
+  if (fSolidClosed)
+  {
+    std::ostringstream message;
+    message << "Solid " << GetName() << " is already closed!" << G4endl
+            << "          The acceleration structure cannot be changed.";
+    G4Exception("G4TessellatedSolid::SetUseBVH()",
+                "GeomSolids1001", JustWarning, message);
+    return;
+  }
+  fUseBVH = flag;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // GetSolidClosed
@@ -947,6 +979,105 @@ EInside G4TessellatedSolid::InsideVoxels(const G4ThreeVector& p) const
   return location;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Same algorithm as InsideNoVoxels(), only facets whose bounding boxes
+// contain the point or are crossed by the rays are tested.
+//
+EInside G4TessellatedSolid::InsideBVH (const G4ThreeVector& p) const
+{
+  if (OutsideOfExtent(p, kCarTolerance))
+    return kOutside;
+
+  const G4double dirTolerance = 1.0E-14;
+
+  //
+  // Check if we are close to a surface
+  //
+  vector<G4int> candidates;
+  G4double minDist = kInfinity;
+  fBVH.GetCandidates(p, candidates);
+  for (auto candidate : candidates)
+  {
+    G4double dist = fFacets[candidate]->Distance(p,minDist);
+    if (dist < minDist) minDist = dist;
+    if (dist <= kCarToleranceHalf)
+    {
+      return kSurface;
+    }
+  }
+
+  G4double distOut = kInfinity;
+  G4double distIn  = kInfinity;
+  G4bool nearParallel = false;
+  EInside location = kOutside;
+  G4int sm = 0;
+
+  do    // Loop checking, 13.08.2015, G.Cosmo
+  {
+    distOut = distIn = kInfinity;
+    const G4ThreeVector& v = fRandir[sm];
+    ++sm;
+    nearParallel = false;
+
+    // Crossings farther than the nearest one found so far cannot change
+    // the result and are pruned
+    //
+    G4double maxDist = kInfinity;
+    fBVH.TraverseRay(p, v, 0., maxDist, [&](G4int candidate, G4double& tmax)
+    {
+      G4VFacet& facet = *fFacets[candidate];
+      G4double distO, distI, distFromSurfaceO, distFromSurfaceI;
+      G4ThreeVector normalO, normalI;
+      G4bool crossingO
+        = facet.Intersect(p,v,true,distO,distFromSurfaceO,normalO);
+      G4bool crossingI
+        = facet.Intersect(p,v,false,distI,distFromSurfaceI,normalI);
+      if (crossingO || crossingI)
+      {
+        nearParallel = (crossingO && std::fabs(normalO.dot(v))<dirTolerance)
+                    || (crossingI && std::fabs(normalI.dot(v))<dirTolerance);
+        if (nearParallel) return false;
+
+        if (crossingO && distO > 0.0 && distO < distOut) distOut = distO;
+        if (crossingI && distI > 0.0 && distI < distIn)  distIn  = distI;
+        tmax = std::min(distOut, distIn) + kCarTolerance;
+      }
+      return true;
+    });
+  }
+  while (nearParallel && sm != fMaxTries);
+
+#ifdef G4VERBOSE
+  if (sm == fMaxTries)
+  {
+    std::ostringstream message;
+    G4long oldprc = message.precision(16);
+    message << "Cannot determine whether point is inside or outside volume!"
+      << G4endl
+      << "Solid name       = " << GetName()  << G4endl
+      << "Geometry Type    = " << fGeometryType  << G4endl
+      << "Number of facets = " << fFacets.size() << G4endl
+      << "Position:"  << G4endl << G4endl
+      << "p.x() = "   << p.x()/mm << " mm" << G4endl
+      << "p.y() = "   << p.y()/mm << " mm" << G4endl
+      << "p.z() = "   << p.z()/mm << " mm";
+    message.precision(oldprc);
+    G4Exception("G4TessellatedSolid::Inside()",
+                "GeomSolids1002", JustWarning, message);
+  }
+#endif
+
+  if (distIn == kInfinity && distOut == kInfinity)
+    location = kOutside;
+  else if (distIn <= distOut - kCarToleranceHalf)
+    location = kOutside;
+  else if (distOut <= distIn - kCarToleranceHalf)
+    location = kInside;
+
+  return location;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 EInside G4TessellatedSolid::InsideNoVoxels (const G4ThreeVector &p) const
@@ -1099,11 +1230,19 @@ G4int G4TessellatedSolid::GetFacetIndex (const G4ThreeVector& p) const
 {
   G4int index = -1;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty() || fVoxels.GetCountOfVoxels() > 1)
   {
-    vector<G4int> curVoxel(3);
-    fVoxels.GetVoxel(curVoxel, p);
-    const vector<G4int> &candidates = fVoxels.GetCandidates(curVoxel);
+    vector<G4int> curVoxel(3), bvhCandidates;
+    if (!fBVH.IsEmpty())
+    {
+      fBVH.GetCandidates(p, bvhCandidates);
+    }
+    else
+    {
+      fVoxels.GetVoxel(curVoxel, p);
+    }
+    const vector<G4int> &candidates = fBVH.IsEmpty()
+      ? fVoxels.GetCandidates(curVoxel) : bvhCandidates;
     if (auto limit = (G4int)candidates.size())
     {
       G4double minDist = kInfinity;
@@ -1150,11 +1289,19 @@ G4bool G4TessellatedSolid::Normal (const G4ThreeVector& p,
   G4double minDist;
   G4VFacet* facet = nullptr;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty() || fVoxels.GetCountOfVoxels() > 1)
   {
-    vector<G4int> curVoxel(3);
-    fVoxels.GetVoxel(curVoxel, p);
-    const vector<G4int> &candidates = fVoxels.GetCandidates(curVoxel);
+    vector<G4int> curVoxel(3), bvhCandidates;
+    if (!fBVH.IsEmpty())
+    {
+      fBVH.GetCandidates(p, bvhCandidates);
+    }
+    else
+    {
+      fVoxels.GetVoxel(curVoxel, p);
+    }
+    const vector<G4int> &candidates = fBVH.IsEmpty()
+      ? fVoxels.GetCandidates(curVoxel) : bvhCandidates;
     // fVoxels.GetCandidatesVoxelArray(p, candidates, 0);
 
     if (auto limit = (G4int)candidates.size())
@@ -1408,7 +1555,11 @@ G4TessellatedSolid::DistanceToOutCore(const G4ThreeVector& aPoint,
 {
   G4double minDistance;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    minDistance = DistanceToOutBVH(aPoint, aDirection, aNormalVector, aConvex);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     minDistance = kInfinity;
 
@@ -1470,6 +1621,72 @@ G4TessellatedSolid::DistanceToOutCore(const G4ThreeVector& aPoint,
   return minDistance;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Same as DistanceToOutCandidates(), for the facets whose bounding boxes
+// are crossed by the ray, visited approximately in order of distance.
+//
+G4double
+G4TessellatedSolid::DistanceToOutBVH(const G4ThreeVector& aPoint,
+                                     const G4ThreeVector& aDirection,
+                                           G4ThreeVector& aNormalVector,
+                                           G4bool& aConvex) const
+{
+  if (OutsideOfExtent(aPoint, kCarTolerance))
+  {
+    aConvex = false;
+    return 0.;
+  }
+
+  G4ThreeVector direction = aDirection.unit();
+  G4double minDistance = kInfinity;
+  G4int minCandidate = -1;
+
+  G4double maxDist = kInfinity;
+  fBVH.TraverseRay(aPoint, direction, -kCarTolerance, maxDist,
+                   [&](G4int candidate, G4double& tmax)
+  {
+    G4VFacet& facet = *fFacets[candidate];
+    G4double dist, distFromSurface;
+    G4ThreeVector normal;
+    if (facet.Intersect(aPoint,direction,true,dist,distFromSurface,normal))
+    {
+      if (distFromSurface > 0.0 && distFromSurface <= kCarToleranceHalf
+       && facet.Distance(aPoint,kCarTolerance) <= kCarToleranceHalf)
+      {
+        // We are on a surface
+        //
+        minDistance = 0.0;
+        aNormalVector = normal;
+        minCandidate = candidate;
+        return false;
+      }
+      if (dist >= 0.0 && dist < minDistance)
+      {
+        minDistance = dist;
+        aNormalVector = normal;
+        minCandidate = candidate;
+        tmax = dist;
+      }
+    }
+    return true;
+  });
+
+  if (minCandidate < 0)
+  {
+    // No intersection found
+    minDistance = 0.;
+    aConvex = false;
+    Normal(aPoint, aNormalVector);
+  }
+  else
+  {
+    aConvex = (fExtremeFacets.find(fFacets[minCandidate])
+            != fExtremeFacets.end());
+  }
+  return minDistance;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 G4double G4TessellatedSolid::
@@ -1518,6 +1735,52 @@ DistanceToInCandidates(const std::vector<G4int>& candidates,
   return minDistance;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Same as DistanceToInCandidates(), for the facets whose bounding boxes
+// are crossed by the ray, visited approximately in order of distance.
+//
+G4double
+G4TessellatedSolid::DistanceToInBVH(const G4ThreeVector& aPoint,
+                                    const G4ThreeVector& aDirection) const
+{
+  G4ThreeVector direction = aDirection.unit();
+  G4double minDistance = kInfinity;
+
+  G4double maxDist = kInfinity;
+  fBVH.TraverseRay(aPoint, direction, -kCarTolerance, maxDist,
+                   [&](G4int candidate, G4double& tmax)
+  {
+    G4VFacet& facet = *fFacets[candidate];
+    G4double dist, distFromSurface;
+    G4ThreeVector normal;
+    if (facet.Intersect(aPoint,direction,false,dist,distFromSurface,normal))
+    {
+      if ( (distFromSurface > kCarToleranceHalf)
+        && (dist >= 0.0) && (dist < minDistance))
+      {
+        minDistance  = dist;
+      }
+      else
+      {
+        if (-kCarToleranceHalf <= dist && dist <= kCarToleranceHalf)
+        {
+          minDistance = 0.0;
+          return false;
+        }
+        else if  (distFromSurface > -kCarToleranceHalf
+               && distFromSurface <  kCarToleranceHalf)
+        {
+          minDistance = dist;
+        }
+      }
+      if (minDistance < tmax) tmax = std::max(minDistance, 0.);
+    }
+    return true;
+  });
+  return minDistance;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 G4double
@@ -1527,7 +1790,11 @@ G4TessellatedSolid::DistanceToInCore(const G4ThreeVector& aPoint,
 {
   G4double minDistance;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    minDistance = DistanceToInBVH(aPoint, aDirection);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     minDistance = kInfinity;
     G4ThreeVector currentPoint = aPoint;
@@ -1590,6 +1857,23 @@ G4TessellatedSolid::MinDistanceFacet(const G4ThreeVector& p,
 {
   G4double minDist = kInfinity;
 
+  if (!fBVH.IsEmpty())
+  {
+    fBVH.TraverseNearest(p, minDist, [&](G4int candidate, G4double& maxDist)
+    {
+      G4VFacet& facet = *fFacets[candidate];
+      G4double dist = simple ? facet.Distance(p,maxDist)
+                             : facet.Distance(p,maxDist,false);
+      if (dist < maxDist)
+      {
+        maxDist  = dist;
+        minFacet = &facet;
+      }
+      return true;
+    });
+    return minDist;
+  }
+
   G4int size = fVoxels.GetVoxelBoxesSize();
   vector<pair<G4int, G4double> > voxelsSorted(size);
 
@@ -1657,7 +1941,15 @@ G4double G4TessellatedSolid::SafetyFromOutside (const G4ThreeVector& p,
 
   G4double minDist;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    if (!aAccurate)
+      return fBVH.DistanceToBoundingBox(p);
+
+    G4VFacet* facet;
+    minDist = MinDistanceFacet(p, true, facet);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     if (!aAccurate)
       return fVoxels.DistanceToBoundingBox(p);
@@ -1717,7 +2009,7 @@ G4TessellatedSolid::SafetyFromInside (const G4ThreeVector& p, G4bool) const
 
   if (OutsideOfExtent(p, kCarTolerance)) return 0.0;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty() || fVoxels.GetCountOfVoxels() > 1)
   {
     G4VFacet* facet;
     minDist = MinDistanceFacet(p, true, facet);
@@ -1801,7 +2093,11 @@ EInside G4TessellatedSolid::Inside (const G4ThreeVector& aPoint) const
 {
   EInside location;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    location = InsideBVH(aPoint);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     location = InsideVoxels(aPoint);
   }
@@ -2249,6 +2545,7 @@ G4int G4TessellatedSolid::AllocatedMemory()
   G4int size = AllocatedMemoryWithoutVoxels();
   G4int sizeInsides = fInsides.GetNbytes();
   G4int sizeVoxels = fVoxels.AllocatedMemory();
+  if (!fBVH.IsEmpty()) sizeVoxels += fBVH.AllocatedMemory();
   size += sizeInsides + sizeVoxels;
   return size;
 }
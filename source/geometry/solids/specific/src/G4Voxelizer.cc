@@ -717,6 +717,23 @@ void G4Voxelizer::Voxelize(std::vector<G4VSolid*>& solids,
   }
 }
 
+//______________________________________________________________________________
+void G4Voxelizer::BuildBoxes(std::vector<G4VSolid*>& solids,
+                             std::vector<G4Transform3D>& transforms)
+{
+  fCountOfVoxels = 0;
+  for (auto & fBoundary : fBoundaries) { fBoundary.clear(); }
+  BuildVoxelLimits(solids, transforms);
+}
+
+//______________________________________________________________________________
+void G4Voxelizer::BuildBoxes(std::vector<G4VFacet*>& facets)
+{
+  fCountOfVoxels = 0;
+  for (auto & fBoundary : fBoundaries) { fBoundary.clear(); }
+  BuildVoxelLimits(facets);
+}
+
 //______________________________________________________________________________
 void G4Voxelizer::CreateMiniVoxels(std::vector<G4double> boundaries[],
                                    G4SurfBits bitmasks[])
@@ -82,6 +82,9 @@ class G4Allocator : public G4AllocatorBase
   // Returns the current size of a page
   inline void IncreasePageSize(unsigned int sz) override;
   // Resets allocator and increases default page size of a given factor
+  inline void Reserve(std::size_t n);
+  // Pre-allocates storage for n elements in a single page, without
+  // resetting the allocator; objects already allocated are not affected
 
   inline const char* GetPoolType() const override;
   // Returns the type_info Id of the allocated type in the pool
@@ -262,6 +265,16 @@ void G4Allocator<Type>::IncreasePageSize(unsigned int sz)
   mem.GrowPageSize(sz);
 }
 
+// ************************************************************
+// Reserve
+// ************************************************************
+//
+template <class Type>
+void G4Allocator<Type>::Reserve(std::size_t n)
+{
+  mem.Reserve(n);
+}
+
 // ************************************************************
 // GetPoolType
 // ************************************************************
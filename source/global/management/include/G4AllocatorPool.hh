@@ -41,6 +41,8 @@
 #ifndef G4AllocatorPool_hh
 #define G4AllocatorPool_hh 1
 
+#include <cstddef>
+
 class G4AllocatorPool
 {
  public:
@@ -70,6 +72,11 @@ class G4AllocatorPool
   // Accessor for default page size
   inline void GrowPageSize(unsigned int factor);
   // Increase default page size by a given factor
+  void Reserve(std::size_t n);
+  // Allocate a single page of n elements and add them to the free
+  // store, so that the next n allocations do not grow the pool.
+  // A page is limited to the range of unsigned int: larger requests
+  // are ignored, with a warning
 
  private:
   struct G4PoolLink
@@ -94,6 +101,8 @@ class G4AllocatorPool
 
   void Grow();
   // Make pool larger
+  void AddChunk(unsigned int sz);
+  // Allocate a page of sz bytes and link its elements to the free store
 
  private:
   const unsigned int esize;
@@ -101,6 +110,7 @@ class G4AllocatorPool
   G4PoolChunk* chunks = nullptr;
   G4PoolLink* head    = nullptr;
   int nchunks         = 0;
+  unsigned int nbytes = 0;
 };
 
 // ------------------------------------------------------------
@@ -137,7 +147,7 @@ inline void G4AllocatorPool::Free(void* b)
 // Size
 // ************************************************************
 //
-inline unsigned int G4AllocatorPool::Size() const { return nchunks * csize; }
+inline unsigned int G4AllocatorPool::Size() const { return nbytes; }
 
 // ************************************************************
 // GetNoPages
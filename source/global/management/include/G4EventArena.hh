@@ -0,0 +1,240 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventArena
+//
+// Class description:
+//
+// Monotonic allocator for objects whose lifetime is bounded by the one
+// of an event, e.g. the hits, digits or trajectory points of user
+// classes. Objects are placed one after the other in pages taken from
+// the thread-local G4EventArenaPool and are never freed one by one:
+// Release() gives all the pages of the arena back to the pool in O(1).
+// The arena keeps the pool it takes its pages from, the one of the
+// thread of its first allocation, and returns them there also when it is
+// released by another thread, e.g. for an event deleted by the master.
+//
+// Each G4Event owns an arena, released when the event is deleted, which
+// G4EventManager makes the current arena of the thread while the event
+// is processed. G4EventArenaAllocator<Type> is a drop-in replacement of
+// G4Allocator<Type> taking the memory from the current arena:
+//
+//   extern G4ThreadLocal G4EventArenaAllocator<MyHit>* MyHitAllocator;
+//
+//   inline void* MyHit::operator new(std::size_t)
+//   {
+//     if (MyHitAllocator == nullptr) {
+//       MyHitAllocator = new G4EventArenaAllocator<MyHit>;
+//     }
+//     return (void*)MyHitAllocator->MallocSingle();
+//   }
+//   inline void MyHit::operator delete(void* hit)
+//   {
+//     MyHitAllocator->FreeSingle((MyHit*)hit);
+//   }
+//
+// Destructors are still invoked by delete, but the memory is recovered
+// only with the release of the arena: objects must not outlive their
+// event, nor be moved to another event (e.g. when merging sub-events),
+// and short-lived objects recycled many times within an event (tracks)
+// should keep using G4Allocator. Objects created outside of the event
+// processing go to a default arena of the thread, which is released
+// only by G4EventArenaPool::ResetStorage().
+//
+// The pool is registered in G4AllocatorList, which reports the memory
+// held by the pages of the thread and deletes the pool.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4EventArena_hh
+#define G4EventArena_hh 1
+
+#include <cstddef>
+#include <cstdint>
+
+#include "G4Allocator.hh"
+#include "G4Threading.hh"
+#include "G4Types.hh"
+
+class G4EventArenaPool;
+
+class G4EventArena
+{
+ public:
+  G4EventArena() = default;
+  ~G4EventArena();
+  // Destructor; releases the pages of the arena
+
+  G4EventArena(const G4EventArena&) = delete;
+  G4EventArena& operator=(const G4EventArena&) = delete;
+
+  inline void* Allocate(std::size_t size,
+                        std::size_t align = alignof(std::max_align_t));
+  // Returns size bytes aligned to align, a power of two
+
+  void Release();
+  // Gives all pages back to the pool they were taken from; objects
+  // allocated in the arena must have been destroyed
+
+  inline std::size_t GetUsedSize() const;
+  // Returns the number of bytes allocated since the last release
+  inline std::size_t GetAllocatedSize() const;
+  // Returns the size of the pages held by the arena
+  inline G4int GetNoPages() const;
+  // Returns the number of pages held by the arena
+  inline G4EventArenaPool* GetPool() const;
+  // Returns the pool of the pages held, null if none
+
+  static G4EventArena* GetCurrentArena();
+  static G4EventArena* SetCurrentArena(G4EventArena* arena);
+  // Accessors of the current arena of the thread, the previous one is
+  // returned by SetCurrentArena()
+
+  struct Page
+  {
+    Page* next;
+    std::size_t size;
+    // followed by the data, starting at offset PageHeaderSize()
+  };
+
+  static constexpr std::size_t PageHeaderSize()
+  {
+    return (sizeof(Page) + alignof(std::max_align_t) - 1)
+           & ~(alignof(std::max_align_t) - 1);
+  }
+
+ private:
+  void* AllocateInNewPage(std::size_t size, std::size_t align);
+
+  G4EventArenaPool* fPool = nullptr;
+  Page* fFirstPage = nullptr;
+  Page* fLastPage = nullptr;
+  char* fCursor = nullptr;
+  char* fEnd = nullptr;
+  std::size_t fUsedSize = 0;
+  std::size_t fAllocatedSize = 0;
+  G4int fNPages = 0;
+};
+
+class G4EventArenaPool : public G4AllocatorBase
+{
+ public:
+  static G4EventArenaPool* GetInstance();
+  // Returns the pool of the thread, created at the first call
+  ~G4EventArenaPool() override;
+
+  G4EventArena::Page* GetPage(std::size_t minSize);
+  // Returns a free page of at least minSize bytes, header included
+  void PutPages(G4EventArena::Page* first, G4EventArena::Page* last);
+  // Returns a list of pages to the free store in O(1); may be called
+  // from any thread
+
+  inline G4EventArena* GetDefaultArena();
+  // Arena used outside of the event processing
+
+  void ResetStorage() override;
+  // Releases the default arena and frees the pages of the free store;
+  // pages held by the arenas of the events are not affected
+  std::size_t GetAllocatedSize() const override;
+  // Returns the size of all pages of the thread, free or in use
+  int GetNoPages() const override;
+  G4int GetNoFreePages() const;
+  // Returns the number of pages in the free store
+  std::size_t GetPageSize() const override;
+  void IncreasePageSize(unsigned int sz) override;
+  // Multiplies by sz the size of the new pages
+  const char* GetPoolType() const override;
+
+ private:
+  G4EventArenaPool() = default;
+
+  static G4ThreadLocal G4EventArenaPool* fInstance;
+
+  mutable G4Mutex fMutex;
+  // Protects the free store and the counters, as pages may be returned
+  // by other threads
+  G4EventArena::Page* fFreePages = nullptr;
+  std::size_t fPageSize = 65536;
+  std::size_t fTotalSize = 0;
+  G4int fNPages = 0;
+  G4int fNFreePages = 0;
+  G4EventArena fDefaultArena;
+};
+
+template <class Type>
+class G4EventArenaAllocator
+{
+ public:
+  static inline Type* MallocSingle();
+  static inline void FreeSingle(Type*) {}
+  // Malloc and Free methods to be used when overloading new and delete
+  // operators in the client <Type> object, as with G4Allocator
+};
+
+// ------------------------------------------------------------
+// Inline implementation
+// ------------------------------------------------------------
+
+inline void* G4EventArena::Allocate(std::size_t size, std::size_t align)
+{
+  auto pos = reinterpret_cast<std::uintptr_t>(fCursor);
+  pos = (pos + align - 1) & ~std::uintptr_t(align - 1);
+  if(fCursor == nullptr || pos + size > reinterpret_cast<std::uintptr_t>(fEnd))
+  {
+    return AllocateInNewPage(size, align);
+  }
+  fCursor = reinterpret_cast<char*>(pos + size);
+  fUsedSize += size;
+  return reinterpret_cast<void*>(pos);
+}
+
+inline std::size_t G4EventArena::GetUsedSize() const { return fUsedSize; }
+
+inline std::size_t G4EventArena::GetAllocatedSize() const
+{
+  return fAllocatedSize;
+}
+
+inline G4int G4EventArena::GetNoPages() const { return fNPages; }
+
+inline G4EventArenaPool* G4EventArena::GetPool() const { return fPool; }
+
+inline G4EventArena* G4EventArenaPool::GetDefaultArena()
+{
+  return &fDefaultArena;
+}
+
+template <class Type>
+inline Type* G4EventArenaAllocator<Type>::MallocSingle()
+{
+  G4EventArena* arena = G4EventArena::GetCurrentArena();
+  if(arena == nullptr)
+  {
+    arena = G4EventArenaPool::GetInstance()->GetDefaultArena();
+  }
+  return static_cast<Type*>(arena->Allocate(sizeof(Type), alignof(Type)));
+}
+
+#endif
@@ -37,6 +37,8 @@
 // function, in order to avoid reallocation during insertions.
 // G4PhysicsTable has a vector of Boolean which are used
 // as 'recalc-needed' flags when processes calculate physics tables.
+// If a G4PhysicsTableImage is recorded or mapped, the tables are also
+// stored in or retrieved from the image.
 
 // Author: G.Cosmo, 2 December 1995
 //         First implementation based on object model
@@ -113,6 +115,7 @@ class G4PhysicsTable : public std::vector<G4PhysicsVector*>
   // Get/Clear the flag for the 'i-th' physics vector
 
   friend std::ostream& operator<<(std::ostream& out, G4PhysicsTable& table);
+  friend class G4PhysicsTableImage;
 
  protected:
   G4PhysicsVector* CreatePhysicsVector(G4int type, G4bool spline);
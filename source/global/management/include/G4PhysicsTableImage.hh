@@ -0,0 +1,120 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4PhysicsTableImage
+//
+// Class description:
+//
+// Single file image of the physics tables of a job, in a binary and
+// versioned format which is mapped read-only in memory. The vectors of a
+// table retrieved from a mapped image are views of the interpolation
+// nodes of the image, so that the pages are shared by all the processes
+// of a node mapping the same file and no data are parsed at start-up.
+//
+// While recording, each table written by G4PhysicsTable::StorePhysicsTable()
+// is added to the image, under the name of its file without directory;
+// once mapped, G4PhysicsTable::RetrievePhysicsTable() and
+// ExistPhysicsTable() look up the image before the file system.
+//
+// Layout of the file, all offsets are counted from the start of the file
+// and the records are aligned to 64 bytes:
+//   header      - magic, version, endianness tag, number of tables,
+//                 offset of the directory, size of the file
+//   table       - number of vectors and offsets of the vector records
+//   vector      - type, spline flag, binning parameters, offsets of the
+//                 nodes (G4PhysicsVectorNode) and of the log-search scale
+//   directory   - name and offset of each table
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4PhysicsTableImage_hh
+#define G4PhysicsTableImage_hh 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class G4PhysicsTable;
+class G4PhysicsVector;
+
+class G4PhysicsTableImage
+{
+ public:
+  static G4PhysicsTableImage* GetInstance();
+
+  G4PhysicsTableImage(const G4PhysicsTableImage&) = delete;
+  G4PhysicsTableImage& operator=(const G4PhysicsTableImage&) = delete;
+
+  // Starts a new image, the tables stored afterwards are added to it
+  void StartRecording();
+  G4bool IsRecording() const { return fRecording; }
+
+  // Adds a copy of the table, replacing a table with the same name
+  void AddTable(const G4String& name, const G4PhysicsTable& table);
+
+  // Writes the recorded image and stops the recording. The file is
+  // replaced atomically, a mapped image of the same name stays valid
+  G4bool Write(const G4String& fileName);
+
+  // Maps the image file read-only, returns false if the file cannot be
+  // opened or is not a valid image of this version and endianness.
+  // The mapping is kept until the end of the job.
+  G4bool Map(const G4String& fileName);
+  G4bool IsMapped() const { return fMapped != nullptr; }
+
+  // Access to the tables of the mapped image
+  G4bool HasTable(const G4String& name) const;
+  G4bool RetrieveTable(const G4String& name, G4PhysicsTable& table,
+                       G4bool spline) const;
+
+  // Name of a table in the image for the given file name
+  static G4String KeyOf(const G4String& fileName);
+
+  // Name of the image file in the physics table directory
+  static const G4String& DefaultFileName();
+
+ private:
+  G4PhysicsTableImage() = default;
+  ~G4PhysicsTableImage() = default;
+
+  std::uint64_t AppendVector(const G4PhysicsVector* vec);
+  std::uint64_t Append(const void* data, std::size_t size);
+  void Align();
+
+  // image being recorded, starting with room for the header
+  std::vector<char> fBuffer;
+  std::map<G4String, std::uint64_t> fRecorded;
+  G4bool fRecording = false;
+
+  // mapped image
+  const char* fMapped = nullptr;
+  std::size_t fMappedSize = 0;
+  G4String fMappedName = "";
+  std::map<G4String, std::uint64_t> fDirectory;
+};
+
+#endif
@@ -32,6 +32,15 @@
 // range of energy, momentum, etc.
 // This class serves as the base class for a vector having various
 // energy scale, for example like 'log', 'linear', 'free', etc.
+// Once filled, the vector may be packed: energy, value and second
+// derivative of each node are then stored interleaved in a single
+// aligned array, which replaces the separate vectors, so that a lookup
+// touches one or two cache lines instead of up to six.
+// A vector retrieved from a mapped G4PhysicsTableImage is a read-only
+// view of the packed nodes of the image, it is copied into its own
+// storage if it is modified.
+// The accessors read the data through strided pointers to the separate
+// vectors, the packed nodes or the mapped nodes, whatever the layout.
 
 // Authors:
 // - 02 Dec. 1995, G.Cosmo: Structure created based on object model
@@ -51,6 +60,16 @@
 #include "G4ios.hh"
 #include "globals.hh"
 
+// Node of the packed layout, two nodes per cache line of 64 bytes
+struct alignas(32) G4PhysicsVectorNode
+{
+  G4double energy = 0.0;
+  G4double value = 0.0;
+  G4double secDerivative = 0.0;
+};
+static_assert(sizeof(G4PhysicsVectorNode) % sizeof(G4double) == 0,
+              "G4PhysicsVectorNode must be an array of doubles");
+
 class G4PhysicsVector
 {
 public:
@@ -59,8 +78,8 @@ public:
   explicit G4PhysicsVector(G4bool spline = false);
 
   // Copy constructor and assignment operator
-  G4PhysicsVector(const G4PhysicsVector&) = default;
-  G4PhysicsVector& operator=(const G4PhysicsVector&) = default;
+  G4PhysicsVector(const G4PhysicsVector&);
+  G4PhysicsVector& operator=(const G4PhysicsVector&);
 
   // not used operators
   G4PhysicsVector(const G4PhysicsVector&&) = delete;
@@ -165,6 +184,22 @@ public:
                              const G4double dir1 = 0.0,
                              const G4double dir2 = 0.0);
 
+  // Moves the data of the filled vector into the packed layout and
+  // releases the separate vectors. A packed vector stays packed when it
+  // is modified, Retrieve() restores the separate vectors. If the packed
+  // layout is enabled by default, the vector is packed at the end of
+  // FillSecondDerivatives().
+  void Pack();
+  inline G4bool IsPacked() const;
+
+  // True if the data are a view of a mapped G4PhysicsTableImage
+  inline G4bool IsMapped() const;
+
+  // Default for the vectors filled after this call, to be set in
+  // the master thread before the physics tables are built.
+  static void SetPackedLayout(G4bool val);
+  static G4bool GetPackedLayout();
+
   // This method can be applied if both energy and data values 
   // grow monotonically, for example, if in this vector a 
   // cumulative probability density function is stored. 
@@ -176,6 +211,7 @@ public:
 
   // Print vector
   friend std::ostream& operator<<(std::ostream&, const G4PhysicsVector&);
+  friend class G4PhysicsTableImage;
   void DumpValues(G4double unitE = 1.0, G4double unitV = 1.0) const;
 
 protected:
@@ -186,18 +222,40 @@ protected:
   void PrintPutValueError(std::size_t index, G4double value, 
                           const G4String& text);
 
+  // Copies the data of a mapped vector into its own packed nodes,
+  // to be called before any modification of the data
+  void DetachFromImage();
+
+  // Moves packed or mapped data back into the separate vectors, to be
+  // called before the vectors are resized or used directly. Returns
+  // true if the data were packed, Pack() then restores the layout
+  G4bool Unpack();
+
+  // Points the accessors to the packed or mapped nodes if any, to the
+  // separate vectors otherwise; to be called when the storage changes
+  void BindData();
+
 private:
 
+  void CopyData(const G4PhysicsVector& vec);
+
   void ComputeSecDerivative0();
   void ComputeSecDerivative1();
   void ComputeSecDerivative2(const G4double firstPointDerivative,
                              const G4double endPointDerivative);
   // Internal methods for computing of spline coeffitients
 
+  // Value of the data at the given index
+  inline G4double Data(const std::size_t index) const;
+
   // Linear or spline interpolation.
   inline G4double Interpolation(const std::size_t idx,
                                 const G4double energy) const;
 
+  // Index of the first node with data not less than x, data being
+  // one of the strided arrays above
+  inline std::size_t LowerBound(const G4double* data, const G4double x) const;
+
   // Assuming (edgeMin <= energy <= edgeMax).
   inline std::size_t LogBin(const G4double energy, const G4double loge) const;
   inline std::size_t BinaryBin(const G4double energy) const;
@@ -227,9 +285,19 @@ protected:
   std::vector<G4double> dataVector;     // crossection/energyloss
   std::vector<G4double> secDerivative;  // second derivatives
   std::vector<std::size_t> scale;       // log seach
+  std::vector<G4PhysicsVectorNode> packedNodes;  // packed layout
+
+  // nodes of a mapped G4PhysicsTableImage, not owned
+  const G4PhysicsVectorNode* mappedNodes = nullptr;
 
 private:
 
+  // data used by the accessors, 'stride' doubles between two nodes
+  const G4double* energyData = nullptr;
+  const G4double* valueData = nullptr;
+  const G4double* secDerivData = nullptr;
+  std::size_t stride = 1;
+
   G4bool useSpline = false;
 };
 
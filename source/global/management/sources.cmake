@@ -44,6 +44,7 @@ geant4_add_module(G4globman
     G4ErrorPropagatorData.hh
     G4ErrorPropagatorData.icc
     G4Evaluator.hh
+    G4EventArena.hh
     G4Exception.hh
     G4ExceptionSeverity.hh
     G4Exp.hh
@@ -71,6 +72,7 @@ geant4_add_module(G4globman
     G4PhysicsOrderedFreeVector.hh
     G4PhysicsTable.hh
     G4PhysicsTable.icc
+    G4PhysicsTableImage.hh
     G4PhysicsVector.hh
     G4PhysicsVector.icc
     G4PhysicsVectorType.hh
@@ -125,6 +127,7 @@ geant4_add_module(G4globman
     G4coutFormatters.cc
     G4DataVector.cc
     G4ErrorPropagatorData.cc
+    G4EventArena.cc
     G4Exception.cc
     G4FilecoutDestination.cc
     G4FindDataDir.cc
@@ -140,6 +143,7 @@ geant4_add_module(G4globman
     G4PhysicsLogVector.cc
     G4PhysicsModelCatalog.cc
     G4PhysicsTable.cc
+    G4PhysicsTableImage.cc
     G4PhysicsVector.cc
     G4Physics2DVector.cc
     G4Pow.cc
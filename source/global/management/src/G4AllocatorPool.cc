@@ -29,6 +29,11 @@
 // --------------------------------------------------------------------
 
 #include "G4AllocatorPool.hh"
+#include "G4Exception.hh"
+#include "G4ios.hh"
+
+#include <limits>
+#include <sstream>
 
 // ************************************************************
 // G4AllocatorPool constructor
@@ -52,6 +57,7 @@ G4AllocatorPool& G4AllocatorPool::operator=(const G4AllocatorPool& right)
   chunks  = right.chunks;
   head    = right.head;
   nchunks = right.nchunks;
+  nbytes  = right.nbytes;
   return *this;
 }
 
@@ -80,6 +86,7 @@ void G4AllocatorPool::Reset()
   head    = nullptr;
   chunks  = nullptr;
   nchunks = 0;
+  nbytes  = 0;
 }
 
 // ************************************************************
@@ -87,16 +94,57 @@ void G4AllocatorPool::Reset()
 // ************************************************************
 //
 void G4AllocatorPool::Grow()
+{
+  // Allocate new chunk of the default page size
+  //
+  AddChunk(csize);
+}
+
+// ************************************************************
+// Reserve
+// ************************************************************
+//
+void G4AllocatorPool::Reserve(std::size_t n)
+{
+  if(n == 0)
+  {
+    return;
+  }
+  const std::size_t nmax = std::numeric_limits<unsigned int>::max() / esize;
+  if(n > nmax)
+  {
+    std::ostringstream message;
+    message << "Cannot reserve " << n << " elements of " << esize
+            << " bytes in one page." << G4endl
+            << "        Maximum number of elements is " << nmax
+            << ", nothing is reserved.";
+    G4Exception("G4AllocatorPool::Reserve()", "glob09", JustWarning,
+                message);
+    return;
+  }
+  AddChunk(static_cast<unsigned int>(n * esize));
+}
+
+// ************************************************************
+// AddChunk
+// ************************************************************
+//
+void G4AllocatorPool::AddChunk(unsigned int sz)
 {
   // Allocate new chunk, organize it as a linked list of
-  // elements of size 'esize'
+  // elements of size 'esize' in front of the free elements
   //
-  auto* n        = new G4PoolChunk(csize);
+  const unsigned int nelem = sz / esize;
+  if(nelem == 0)
+  {
+    return;
+  }
+  auto* n        = new G4PoolChunk(sz);
   n->next        = chunks;
   chunks         = n;
   ++nchunks;
+  nbytes += sz;
 
-  const int nelem = csize / esize;
   char* start     = n->mem;
   char* last      = &start[(nelem - 1) * esize];
   for(char* p = start; p < last; p += esize)
@@ -104,6 +152,6 @@ void G4AllocatorPool::Grow()
     reinterpret_cast<G4PoolLink*>(p)->next =
       reinterpret_cast<G4PoolLink*>(p + esize);
   }
-  reinterpret_cast<G4PoolLink*>(last)->next = nullptr;
+  reinterpret_cast<G4PoolLink*>(last)->next = head;
   head = reinterpret_cast<G4PoolLink*>(start);
 }
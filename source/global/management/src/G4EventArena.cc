@@ -0,0 +1,208 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventArena, G4EventArenaPool implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4EventArena.hh"
+#include "G4AutoLock.hh"
+
+#include <new>
+
+namespace
+{
+  G4ThreadLocal G4EventArena* currentArena = nullptr;
+}
+
+G4ThreadLocal G4EventArenaPool* G4EventArenaPool::fInstance = nullptr;
+
+// --------------------------------------------------------------------
+G4EventArena::~G4EventArena() { Release(); }
+
+// --------------------------------------------------------------------
+void* G4EventArena::AllocateInNewPage(std::size_t size, std::size_t align)
+{
+  // the data of a page are aligned to max_align_t
+  std::size_t need = PageHeaderSize() + size;
+  if(align > alignof(std::max_align_t))
+  {
+    need += align;
+  }
+  if(fPool == nullptr)
+  {
+    fPool = G4EventArenaPool::GetInstance();
+  }
+  Page* page = fPool->GetPage(need);
+  page->next = nullptr;
+  if(fLastPage != nullptr)
+  {
+    fLastPage->next = page;
+  }
+  else
+  {
+    fFirstPage = page;
+  }
+  fLastPage = page;
+  fAllocatedSize += page->size;
+  ++fNPages;
+
+  fCursor = reinterpret_cast<char*>(page) + PageHeaderSize();
+  fEnd = reinterpret_cast<char*>(page) + page->size;
+  return Allocate(size, align);
+}
+
+// --------------------------------------------------------------------
+void G4EventArena::Release()
+{
+  if(fFirstPage != nullptr)
+  {
+    fPool->PutPages(fFirstPage, fLastPage);
+  }
+  fPool = nullptr;
+  fFirstPage = fLastPage = nullptr;
+  fCursor = fEnd = nullptr;
+  fUsedSize = fAllocatedSize = 0;
+  fNPages = 0;
+}
+
+// --------------------------------------------------------------------
+G4EventArena* G4EventArena::GetCurrentArena() { return currentArena; }
+
+// --------------------------------------------------------------------
+G4EventArena* G4EventArena::SetCurrentArena(G4EventArena* arena)
+{
+  G4EventArena* previous = currentArena;
+  currentArena = arena;
+  return previous;
+}
+
+// --------------------------------------------------------------------
+G4EventArenaPool* G4EventArenaPool::GetInstance()
+{
+  if(fInstance == nullptr)
+  {
+    fInstance = new G4EventArenaPool;
+  }
+  return fInstance;
+}
+
+// --------------------------------------------------------------------
+G4EventArenaPool::~G4EventArenaPool()
+{
+  ResetStorage();
+  if(fInstance == this)
+  {
+    fInstance = nullptr;
+  }
+}
+
+// --------------------------------------------------------------------
+G4EventArena::Page* G4EventArenaPool::GetPage(std::size_t minSize)
+{
+  G4AutoLock l(&fMutex);
+  if(fFreePages != nullptr && fFreePages->size >= minSize)
+  {
+    G4EventArena::Page* page = fFreePages;
+    fFreePages = page->next;
+    --fNFreePages;
+    return page;
+  }
+  std::size_t size = (minSize > fPageSize) ? minSize : fPageSize;
+  auto page = static_cast<G4EventArena::Page*>(::operator new(size));
+  page->next = nullptr;
+  page->size = size;
+  fTotalSize += size;
+  ++fNPages;
+  return page;
+}
+
+// --------------------------------------------------------------------
+void G4EventArenaPool::PutPages(G4EventArena::Page* first,
+                                G4EventArena::Page* last)
+{
+  G4int n = 1;
+  for(auto page = first; page != last; page = page->next)
+  {
+    ++n;
+  }
+  G4AutoLock l(&fMutex);
+  last->next = fFreePages;
+  fFreePages = first;
+  fNFreePages += n;
+}
+
+// --------------------------------------------------------------------
+void G4EventArenaPool::ResetStorage()
+{
+  fDefaultArena.Release();
+  G4AutoLock l(&fMutex);
+  while(fFreePages != nullptr)
+  {
+    G4EventArena::Page* page = fFreePages;
+    fFreePages = page->next;
+    fTotalSize -= page->size;
+    --fNPages;
+    ::operator delete(page);
+  }
+  fNFreePages = 0;
+}
+
+// --------------------------------------------------------------------
+std::size_t G4EventArenaPool::GetAllocatedSize() const
+{
+  G4AutoLock l(&fMutex);
+  return fTotalSize;
+}
+
+// --------------------------------------------------------------------
+int G4EventArenaPool::GetNoPages() const
+{
+  G4AutoLock l(&fMutex);
+  return fNPages;
+}
+
+// --------------------------------------------------------------------
+G4int G4EventArenaPool::GetNoFreePages() const
+{
+  G4AutoLock l(&fMutex);
+  return fNFreePages;
+}
+
+// --------------------------------------------------------------------
+std::size_t G4EventArenaPool::GetPageSize() const { return fPageSize; }
+
+// --------------------------------------------------------------------
+void G4EventArenaPool::IncreasePageSize(unsigned int sz)
+{
+  if(sz > 0)
+  {
+    fPageSize *= sz;
+  }
+}
+
+// --------------------------------------------------------------------
+const char* G4EventArenaPool::GetPoolType() const { return "G4EventArena"; }
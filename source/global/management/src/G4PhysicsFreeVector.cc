@@ -118,8 +118,17 @@ void G4PhysicsFreeVector::PutValues(const std::size_t index,
     PrintPutValueError(index, value, "G4PhysicsFreeVector::PutValues ");
     return;
   }
-  binVector[index]  = e;
-  dataVector[index] = value;
+  DetachFromImage();
+  if (packedNodes.empty())
+  {
+    binVector[index]  = e;
+    dataVector[index] = value;
+  }
+  else
+  {
+    packedNodes[index].energy = e;
+    packedNodes[index].value = value;
+  }
   if(index == 0)
   {
     edgeMin = e;
@@ -134,6 +143,7 @@ void G4PhysicsFreeVector::PutValues(const std::size_t index,
 void G4PhysicsFreeVector::InsertValues(const G4double energy, 
                                        const G4double value)
 {
+  const G4bool packed = Unpack();
   auto binLoc = std::lower_bound(binVector.cbegin(), binVector.cend(), energy);
   auto dataLoc = dataVector.cbegin();
   dataLoc += binLoc - binVector.cbegin(); 
@@ -143,6 +153,7 @@ void G4PhysicsFreeVector::InsertValues(const G4double energy,
 
   ++numberOfNodes;
   Initialise();
+  if (packed) { Pack(); }
 }
 
 // --------------------------------------------------------------------
@@ -167,7 +178,7 @@ void G4PhysicsFreeVector::EnableLogBinSearch(const G4int n)
     G4double e = edgeMin*G4Exp(i/iBin1);
     for (; j <= idxmax; ++j)
     {
-      if (binVector[j] <= e && e < binVector[j+1])
+      if (Energy(j) <= e && e < Energy(j+1))
       {
         scale[i] = j;
         break;
@@ -78,6 +78,7 @@ G4PhysicsLinearVector::G4PhysicsLinearVector(G4double Emin, G4double Emax,
 // --------------------------------------------------------------------
 void G4PhysicsLinearVector::Initialise()
 {
+  BindData();
   idxmax  = numberOfNodes - 2;
   edgeMin = binVector[0];
   edgeMax = binVector[numberOfNodes - 1];
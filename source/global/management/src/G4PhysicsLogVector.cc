@@ -78,6 +78,7 @@ G4PhysicsLogVector::G4PhysicsLogVector(G4double Emin, G4double Emax,
 // --------------------------------------------------------------------
 void G4PhysicsLogVector::Initialise()
 {
+  BindData();
   idxmax  = numberOfNodes - 2;
   edgeMin = binVector[0];
   edgeMax = binVector[idxmax + 1];
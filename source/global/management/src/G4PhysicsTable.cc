@@ -40,6 +40,7 @@
 #include "G4PhysicsLinearVector.hh"
 #include "G4PhysicsLogVector.hh"
 #include "G4PhysicsTable.hh"
+#include "G4PhysicsTableImage.hh"
 #include "G4PhysicsVector.hh"
 #include "G4PhysicsVectorType.hh"
 
@@ -116,12 +117,24 @@ G4bool G4PhysicsTable::StorePhysicsTable(const G4String& fileName, G4bool ascii)
     itr->Store(fOut, ascii);
   }
   fOut.close();
+
+  auto image = G4PhysicsTableImage::GetInstance();
+  if(image->IsRecording())
+  {
+    image->AddTable(G4PhysicsTableImage::KeyOf(fileName), *this);
+  }
   return true;
 }
 
 // --------------------------------------------------------------------
 G4bool G4PhysicsTable::ExistPhysicsTable(const G4String& fileName) const
 {
+  auto image = G4PhysicsTableImage::GetInstance();
+  if(image->IsMapped() &&
+     image->HasTable(G4PhysicsTableImage::KeyOf(fileName)))
+  {
+    return true;
+  }
   std::ifstream fIn;
   G4bool value = true;
   // open input file
@@ -140,6 +153,14 @@ G4bool G4PhysicsTable::ExistPhysicsTable(const G4String& fileName) const
 G4bool G4PhysicsTable::RetrievePhysicsTable(const G4String& fileName,
                                             G4bool ascii, G4bool spline)
 {
+  // zero-copy retrieval from the mapped image
+  auto image = G4PhysicsTableImage::GetInstance();
+  if(image->IsMapped() &&
+     image->RetrieveTable(G4PhysicsTableImage::KeyOf(fileName), *this, spline))
+  {
+    return true;
+  }
+
   std::ifstream fIn;
   // open input file
   if(ascii)
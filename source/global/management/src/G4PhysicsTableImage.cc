@@ -0,0 +1,401 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4PhysicsTableImage implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4PhysicsTableImage.hh"
+
+#include "G4AutoLock.hh"
+#include "G4PhysicsTable.hh"
+#include "G4PhysicsVector.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if !defined(WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+  G4Mutex imageMutex = G4MUTEX_INITIALIZER;
+
+  const char imageMagic[8] = {'G', '4', 'P', 'T', 'I', 'M', 'G', '\0'};
+  constexpr std::uint32_t imageVersion = 1;
+  constexpr std::uint32_t imageEndian = 0x01020304;
+  constexpr std::size_t imageAlign = 64;
+
+  struct ImageHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian;
+    std::uint64_t nTables;
+    std::uint64_t directoryOffset;
+    std::uint64_t fileSize;
+    std::uint64_t reserved[3];
+  };
+  static_assert(sizeof(ImageHeader) == imageAlign, "image header size");
+
+  struct VectorRecord
+  {
+    std::int32_t type;
+    std::int32_t spline;
+    std::uint64_t nNodes;
+    std::uint64_t nLogNodes;
+    std::uint64_t idxmax;
+    std::uint64_t imax1;
+    G4double edgeMin;
+    G4double edgeMax;
+    G4double invdBin;
+    G4double logemin;
+    G4double iBin1;
+    G4double lmin1;
+    std::uint64_t nodesOffset;
+    std::uint64_t scaleOffset;
+  };
+
+  template <typename T>
+  const T* At(const char* base, std::uint64_t offset)
+  {
+    return reinterpret_cast<const T*>(base + offset);
+  }
+}
+
+// --------------------------------------------------------------------
+G4PhysicsTableImage* G4PhysicsTableImage::GetInstance()
+{
+  static G4PhysicsTableImage instance;
+  return &instance;
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsTableImage::StartRecording()
+{
+  G4AutoLock l(&imageMutex);
+  fBuffer.assign(sizeof(ImageHeader), 0);
+  fRecorded.clear();
+  fRecording = true;
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsTableImage::Align()
+{
+  fBuffer.resize((fBuffer.size() + imageAlign - 1) / imageAlign * imageAlign, 0);
+}
+
+// --------------------------------------------------------------------
+std::uint64_t G4PhysicsTableImage::Append(const void* data, std::size_t size)
+{
+  std::uint64_t offset = fBuffer.size();
+  const char* p = static_cast<const char*>(data);
+  fBuffer.insert(fBuffer.end(), p, p + size);
+  return offset;
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsTableImage::AddTable(const G4String& name,
+                                   const G4PhysicsTable& table)
+{
+  G4AutoLock l(&imageMutex);
+  if (!fRecording) { return; }
+
+  std::vector<std::uint64_t> offsets(table.size(), 0);
+  for (std::size_t i = 0; i < table.size(); ++i)
+  {
+    if (nullptr != table[i]) { offsets[i] = AppendVector(table[i]); }
+  }
+  Align();
+  std::uint64_t n = offsets.size();
+  fRecorded[name] = Append(&n, sizeof(n));
+  Append(offsets.data(), n * sizeof(std::uint64_t));
+}
+
+// --------------------------------------------------------------------
+std::uint64_t G4PhysicsTableImage::AppendVector(const G4PhysicsVector* vec)
+{
+  const std::size_t n = vec->numberOfNodes;
+  const G4bool sd = vec->useSpline &&
+    (vec->IsPacked() || vec->secDerivative.size() == n);
+
+  // interpolation nodes
+  std::vector<G4PhysicsVectorNode> nodes(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    nodes[i].energy = vec->Energy(i);
+    nodes[i].value = vec->Data(i);
+    if (sd) { nodes[i].secDerivative = vec->secDerivData[i * vec->stride]; }
+  }
+  VectorRecord rec{};
+  rec.type = vec->type;
+  rec.spline = sd ? 1 : 0;
+  rec.nNodes = n;
+  rec.nLogNodes = vec->nLogNodes;
+  rec.idxmax = vec->idxmax;
+  rec.imax1 = vec->imax1;
+  rec.edgeMin = vec->edgeMin;
+  rec.edgeMax = vec->edgeMax;
+  rec.invdBin = vec->invdBin;
+  rec.logemin = vec->logemin;
+  rec.iBin1 = vec->iBin1;
+  rec.lmin1 = vec->lmin1;
+
+  Align();
+  rec.nodesOffset = Append(nodes.data(), n * sizeof(G4PhysicsVectorNode));
+  if (!vec->scale.empty())
+  {
+    std::vector<std::uint64_t> scale(vec->scale.cbegin(), vec->scale.cend());
+    rec.scaleOffset = Append(scale.data(), scale.size() * sizeof(std::uint64_t));
+  }
+  Align();
+  return Append(&rec, sizeof(rec));
+}
+
+// --------------------------------------------------------------------
+G4bool G4PhysicsTableImage::Write(const G4String& fileName)
+{
+  G4AutoLock l(&imageMutex);
+  if (!fRecording) { return false; }
+  fRecording = false;
+
+  // directory
+  Align();
+  const std::uint64_t dirOffset = fBuffer.size();
+  for (const auto& entry : fRecorded)
+  {
+    std::uint64_t rec[2] = { entry.first.size(), entry.second };
+    Append(rec, sizeof(rec));
+    Append(entry.first.data(), entry.first.size());
+    fBuffer.resize((fBuffer.size() + 7) / 8 * 8, 0);
+  }
+  ImageHeader header{};
+  std::memcpy(header.magic, imageMagic, sizeof(imageMagic));
+  header.version = imageVersion;
+  header.endian = imageEndian;
+  header.nTables = fRecorded.size();
+  header.directoryOffset = dirOffset;
+  header.fileSize = fBuffer.size();
+  std::memcpy(fBuffer.data(), &header, sizeof(header));
+
+  // the image is written to a temporary file in the same directory and
+  // renamed over the target, so that an image of the same name mapped by
+  // this or another process is never truncated nor seen half written
+  G4String tmpName = fileName + ".tmp";
+#if !defined(WIN32)
+  tmpName += "." + std::to_string(getpid());
+#endif
+  std::ofstream fOut(tmpName, std::ios::out | std::ios::binary);
+  G4bool res = fOut.is_open();
+  if (res)
+  {
+    fOut.write(fBuffer.data(), fBuffer.size());
+    fOut.close();
+    res = !fOut.fail();
+  }
+  if (res)
+  {
+#if defined(WIN32)
+    std::remove(fileName.c_str());
+#endif
+    res = (std::rename(tmpName.c_str(), fileName.c_str()) == 0);
+  }
+  if (!res)
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot write physics table image " << fileName;
+    G4Exception("G4PhysicsTableImage::Write()", "glob08", JustWarning, ed);
+    std::remove(tmpName.c_str());
+  }
+  fBuffer.clear();
+  fBuffer.shrink_to_fit();
+  fRecorded.clear();
+  return res;
+}
+
+// --------------------------------------------------------------------
+G4bool G4PhysicsTableImage::Map(const G4String& fileName)
+{
+  G4AutoLock l(&imageMutex);
+  if (nullptr != fMapped && fileName == fMappedName) { return true; }
+
+  const char* base = nullptr;
+  std::size_t size = 0;
+#if !defined(WIN32)
+  G4int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) { return false; }
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(ImageHeader))
+  {
+    size = st.st_size;
+    void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p != MAP_FAILED) { base = static_cast<const char*>(p); }
+  }
+  close(fd);
+#else
+  // no mapping, the image is read into an aligned buffer
+  std::ifstream fIn(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!fIn.is_open()) { return false; }
+  size = fIn.tellg();
+  if (size >= sizeof(ImageHeader))
+  {
+    auto p = static_cast<char*>(::operator new(size, std::align_val_t(imageAlign)));
+    fIn.seekg(0);
+    fIn.read(p, size);
+    base = p;
+  }
+#endif
+  if (nullptr == base) { return false; }
+
+  // validation of the header and of the directory
+  const auto header = At<ImageHeader>(base, 0);
+  G4bool ok = std::memcmp(header->magic, imageMagic, sizeof(imageMagic)) == 0 &&
+    header->version == imageVersion && header->endian == imageEndian &&
+    header->fileSize == size && header->directoryOffset <= size;
+  std::map<G4String, std::uint64_t> directory;
+  std::uint64_t pos = header->directoryOffset;
+  for (std::uint64_t i = 0; ok && i < header->nTables; ++i)
+  {
+    ok = (pos + 2 * sizeof(std::uint64_t) <= size);
+    if (!ok) { break; }
+    const auto rec = At<std::uint64_t>(base, pos);
+    pos += 2 * sizeof(std::uint64_t);
+    ok = (pos + rec[0] <= size && rec[1] < header->directoryOffset);
+    if (!ok) { break; }
+    directory[G4String(base + pos, rec[0])] = rec[1];
+    pos += (rec[0] + 7) / 8 * 8;
+  }
+  if (!ok)
+  {
+#if !defined(WIN32)
+    munmap(const_cast<char*>(base), size);
+#else
+    ::operator delete(const_cast<char*>(base), std::align_val_t(imageAlign));
+#endif
+    G4ExceptionDescription ed;
+    ed << "File " << fileName << " is not a valid physics table image"
+       << " of version " << imageVersion;
+    G4Exception("G4PhysicsTableImage::Map()", "glob08", JustWarning, ed);
+    return false;
+  }
+
+  // a previous image is not released, its vectors may still be in use
+  fMapped = base;
+  fMappedSize = size;
+  fMappedName = fileName;
+  fDirectory = std::move(directory);
+  return true;
+}
+
+// --------------------------------------------------------------------
+G4bool G4PhysicsTableImage::HasTable(const G4String& name) const
+{
+  G4AutoLock l(&imageMutex);
+  return fDirectory.find(name) != fDirectory.cend();
+}
+
+// --------------------------------------------------------------------
+G4bool G4PhysicsTableImage::RetrieveTable(const G4String& name,
+                                          G4PhysicsTable& table,
+                                          G4bool spline) const
+{
+  G4AutoLock l(&imageMutex);
+  auto itr = fDirectory.find(name);
+  if (itr == fDirectory.cend()) { return false; }
+
+  table.clearAndDestroy();
+  const std::uint64_t n = *At<std::uint64_t>(fMapped, itr->second);
+  const auto offsets = At<std::uint64_t>(fMapped, itr->second + sizeof(n));
+  table.reserve(n);
+  table.vecFlag.clear();
+  for (std::uint64_t i = 0; i < n; ++i)
+  {
+    if (0 == offsets[i])
+    {
+      table.push_back(nullptr);
+      continue;
+    }
+    const auto rec = At<VectorRecord>(fMapped, offsets[i]);
+    G4PhysicsVector* vec = table.CreatePhysicsVector(rec->type, spline);
+    vec->numberOfNodes = rec->nNodes;
+    vec->nLogNodes = rec->nLogNodes;
+    vec->idxmax = rec->idxmax;
+    vec->imax1 = rec->imax1;
+    vec->edgeMin = rec->edgeMin;
+    vec->edgeMax = rec->edgeMax;
+    vec->invdBin = rec->invdBin;
+    vec->logemin = rec->logemin;
+    vec->iBin1 = rec->iBin1;
+    vec->lmin1 = rec->lmin1;
+    if (0 != rec->scaleOffset)
+    {
+      const auto scale = At<std::uint64_t>(fMapped, rec->scaleOffset);
+      vec->scale.assign(scale, scale + rec->nLogNodes);
+    }
+    const auto nodes = At<G4PhysicsVectorNode>(fMapped, rec->nodesOffset);
+    if (spline && 0 == rec->spline)
+    {
+      // second derivatives are not in the image, the vector owns its data
+      // and the derivatives are computed by FillSecondDerivatives()
+      vec->binVector.resize(rec->nNodes);
+      vec->dataVector.resize(rec->nNodes);
+      for (std::size_t j = 0; j < rec->nNodes; ++j)
+      {
+        vec->binVector[j] = nodes[j].energy;
+        vec->dataVector[j] = nodes[j].value;
+      }
+    }
+    else
+    {
+      vec->mappedNodes = nodes;
+    }
+    vec->BindData();
+    table.push_back(vec);
+  }
+  return true;
+}
+
+// --------------------------------------------------------------------
+G4String G4PhysicsTableImage::KeyOf(const G4String& fileName)
+{
+  std::size_t pos = fileName.find_last_of("/\\");
+  if (pos == G4String::npos) { return fileName; }
+  return fileName.substr(pos + 1);
+}
+
+// --------------------------------------------------------------------
+const G4String& G4PhysicsTableImage::DefaultFileName()
+{
+  static const G4String name = "PhysicsTableImage.bin";
+  return name;
+}
@@ -35,14 +35,61 @@
 #include "G4PhysicsVector.hh"
 #include <iomanip>
 
+namespace
+{
+  G4bool packedLayoutDefault = false;
+}
+
 // --------------------------------------------------------------
 G4PhysicsVector::G4PhysicsVector(G4bool val)
   : useSpline(val)
 {}
 
+// --------------------------------------------------------------
+G4PhysicsVector::G4PhysicsVector(const G4PhysicsVector& right)
+{
+  CopyData(right);
+}
+
+// --------------------------------------------------------------
+G4PhysicsVector& G4PhysicsVector::operator=(const G4PhysicsVector& right)
+{
+  if (&right != this)
+  {
+    CopyData(right);
+  }
+  return *this;
+}
+
+// --------------------------------------------------------------
+void G4PhysicsVector::CopyData(const G4PhysicsVector& vec)
+{
+  edgeMin = vec.edgeMin;
+  edgeMax = vec.edgeMax;
+  invdBin = vec.invdBin;
+  logemin = vec.logemin;
+  iBin1 = vec.iBin1;
+  lmin1 = vec.lmin1;
+  verboseLevel = vec.verboseLevel;
+  idxmax = vec.idxmax;
+  imax1 = vec.imax1;
+  numberOfNodes = vec.numberOfNodes;
+  nLogNodes = vec.nLogNodes;
+  type = vec.type;
+  binVector = vec.binVector;
+  dataVector = vec.dataVector;
+  secDerivative = vec.secDerivative;
+  scale = vec.scale;
+  packedNodes = vec.packedNodes;
+  mappedNodes = vec.mappedNodes;
+  useSpline = vec.useSpline;
+  BindData();
+}
+
 // --------------------------------------------------------------------
 void G4PhysicsVector::Initialise()
 {
+  BindData();
   if (1 < numberOfNodes)
   {
     idxmax = numberOfNodes - 2;
@@ -68,14 +115,14 @@ G4bool G4PhysicsVector::Store(std::ofstream& fOut, G4bool ascii) const
   fOut.write((char*) (&numberOfNodes), sizeof numberOfNodes);
 
   // contents
-  std::size_t size = dataVector.size();
+  std::size_t size = numberOfNodes;
   fOut.write((char*) (&size), sizeof size);
 
   auto value = new G4double[2 * size];
   for (std::size_t i = 0; i < size; ++i)
   {
-    value[2 * i]     = binVector[i];
-    value[2 * i + 1] = dataVector[i];
+    value[2 * i]     = Energy(i);
+    value[2 * i + 1] = Data(i);
   }
   fOut.write((char*) (value), 2 * size * (sizeof(G4double)));
   delete[] value;
@@ -90,6 +137,9 @@ G4bool G4PhysicsVector::Retrieve(std::ifstream& fIn, G4bool ascii)
   dataVector.clear();
   binVector.clear();
   secDerivative.clear();
+  packedNodes.clear();
+  mappedNodes = nullptr;
+  BindData();
 
   // retrieve in ascii mode
   if (ascii)
@@ -166,7 +216,7 @@ void G4PhysicsVector::DumpValues(G4double unitE, G4double unitV) const
 {
   for (std::size_t i = 0; i < numberOfNodes; ++i)
   {
-    G4cout << binVector[i] / unitE << "   " << dataVector[i] / unitV 
+    G4cout << Energy(i) / unitE << "   " << Data(i) / unitV 
            << G4endl;
   }
 }
@@ -176,15 +226,15 @@ std::size_t G4PhysicsVector::FindBin(const G4double energy,
                                      std::size_t idx) const
 {
   if (idx + 1 < numberOfNodes && 
-      energy >= binVector[idx] && energy <= binVector[idx])
+      energy >= Energy(idx) && energy <= Energy(idx))
   {
     return idx;
   } 
-  if (energy <= binVector[1])
+  if (energy <= Energy(1))
   {
     return 0;
   }
-  if (energy >= binVector[idxmax])
+  if (energy >= Energy(idxmax))
   {
     return idxmax;
   }
@@ -195,12 +245,14 @@ std::size_t G4PhysicsVector::FindBin(const G4double energy,
 void G4PhysicsVector::ScaleVector(const G4double factorE, 
                                   const G4double factorV)
 {
+  const G4bool packed = Unpack();
   for (std::size_t i = 0; i < numberOfNodes; ++i)
   {
     binVector[i] *= factorE;
     dataVector[i] *= factorV;
   }
   Initialise();
+  if (packed) { Pack(); }
 }
 
 // --------------------------------------------------------------------
@@ -209,6 +261,8 @@ void G4PhysicsVector::FillSecondDerivatives(const G4SplineType stype,
 					    const G4double dir2)
 {
   if (!useSpline) { return; }
+  // second derivatives of a mapped vector are taken from the image
+  if (nullptr != mappedNodes) { return; }
   // cannot compute derivatives for less than 5 points
   const std::size_t nmin = (stype == G4SplineType::Base) ? 5 : 4;
   if (nmin > numberOfNodes) 
@@ -228,13 +282,13 @@ void G4PhysicsVector::FillSecondDerivatives(const G4SplineType stype,
   {
     for (std::size_t i=0; i<=idxmax; ++i) 
     {
-      if (binVector[i + 1] <= binVector[i])
+      if (Energy(i + 1) <= Energy(i))
       {
         if (0 < verboseLevel) 
         {
 	  G4cout << "### G4PhysicsVector: spline cannot be used, because "
-		 << " E[" << i << "]=" << binVector[i]
-		 << " >= E[" << i+1 << "]=" << binVector[i + 1]
+		 << " E[" << i << "]=" << Energy(i)
+		 << " >= E[" << i+1 << "]=" << Energy(i + 1)
 		 << G4endl;
 	  DumpValues();
         }
@@ -245,8 +299,9 @@ void G4PhysicsVector::FillSecondDerivatives(const G4SplineType stype,
   }
 
   // spline is possible
-  Initialise();
+  const G4bool packed = Unpack();
   secDerivative.resize(numberOfNodes);
+  Initialise();
 
   if (1 < verboseLevel)
   {
@@ -268,6 +323,86 @@ void G4PhysicsVector::FillSecondDerivatives(const G4SplineType stype,
     default:
       ComputeSecDerivative0();
   }
+  if (packedLayoutDefault || packed) { Pack(); }
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsVector::Pack()
+{
+  if (IsPacked()) { return; }
+  packedNodes.resize(numberOfNodes);
+  const G4bool sd = (secDerivative.size() == numberOfNodes);
+  for (std::size_t i = 0; i < numberOfNodes; ++i)
+  {
+    packedNodes[i].energy = binVector[i];
+    packedNodes[i].value = dataVector[i];
+    packedNodes[i].secDerivative = sd ? secDerivative[i] : 0.0;
+  }
+  std::vector<G4double>().swap(binVector);
+  std::vector<G4double>().swap(dataVector);
+  std::vector<G4double>().swap(secDerivative);
+  BindData();
+}
+
+// --------------------------------------------------------------------
+G4bool G4PhysicsVector::Unpack()
+{
+  if (!IsPacked()) { return false; }
+  binVector.resize(numberOfNodes);
+  dataVector.resize(numberOfNodes);
+  if (useSpline) { secDerivative.resize(numberOfNodes); }
+  for (std::size_t i = 0; i < numberOfNodes; ++i)
+  {
+    binVector[i] = Energy(i);
+    dataVector[i] = Data(i);
+    if (useSpline) { secDerivative[i] = secDerivData[i * stride]; }
+  }
+  std::vector<G4PhysicsVectorNode>().swap(packedNodes);
+  mappedNodes = nullptr;
+  BindData();
+  return true;
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsVector::BindData()
+{
+  const G4PhysicsVectorNode* nodes = mappedNodes;
+  if (nullptr == nodes && !packedNodes.empty()) { nodes = packedNodes.data(); }
+  if (nullptr != nodes)
+  {
+    energyData = &nodes->energy;
+    valueData = &nodes->value;
+    secDerivData = &nodes->secDerivative;
+    stride = sizeof(G4PhysicsVectorNode) / sizeof(G4double);
+  }
+  else
+  {
+    energyData = binVector.data();
+    valueData = dataVector.data();
+    secDerivData = secDerivative.data();
+    stride = 1;
+  }
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsVector::SetPackedLayout(G4bool val)
+{
+  packedLayoutDefault = val;
+}
+
+// --------------------------------------------------------------------
+void G4PhysicsVector::DetachFromImage()
+{
+  if (nullptr == mappedNodes) { return; }
+  packedNodes.assign(mappedNodes, mappedNodes + numberOfNodes);
+  mappedNodes = nullptr;
+  BindData();
+}
+
+// --------------------------------------------------------------------
+G4bool G4PhysicsVector::GetPackedLayout()
+{
+  return packedLayoutDefault;
 }
 
 // --------------------------------------------------------------
@@ -419,10 +554,10 @@ std::ostream& operator<<(std::ostream& out, const G4PhysicsVector& pv)
       << pv.numberOfNodes << G4endl;
 
   // contents
-  out << pv.dataVector.size() << G4endl;
-  for (std::size_t i = 0; i < pv.dataVector.size(); ++i)
+  out << pv.numberOfNodes << G4endl;
+  for (std::size_t i = 0; i < pv.numberOfNodes; ++i)
   {
-    out << pv.binVector[i] << "  " << pv.dataVector[i] << G4endl;
+    out << pv.Energy(i) << "  " << pv.Data(i) << G4endl;
   }
   out.precision(prec);
 
@@ -436,22 +571,21 @@ G4double G4PhysicsVector::GetEnergy(const G4double val) const
   {
     return 0.0;
   }
-  if (1 == numberOfNodes || val <= dataVector[0])
+  if (1 == numberOfNodes || val <= Data(0))
   {
     return edgeMin;
   }
-  if (val >= dataVector[numberOfNodes - 1])
+  if (val >= Data(numberOfNodes - 1))
   {
     return edgeMax;
   }
-  std::size_t bin = std::lower_bound(dataVector.cbegin(), dataVector.cend(), val)
-                  - dataVector.cbegin() - 1;
+  std::size_t bin = LowerBound(valueData, val) - 1;
   if (bin > idxmax) { bin = idxmax; } 
-  G4double res = binVector[bin];
-  G4double del = dataVector[bin + 1] - dataVector[bin];
+  G4double res = Energy(bin);
+  G4double del = Data(bin + 1) - Data(bin);
   if (del > 0.0)
   {
-    res += (val - dataVector[bin]) * (binVector[bin + 1] - res) / del;
+    res += (val - Data(bin)) * (Energy(bin + 1) - res) / del;
   }
   return res;
 }
@@ -0,0 +1,170 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class header file
+//
+//
+// File name:     G4EmBatchedTrackingManager
+//
+// Creation date: 18.10.2026
+//
+// Modifications:
+//
+// Class Description:
+//
+// Experimental tracking manager advancing many tracks of the same
+// neutral particle in lock-step, intended to evaluate the throughput of
+// batched stepping for gamma dominated workloads. Tracks handed over
+// are buffered and tracked by batches; the step data of a batch are
+// kept in structure-of-arrays form (kinetic energy, couple, number of
+// interaction lengths left and cross section per process) and the
+// physics step limits of the whole batch are computed at once with
+// G4VEmProcess::GetLambdas(). Transportation, the selected interaction,
+// sensitive detectors and user actions are then applied track by track
+// using a single G4Step.
+//
+// Only discrete G4VEmProcess without integral approach and biasing are
+// supported, and tracks are transported along straight lines in the
+// mass geometry: this covers the gamma processes of the standard EM
+// constructors (without general process). Trajectories are not stored.
+// The processes are deleted by G4LossTableManager. The tracking manager
+// is created by each thread in the same way, e.g. in ConstructProcess():
+//
+//   auto tm = new G4EmBatchedTrackingManager();
+//   tm->AddEmProcess(new G4PhotoElectricEffect());
+//   tm->AddEmProcess(new G4ComptonScattering());
+//   tm->AddEmProcess(new G4GammaConversion());
+//   tm->AddEmProcess(new G4RayleighScattering());
+//   G4Gamma::Gamma()->SetTrackingManager(tm);
+
+// -------------------------------------------------------------------
+//
+
+#ifndef G4EmBatchedTrackingManager_h
+#define G4EmBatchedTrackingManager_h 1
+
+#include "G4VTrackingManager.hh"
+#include "G4TrackVector.hh"
+#include "globals.hh"
+
+#include <memory>
+#include <vector>
+
+class G4MaterialCutsCouple;
+class G4Navigator;
+class G4Step;
+class G4Track;
+class G4VEmProcess;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+class G4EmBatchedTrackingManager : public G4VTrackingManager
+{
+public:
+
+  explicit G4EmBatchedTrackingManager(G4int batchSize = 256);
+
+  ~G4EmBatchedTrackingManager() override;
+
+  void AddEmProcess(G4VEmProcess*);
+
+  void PreparePhysicsTable(const G4ParticleDefinition&) override;
+
+  void BuildPhysicsTable(const G4ParticleDefinition&) override;
+
+  void HandOverOneTrack(G4Track* aTrack) override;
+
+  void FlushEvent() override;
+
+  inline void SetBatchSize(G4int val);
+  inline G4int GetBatchSize() const;
+
+  // hide copy constructor and assignment operator
+  G4EmBatchedTrackingManager(G4EmBatchedTrackingManager&) = delete;
+  G4EmBatchedTrackingManager& operator=
+  (const G4EmBatchedTrackingManager& right) = delete;
+
+private:
+
+  void ProcessBatch();
+
+  G4bool StartTrack(G4Track* aTrack);
+
+  void StepTrack(std::size_t i);
+
+  void EndTrack(std::size_t i);
+
+  void RemoveTrack(std::size_t i);
+
+  // structure-of-arrays step data of the current batch, for the
+  // per-process arrays the data of process p start at p*capacity
+  struct BatchData
+  {
+    std::vector<G4Track*> track;
+    std::vector<G4double> kinEnergy;
+    std::vector<G4double> logKinEnergy;
+    std::vector<const G4MaterialCutsCouple*> couple;
+    std::vector<G4double> physicalStep;
+    std::vector<G4int> selected;
+    std::vector<G4double> nInteractionLengthLeft;
+    std::vector<G4double> lambda;
+    std::vector<G4TrackVector> secondaries;
+    std::size_t size = 0;
+    std::size_t capacity = 0;
+  };
+
+  std::vector<G4VEmProcess*> fProcesses;
+  std::vector<G4Track*> fPending;
+  BatchData fBatch;
+
+  std::unique_ptr<G4Step> fStep;
+  G4Navigator* fNavigator = nullptr;
+  const G4Track* fLastNavigatedTrack = nullptr;
+
+  G4int fBatchSize;
+
+  static G4EmBatchedTrackingManager* fMasterTrackingManager;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+inline void G4EmBatchedTrackingManager::SetBatchSize(G4int val)
+{
+  fBatchSize = std::max(val, 1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+inline G4int G4EmBatchedTrackingManager::GetBatchSize() const
+{
+  return fBatchSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+#endif
@@ -0,0 +1,139 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class header file
+//
+//
+// File name:     G4EmStandardTrackingManager
+//
+// Creation date: 18.10.2026
+//
+// Modifications:
+//
+// Class Description:
+//
+// Specialised tracking manager for e-, e+ and gamma with the same
+// processes and models as G4EmStandardPhysics. The processes are
+// owned by the tracking manager and called directly in a fixed order
+// from a stepping loop generated by G4TrackingManagerHelper, which
+// replaces the generic process vector dispatch of G4SteppingManager:
+// transportation, multiple scattering, ionisation and bremsstrahlung
+// are inlined, particle changes are applied directly to the step and
+// the secondaries are handed over to the event manager without copy.
+//
+// Tracking managers take precedence over the processes registered in
+// the G4ProcessManager and hide them, so that physics constructors
+// adding processes to e+-, gamma (e.g. G4EmExtraPhysics), biasing and
+// parallel worlds are not applied to these particles. The tracking
+// manager is enabled in G4EmStandardPhysics with
+//   G4EmParameters::SetEmTrackingManagerActive(true)
+// or the UI command /process/em/UseEmTrackingManager true
+//
+// Original author: J.Hahnfeld, 2021 - extended example RE07
+
+// -------------------------------------------------------------------
+//
+
+#ifndef G4EmStandardTrackingManager_h
+#define G4EmStandardTrackingManager_h 1
+
+#include "G4VTrackingManager.hh"
+#include "globals.hh"
+
+class G4eMultipleScattering;
+class G4CoulombScattering;
+class G4eIonisation;
+class G4eBremsstrahlung;
+class G4eplusAnnihilation;
+
+class G4ComptonScattering;
+class G4GammaConversion;
+class G4PhotoElectricEffect;
+class G4RayleighScattering;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+class G4EmStandardTrackingManager : public G4VTrackingManager
+{
+public:
+
+  G4EmStandardTrackingManager();
+
+  ~G4EmStandardTrackingManager() override;
+
+  void PreparePhysicsTable(const G4ParticleDefinition&) override;
+
+  void BuildPhysicsTable(const G4ParticleDefinition&) override;
+
+  void HandOverOneTrack(G4Track* aTrack) override;
+
+  // hide copy constructor and assignment operator
+  G4EmStandardTrackingManager(G4EmStandardTrackingManager&) = delete;
+  G4EmStandardTrackingManager& operator=
+  (const G4EmStandardTrackingManager& right) = delete;
+
+private:
+
+  void TrackElectron(G4Track* aTrack);
+
+  void TrackPositron(G4Track* aTrack);
+
+  void TrackGamma(G4Track* aTrack);
+
+  // the processes are deleted by G4LossTableManager
+  struct
+  {
+    G4eMultipleScattering* msc;
+    G4eIonisation* ioni;
+    G4eBremsstrahlung* brems;
+    G4CoulombScattering* ss;
+  } fElectronProcs;
+
+  struct
+  {
+    G4eMultipleScattering* msc;
+    G4eIonisation* ioni;
+    G4eBremsstrahlung* brems;
+    G4eplusAnnihilation* annihilation;
+    G4CoulombScattering* ss;
+  } fPositronProcs;
+
+  struct
+  {
+    G4PhotoElectricEffect* pe;
+    G4ComptonScattering* compton;
+    G4GammaConversion* conversion;
+    G4RayleighScattering* rayleigh;
+  } fGammaProcs;
+
+  static G4EmStandardTrackingManager* fMasterTrackingManager;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+#endif
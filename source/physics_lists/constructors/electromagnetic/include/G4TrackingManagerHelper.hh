@@ -23,19 +23,23 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-// TrackingManagerHelper
+// G4TrackingManagerHelper
 //
 // Class description:
 //
-// Helper class for reducing the effort required to implement a custom tracking
-// manager. It implements a stepping loop that calls user actions as the generic
-// tracking and stepping managers do, and it implements navigation for charged
-// particles in energy-preserving fields and for neutral particles.
-//
-// Original author: Jonas Hahnfeld, 2021
-
-#ifndef TrackingManagerHelper_hh
-#define TrackingManagerHelper_hh 1
+// Helper class for reducing the effort required to implement a specialised
+// tracking manager, see G4VTrackingManager. It implements a stepping loop
+// that calls sensitive detectors and user actions as the generic tracking
+// and stepping managers do, and it implements navigation for charged
+// particles in energy-preserving fields and for neutral particles. The
+// physics is provided as a template argument, so that the calls of the
+// stepping loop are resolved at compile time.
+
+// Author: J.Hahnfeld, 2021 - extended example RE07
+// 18.10.26 - Moved to the kernel for G4EmStandardTrackingManager
+// --------------------------------------------------------------------
+#ifndef G4TrackingManagerHelper_hh
+#define G4TrackingManagerHelper_hh 1
 
 #include "G4TrackVector.hh"
 #include "globals.hh"
@@ -43,7 +47,7 @@
 class G4Step;
 class G4Track;
 
-class TrackingManagerHelper
+class G4TrackingManagerHelper
 {
   public:
     class Physics
@@ -69,7 +73,7 @@ class TrackingManagerHelper
         // the container passed as the last argument.
         virtual void PostStepDoIt(G4Track& track, G4Step& step, G4TrackVector& secondaries) = 0;
 
-        virtual bool HasAtRestProcesses() { return false; }
+        virtual G4bool HasAtRestProcesses() { return false; }
 
         // This method is called when a track is stopped, but still alive. If
         // secondaries should be given back to the G4EventManager, put them into
@@ -100,6 +104,6 @@ class TrackingManagerHelper
     static void TrackNeutralParticle(G4Track* aTrack, PhysicsImpl& physics);
 };
 
-#include "TrackingManagerHelper.icc"
+#include "G4TrackingManagerHelper.icc"
 
 #endif
@@ -4,6 +4,7 @@
 geant4_add_module(G4phys_ctor_em
   PUBLIC_HEADERS
     G4ChargedUnknownPhysics.hh
+    G4EmBatchedTrackingManager.hh
     G4EmBuilder.hh
     G4EmDNABuilder.hh
     G4EmDNAChemistry.hh
@@ -38,12 +39,16 @@ geant4_add_module(G4phys_ctor_em
     G4EmStandardPhysics_option2.hh
     G4EmStandardPhysics_option3.hh
     G4EmStandardPhysics_option4.hh
+    G4EmStandardTrackingManager.hh
     G4GammaGeneralProcess.hh
     G4OpticalPhysics.hh
+    G4TrackingManagerHelper.hh
+    G4TrackingManagerHelper.icc
     G4ChemDissociationChannels.hh
     G4ChemDissociationChannels_option1.hh
   SOURCES
     G4ChargedUnknownPhysics.cc
+    G4EmBatchedTrackingManager.cc
     G4EmBuilder.cc
     G4EmDNABuilder.cc
     G4EmDNAChemistry.cc
@@ -78,6 +83,7 @@ geant4_add_module(G4phys_ctor_em
     G4EmStandardPhysics_option2.cc
     G4EmStandardPhysics_option3.cc
     G4EmStandardPhysics_option4.cc
+    G4EmStandardTrackingManager.cc
     G4GammaGeneralProcess.cc
     G4OpticalPhysics.cc
     G4ChemDissociationChannels.cc
@@ -95,6 +101,7 @@ geant4_module_link_libraries(G4phys_ctor_em
     G4baryons
     G4bosons
     G4cuts
+    G4detector
     G4emdna-man
     G4emdna-models
     G4emdna-molman
@@ -106,9 +113,11 @@ geant4_module_link_libraries(G4phys_ctor_em
     G4hadronic_util
     G4ions
     G4leptons
+    G4magneticfield
     G4materials
     G4mesons
     G4muons
+    G4navigation
     G4optical
     G4partman
     G4phys_builders
@@ -117,4 +126,5 @@ geant4_module_link_libraries(G4phys_ctor_em
     G4procman
     G4track
     G4transportation #NB Only for single enum in header
+    G4volumes
     G4xrays)
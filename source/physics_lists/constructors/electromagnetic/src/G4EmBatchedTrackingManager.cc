@@ -0,0 +1,441 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4EmBatchedTrackingManager
+//
+// Creation date: 18.10.2026
+//
+// Modifications:
+//
+// Class Description:
+//
+
+// -------------------------------------------------------------------
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+#include "G4EmBatchedTrackingManager.hh"
+#include "G4VEmProcess.hh"
+#include "G4EventManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4Region.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4TouchableHandle.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "G4UserSteppingAction.hh"
+#include "G4UserTrackingAction.hh"
+#include "G4VParticleChange.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSensitiveDetector.hh"
+#include "G4Log.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4EmBatchedTrackingManager* 
+G4EmBatchedTrackingManager::fMasterTrackingManager = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4EmBatchedTrackingManager::G4EmBatchedTrackingManager(G4int batchSize)
+  : fStep(std::make_unique<G4Step>()), fBatchSize(std::max(batchSize, 1))
+{
+  fStep->NewSecondaryVector();
+  if (nullptr == fMasterTrackingManager) { fMasterTrackingManager = this; }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4EmBatchedTrackingManager::~G4EmBatchedTrackingManager()
+{
+  fStep->DeleteSecondaryVector();
+  if (fMasterTrackingManager == this) { fMasterTrackingManager = nullptr; }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::AddEmProcess(G4VEmProcess* ptr)
+{
+  if (nullptr == ptr) { return; }
+  if (fMasterTrackingManager != this) {
+    const std::size_t idx = fProcesses.size();
+    if (idx < fMasterTrackingManager->fProcesses.size()) {
+      ptr->SetMasterProcess(fMasterTrackingManager->fProcesses[idx]);
+    }
+  }
+  fProcesses.push_back(ptr);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void 
+G4EmBatchedTrackingManager::PreparePhysicsTable(const G4ParticleDefinition& part)
+{
+  for (auto const & proc : fProcesses) {
+    if (proc->CrossSectionType() != fEmNoIntegral) {
+      G4ExceptionDescription ed;
+      ed << "Process " << proc->GetProcessName() 
+         << " uses the integral approach, which is not supported by"
+         << " the batched tracking manager.";
+      G4Exception("G4EmBatchedTrackingManager::PreparePhysicsTable", 
+                  "em0079", FatalException, ed);
+    }
+    proc->PreparePhysicsTable(part);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void 
+G4EmBatchedTrackingManager::BuildPhysicsTable(const G4ParticleDefinition& part)
+{
+  for (auto const & proc : fProcesses) { proc->BuildPhysicsTable(part); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::HandOverOneTrack(G4Track* aTrack)
+{
+  fPending.push_back(aTrack);
+  if (G4int(fPending.size()) >= fBatchSize) { ProcessBatch(); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::FlushEvent()
+{
+  while (!fPending.empty()) { ProcessBatch(); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::ProcessBatch()
+{
+  fNavigator = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking();
+  fLastNavigatedTrack = nullptr;
+
+  // take at most fBatchSize pending tracks
+  const std::size_t nTracks = std::min(fPending.size(), (std::size_t)fBatchSize);
+  const std::size_t nProc = fProcesses.size();
+  const std::size_t cap = nTracks;
+  fBatch.size = 0;
+  fBatch.capacity = cap;
+  fBatch.track.resize(cap);
+  fBatch.kinEnergy.resize(cap);
+  fBatch.logKinEnergy.resize(cap);
+  fBatch.couple.resize(cap);
+  fBatch.physicalStep.resize(cap);
+  fBatch.selected.resize(cap);
+  fBatch.nInteractionLengthLeft.resize(nProc*cap);
+  fBatch.lambda.resize(nProc*cap);
+  fBatch.secondaries.resize(cap);
+
+  const std::size_t first = fPending.size() - nTracks;
+  for (std::size_t k=first; k<fPending.size(); ++k) {
+    G4Track* track = fPending[k];
+    if (!StartTrack(track)) { continue; }
+    const std::size_t i = fBatch.size++;
+    fBatch.track[i] = track;
+    fBatch.kinEnergy[i] = track->GetKineticEnergy();
+    fBatch.logKinEnergy[i] = track->GetDynamicParticle()->GetLogKineticEnergy();
+    fBatch.couple[i] = fStep->GetPreStepPoint()->GetMaterialCutsCouple();
+    for (std::size_t p=0; p<nProc; ++p) {
+      fBatch.nInteractionLengthLeft[p*cap + i] = -G4Log(G4UniformRand());
+    }
+  }
+  fPending.resize(first);
+
+  while (fBatch.size > 0) {
+    const std::size_t n = fBatch.size;
+
+    // step limits of the whole batch
+    for (std::size_t p=0; p<nProc; ++p) {
+      fProcesses[p]->GetLambdas((G4int)n, fBatch.kinEnergy.data(),
+                                fBatch.logKinEnergy.data(),
+                                fBatch.couple.data(), &fBatch.lambda[p*cap]);
+    }
+    std::fill_n(fBatch.physicalStep.begin(), n, DBL_MAX);
+    std::fill_n(fBatch.selected.begin(), n, -1);
+    for (std::size_t p=0; p<nProc; ++p) {
+      const G4double* lambda = &fBatch.lambda[p*cap];
+      const G4double* nLeft = &fBatch.nInteractionLengthLeft[p*cap];
+      for (std::size_t i=0; i<n; ++i) {
+        const G4double x = (lambda[i] > 0.0) ? nLeft[i]/lambda[i] : DBL_MAX;
+        if (x < fBatch.physicalStep[i]) {
+          fBatch.physicalStep[i] = x;
+          fBatch.selected[i] = (G4int)p;
+        }
+      }
+    }
+
+    // transportation and interactions track by track
+    for (std::size_t i=0; i<n; ++i) { StepTrack(i); }
+
+    // remove the finished tracks keeping the arrays compact
+    for (std::size_t i=fBatch.size; i>0; --i) {
+      if (fBatch.track[i-1]->GetTrackStatus() != fAlive) { 
+        EndTrack(i-1); 
+        RemoveTrack(i-1);
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4bool G4EmBatchedTrackingManager::StartTrack(G4Track* aTrack)
+{
+  // locate the track in the mass geometry
+  const G4ThreeVector& pos = aTrack->GetPosition();
+  const G4ThreeVector& dir = aTrack->GetMomentumDirection();
+  G4TouchableHandle touchableHandle;
+  if (aTrack->GetTouchableHandle()) {
+    touchableHandle = aTrack->GetTouchableHandle();
+    auto touchableHistory = (G4TouchableHistory*)touchableHandle();
+    G4VPhysicalVolume* oldTopVolume = touchableHandle->GetVolume();
+    G4VPhysicalVolume* newTopVolume =
+      fNavigator->ResetHierarchyAndLocate(pos, dir, *touchableHistory);
+    if (newTopVolume != oldTopVolume || 
+        oldTopVolume->GetRegularStructureId() == 1) {
+      touchableHandle = fNavigator->CreateTouchableHistory();
+      aTrack->SetTouchableHandle(touchableHandle);
+    }
+  } else {
+    fNavigator->LocateGlobalPointAndSetup(pos, &dir, false, false);
+    touchableHandle = fNavigator->CreateTouchableHistory();
+    aTrack->SetTouchableHandle(touchableHandle);
+  }
+  aTrack->SetNextTouchableHandle(touchableHandle);
+  fLastNavigatedTrack = aTrack;
+
+  if (nullptr == touchableHandle->GetVolume()) {
+    // the track starts outside the world
+    aTrack->SetTrackStatus(fStopAndKill);
+  } else {
+    fStep->InitializeStep(aTrack);
+  }
+  aTrack->SetStep(fStep.get());
+
+  auto evtMgr = G4EventManager::GetEventManager();
+  G4UserTrackingAction* userTrackingAction = evtMgr->GetUserTrackingAction();
+  if (nullptr != userTrackingAction) {
+    userTrackingAction->PreUserTrackingAction(aTrack);
+  }
+  for (auto const & proc : fProcesses) { proc->StartTracking(aTrack); }
+
+  if (aTrack->GetTrackStatus() == fAlive) { return true; }
+
+  // killed by the user before the first step
+  for (auto const & proc : fProcesses) { proc->EndTracking(); }
+  if (nullptr != userTrackingAction) {
+    userTrackingAction->PostUserTrackingAction(aTrack);
+  }
+  delete aTrack;
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::StepTrack(std::size_t i)
+{
+  G4Track* track = fBatch.track[i];
+  G4Step& step = *fStep;
+  G4StepPoint* postStepPoint = step.GetPostStepPoint();
+
+  // load the track into the step
+  track->IncrementCurrentStepNumber();
+  track->SetTouchableHandle(track->GetNextTouchableHandle());
+  step.InitializeStep(track);
+  step.GetfSecondary()->clear();
+  track->SetStep(&step);
+
+  const G4ThreeVector startPosition = track->GetPosition();
+  const G4ThreeVector& dir = track->GetMomentumDirection();
+  if (track != fLastNavigatedTrack) {
+    auto touchableHistory = (G4TouchableHistory*)(track->GetTouchableHandle()());
+    fNavigator->ResetHierarchyAndLocate(startPosition, dir, *touchableHistory);
+    fLastNavigatedTrack = track;
+  }
+
+  // transportation along a straight line
+  const G4double physicalStep = fBatch.physicalStep[i];
+  G4double safety = 0.0;
+  const G4double linearStep = 
+    fNavigator->ComputeStep(startPosition, dir, physicalStep, safety);
+  const G4bool geometryLimited = (linearStep < physicalStep);
+  const G4double stepLength = (geometryLimited) ? linearStep : physicalStep;
+
+  step.SetStepLength(stepLength);
+  track->SetStepLength(stepLength);
+  postStepPoint->SetPosition(startPosition + stepLength*dir);
+  postStepPoint->SetSafety(std::max(safety - stepLength, 0.0));
+  const G4double velocity = step.GetPreStepPoint()->GetVelocity();
+  if (velocity > 0.0) {
+    const G4double deltaTime = stepLength/velocity;
+    postStepPoint->AddGlobalTime(deltaTime);
+    postStepPoint->AddLocalTime(deltaTime);
+    postStepPoint->AddProperTime(deltaTime*track->GetDynamicParticle()->GetMass()
+                                 /track->GetTotalEnergy());
+  }
+
+  G4TouchableHandle touchableHandle = track->GetTouchableHandle();
+  if (geometryLimited) {
+    fNavigator->SetGeometricallyLimitedStep();
+    fNavigator->LocateGlobalPointAndUpdateTouchableHandle(
+      postStepPoint->GetPosition(), dir, touchableHandle, true);
+    const G4VPhysicalVolume* newVolume = touchableHandle->GetVolume();
+    postStepPoint->SetStepStatus((nullptr == newVolume) ? fWorldBoundary 
+                                                        : fGeomBoundary);
+    if (nullptr != newVolume) {
+      const G4LogicalVolume* lvol = newVolume->GetLogicalVolume();
+      postStepPoint->SetMaterial(lvol->GetMaterial());
+      postStepPoint->SetMaterialCutsCouple(lvol->GetMaterialCutsCouple());
+      postStepPoint->SetSensitiveDetector(lvol->GetSensitiveDetector());
+    }
+  } else {
+    fNavigator->LocateGlobalPointWithinVolume(postStepPoint->GetPosition());
+    postStepPoint->SetStepStatus(fPostStepDoItProc);
+  }
+  postStepPoint->SetTouchableHandle(touchableHandle);
+  step.UpdateTrack();
+  if (nullptr == touchableHandle->GetVolume()) { 
+    track->SetTrackStatus(fStopAndKill); 
+  }
+
+  // update the number of interaction lengths left of all processes
+  const std::size_t cap = fBatch.capacity;
+  const std::size_t nProc = fProcesses.size();
+  for (std::size_t p=0; p<nProc; ++p) {
+    G4double& nLeft = fBatch.nInteractionLengthLeft[p*cap + i];
+    nLeft = std::max(nLeft - stepLength*fBatch.lambda[p*cap + i], 0.0);
+  }
+
+  // interaction
+  const G4int sel = fBatch.selected[i];
+  if (!geometryLimited && sel >= 0 && track->GetTrackStatus() == fAlive) {
+    G4VEmProcess* proc = fProcesses[sel];
+
+    // select material and model of the process for this track
+    proc->GetLambda(fBatch.kinEnergy[i], fBatch.couple[i], 
+                    fBatch.logKinEnergy[i]);
+    postStepPoint->SetProcessDefinedStep(proc);
+    G4VParticleChange* particleChange = proc->PostStepDoIt(*track, step);
+    particleChange->UpdateStepForPostStep(&step);
+    step.UpdateTrack();
+
+    const G4int nSecondaries = particleChange->GetNumberOfSecondaries();
+    for (G4int k=0; k<nSecondaries; ++k) {
+      G4Track* secondary = particleChange->GetSecondary(k);
+      secondary->SetParentID(track->GetTrackID());
+      secondary->SetCreatorProcess(proc);
+      fBatch.secondaries[i].push_back(secondary);
+      step.GetfSecondary()->push_back(secondary);
+    }
+    track->SetTrackStatus(particleChange->GetTrackStatus());
+    particleChange->Clear();
+    fBatch.nInteractionLengthLeft[sel*cap + i] = -G4Log(G4UniformRand());
+  }
+  if (track->GetTrackStatus() == fAlive && track->GetKineticEnergy() < DBL_MIN) {
+    track->SetTrackStatus(fStopAndKill);
+  }
+  track->AddTrackLength(stepLength);
+
+  // sensitive detector and stepping actions
+  G4VSensitiveDetector* sensitive = step.GetPreStepPoint()->GetSensitiveDetector();
+  if (nullptr != sensitive && step.GetControlFlag() != AvoidHitInvocation) {
+    sensitive->Hit(&step);
+  }
+  G4UserSteppingAction* userSteppingAction = 
+    G4EventManager::GetEventManager()->GetUserSteppingAction();
+  if (nullptr != userSteppingAction) {
+    userSteppingAction->UserSteppingAction(&step);
+  }
+  const G4LogicalVolume* lvol = step.GetPreStepPoint()->GetPhysicalVolume()
+    ->GetLogicalVolume();
+  G4UserSteppingAction* regionalAction = 
+    lvol->GetRegion()->GetRegionalSteppingAction();
+  if (nullptr != regionalAction) {
+    regionalAction->UserSteppingAction(&step);
+  }
+
+  // new state of the track
+  fBatch.kinEnergy[i] = track->GetKineticEnergy();
+  fBatch.logKinEnergy[i] = track->GetDynamicParticle()->GetLogKineticEnergy();
+  if (track->GetTrackStatus() == fAlive) {
+    fBatch.couple[i] = postStepPoint->GetMaterialCutsCouple();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::EndTrack(std::size_t i)
+{
+  G4Track* track = fBatch.track[i];
+  for (auto const & proc : fProcesses) { proc->EndTracking(); }
+
+  auto evtMgr = G4EventManager::GetEventManager();
+  G4UserTrackingAction* userTrackingAction = evtMgr->GetUserTrackingAction();
+  if (nullptr != userTrackingAction) {
+    userTrackingAction->PostUserTrackingAction(track);
+  }
+  evtMgr->StackTracks(&fBatch.secondaries[i]);
+  fBatch.secondaries[i].clear();
+  if (fLastNavigatedTrack == track) { fLastNavigatedTrack = nullptr; }
+  delete track;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmBatchedTrackingManager::RemoveTrack(std::size_t i)
+{
+  const std::size_t last = --fBatch.size;
+  if (i == last) { return; }
+  const std::size_t cap = fBatch.capacity;
+  fBatch.track[i] = fBatch.track[last];
+  fBatch.kinEnergy[i] = fBatch.kinEnergy[last];
+  fBatch.logKinEnergy[i] = fBatch.logKinEnergy[last];
+  fBatch.couple[i] = fBatch.couple[last];
+  for (std::size_t p=0; p<fProcesses.size(); ++p) {
+    fBatch.nInteractionLengthLeft[p*cap + i] = 
+      fBatch.nInteractionLengthLeft[p*cap + last];
+  }
+  std::swap(fBatch.secondaries[i], fBatch.secondaries[last]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
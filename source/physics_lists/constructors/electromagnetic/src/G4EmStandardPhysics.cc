@@ -75,6 +75,7 @@
 #include "G4BuilderType.hh"
 #include "G4EmModelActivator.hh"
 #include "G4GammaGeneralProcess.hh"
+#include "G4EmStandardTrackingManager.hh"
 
 // factory
 #include "G4PhysicsConstructorFactory.hh"
@@ -133,93 +134,104 @@ void G4EmStandardPhysics::ConstructProcess()
   // high energy limit for e+- scattering models and bremsstrahlung
   G4double highEnergyLimit = param->MscEnergyLimit();
 
-  // Add gamma EM Processes
-  G4ParticleDefinition* particle = G4Gamma::Gamma();
-  G4bool polar = param->EnablePolarisation();
+  G4ParticleDefinition* particle = nullptr;
 
-  // Photoelectric
-  G4PhotoElectricEffect* pe = new G4PhotoElectricEffect();
-  G4VEmModel* peModel = new G4LivermorePhotoElectricModel();
-  pe->SetEmModel(peModel);
-  if(polar) {
-    peModel->SetAngularDistribution(new G4PhotoElectricAngularGeneratorPolarized());
-  }
-
-  // Compton scattering
-  G4ComptonScattering* cs = new G4ComptonScattering;
-  if(polar) {
-    cs->SetEmModel(new G4KleinNishinaModel());
-  }
-
-  // default Rayleigh scattering is Livermore
-  G4RayleighScattering* rl = new G4RayleighScattering();
-  if(polar) {
-    rl->SetEmModel(new G4LivermorePolarizedRayleighModel());
-  }
-
-  if(G4EmParameters::Instance()->GeneralProcessActive()) {
-    G4GammaGeneralProcess* sp = new G4GammaGeneralProcess();
-    sp->AddEmProcess(pe);
-    sp->AddEmProcess(cs);
-    sp->AddEmProcess(new G4GammaConversion());
-    sp->AddEmProcess(rl);
-    G4LossTableManager::Instance()->SetGammaGeneralProcess(sp);
-    ph->RegisterProcess(sp, particle);
+  if(param->EmTrackingManagerActive()) {
+    // e+-, gamma are tracked by the specialised tracking manager
+    auto tm = new G4EmStandardTrackingManager();
+    G4Gamma::Gamma()->SetTrackingManager(tm);
+    G4Electron::Electron()->SetTrackingManager(tm);
+    G4Positron::Positron()->SetTrackingManager(tm);
 
   } else {
-    ph->RegisterProcess(pe, particle);
-    ph->RegisterProcess(cs, particle);
-    ph->RegisterProcess(new G4GammaConversion(), particle);
-    ph->RegisterProcess(rl, particle);
-  }
-
-  // e-
-  particle = G4Electron::Electron();
-
-  G4UrbanMscModel* msc1 = new G4UrbanMscModel();
-  G4WentzelVIModel* msc2 = new G4WentzelVIModel();
-  msc1->SetHighEnergyLimit(highEnergyLimit);
-  msc2->SetLowEnergyLimit(highEnergyLimit);
-  G4EmBuilder::ConstructElectronMscProcess(msc1, msc2, particle);
-
-  G4eCoulombScatteringModel* ssm = new G4eCoulombScatteringModel(); 
-  G4CoulombScattering* ss = new G4CoulombScattering();
-  ss->SetEmModel(ssm); 
-  ss->SetMinKinEnergy(highEnergyLimit);
-  ssm->SetLowEnergyLimit(highEnergyLimit);
-  ssm->SetActivationLowEnergyLimit(highEnergyLimit);
-
-  ph->RegisterProcess(new G4eIonisation(), particle);
-  ph->RegisterProcess(new G4eBremsstrahlung(), particle);
-  ph->RegisterProcess(ss, particle);
-
-  // e+
-  particle = G4Positron::Positron();
-
-  msc1 = new G4UrbanMscModel();
-  msc2 = new G4WentzelVIModel();
-  msc1->SetHighEnergyLimit(highEnergyLimit);
-  msc2->SetLowEnergyLimit(highEnergyLimit);
-  G4EmBuilder::ConstructElectronMscProcess(msc1, msc2, particle);
-
-  ssm = new G4eCoulombScatteringModel(); 
-  ss = new G4CoulombScattering();
-  ss->SetEmModel(ssm); 
-  ss->SetMinKinEnergy(highEnergyLimit);
-  ssm->SetLowEnergyLimit(highEnergyLimit);
-  ssm->SetActivationLowEnergyLimit(highEnergyLimit);
-
-  // annihilation
-  auto anni = new G4eplusAnnihilation();
-  if (param->Use3GammaAnnihilationOnFly()) {
-    anni->SetEmModel(new G4eplusTo2or3GammaModel());
+    // Add gamma EM Processes
+    particle = G4Gamma::Gamma();
+    G4bool polar = param->EnablePolarisation();
+
+    // Photoelectric
+    G4PhotoElectricEffect* pe = new G4PhotoElectricEffect();
+    G4VEmModel* peModel = new G4LivermorePhotoElectricModel();
+    pe->SetEmModel(peModel);
+    if(polar) {
+      peModel->SetAngularDistribution(new G4PhotoElectricAngularGeneratorPolarized());
+    }
+
+    // Compton scattering
+    G4ComptonScattering* cs = new G4ComptonScattering;
+    if(polar) {
+      cs->SetEmModel(new G4KleinNishinaModel());
+    }
+
+    // default Rayleigh scattering is Livermore
+    G4RayleighScattering* rl = new G4RayleighScattering();
+    if(polar) {
+      rl->SetEmModel(new G4LivermorePolarizedRayleighModel());
+    }
+
+    if(G4EmParameters::Instance()->GeneralProcessActive()) {
+      G4GammaGeneralProcess* sp = new G4GammaGeneralProcess();
+      sp->AddEmProcess(pe);
+      sp->AddEmProcess(cs);
+      sp->AddEmProcess(new G4GammaConversion());
+      sp->AddEmProcess(rl);
+      G4LossTableManager::Instance()->SetGammaGeneralProcess(sp);
+      ph->RegisterProcess(sp, particle);
+
+    } else {
+      ph->RegisterProcess(pe, particle);
+      ph->RegisterProcess(cs, particle);
+      ph->RegisterProcess(new G4GammaConversion(), particle);
+      ph->RegisterProcess(rl, particle);
+    }
+
+    // e-
+    particle = G4Electron::Electron();
+
+    G4UrbanMscModel* msc1 = new G4UrbanMscModel();
+    G4WentzelVIModel* msc2 = new G4WentzelVIModel();
+    msc1->SetHighEnergyLimit(highEnergyLimit);
+    msc2->SetLowEnergyLimit(highEnergyLimit);
+    G4EmBuilder::ConstructElectronMscProcess(msc1, msc2, particle);
+
+    G4eCoulombScatteringModel* ssm = new G4eCoulombScatteringModel(); 
+    G4CoulombScattering* ss = new G4CoulombScattering();
+    ss->SetEmModel(ssm); 
+    ss->SetMinKinEnergy(highEnergyLimit);
+    ssm->SetLowEnergyLimit(highEnergyLimit);
+    ssm->SetActivationLowEnergyLimit(highEnergyLimit);
+
+    ph->RegisterProcess(new G4eIonisation(), particle);
+    ph->RegisterProcess(new G4eBremsstrahlung(), particle);
+    ph->RegisterProcess(ss, particle);
+
+    // e+
+    particle = G4Positron::Positron();
+
+    msc1 = new G4UrbanMscModel();
+    msc2 = new G4WentzelVIModel();
+    msc1->SetHighEnergyLimit(highEnergyLimit);
+    msc2->SetLowEnergyLimit(highEnergyLimit);
+    G4EmBuilder::ConstructElectronMscProcess(msc1, msc2, particle);
+
+    ssm = new G4eCoulombScatteringModel(); 
+    ss = new G4CoulombScattering();
+    ss->SetEmModel(ssm); 
+    ss->SetMinKinEnergy(highEnergyLimit);
+    ssm->SetLowEnergyLimit(highEnergyLimit);
+    ssm->SetActivationLowEnergyLimit(highEnergyLimit);
+
+    // annihilation
+    auto anni = new G4eplusAnnihilation();
+    if (param->Use3GammaAnnihilationOnFly()) {
+      anni->SetEmModel(new G4eplusTo2or3GammaModel());
+    }
+
+    ph->RegisterProcess(new G4eIonisation(), particle);
+    ph->RegisterProcess(new G4eBremsstrahlung(), particle);
+    ph->RegisterProcess(anni, particle);
+    ph->RegisterProcess(ss, particle);
   }
 
-  ph->RegisterProcess(new G4eIonisation(), particle);
-  ph->RegisterProcess(new G4eBremsstrahlung(), particle);
-  ph->RegisterProcess(anni, particle);
-  ph->RegisterProcess(ss, particle);
-
   // generic ion
   particle = G4GenericIon::GenericIon();
   G4ionIonisation* ionIoni = new G4ionIonisation();
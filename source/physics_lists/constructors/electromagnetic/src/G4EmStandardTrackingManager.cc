@@ -23,14 +23,25 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-// Implementation of a custom tracking manager for e-/e+ and gamma, using
-// the same processes as defined in G4EmStandardPhysics.
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4EmStandardTrackingManager
+//
+// Creation date: 18.10.2026
+//
+// Original author: J.Hahnfeld, 2021 - extended example RE07
+//
+// Modifications:
+//
+// -------------------------------------------------------------------
 //
-// Original author: Jonas Hahnfeld, 2021
 
-#include "EmStandardPhysicsTrackingManager.hh"
+#include "G4EmStandardTrackingManager.hh"
 
-#include "TrackingManagerHelper.hh"
+#include "G4TrackingManagerHelper.hh"
 
 #include "G4ComptonScattering.hh"
 #include "G4CoulombScattering.hh"
@@ -53,15 +64,16 @@
 #include "G4eIonisation.hh"
 #include "G4eMultipleScattering.hh"
 #include "G4eplusAnnihilation.hh"
+#include "G4eplusTo2or3GammaModel.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-EmStandardPhysicsTrackingManager* EmStandardPhysicsTrackingManager::fMasterTrackingManager =
-  nullptr;
+G4EmStandardTrackingManager*
+G4EmStandardTrackingManager::fMasterTrackingManager = nullptr;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-EmStandardPhysicsTrackingManager::EmStandardPhysicsTrackingManager()
+G4EmStandardTrackingManager::G4EmStandardTrackingManager()
 {
   G4EmParameters* param = G4EmParameters::Instance();
   G4double highEnergyLimit = param->MscEnergyLimit();
@@ -103,7 +115,11 @@ EmStandardPhysicsTrackingManager::EmStandardPhysicsTrackingManager()
 
     fPositronProcs.ioni = new G4eIonisation;
     fPositronProcs.brems = new G4eBremsstrahlung;
-    fPositronProcs.annihilation = new G4eplusAnnihilation;
+    auto anni = new G4eplusAnnihilation;
+    if (param->Use3GammaAnnihilationOnFly()) {
+      anni->SetEmModel(new G4eplusTo2or3GammaModel);
+    }
+    fPositronProcs.annihilation = anni;
 
     G4CoulombScattering* ss = new G4CoulombScattering;
     G4eCoulombScatteringModel* ssm = new G4eCoulombScatteringModel;
@@ -114,6 +130,7 @@ EmStandardPhysicsTrackingManager::EmStandardPhysicsTrackingManager()
     fPositronProcs.ss = ss;
   }
 
+  // gamma
   {
     G4PhotoElectricEffect* pe = new G4PhotoElectricEffect;
     G4VEmModel* peModel = new G4LivermorePhotoElectricModel;
@@ -163,7 +180,7 @@ EmStandardPhysicsTrackingManager::EmStandardPhysicsTrackingManager()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-EmStandardPhysicsTrackingManager::~EmStandardPhysicsTrackingManager()
+G4EmStandardTrackingManager::~G4EmStandardTrackingManager()
 {
   if (fMasterTrackingManager == this) {
     fMasterTrackingManager = nullptr;
@@ -172,7 +189,7 @@ EmStandardPhysicsTrackingManager::~EmStandardPhysicsTrackingManager()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EmStandardPhysicsTrackingManager::BuildPhysicsTable(const G4ParticleDefinition& part)
+void G4EmStandardTrackingManager::BuildPhysicsTable(const G4ParticleDefinition& part)
 {
   if (&part == G4Electron::Definition()) {
     fElectronProcs.msc->BuildPhysicsTable(part);
@@ -197,7 +214,7 @@ void EmStandardPhysicsTrackingManager::BuildPhysicsTable(const G4ParticleDefinit
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EmStandardPhysicsTrackingManager::PreparePhysicsTable(const G4ParticleDefinition& part)
+void G4EmStandardTrackingManager::PreparePhysicsTable(const G4ParticleDefinition& part)
 {
   if (&part == G4Electron::Definition()) {
     fElectronProcs.msc->PreparePhysicsTable(part);
@@ -222,12 +239,12 @@ void EmStandardPhysicsTrackingManager::PreparePhysicsTable(const G4ParticleDefin
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EmStandardPhysicsTrackingManager::TrackElectron(G4Track* aTrack)
+void G4EmStandardTrackingManager::TrackElectron(G4Track* aTrack)
 {
-  class ElectronPhysics final : public TrackingManagerHelper::Physics
+  class ElectronPhysics final : public G4TrackingManagerHelper::Physics
   {
     public:
-      ElectronPhysics(EmStandardPhysicsTrackingManager& mgr) : fMgr(mgr) {}
+      ElectronPhysics(G4EmStandardTrackingManager& mgr) : fMgr(mgr) {}
 
       void StartTracking(G4Track* aTrack) override
       {
@@ -366,24 +383,24 @@ void EmStandardPhysicsTrackingManager::TrackElectron(G4Track* aTrack)
       }
 
     private:
-      EmStandardPhysicsTrackingManager& fMgr;
+      G4EmStandardTrackingManager& fMgr;
       G4double fPreviousStepLength;
       G4double fProposedStep;
       G4int fSelected;
   };
 
   ElectronPhysics physics(*this);
-  TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
+  G4TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EmStandardPhysicsTrackingManager::TrackPositron(G4Track* aTrack)
+void G4EmStandardTrackingManager::TrackPositron(G4Track* aTrack)
 {
-  class PositronPhysics final : public TrackingManagerHelper::Physics
+  class PositronPhysics final : public G4TrackingManagerHelper::Physics
   {
     public:
-      PositronPhysics(EmStandardPhysicsTrackingManager& mgr) : fMgr(mgr) {}
+      PositronPhysics(G4EmStandardTrackingManager& mgr) : fMgr(mgr) {}
 
       void StartTracking(G4Track* aTrack) override
       {
@@ -557,24 +574,24 @@ void EmStandardPhysicsTrackingManager::TrackPositron(G4Track* aTrack)
       }
 
     private:
-      EmStandardPhysicsTrackingManager& fMgr;
+      G4EmStandardTrackingManager& fMgr;
       G4double fPreviousStepLength;
       G4double fProposedStep;
       G4int fSelected;
   };
 
   PositronPhysics physics(*this);
-  TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
+  G4TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EmStandardPhysicsTrackingManager::TrackGamma(G4Track* aTrack)
+void G4EmStandardTrackingManager::TrackGamma(G4Track* aTrack)
 {
-  class GammaPhysics final : public TrackingManagerHelper::Physics
+  class GammaPhysics final : public G4TrackingManagerHelper::Physics
   {
     public:
-      GammaPhysics(EmStandardPhysicsTrackingManager& mgr) : fMgr(mgr) {}
+      GammaPhysics(G4EmStandardTrackingManager& mgr) : fMgr(mgr) {}
 
       void StartTracking(G4Track* aTrack) override
       {
@@ -691,19 +708,19 @@ void EmStandardPhysicsTrackingManager::TrackGamma(G4Track* aTrack)
       }
 
     private:
-      EmStandardPhysicsTrackingManager& fMgr;
+      G4EmStandardTrackingManager& fMgr;
       G4double fPreviousStepLength;
       G4double fProposedStep;
       G4int fSelected;
   };
 
   GammaPhysics physics(*this);
-  TrackingManagerHelper::TrackNeutralParticle(aTrack, physics);
+  G4TrackingManagerHelper::TrackNeutralParticle(aTrack, physics);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EmStandardPhysicsTrackingManager::HandOverOneTrack(G4Track* aTrack)
+void G4EmStandardTrackingManager::HandOverOneTrack(G4Track* aTrack)
 {
   const G4ParticleDefinition* part = aTrack->GetParticleDefinition();
 
@@ -722,3 +739,4 @@ void EmStandardPhysicsTrackingManager::HandOverOneTrack(G4Track* aTrack)
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
@@ -36,7 +36,9 @@
 // Creation date: 29.05.2008
 //
 // Modifications:
-//
+// 18.10.26 The normalised cumulative cross sections of all elements are
+//          kept in one table on the shared energy grid, the element is
+//          found by a binary search for materials with many elements
 //
 // Class Description:
 //
@@ -55,6 +57,7 @@
 #include "G4ElementVector.hh"
 #include "G4PhysicsLogVector.hh"
 #include "Randomize.hh"
+#include "G4Log.hh"
 #include <vector>
 
 class G4VEmModel;
@@ -87,18 +90,31 @@ public:
 
 private:
 
+  // index of the element for the random number x, the probabilities
+  // are interpolated between the nodes idx and idx+1 
+  inline G4int FindElement(const G4double x, const std::size_t idx,
+                           const G4double a) const;
+
   G4VEmModel*       model;
   const G4Material* material;
   const G4ElementVector* theElementVector;
 
   G4int    nElmMinusOne;
   G4int    nbins;
+  G4int    nElm;
 
   G4double cutEnergy;
   G4double lowEnergy;
   G4double highEnergy;
 
-  std::vector<G4PhysicsLogVector*> xSections;
+  // binary search is used if probabilities are monotonic
+  G4bool   binarySearch = false;
+
+  // energy grid shared by all elements, its values are not used
+  G4PhysicsLogVector* energyGrid = nullptr;
+
+  // cumulative probabilities, nElm values per energy node
+  std::vector<G4double> xSections;
   
 };
 
@@ -107,18 +123,38 @@ private:
 
 inline const G4Element* G4EmElementSelector::SelectRandomAtom(G4double e) const
 {
-  const G4Element* element = (*theElementVector)[nElmMinusOne];
-  if (nElmMinusOne > 0) {
-    G4double x = G4UniformRand();
-    size_t idx(0);
-    for(G4int i=0; i<nElmMinusOne; ++i) {
-      if (x <= (xSections[i])->Value(e, idx)) {
-        element = (*theElementVector)[i];
-        break;
+  return (nElmMinusOne > 0) ? SelectRandomAtom(e, G4Log(e))
+    : (*theElementVector)[0];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
+
+inline G4int G4EmElementSelector::FindElement(const G4double x,
+                                              const std::size_t idx,
+                                              const G4double a) const
+{
+  const G4double* y1 = &xSections[idx*nElm];
+  const G4double* y2 = y1 + nElm;
+  G4int i = 0;
+  if (binarySearch) {
+    // first element with x <= y in the range [0, nElmMinusOne]
+    G4int n = nElmMinusOne;
+    while (n > 0) {
+      const G4int half = n/2;
+      const G4int j = i + half;
+      if (x <= y1[j] + a*(y2[j] - y1[j])) {
+        n = half;
+      } else {
+        i = j + 1;
+        n -= half + 1;
       }
     }
+  } else {
+    for (; i < nElmMinusOne; ++i) {
+      if (x <= y1[i] + a*(y2[i] - y1[i])) { break; }
+    }
   }
-  return element;
+  return i;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class header file
+//
+// File name:     G4EmLazyTable
+//
+// Creation date: 18.10.2026
+//
+// Modifications:
+//
+// Class Description:
+//
+// Build state of the tables of a process, which vectors are built on
+// first use of each material-cuts couple. The object is created by the
+// master process and shared by the worker processes: the vectors of a
+// couple are filled once, under the lock of this object, by the thread
+// which first needs them. The list of objects is kept to report which
+// couples were used in the job.
+//
+// Class Description: End
+
+// -------------------------------------------------------------------
+//
+
+#ifndef G4EmLazyTable_h
+#define G4EmLazyTable_h 1
+
+#include "globals.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+class G4EmLazyTable
+{
+public:
+
+  // nCouples - number of couples, all couples are not built
+  G4EmLazyTable(const G4String& name, std::size_t nCouples);
+
+  ~G4EmLazyTable();
+
+  inline G4bool IsBuilt(std::size_t idx) const;
+
+  // marks a couple which does not need to be built
+  void SetBuilt(std::size_t idx);
+
+  // calls func once for the couple, thread safe
+  void Build(std::size_t idx, const std::function<void()>& func);
+
+  std::size_t NumberOfCouples() const { return nCouples; }
+  std::size_t NumberOfBuiltCouples() const;
+
+  const G4String& GetName() const { return fName; }
+
+  // used couples of all existing objects
+  static void Report(std::ostream& out);
+
+  G4EmLazyTable& operator=(const G4EmLazyTable& right) = delete;
+  G4EmLazyTable(const G4EmLazyTable&) = delete;
+
+private:
+
+  G4String fName;
+  std::size_t nCouples;
+  std::unique_ptr<std::atomic<G4bool>[]> fBuilt;
+  // couples built on demand, in the order of first use
+  std::vector<std::size_t> fUsed;
+  G4Mutex fMutex;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+inline G4bool G4EmLazyTable::IsBuilt(std::size_t idx) const
+{
+  return fBuilt[idx].load(std::memory_order_acquire);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+#endif
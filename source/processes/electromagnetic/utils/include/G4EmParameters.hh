@@ -199,6 +199,27 @@ public:
   void SetGeneralProcessActive(G4bool val);
   G4bool GeneralProcessActive() const;
 
+  // if enabled, e+, e- and gamma are tracked by the specialised
+  // G4EmStandardTrackingManager instead of the generic stepping loop
+  void SetEmTrackingManagerActive(G4bool val);
+  G4bool EmTrackingManagerActive() const;
+
+  // if enabled, the physics vectors of the tables built afterwards are
+  // packed, see G4PhysicsVector::Pack()
+  void SetPackedPhysicsVectors(G4bool val);
+  G4bool PackedPhysicsVectors() const;
+
+  // if enabled, the range, inverse range and spline coefficients of the
+  // vectors of different couples are built in tasks of the thread pool
+  // of the task-based run manager, see G4LossTableBuilder
+  void SetParallelTableBuild(G4bool val);
+  G4bool ParallelTableBuild() const;
+
+  // if enabled, lambda tables of discrete processes are filled for
+  // a couple only when it is used for the first time
+  void SetLazyTableBuild(G4bool val);
+  G4bool LazyTableBuild() const;
+
   void SetEnableSamplingTable(G4bool val);
   G4bool EnableSamplingTable() const;
 
@@ -449,6 +470,10 @@ private:
   G4bool birks;
   G4bool fICRU90;
   G4bool gener;
+  G4bool fEmTrackingManager;
+  G4bool fPackedVectors;
+  G4bool fParallelTables;
+  G4bool fLazyTables;
   G4bool fSamplingTable;
   G4bool fPolarisation;
   G4bool fMuDataFromFile;
@@ -98,6 +98,10 @@ private:
   G4UIcmdWithABool* mottCmd;
   G4UIcmdWithABool* birksCmd;
   G4UIcmdWithABool* sharkCmd;
+  G4UIcmdWithABool* emtmCmd;
+  G4UIcmdWithABool* packCmd;
+  G4UIcmdWithABool* parTabCmd;
+  G4UIcmdWithABool* lazyTabCmd;
   G4UIcmdWithABool* poCmd;
   G4UIcmdWithABool* onIsolatedCmd;
   G4UIcmdWithABool* sampleTCmd;
@@ -147,6 +151,7 @@ private:
   G4UIcmdWithAString*        posiCmd;
 
   G4UIcommand*               dumpCmd;
+  G4UIcommand*               lazyDumpCmd;
 
 };
 
@@ -81,6 +81,22 @@ public:
                                const G4bool startFromNull,
                                const G4bool splineFlag);
 
+  // fill lambda vectors of the couple idx, the spline is computed
+  // if splineVectors is nullptr, otherwise the vectors are added to it
+  static void FillLambdaVectors(G4VEmProcess* proc,
+                                const G4ParticleDefinition* part,
+                                G4EmModelManager* modelManager,
+                                G4PhysicsTable* theLambdaTable,
+                                G4PhysicsTable* theLambdaTablePrim,
+                                const std::size_t idx,
+                                const G4double minKinEnergy,
+                                const G4double minKinEnergyPrim,
+                                const G4double maxKinEnergy,
+                                const G4double scale,
+                                const G4bool startFromNull,
+                                const G4bool splineFlag,
+                                std::vector<G4PhysicsVector*>* splineVectors);
+
   static void BuildLambdaTable(G4VEnergyLossProcess* proc,
                                const G4ParticleDefinition* part,
                                G4EmModelManager* modelManager,
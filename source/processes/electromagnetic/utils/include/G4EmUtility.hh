@@ -68,6 +68,9 @@ public:
   static std::vector<G4double>* 
   FindCrossSectionMax(G4VDiscreteProcess*, const G4ParticleDefinition*);
 
+  // energy of the first maximum of the vector, DBL_MAX if no peak
+  static G4double FindCrossSectionMax(const G4PhysicsVector*);
+
   // fill structure describing more than one peak in cross sections
   static std::vector<G4TwoPeaksXS*>*
   FillPeaksStructure(G4PhysicsTable*, G4LossTableBuilder*);
@@ -41,6 +41,10 @@
 // Class Description: 
 //
 // Provide building of dE/dx, range, and inverse range tables.
+// If enabled by G4EmParameters::SetParallelTableBuild(), the vectors of
+// different couples are computed in tasks of the thread pool of the
+// task-based run manager, the result does not depend on the number
+// of threads.
 
 // -------------------------------------------------------------------
 //
@@ -48,6 +52,7 @@
 #ifndef G4LossTableBuilder_h
 #define G4LossTableBuilder_h 1
 
+#include <functional>
 #include <vector>
 #include "globals.hh"
 #include "G4PhysicsTable.hh"
@@ -87,6 +92,12 @@ public:
   // initialise base materials
   void InitialiseBaseMaterials(const G4PhysicsTable* table=nullptr);
 
+  // call func(i) for i in [0, n), concurrently in the master thread if
+  // parallel build is enabled and a thread pool is available;
+  // func must only modify data owned by the index i
+  void ParallelFor(std::size_t n,
+                   const std::function<void(std::size_t)>& func) const;
+
   // access methods
   static const std::vector<G4int>* GetCoupleIndexes();
 
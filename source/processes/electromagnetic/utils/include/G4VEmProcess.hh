@@ -60,6 +60,7 @@
 #include "G4EmDataHandler.hh"
 #include "G4EmTableType.hh"
 #include "G4EmModelManager.hh"
+#include "G4EmLazyTable.hh"
 #include "G4EmSecondaryParticleType.hh"
 
 class G4Step;
@@ -144,6 +145,14 @@ public:
                             const G4MaterialCutsCouple* couple,
                             G4double logKinEnergy);
 
+  // Cross sections per volume of n particles at once, used by batched
+  // tracking loops; zero is returned where the process is not active.
+  // Grouping the particles by couple reduces the material switches
+  void GetLambdas(G4int n, const G4double* kinEnergy,
+                  const G4double* logKinEnergy,
+                  const G4MaterialCutsCouple* const* couple,
+                  G4double* lambda);
+
   // It returns the cross section per volume for energy/material
   G4double GetCrossSection(const G4double kinEnergy,
                            const G4MaterialCutsCouple* couple) override;
@@ -249,6 +258,13 @@ public:
 
   void BuildLambdaTable();
 
+  // build lambda vectors of the couple if tables are built on demand
+  void BuildLambdaForCouple(std::size_t idx);
+
+  inline G4EmLazyTable* LazyTable() const;
+
+  inline void SetLazyTable(G4EmLazyTable*);
+
   void StreamInfo(std::ostream& outFile, const G4ParticleDefinition&,
                   G4bool rst=false) const;
 
@@ -312,6 +328,8 @@ private:
 
   void PrintWarning(G4String tit, G4double val);
 
+  G4double LambdaBinScale() const;
+
   void ComputeIntegralLambda(G4double kinEnergy, const G4Track&);
 
   inline G4double LogEkin(const G4Track&);
@@ -341,6 +359,7 @@ private:
   const G4ParticleDefinition*  secondaryParticle = nullptr;
   const G4VEmProcess*          masterProc = nullptr;
   G4EmDataHandler*             theData = nullptr;
+  G4EmLazyTable*               fLazyTable = nullptr;
   G4VEmModel*                  currentModel = nullptr;
   G4LossTableManager*          lManager = nullptr;
   G4EmParameters*              theParameters = nullptr;
@@ -482,6 +501,9 @@ inline void G4VEmProcess::DefineMaterial(const G4MaterialCutsCouple* couple)
         baseMaterial = currentMaterial->GetBaseMaterial();
       fFactor *= (*theDensityFactor)[currentCoupleIndex];
     }
+    if (nullptr != fLazyTable && !fLazyTable->IsBuilt(basedCoupleIndex)) {
+      BuildLambdaForCouple(basedCoupleIndex);
+    }
   }
 }
 
@@ -688,6 +710,20 @@ G4VEmProcess::SetEnergyOfCrossSectionMax(std::vector<G4double>* ptr)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
+inline G4EmLazyTable* G4VEmProcess::LazyTable() const
+{
+  return fLazyTable;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+inline void G4VEmProcess::SetLazyTable(G4EmLazyTable* ptr)
+{
+  fLazyTable = ptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
 inline const G4ParticleDefinition* G4VEmProcess::Particle() const
 {
   return particle;
@@ -21,6 +21,7 @@ geant4_add_module(G4emutils
     G4EmExtraParameters.hh
     G4EmExtraParametersMessenger.hh
     G4EmFluoDirectory.hh
+    G4EmLazyTable.hh
     G4EmLowEParameters.hh
     G4EmLowEParametersMessenger.hh
     G4EmModelManager.hh
@@ -68,6 +69,7 @@ geant4_add_module(G4emutils
     G4EmElementXS.cc
     G4EmExtraParameters.cc
     G4EmExtraParametersMessenger.cc
+    G4EmLazyTable.cc
     G4EmLowEParameters.cc
     G4EmLowEParametersMessenger.cc
     G4EmModelManager.cc
@@ -47,6 +47,7 @@
 #include "G4EmElementSelector.hh"
 #include "G4VEmModel.hh"
 #include "G4SystemOfUnits.hh"
+#include <algorithm>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -60,20 +61,15 @@ G4EmElementSelector::G4EmElementSelector(G4VEmModel* mod,
   model(mod), material(mat), nbins(bins), cutEnergy(-1.0), 
   lowEnergy(emin), highEnergy(emax)
 {
-  G4int n = (G4int)material->GetNumberOfElements();
-  nElmMinusOne = n - 1;
+  nElm = (G4int)material->GetNumberOfElements();
+  nElmMinusOne = nElm - 1;
   theElementVector = material->GetElementVector();
   if(nElmMinusOne > 0) {
-    xSections.reserve(n);
-    auto v0 = new G4PhysicsLogVector(lowEnergy,highEnergy,nbins,false);
-    xSections.push_back(v0);
-    for(G4int i=1; i<n; ++i) {
-      auto v = new G4PhysicsLogVector(*v0);
-      xSections.push_back(v);
-    }
+    energyGrid = new G4PhysicsLogVector(lowEnergy,highEnergy,nbins,false);
+    xSections.resize((std::size_t)(nbins + 1)*nElm, 0.0);
   }
   /*  
-  G4cout << "G4EmElementSelector for " << mat->GetName() << " n= " << n
+  G4cout << "G4EmElementSelector for " << mat->GetName() << " n= " << nElm
          << " nbins= " << nbins << "  Emin= " << lowEnergy 
          << " Emax= " << highEnergy << G4endl;
   */
@@ -83,9 +79,7 @@ G4EmElementSelector::G4EmElementSelector(G4VEmModel* mod,
 
 G4EmElementSelector::~G4EmElementSelector()
 {
-  if(nElmMinusOne > 0) {
-    for(G4int i=0; i<=nElmMinusOne; ++i) { delete xSections[i]; }
-  }
+  delete energyGrid;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -106,47 +100,46 @@ void G4EmElementSelector::Initialise(const G4ParticleDefinition* part,
 
   // loop over bins
   for(G4int j=0; j<=nbins; ++j) {
-    G4double e = (xSections[0])->Energy(j);
+    G4double e = energyGrid->Energy(j);
     model->SetupForMaterial(part, material, e);
     cross = 0.0;
+    G4double* y = &xSections[(std::size_t)j*nElm];
     //G4cout << "j= " << j << " e(MeV)= " << e/MeV << G4endl;
     for (G4int i=0; i<=nElmMinusOne; ++i) {
       cross += theAtomNumDensityVector[i]*      
         model->ComputeCrossSectionPerAtom(part, (*theElementVector)[i], e, 
                                           cutEnergy, e);
-      xSections[i]->PutValue(j, cross);
+      y[i] = cross;
     }
   }
   // xSections start from null, so use probabilities from the next bin
-  if(0.0 == (*xSections[nElmMinusOne])[0]) {
-    for (G4int i=0; i<=nElmMinusOne; ++i) {
-      xSections[i]->PutValue(0, (*xSections[i])[1]);
-    }
+  if(0.0 == xSections[nElmMinusOne]) {
+    std::copy(&xSections[nElm], &xSections[2*nElm], &xSections[0]);
   }
   // xSections ends with null, so use probabilities from the previous bin
-  if(0.0 == (*xSections[nElmMinusOne])[nbins]) {
-    for (G4int i=0; i<=nElmMinusOne; ++i) {
-      xSections[i]->PutValue(nbins, (*xSections[i])[nbins-1]);
-    }
+  const std::size_t last = (std::size_t)nbins*nElm;
+  if(0.0 == xSections[last + nElmMinusOne]) {
+    std::copy(&xSections[last - nElm], &xSections[last], &xSections[last]);
   }
   // perform normalization
+  binarySearch = true;
   for(G4int j=0; j<=nbins; ++j) {
-    cross = (*xSections[nElmMinusOne])[j];
+    G4double* y = &xSections[(std::size_t)j*nElm];
+    cross = y[nElmMinusOne];
     // only for positive X-section 
     if(cross > 0.0) {
-      for (G4int i=0; i<nElmMinusOne; ++i) {
-        G4double x = (*xSections[i])[j]/cross;
-        xSections[i]->PutValue(j, x);
-      }
+      for (G4int i=0; i<nElmMinusOne; ++i) { y[i] /= cross; }
+    }
+    for (G4int i=1; i<nElmMinusOne; ++i) {
+      if(y[i-1] > y[i]) { binarySearch = false; }
     }
   }
+  // a linear scan is faster for few elements
+  if(nElmMinusOne < 8) { binarySearch = false; }
   /*
   G4cout << "======== G4EmElementSelector for the " << model->GetName() 
          << G4endl;
-  for (G4int i=0; i<=nElmMinusOne; ++i) {
-    G4cout << "#### i=" << i << G4endl;
-    G4cout << (*xSections[i]) << G4endl;
-  }
+  Dump();
   */
 }
 
@@ -164,25 +157,18 @@ G4EmElementSelector::SelectRandomAtom(const G4double e,
     // ekin = x[N-1] if e>=x[N-1] and idx will be N-2 ^ a=1 => so y=y_{N-1}
     G4double ekin = e;
     std::size_t idx = 0;
-    if(e <= (xSections[0])->Energy(0)) {
-      ekin = (xSections[0])->Energy(0);
-    } else if(e < (xSections[0])->GetMaxEnergy()) {
-      idx = (xSections[0])->ComputeLogVectorBin(loge);
+    if(e <= energyGrid->Energy(0)) {
+      ekin = energyGrid->Energy(0);
+    } else if(e < energyGrid->GetMaxEnergy()) {
+      idx = energyGrid->ComputeLogVectorBin(loge);
     } else {
-      ekin = (xSections[0])->GetMaxEnergy();
-      idx = (xSections[0])->GetVectorLength() - 2;
+      ekin = energyGrid->GetMaxEnergy();
+      idx = energyGrid->GetVectorLength() - 2;
     }
     // 2. Do the linear interp.(corner cases are already excluded)
-    const G4double x1 = (xSections[0])->Energy(idx);
-    const G4double  a = (ekin - x1)/((xSections[0])->Energy(idx+1) - x1);
-    const G4double urnd = G4UniformRand();
-    for (G4int i = 0; i < nElmMinusOne; ++i) {
-      const G4double  y1 = (*xSections[i])[idx];
-      if (urnd <= y1 + a*((*xSections[i])[idx+1] - y1)) {
-        element = (*theElementVector)[i];
-        break;
-      }
-    }
+    const G4double x1 = energyGrid->Energy(idx);
+    const G4double  a = (ekin - x1)/(energyGrid->Energy(idx+1) - x1);
+    element = (*theElementVector)[FindElement(G4UniformRand(), idx, a)];
   }
   return element;
 }
@@ -197,7 +183,10 @@ void G4EmElementSelector::Dump(const G4ParticleDefinition* part)
   if(0 < nElmMinusOne) {
     for(G4int i=0; i<nElmMinusOne; i++) {
       G4cout << "      " << (*theElementVector)[i]->GetName() << " : " << G4endl;
-      G4cout << *(xSections[i]) << G4endl;
+      for(G4int j=0; j<=nbins; ++j) {
+        G4cout << energyGrid->Energy(j) << "   " 
+               << xSections[(std::size_t)j*nElm + i] << G4endl;
+      }
     }
   }  
   G4cout << "Last Element in element vector " 
@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+// File name:     G4EmLazyTable
+//
+// Creation date: 18.10.2026
+//
+// Modifications:
+//
+// -------------------------------------------------------------------
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+#include "G4EmLazyTable.hh"
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  G4Mutex lazyListMutex = G4MUTEX_INITIALIZER;
+  std::vector<G4EmLazyTable*>& LazyTables()
+  {
+    static std::vector<G4EmLazyTable*> list;
+    return list;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4EmLazyTable::G4EmLazyTable(const G4String& name, std::size_t n)
+  : fName(name), nCouples(n), fBuilt(new std::atomic<G4bool>[n])
+{
+  for(std::size_t i=0; i<nCouples; ++i) { fBuilt[i] = false; }
+  G4AutoLock l(&lazyListMutex);
+  LazyTables().push_back(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4EmLazyTable::~G4EmLazyTable()
+{
+  G4AutoLock l(&lazyListMutex);
+  auto& list = LazyTables();
+  list.erase(std::remove(list.begin(), list.end(), this), list.end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmLazyTable::SetBuilt(std::size_t idx)
+{
+  fBuilt[idx].store(true, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmLazyTable::Build(std::size_t idx, const std::function<void()>& func)
+{
+  G4AutoLock l(&fMutex);
+  // the couple may have been built by another thread
+  if(IsBuilt(idx)) { return; }
+  func();
+  fUsed.push_back(idx);
+  fBuilt[idx].store(true, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+std::size_t G4EmLazyTable::NumberOfBuiltCouples() const
+{
+  std::size_t n = 0;
+  for(std::size_t i=0; i<nCouples; ++i) {
+    if(IsBuilt(i)) { ++n; }
+  }
+  return n;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4EmLazyTable::Report(std::ostream& out)
+{
+  G4AutoLock l(&lazyListMutex);
+  const auto& list = LazyTables();
+  if(list.empty()) { return; }
+  out << "=== EM tables built on demand: couples used by each process"
+      << G4endl;
+  for(auto const & p : list) {
+    G4AutoLock lp(&(p->fMutex));
+    std::vector<std::size_t> used = p->fUsed;
+    std::sort(used.begin(), used.end());
+    out << "  " << p->fName << ": " << used.size() << " of "
+        << p->nCouples << " couples built on demand";
+    if(!used.empty()) {
+      out << ", indexes:";
+      for(auto const & i : used) { out << " " << i; }
+    }
+    out << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
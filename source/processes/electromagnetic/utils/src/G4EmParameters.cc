@@ -42,6 +42,7 @@
 
 #include "G4EmParameters.hh"
 #include "G4PhysicalConstants.hh"
+#include "G4PhysicsVector.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4VEmProcess.hh"
@@ -130,6 +131,10 @@ void G4EmParameters::Initialise()
   birks = false;
   fICRU90 = false;
   gener = false;
+  fEmTrackingManager = false;
+  fPackedVectors = false;
+  fParallelTables = false;
+  fLazyTables = false;
   onIsolated = false;
   fSamplingTable = false;
   fPolarisation = false;
@@ -475,6 +480,51 @@ G4bool G4EmParameters::GeneralProcessActive() const
   return gener;
 }
 
+void G4EmParameters::SetEmTrackingManagerActive(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fEmTrackingManager = val;
+}
+
+G4bool G4EmParameters::EmTrackingManagerActive() const
+{
+  return fEmTrackingManager;
+}
+
+void G4EmParameters::SetPackedPhysicsVectors(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fPackedVectors = val;
+  G4PhysicsVector::SetPackedLayout(val);
+}
+
+G4bool G4EmParameters::PackedPhysicsVectors() const
+{
+  return fPackedVectors;
+}
+
+void G4EmParameters::SetParallelTableBuild(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fParallelTables = val;
+}
+
+G4bool G4EmParameters::ParallelTableBuild() const
+{
+  return fParallelTables;
+}
+
+void G4EmParameters::SetLazyTableBuild(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fLazyTables = val;
+}
+
+G4bool G4EmParameters::LazyTableBuild() const
+{
+  return fLazyTables;
+}
+
 void G4EmParameters::SetEmSaturation(G4EmSaturation* ptr)
 {
   if(IsLocked()) { return; }
@@ -1382,6 +1432,11 @@ void G4EmParameters::StreamInfo(std::ostream& os) const
   }
   os << "Use combined TransportationWithMsc                 " <<transportationWithMsc << "\n";
   os << "Use general process                                " <<gener << "\n";
+  os << "Use specialised e+- and gamma tracking manager     " 
+     <<fEmTrackingManager << "\n";
+  os << "Use packed layout of physics vectors               " <<fPackedVectors << "\n";
+  os << "Build tables of couples in parallel tasks          " <<fParallelTables << "\n";
+  os << "Build lambda tables of couples on demand           " <<fLazyTables << "\n";
   os << "Enable linear polarisation for gamma               " <<fPolarisation << "\n";
   os << "Enable photoeffect sampling below K-shell          " <<fPEKShell << "\n";
   os << "Enable sampling of quantum entanglement            " 
@@ -53,6 +53,7 @@
 #include "G4MscStepLimitType.hh"
 #include "G4NuclearFormfactorType.hh"
 #include "G4EmParameters.hh"
+#include "G4EmLazyTable.hh"
 
 #include <sstream>
 
@@ -163,6 +164,38 @@ G4EmParametersMessenger::G4EmParametersMessenger(G4EmParameters* ptr)
   sharkCmd->AvailableForStates(G4State_PreInit);
   sharkCmd->SetToBeBroadcasted(false);
 
+  emtmCmd = new G4UIcmdWithABool("/process/em/UseEmTrackingManager",this);
+  emtmCmd->SetGuidance("Enable specialised tracking manager for gamma, e+-");
+  emtmCmd->SetParameterName("emtm",true);
+  emtmCmd->SetDefaultValue(false);
+  emtmCmd->AvailableForStates(G4State_PreInit);
+  emtmCmd->SetToBeBroadcasted(false);
+
+  packCmd = new G4UIcmdWithABool("/process/em/PackedPhysicsVectors",this);
+  packCmd->SetGuidance("Enable packed layout of physics vectors of EM tables");
+  packCmd->SetParameterName("pack",true);
+  packCmd->SetDefaultValue(false);
+  packCmd->AvailableForStates(G4State_PreInit);
+  packCmd->SetToBeBroadcasted(false);
+
+  parTabCmd = new G4UIcmdWithABool("/process/em/ParallelTableBuild",this);
+  parTabCmd->SetGuidance("Enable building of range, inverse range and spline");
+  parTabCmd->SetGuidance("  coefficients of EM tables of different couples in");
+  parTabCmd->SetGuidance("  parallel tasks of the thread pool (tasking only);");
+  parTabCmd->SetGuidance("  the models fill the dE/dx and lambda tables serially");
+  parTabCmd->SetParameterName("parTab",true);
+  parTabCmd->SetDefaultValue(false);
+  parTabCmd->AvailableForStates(G4State_PreInit);
+  parTabCmd->SetToBeBroadcasted(false);
+
+  lazyTabCmd = new G4UIcmdWithABool("/process/em/LazyTableBuild",this);
+  lazyTabCmd->SetGuidance("Enable building of lambda tables of discrete");
+  lazyTabCmd->SetGuidance("  processes for a couple at its first use");
+  lazyTabCmd->SetParameterName("lazyTab",true);
+  lazyTabCmd->SetDefaultValue(false);
+  lazyTabCmd->AvailableForStates(G4State_PreInit);
+  lazyTabCmd->SetToBeBroadcasted(false);
+
   poCmd = new G4UIcmdWithABool("/process/em/Polarisation",this);
   poCmd->SetGuidance("Enable polarisation");
   poCmd->AvailableForStates(G4State_PreInit);
@@ -431,6 +464,12 @@ G4EmParametersMessenger::G4EmParametersMessenger(G4EmParameters* ptr)
   dumpCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
   dumpCmd->SetToBeBroadcasted(false);
 
+  lazyDumpCmd = new G4UIcommand("/process/em/printLazyTables",this);
+  lazyDumpCmd->SetGuidance("Print couples used by processes with lambda");
+  lazyDumpCmd->SetGuidance("  tables built on demand.");
+  lazyDumpCmd->AvailableForStates(G4State_Idle);
+  lazyDumpCmd->SetToBeBroadcasted(false);
+
   nffCmd = new G4UIcmdWithAString("/process/em/setNuclearFormFactor",this);
   nffCmd->SetGuidance("Define type of nuclear form-factor");
   nffCmd->SetParameterName("NucFF",true);
@@ -503,6 +542,10 @@ G4EmParametersMessenger::~G4EmParametersMessenger()
   delete mottCmd;
   delete birksCmd;
   delete sharkCmd;
+  delete emtmCmd;
+  delete packCmd;
+  delete parTabCmd;
+  delete lazyTabCmd;
   delete onIsolatedCmd;
   delete sampleTCmd;
   delete poCmd;
@@ -552,6 +595,7 @@ G4EmParametersMessenger::~G4EmParametersMessenger()
   delete posiCmd;
 
   delete dumpCmd;
+  delete lazyDumpCmd;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -595,6 +639,14 @@ void G4EmParametersMessenger::SetNewValue(G4UIcommand* command,
     theParameters->SetUseICRU90Data(icru90Cmd->GetNewBoolValue(newValue));
   } else if (command == sharkCmd) {
     theParameters->SetGeneralProcessActive(sharkCmd->GetNewBoolValue(newValue));
+  } else if (command == emtmCmd) {
+    theParameters->SetEmTrackingManagerActive(emtmCmd->GetNewBoolValue(newValue));
+  } else if (command == packCmd) {
+    theParameters->SetPackedPhysicsVectors(packCmd->GetNewBoolValue(newValue));
+  } else if (command == parTabCmd) {
+    theParameters->SetParallelTableBuild(parTabCmd->GetNewBoolValue(newValue));
+  } else if (command == lazyTabCmd) {
+    theParameters->SetLazyTableBuild(lazyTabCmd->GetNewBoolValue(newValue));
   } else if (command == poCmd) {
     theParameters->SetEnablePolarisation(poCmd->GetNewBoolValue(newValue));
   } else if (command == sampleTCmd) {
@@ -679,6 +731,8 @@ void G4EmParametersMessenger::SetNewValue(G4UIcommand* command,
   } else if (command == dumpCmd) {
     theParameters->SetIsPrintedFlag(false);
     theParameters->Dump();
+  } else if (command == lazyDumpCmd) {
+    G4EmLazyTable::Report(G4cout);
   } else if (command == transWithMscCmd) {
     G4TransportationWithMscType type = G4TransportationWithMscType::fDisabled;
     if(newValue == "Disabled") {
@@ -131,6 +131,7 @@ void G4EmTableUtil::BuildEmProcess(G4VEmProcess* proc,
       proc->SetLambdaTablePrim(masterProc->LambdaTablePrim());
       proc->SetCrossSectionType(masterProc->CrossSectionType());
       proc->SetEnergyOfCrossSectionMax(masterProc->EnergyOfCrossSectionMax());
+      proc->SetLazyTable(masterProc->LazyTable());
 
       // local initialisation of models
       baseMat = masterProc->UseBaseMaterial();
@@ -150,7 +151,16 @@ void G4EmTableUtil::BuildEmProcess(G4VEmProcess* proc,
       v = nullptr;
       if(fXSType == fEmOnePeak) {
         auto table = proc->LambdaTable();
-        if(nullptr == table) {
+        auto lazy = proc->LazyTable();
+        if(nullptr != lazy && nullptr != table) {
+          // peaks of other couples are found when vectors are built
+          v = new std::vector<G4double>(table->length(), DBL_MAX);
+          for(std::size_t i=0; i<table->length(); ++i) {
+            if(lazy->IsBuilt(i)) {
+              (*v)[i] = G4EmUtility::FindCrossSectionMax((*table)[i]);
+            }
+          }
+        } else if(nullptr == table) {
 	  v = G4EmUtility::FindCrossSectionMax(proc, part);
 	} else {
 	  v = G4EmUtility::FindCrossSectionMax(table);
@@ -210,64 +220,20 @@ void G4EmTableUtil::BuildLambdaTable(G4VEmProcess* proc,
         G4ProductionCutsTable::GetProductionCutsTable();
   std::size_t numOfCouples = theCoupleTable->GetTableSize();
 
-  G4PhysicsLogVector* aVector = nullptr;
-  G4PhysicsLogVector* aVectorPrim = nullptr;
-  G4PhysicsLogVector* bVectorPrim = nullptr;
-
-  G4double emax1 = std::min(maxKinEnergy, minKinEnergyPrim);
+  // vectors for which the spline is computed after the loop
+  std::vector<G4PhysicsVector*> splineVectors;
     
   for(std::size_t i=0; i<numOfCouples; ++i) {
-
     if (bld->GetFlag(i)) {
-      // create physics vector and fill it
-      const G4MaterialCutsCouple* couple = 
-        theCoupleTable->GetMaterialCutsCouple((G4int)i);
-
-      // build main table
-      if(nullptr != theLambdaTable) {
-        delete (*theLambdaTable)[i];
-
-        // if start from zero then change the scale
-        G4double emin = minKinEnergy;
-        G4bool startNull = false;
-        if(startFromNull) {
-          G4double e = proc->MinPrimaryEnergy(part, couple->GetMaterial());
-          if(e >= emin) {
-            emin = e;
-            startNull = true;
-          }
-        }
-        G4double emax = emax1;
-        if(emax <= emin) { emax = 2*emin; }
-        G4int bin = G4lrint(scale*G4Log(emax/emin));
-        bin = std::max(bin, 5);
-        aVector = new G4PhysicsLogVector(emin, emax, bin, splineFlag);
-        modelManager->FillLambdaVector(aVector, couple, startNull);
-        if(splineFlag) { aVector->FillSecondDerivatives(); }
-        G4PhysicsTableHelper::SetPhysicsVector(theLambdaTable, i, aVector);
-      }
-      // build high energy table
-      if(nullptr != theLambdaTablePrim && minKinEnergyPrim < maxKinEnergy) {
-        delete (*theLambdaTablePrim)[i];
-
-        // start not from zero and always use spline
-        if(nullptr == bVectorPrim) {
-          G4int bin = G4lrint(scale*G4Log(maxKinEnergy/minKinEnergyPrim));
-          bin = std::max(bin, 5);
-          aVectorPrim = 
-            new G4PhysicsLogVector(minKinEnergyPrim, maxKinEnergy, bin, true);
-          bVectorPrim = aVectorPrim;
-        } else {
-          aVectorPrim = new G4PhysicsLogVector(*bVectorPrim);
-        }
-        modelManager->FillLambdaVector(aVectorPrim, couple, false, 
-                                       fIsCrossSectionPrim);
-        aVectorPrim->FillSecondDerivatives();
-        G4PhysicsTableHelper::SetPhysicsVector(theLambdaTablePrim, i, 
-                                               aVectorPrim);
-      }
+      FillLambdaVectors(proc, part, modelManager, theLambdaTable,
+                        theLambdaTablePrim, i, minKinEnergy, minKinEnergyPrim,
+                        maxKinEnergy, scale, startFromNull, splineFlag,
+                        &splineVectors);
     }
   }
+  bld->ParallelFor(splineVectors.size(), [&splineVectors](std::size_t i) {
+    splineVectors[i]->FillSecondDerivatives();
+  });
 
   if(1 < verboseLevel) {
     G4cout << "Lambda table is built for " << part->GetParticleName() << G4endl;
@@ -276,6 +242,70 @@ void G4EmTableUtil::BuildLambdaTable(G4VEmProcess* proc,
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
 
+void G4EmTableUtil::FillLambdaVectors(G4VEmProcess* proc,
+                                      const G4ParticleDefinition* part,
+                                      G4EmModelManager* modelManager,
+                                      G4PhysicsTable* theLambdaTable,
+                                      G4PhysicsTable* theLambdaTablePrim,
+                                      const std::size_t idx,
+                                      const G4double minKinEnergy,
+                                      const G4double minKinEnergyPrim,
+                                      const G4double maxKinEnergy,
+                                      const G4double scale,
+                                      const G4bool startFromNull,
+                                      const G4bool splineFlag,
+                                      std::vector<G4PhysicsVector*>* splineVectors)
+{
+  const G4MaterialCutsCouple* couple = G4ProductionCutsTable::
+    GetProductionCutsTable()->GetMaterialCutsCouple((G4int)idx);
+  G4double emax1 = std::min(maxKinEnergy, minKinEnergyPrim);
+
+  // build main table
+  if(nullptr != theLambdaTable) {
+    delete (*theLambdaTable)[idx];
+
+    // if start from zero then change the scale
+    G4double emin = minKinEnergy;
+    G4bool startNull = false;
+    if(startFromNull) {
+      G4double e = proc->MinPrimaryEnergy(part, couple->GetMaterial());
+      if(e >= emin) {
+        emin = e;
+        startNull = true;
+      }
+    }
+    G4double emax = emax1;
+    if(emax <= emin) { emax = 2*emin; }
+    G4int bin = G4lrint(scale*G4Log(emax/emin));
+    bin = std::max(bin, 5);
+    auto aVector = new G4PhysicsLogVector(emin, emax, bin, splineFlag);
+    modelManager->FillLambdaVector(aVector, couple, startNull);
+    if(splineFlag) {
+      if(nullptr != splineVectors) { splineVectors->push_back(aVector); }
+      else { aVector->FillSecondDerivatives(); }
+    }
+    G4PhysicsTableHelper::SetPhysicsVector(theLambdaTable, idx, aVector);
+  }
+  // build high energy table
+  if(nullptr != theLambdaTablePrim && minKinEnergyPrim < maxKinEnergy) {
+    delete (*theLambdaTablePrim)[idx];
+
+    // start not from zero and always use spline
+    G4int bin = G4lrint(scale*G4Log(maxKinEnergy/minKinEnergyPrim));
+    bin = std::max(bin, 5);
+    auto aVectorPrim = 
+      new G4PhysicsLogVector(minKinEnergyPrim, maxKinEnergy, bin, true);
+    modelManager->FillLambdaVector(aVectorPrim, couple, false, 
+                                   fIsCrossSectionPrim);
+    if(nullptr != splineVectors) { splineVectors->push_back(aVectorPrim); }
+    else { aVectorPrim->FillSecondDerivatives(); }
+    G4PhysicsTableHelper::SetPhysicsVector(theLambdaTablePrim, idx, 
+                                           aVectorPrim);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
+
 void  G4EmTableUtil::BuildLambdaTable(G4VEnergyLossProcess* proc,
                                      const G4ParticleDefinition* part,
                                      G4EmModelManager* modelManager,
@@ -299,6 +329,7 @@ void  G4EmTableUtil::BuildLambdaTable(G4VEnergyLossProcess* proc,
   std::size_t numOfCouples = theCoupleTable->GetTableSize();
 
   G4PhysicsLogVector* aVector = nullptr;
+  std::vector<G4PhysicsVector*> splineVectors;
   for(std::size_t i=0; i<numOfCouples; ++i) {
     if (bld->GetFlag(i)) {
       // create physics vector and fill it
@@ -320,10 +351,13 @@ void  G4EmTableUtil::BuildLambdaTable(G4VEnergyLossProcess* proc,
       bin = std::max(bin, 5);
       aVector = new G4PhysicsLogVector(emin, emax, bin, splineFlag);
       modelManager->FillLambdaVector(aVector, couple, startNull, fRestricted);
-      if(splineFlag) { aVector->FillSecondDerivatives(); }
+      if(splineFlag) { splineVectors.push_back(aVector); }
       G4PhysicsTableHelper::SetPhysicsVector(theLambdaTable, i, aVector);
     }
   }
+  bld->ParallelFor(splineVectors.size(), [&splineVectors](std::size_t i) {
+    splineVectors[i]->FillSecondDerivatives();
+  });
 
   if(1 < verboseLevel) {
     G4cout << "Lambda table is built for " << part->GetParticleName() << G4endl;
@@ -462,6 +496,7 @@ void G4EmTableUtil::BuildDEDXTable(G4VEnergyLossProcess* proc,
   }
   G4PhysicsLogVector* aVector = nullptr;
   G4PhysicsLogVector* bVector = nullptr;
+  std::vector<G4PhysicsVector*> splineVectors;
 
   for(std::size_t i=0; i<numOfCouples; ++i) {
 
@@ -484,12 +519,15 @@ void G4EmTableUtil::BuildDEDXTable(G4VEnergyLossProcess* proc,
       }
 
       modelManager->FillDEDXVector(aVector, couple, tType);
-      if(spline) { aVector->FillSecondDerivatives(); }
+      if(spline) { splineVectors.push_back(aVector); }
 
       // Insert vector for this material into the table
       G4PhysicsTableHelper::SetPhysicsVector(table, i, aVector);
     }
   }
+  bld->ParallelFor(splineVectors.size(), [&splineVectors](std::size_t i) {
+    splineVectors[i]->FillSecondDerivatives();
+  });
 
   if(1 < verbose) {
     G4cout << "G4EmTableUtil::BuildDEDXTable(): table is built for "
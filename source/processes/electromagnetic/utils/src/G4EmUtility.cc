@@ -111,28 +111,11 @@ std::vector<G4double>* G4EmUtility::FindCrossSectionMax(G4PhysicsTable* p)
   ptr->resize(n, DBL_MAX);
 
   G4bool isPeak = false;
-  G4double e, ss, ee, xs;
 
   // first loop on existing vectors
   for (std::size_t i=0; i<n; ++i) {
-    const G4PhysicsVector* pv = (*p)[i];
-    xs = ee = 0.0;
-    if(nullptr != pv) {
-      G4int nb = (G4int)pv->GetVectorLength();
-      for (G4int j=0; j<nb; ++j) {
-	e = pv->Energy(j);
-	ss = (*pv)(j);
-	if(ss >= xs) {
-	  xs = ss;
-	  ee = e;
-	  continue;
-	} else {
-	  isPeak = true;
-	  (*ptr)[i] = ee;
-	  break;
-	}
-      }
-    }
+    (*ptr)[i] = FindCrossSectionMax((*p)[i]);
+    if((*ptr)[i] < DBL_MAX) { isPeak = true; }
   }
 
   // there is no peak for any material
@@ -143,6 +126,27 @@ std::vector<G4double>* G4EmUtility::FindCrossSectionMax(G4PhysicsTable* p)
   return ptr;
 }
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4double G4EmUtility::FindCrossSectionMax(const G4PhysicsVector* pv)
+{
+  G4double ee = 0.0;
+  G4double xs = 0.0;
+  if(nullptr != pv) {
+    G4int nb = (G4int)pv->GetVectorLength();
+    for (G4int j=0; j<nb; ++j) {
+      G4double ss = (*pv)(j);
+      if(ss >= xs) {
+        xs = ss;
+        ee = pv->Energy(j);
+      } else {
+        return ee;
+      }
+    }
+  }
+  return DBL_MAX;
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
 
 std::vector<G4double>* 
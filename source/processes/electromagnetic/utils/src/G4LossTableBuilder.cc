@@ -65,6 +65,13 @@
 #include "G4ParticleDefinition.hh"
 #include "G4LossTableManager.hh"
 #include "G4EmParameters.hh"
+#include "G4Threading.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4TaskGroup.hh"
+#include "PTL/TaskRunManager.hh"
+#include "PTL/ThreadPool.hh"
+#endif
 
 G4bool G4LossTableBuilder::baseMatFlag = false;
 std::vector<G4double>* G4LossTableBuilder::theDensityFactor = nullptr;
@@ -141,10 +148,11 @@ G4LossTableBuilder::BuildDEDXTable(G4PhysicsTable* dedxTable,
   //	 << dedxTable->size() << G4endl;
   if(0 >= nCouples) { return; }
 
-  for (std::size_t i=0; i<nCouples; ++i) {
+  std::vector<G4PhysicsVector*> vec(nCouples, nullptr);
+  ParallelFor(nCouples, [&](std::size_t i) {
     auto pv0 = static_cast<G4PhysicsLogVector*>((*(list[0]))[i]);
     //if (0 == i) G4cout << i << ". pv0=" << pv0 << "  t:" << list[0] << G4endl;
-    if(pv0 == nullptr) { continue; } 
+    if(pv0 == nullptr) { return; } 
     std::size_t npoints = pv0->GetVectorLength();
     auto pv = new G4PhysicsLogVector(*pv0);
     for (std::size_t j=0; j<npoints; ++j) {
@@ -157,7 +165,13 @@ G4LossTableBuilder::BuildDEDXTable(G4PhysicsTable* dedxTable,
       pv->PutValue(j, dedx);
     }
     if(splineFlag) { pv->FillSecondDerivatives(); }
-    G4PhysicsTableHelper::SetPhysicsVector(dedxTable, i, pv);
+    vec[i] = pv;
+  });
+  // the flags of the table are not set concurrently
+  for (std::size_t i=0; i<nCouples; ++i) {
+    if(nullptr != vec[i]) { 
+      G4PhysicsTableHelper::SetPhysicsVector(dedxTable, i, vec[i]);
+    }
   }
   //G4cout << "### G4LossTableBuilder::BuildDEDXTable " << G4endl; 
   //G4cout << *dedxTable << G4endl;
@@ -177,9 +191,10 @@ void G4LossTableBuilder::BuildRangeTable(const G4PhysicsTable* dedxTable,
   const std::size_t n = 100;
   const G4double del = 1.0/(G4double)n;
 
-  for (std::size_t i=0; i<nCouples; ++i) {
+  std::vector<G4PhysicsVector*> vec(nCouples, nullptr);
+  ParallelFor(nCouples, [&](std::size_t i) {
     auto pv = static_cast<G4PhysicsLogVector*>((*dedxTable)[i]);
-    if((pv == nullptr) || (isBaseMatActive && !(*theFlag)[i])) { continue; } 
+    if((pv == nullptr) || (isBaseMatActive && !(*theFlag)[i])) { return; } 
     std::size_t npoints = pv->GetVectorLength();
     std::size_t bin0    = 0;
     G4double elow  = pv->Energy(0);
@@ -238,7 +253,12 @@ void G4LossTableBuilder::BuildRangeTable(const G4PhysicsTable* dedxTable,
       energy1 = energy2;
     }
     if(splineFlag) { v->FillSecondDerivatives(); }
-    G4PhysicsTableHelper::SetPhysicsVector(rangeTable, i, v);
+    vec[i] = v;
+  });
+  for (std::size_t i=0; i<nCouples; ++i) {
+    if(nullptr != vec[i]) { 
+      G4PhysicsTableHelper::SetPhysicsVector(rangeTable, i, vec[i]);
+    }
   }
   //G4cout << "### Range table" << G4endl; 
   //G4cout << *rangeTable << G4endl;
@@ -254,9 +274,11 @@ G4LossTableBuilder::BuildInverseRangeTable(const G4PhysicsTable* rangeTable,
   std::size_t nCouples = rangeTable->size();
   if(0 >= nCouples) { return; }
 
-  for (std::size_t i=0; i<nCouples; ++i) {
+  const G4int nlog = theParameters->NumberForFreeVector();
+  std::vector<G4PhysicsVector*> vec(nCouples, nullptr);
+  ParallelFor(nCouples, [&](std::size_t i) {
     G4PhysicsVector* pv = (*rangeTable)[i];
-    if((pv == nullptr) || (isBaseMatActive && !(*theFlag)[i])) { continue; } 
+    if((pv == nullptr) || (isBaseMatActive && !(*theFlag)[i])) { return; } 
     std::size_t npoints = pv->GetVectorLength();
       
     delete (*invRangeTable)[i];
@@ -268,9 +290,13 @@ G4LossTableBuilder::BuildInverseRangeTable(const G4PhysicsTable* rangeTable,
       v->PutValues(j,r,e);
     }
     if (splineFlag) { v->FillSecondDerivatives(); }
-    v->EnableLogBinSearch(theParameters->NumberForFreeVector());
-
-    G4PhysicsTableHelper::SetPhysicsVector(invRangeTable, i, v);
+    v->EnableLogBinSearch(nlog);
+    vec[i] = v;
+  });
+  for (std::size_t i=0; i<nCouples; ++i) {
+    if(nullptr != vec[i]) { 
+      G4PhysicsTableHelper::SetPhysicsVector(invRangeTable, i, vec[i]);
+    }
   }
   //G4cout << "### Inverse range table" << G4endl; 
   //G4cout << *invRangeTable << G4endl;
@@ -429,3 +455,35 @@ G4LossTableBuilder::BuildTableForModel(G4PhysicsTable* aTable,
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4LossTableBuilder::ParallelFor(
+  std::size_t n, const std::function<void(std::size_t)>& func) const
+{
+#ifdef G4MULTITHREADED
+  std::size_t nThreads = 0;
+  if(isInitializer && theParameters->ParallelTableBuild() &&
+     G4Threading::IsMasterThread()) {
+    auto mrm = PTL::TaskRunManager::GetMasterRunManager();
+    if(nullptr != mrm && nullptr != mrm->GetThreadPool()) {
+      nThreads = mrm->GetThreadPool()->size();
+    }
+  }
+  if(1 < nThreads && 1 < n) {
+    // contiguous ranges of indexes, a few per thread for load balance
+    const std::size_t nTasks = std::min(n, 4*nThreads);
+    G4TaskGroup<void> tasks;
+    for(std::size_t t=0; t<nTasks; ++t) {
+      const std::size_t i0 = t*n/nTasks;
+      const std::size_t i1 = (t + 1)*n/nTasks;
+      tasks.exec([&func, i0, i1]() {
+        for(std::size_t i=i0; i<i1; ++i) { func(i); }
+      });
+    }
+    tasks.join();
+    return;
+  }
+#endif
+  for(std::size_t i=0; i<n; ++i) { func(i); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -114,6 +114,7 @@ G4VEmProcess::~G4VEmProcess()
   if(isTheMaster) {
     delete theData;
     delete theEnergyOfCrossSectionMax;
+    delete fLazyTable;
   }
   delete modelManager;
   delete biasManager;
@@ -243,20 +244,59 @@ void G4VEmProcess::BuildPhysicsTable(const G4ParticleDefinition& part)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
-void G4VEmProcess::BuildLambdaTable()
+G4double G4VEmProcess::LambdaBinScale() const
 {
   G4double scale = theParameters->MaxKinEnergy()/theParameters->MinKinEnergy();
   G4int nbin = 
     theParameters->NumberOfBinsPerDecade()*G4lrint(std::log10(scale));
   if(actBinning) { nbin = std::max(nbin, nLambdaBins); }
-  scale = nbin/G4Log(scale);
-  
+  return nbin/G4Log(scale);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4VEmProcess::BuildLambdaTable()
+{
   G4LossTableBuilder* bld = lManager->GetTableBuilder();
+
+  // on-demand mode: only couples not requiring a rebuild are marked,
+  // other vectors are filled at first use by BuildLambdaForCouple()
+  delete fLazyTable;
+  fLazyTable = nullptr;
+  if(theParameters->LazyTableBuild()) {
+    std::size_t n = 
+      G4ProductionCutsTable::GetProductionCutsTable()->GetTableSize();
+    fLazyTable = new G4EmLazyTable(GetProcessName() + "/" 
+                                   + particle->GetParticleName(), n);
+    for(std::size_t i=0; i<n; ++i) {
+      if(!bld->GetFlag(i)) { fLazyTable->SetBuilt(i); }
+    }
+    return;
+  }
   G4EmTableUtil::BuildLambdaTable(this, particle, modelManager,
                                   bld, theLambdaTable, theLambdaTablePrim,
                                   minKinEnergy, minKinEnergyPrim,
-                                  maxKinEnergy, scale, verboseLevel,
-                                  startFromNull, splineFlag);
+                                  maxKinEnergy, LambdaBinScale(), 
+                                  verboseLevel, startFromNull, splineFlag);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4VEmProcess::BuildLambdaForCouple(std::size_t idx)
+{
+  // vectors are filled by models of the calling thread and 
+  // are stored in the tables shared with the master
+  fLazyTable->Build(idx, [this, idx]() {
+    G4EmTableUtil::FillLambdaVectors(this, particle, modelManager,
+                                     theLambdaTable, theLambdaTablePrim,
+                                     idx, minKinEnergy, minKinEnergyPrim,
+                                     maxKinEnergy, LambdaBinScale(),
+                                     startFromNull, splineFlag, nullptr);
+    if(nullptr != theEnergyOfCrossSectionMax && nullptr != theLambdaTable) {
+      (*theEnergyOfCrossSectionMax)[idx] = 
+        G4EmUtility::FindCrossSectionMax((*theLambdaTable)[idx]);
+    }
+  });
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -281,6 +321,9 @@ void G4VEmProcess::StreamInfo(std::ostream& out,
   }
   if(biasFactor != 1.0) { out << "  BiasingFactor=" << biasFactor; }
   out << " BuildTable=" << buildLambdaTable << G4endl;
+  if(nullptr != fLazyTable) {
+    out << "      Lambda tables are built on demand" << G4endl;
+  }
   if(buildLambdaTable) {
     if(particle == &part) { 
       for(auto & v : *theLambdaTable) {
@@ -463,6 +506,22 @@ void G4VEmProcess::ComputeIntegralLambda(G4double e, const G4Track& track)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
+void G4VEmProcess::GetLambdas(G4int n, const G4double* e,
+                              const G4double* loge,
+                              const G4MaterialCutsCouple* const* couple,
+                              G4double* lambda)
+{
+  for (G4int i=0; i<n; ++i) {
+    DefineMaterial(couple[i]);
+    const G4double scaledEnergy = e[i]*massRatio;
+    SelectModel(scaledEnergy, currentCoupleIndex);
+    lambda[i] = (currentModel->IsActive(scaledEnergy)) 
+      ? std::max(GetCurrentLambda(e[i], loge[i]), 0.0) : 0.0;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
 G4VParticleChange* G4VEmProcess::PostStepDoIt(const G4Track& track,
                                               const G4Step& step)
 {
@@ -649,6 +708,11 @@ G4bool G4VEmProcess::StorePhysicsTable(const G4ParticleDefinition* part,
                                        G4bool ascii)
 {
   if(!isTheMaster || part != particle) { return true; }
+  if(nullptr != fLazyTable) {
+    for(std::size_t i=0; i<fLazyTable->NumberOfCouples(); ++i) {
+      if(!fLazyTable->IsBuilt(i)) { BuildLambdaForCouple(i); }
+    }
+  }
   if(G4EmTableUtil::StoreTable(this, part, theLambdaTable,
 			       directory, "Lambda",
                                verboseLevel, ascii) &&
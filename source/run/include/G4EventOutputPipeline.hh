@@ -0,0 +1,99 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventOutputPipeline
+//
+// Class description:
+//
+// Output stage of the pipelined event loop of G4WorkerTaskRunManager.
+// Completed events are queued by the worker and handed in order to the
+// user's G4UserEventOutputAction by a task submitted to the thread pool,
+// so that the worker can start tracking the next event immediately.
+// At most one task processes the queue of a given pipeline at a time.
+// Processed events are returned to the worker with Collect(), since
+// events must be deleted on the thread which created them.
+// The number of events in flight is bounded: when the limit is reached
+// the worker processes the queue itself, or waits for the running task,
+// instead of queuing more events. Pending tasks only hold the shared
+// state, so the pipeline may be destroyed before they execute.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4EventOutputPipeline_hh
+#define G4EventOutputPipeline_hh 1
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "G4Types.hh"
+
+class G4Event;
+class G4UserEventOutputAction;
+
+class G4EventOutputPipeline
+{
+  public:
+
+    explicit G4EventOutputPipeline(G4UserEventOutputAction* action);
+   ~G4EventOutputPipeline() = default;
+
+    G4EventOutputPipeline(const G4EventOutputPipeline&) = delete;
+    G4EventOutputPipeline& operator=(const G4EventOutputPipeline&) = delete;
+
+    void Submit(G4Event* anEvent, G4int maxEventsInFlight);
+      // Queues a completed event and makes sure a task processes the
+      // queue. Blocks while maxEventsInFlight events are queued or
+      // being processed, helping to process them if no task does.
+    void Collect(std::vector<G4Event*>& processed);
+      // Appends the events processed since the last call
+    void Drain();
+      // Returns when all the submitted events have been processed
+
+    G4int GetNumberOfEventsInFlight() const;
+
+  private:
+
+    struct State
+    {
+      G4UserEventOutputAction* action = nullptr;
+      mutable std::mutex mutex;
+      std::condition_variable processedCondition;
+      std::deque<G4Event*> queue;
+      std::vector<G4Event*> processed;
+      G4bool taskScheduled = false;
+      G4bool running = false;
+    };
+
+    static void ProcessQueue(State& state, std::unique_lock<std::mutex>& lock);
+      // Processes the queue until it is empty; the lock is released
+      // while the user action runs
+
+    std::shared_ptr<State> fState;
+};
+
+#endif
@@ -23,32 +23,34 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-/// \file include/PhysicsListEmStandardTracking.hh
-/// \brief Definition of the PhysicsListEmStandardTracking class
+// G4EventRNGStream
 //
+// Class description:
 //
-//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+// Seeding of the random number engine of the calling thread from a key
+// (base seed, run ID, event ID, sub-event ID), instead of the seeds
+// pre-generated by the master. The random number sequence of an event
+// then depends only on its key, so that any event can be replayed alone,
+// whatever the number of threads and the order of processing.
+//
+// With the MixMax engine (Geant4 default), the four key values are given
+// to MixMaxRng::setSeeds(), which guarantees non-overlapping streams for
+// distinct keys. For the other engines two seeds are derived from a hash
+// of the key.
 
-#ifndef PhysicsListEmStandardTracking_h
-#define PhysicsListEmStandardTracking_h 1
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4EventRNGStream_hh
+#define G4EventRNGStream_hh 1
 
-#include "G4VPhysicsConstructor.hh"
 #include "globals.hh"
 
-//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-
-class PhysicsListEmStandardTracking : public G4VPhysicsConstructor
+class G4EventRNGStream
 {
   public:
-    PhysicsListEmStandardTracking(G4int ver = 1);
-    ~PhysicsListEmStandardTracking();
-
-  public:
-    void ConstructParticle() override;
-    void ConstructProcess() override;
+    // Seeds the engine of the calling thread with the stream of the key
+    static void SeedEngine(G4long baseSeed, G4int runID, G4int eventID,
+                           G4int subEventID = 0);
 };
 
-//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-
 #endif
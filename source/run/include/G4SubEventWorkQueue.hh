@@ -0,0 +1,95 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// G4SubEventWorkQueue
+//
+// Class description:
+//
+// Lock-free work-stealing deque of sub-event slices, used by the workers
+// of G4SubEvtRunManager. A slice is a range of the tracks of a G4SubEvent
+// fetched from the master. The owning worker splits large slices in
+// halves, pushes one half to the bottom of its queue and keeps working
+// on the other; it pops from the bottom, while idle workers of the same
+// sub-event type steal from the top, i.e. the largest pieces.
+// Implemented as a fixed-capacity Chase-Lev deque: Push() and Pop() may
+// only be called by the owner, Steal() by any thread.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4SubEventWorkQueue_hh
+#define G4SubEventWorkQueue_hh 1
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "G4Types.hh"
+
+class G4SubEvent;
+
+struct G4SubEventSlice
+{
+  const G4SubEvent* subEvent = nullptr;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  std::atomic<G4int>* pendingSlices = nullptr;
+    // Number of slices of subEvent not yet merged to the master;
+    // shared by all the slices of the same sub-event
+};
+
+class G4SubEventWorkQueue
+{
+  public:
+
+    explicit G4SubEventWorkQueue(G4int subEventType)
+      : fSubEventType(subEventType) {}
+   ~G4SubEventWorkQueue() = default;
+
+    G4SubEventWorkQueue(const G4SubEventWorkQueue&) = delete;
+    G4SubEventWorkQueue& operator=(const G4SubEventWorkQueue&) = delete;
+
+    G4bool Push(G4SubEventSlice* slice);
+      // Owner only. Returns false if the queue is full.
+    G4SubEventSlice* Pop();
+      // Owner only. Returns the most recently pushed slice, or null.
+    G4SubEventSlice* Steal();
+      // Any thread. Returns the oldest slice, or null if the queue is
+      // empty or the slice was taken concurrently.
+
+    inline G4int GetSubEventType() const { return fSubEventType; }
+    inline G4bool IsEmpty() const
+    { return fBottom.load(std::memory_order_relaxed)
+             <= fTop.load(std::memory_order_relaxed); }
+
+    static constexpr std::int64_t kCapacity = 64;
+
+  private:
+
+    G4int fSubEventType;
+    alignas(64) std::atomic<std::int64_t> fTop{0};
+    alignas(64) std::atomic<std::int64_t> fBottom{0};
+    std::array<std::atomic<G4SubEventSlice*>, kCapacity> fSlices{};
+};
+
+#endif
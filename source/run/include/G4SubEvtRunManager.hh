@@ -40,9 +40,14 @@
 #define G4SubEvtRunManager_hh 1
 
 #include "G4TaskRunManager.hh"
+#include "G4SubEventWorkQueue.hh"
 
+#include <array>
 #include <atomic>
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 class G4WorkerSubEvtRunManager;
 
@@ -103,6 +108,34 @@ class G4SubEvtRunManager : public G4TaskRunManager
     // after invoking this method.
     void SubEventFinished(const G4SubEvent* se,const G4Event* evt) override;
 
+    // Work stealing between workers. When the slice size is positive,
+    // a worker splits each sub-event it receives into slices of at least
+    // this number of tracks, which idle workers of the same sub-event
+    // type can steal from its queue. Zero (default) disables splitting.
+    inline void SetSubEventSliceSize(G4int n) { fSliceSize = (n > 0) ? n : 0; }
+    inline G4int GetSubEventSliceSize() const { return fSliceSize; }
+
+    // Number of processed slices a worker keeps before merging them to
+    // the master under a single lock. The buffer is also flushed whenever
+    // the worker moves to another event or runs out of local work.
+    inline void SetResultBufferSize(G4int n) { fResultBufferSize = (n > 1) ? n : 1; }
+    inline G4int GetResultBufferSize() const { return fResultBufferSize; }
+
+    // Create the work queue of a worker of the given sub-event type. The
+    // queue is owned by the master. Null is returned if kMaxWorkQueues
+    // queues already exist.
+    G4SubEventWorkQueue* RegisterWorkQueue(G4int ty);
+
+    // Steal a slice of sub-event type "ty" from the queue of another worker.
+    // Lock free. Null is returned if no work is available.
+    G4SubEventSlice* StealSubEventSlice(G4int ty, const G4SubEventWorkQueue* self);
+
+    // Merge the results of processed slices, in the order given, with a
+    // single lock. A sub-event is terminated once all its slices are merged.
+    // Each "evt" remains owned by the worker, as for SubEventFinished().
+    void SubEventSlicesFinished(
+           const std::vector<std::pair<G4SubEventSlice*,G4Event*>>& results);
+
     // Merge local scores to the master
     void MergeScores(const G4ScoringManager* localScoringManager) override;
 
@@ -191,6 +224,7 @@ class G4SubEvtRunManager : public G4TaskRunManager
     void SetUpSeedsForSubEvent(G4long& s1, G4long& s2, G4long& s3);
 
     void MergeTrajectories(const G4SubEvent* se,const G4Event* evt) override;
+    void MergeSubEventOutput(const G4SubEvent* se,const G4Event* evt);
     void UpdateScoringForSubEvent(const G4SubEvent* se,const G4Event* evt) override;
 
     void CleanUpUnnecessaryEvents(G4int keepNEvents) override;
@@ -204,6 +238,13 @@ class G4SubEvtRunManager : public G4TaskRunManager
     std::map<G4int,G4int> fSubEvtTypeMap;
     std::map<G4WorkerSubEvtRunManager*,G4int> fWorkerMap;
 
+    static constexpr G4int kMaxWorkQueues = 1024;
+    std::array<std::atomic<G4SubEventWorkQueue*>,kMaxWorkQueues> fWorkQueues{};
+    std::vector<std::unique_ptr<G4SubEventWorkQueue>> fOwnedWorkQueues;
+    std::atomic<G4int> fNumberOfWorkQueues = 0;
+    G4int fSliceSize = 0;
+    G4int fResultBufferSize = 1;
+
     G4bool CheckSubEvtTypes();
 
   public:
@@ -94,6 +94,30 @@ class G4TaskRunManager : public G4MTRunManager, public PTL::TaskRunManager
 
     void SetGrainsize(G4int n) { eventGrainsize = n; }
     G4int GetGrainsize() const { return eventGrainsize; }
+
+    // Maximum number of completed events per worker handed to the user's
+    // G4UserEventOutputAction while the worker tracks the next events.
+    // Zero (default) disables the pipeline: the output action, if any,
+    // is invoked by the worker at the end of each event.
+    void SetEventPipelineDepth(G4int n) { eventPipelineDepth = (n > 0) ? n : 0; }
+    G4int GetEventPipelineDepth() const { return eventPipelineDepth; }
+
+    // Seeds each event from its own stream keyed by (base seed, run ID,
+    // event ID), see G4EventRNGStream, instead of the seeds pre-generated
+    // by the master. A negative base seed (default) is drawn from the master
+    // engine at the beginning of each run. Together with SetFirstEventID()
+    // and SetRunIDCounter(), any event of a run can be replayed alone.
+    void SetEventRNGStreams(G4bool val, G4long baseSeed = -1)
+    {
+      eventRNGStreams = val;
+      eventRNGStreamSeed = baseSeed;
+    }
+    G4bool GetEventRNGStreams() const { return eventRNGStreams; }
+    G4long GetEventRNGStreamSeedOfRun() const { return eventRNGStreamSeedOfRun; }
+
+    // ID given to the first event of the next runs (default 0)
+    void SetFirstEventID(G4int id) { firstEventID = (id > 0) ? id : 0; }
+    G4int GetFirstEventID() const { return firstEventID; }
     inline G4int GetNumberOfTasks() const { return numberOfTasks; }
     inline G4int GetNumberOfEventsPerTask() const { return numberOfEventsPerTask; }
 
@@ -207,6 +231,11 @@ class G4TaskRunManager : public G4MTRunManager, public PTL::TaskRunManager
     // grainsize
     G4bool workersStarted = false;
     G4int eventGrainsize = 0;
+    G4int eventPipelineDepth = 0;
+    G4bool eventRNGStreams = false;
+    G4long eventRNGStreamSeed = -1;
+    G4long eventRNGStreamSeedOfRun = 0;
+    G4int firstEventID = 0;
     G4int numberOfEventsPerTask = -1;
     G4int numberOfTasks = -1;
     CLHEP::HepRandomEngine* masterRNGEngine = nullptr;
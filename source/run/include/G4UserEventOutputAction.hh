@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4UserEventOutputAction
+//
+// Class description:
+//
+// Abstract base class for the digitisation and output of completed events
+// in the pipelined mode of G4WorkerTaskRunManager. The user instantiates
+// it in G4VUserActionInitialization::Build(), so that each worker has its
+// own instance, owned by the worker run manager.
+//
+// ProcessEvent() is invoked once per event, in the order of completion,
+// after G4UserEventAction::EndOfEventAction() and G4Run::RecordEvent():
+// the hits collections of the event are closed and may be digitised,
+// written out or added to the event. When the pipeline is enabled, see
+// G4TaskRunManager::SetEventPipelineDepth(), the invocation is a separate
+// task, possibly running on another thread of the pool, while the worker
+// tracks the next events. Calls to the same instance never overlap, but
+// the implementation must only rely on the given event and on its own
+// state: thread-local singletons (e.g. the analysis manager) and objects
+// created with thread-local G4Allocators must not be used here.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4UserEventOutputAction_hh
+#define G4UserEventOutputAction_hh 1
+
+class G4Event;
+
+class G4UserEventOutputAction
+{
+  public:
+    G4UserEventOutputAction() = default;
+    virtual ~G4UserEventOutputAction() = default;
+
+    virtual void ProcessEvent(G4Event* anEvent) = 0;
+};
+
+#endif
@@ -41,6 +41,10 @@
 // G4MTRunManager is a run action. It is then used at the beginning and the
 // end of a run. It may be the same class or a dedicated class different from
 // the run action instantiated for G4WorkerRunManager.
+//
+// Note for tasking mode: a G4UserEventOutputAction may be set to
+// G4WorkerTaskRunManager for the digitisation and output of completed
+// events, possibly executed asynchronously. It is ignored otherwise.
 
 // Author: M.Asai (SLAC), 17 April 2013
 // --------------------------------------------------------------------
@@ -53,6 +57,7 @@ class G4UserEventAction;
 class G4UserStackingAction;
 class G4UserTrackingAction;
 class G4UserSteppingAction;
+class G4UserEventOutputAction;
 class G4VSteppingVerbose;
 
 class G4VUserActionInitialization
@@ -88,6 +93,7 @@ class G4VUserActionInitialization
     void SetUserAction(G4UserStackingAction*) const;
     void SetUserAction(G4UserTrackingAction*) const;
     void SetUserAction(G4UserSteppingAction*) const;
+    void SetUserAction(G4UserEventOutputAction*) const;
 };
 
 #endif
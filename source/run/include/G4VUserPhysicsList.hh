@@ -160,6 +160,13 @@ class G4VUserPhysicsList
     void SetPhysicsTableRetrieved(const G4String& directory = "");
     void SetStoredInAscii();
 
+    // Set/get the flag of the single file image of physics tables,
+    // see G4PhysicsTableImage. If set, StorePhysicsTable() also writes
+    // the image in the directory and the retrieval maps it read-only,
+    // the per-table files are used if the image cannot be mapped.
+    void SetPhysicsTableImage(G4bool val);
+    G4bool IsPhysicsTableImage() const;
+
     // Reset "Retrieve" flag.
     void ResetPhysicsTableRetrieved();
     void ResetStoredInAscii();
@@ -282,6 +289,7 @@ class G4VUserPhysicsList
     // Flag to determine if physics table will be build from file or not.
     G4bool fRetrievePhysicsTable = false;
     G4bool fStoredInAscii = true;
+    G4bool fPhysicsTableImage = false;
 
     G4bool fIsCheckedForRetrievePhysicsTable = false;
     G4bool fIsRestoredCutValues = false;
@@ -357,6 +365,16 @@ inline void G4VUserPhysicsList::ResetStoredInAscii()
   fStoredInAscii = false;
 }
 
+inline void G4VUserPhysicsList::SetPhysicsTableImage(G4bool val)
+{
+  fPhysicsTableImage = val;
+}
+
+inline G4bool G4VUserPhysicsList::IsPhysicsTableImage() const
+{
+  return fPhysicsTableImage;
+}
+
 inline void G4VUserPhysicsList::DisableCheckParticleList()
 {
   fDisableCheckParticleList = true;
@@ -40,6 +40,10 @@
 #define G4WorkerSubEvtRunManager_h 1
 
 #include "G4WorkerTaskRunManager.hh"
+#include "G4SubEventWorkQueue.hh"
+
+#include <utility>
+#include <vector>
 
 class G4WorkerThread;
 class G4WorkerTaskRunManagerKernel;
@@ -85,8 +89,18 @@ class G4WorkerSubEvtRunManager : public G4WorkerTaskRunManager
     void StoreRNGStatus(const G4String& filenamePrefix) override;
     void SetupDefaultRNGEngine() override;
 
+  private:
+    void ProcessSubEventSlice(G4SubEventSlice* slice, G4int sliceSize);
+      // Process the tracks of a slice, after splitting off the parts that
+      // other workers may steal. The results are buffered.
+    void FlushSubEventResults();
+      // Merge the buffered results to the master with a single lock
+
   private:
     G4int fSubEventType = -1;
+    G4SubEventWorkQueue* fWorkQueue = nullptr;
+    G4bool fWorkQueueRequested = false;
+    std::vector<std::pair<G4SubEventSlice*,G4Event*>> fSliceResults;
 
   public:
     G4int GetSubEventType() const override
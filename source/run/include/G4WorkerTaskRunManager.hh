@@ -42,6 +42,10 @@
 #include "G4RunManager.hh"
 #include "G4WorkerRunManager.hh"
 
+#include <memory>
+
+class G4EventOutputPipeline;
+class G4UserEventOutputAction;
 class G4WorkerThread;
 class G4WorkerTaskRunManagerKernel;
 
@@ -53,12 +57,14 @@ class G4WorkerTaskRunManager : public G4WorkerRunManager
   public:
     static G4WorkerTaskRunManager* GetWorkerRunManager();
     static G4WorkerTaskRunManagerKernel* GetWorkerRunManagerKernel();
-    G4WorkerTaskRunManager() = default;
+    G4WorkerTaskRunManager();
+    ~G4WorkerTaskRunManager() override;
 
     // Modified for worker behavior
     void RunInitialization() override;
     void DoEventLoop(G4int n_event, const char* macroFile = nullptr, G4int n_select = -1) override;
     void ProcessOneEvent(G4int i_event) override;
+    void TerminateOneEvent() override;
     G4Event* GenerateEvent(G4int i_event) override;
     void RunTermination() override;
     void TerminateEventLoop() override;
@@ -70,14 +76,30 @@ class G4WorkerTaskRunManager : public G4WorkerRunManager
     G4WorkerThread* GetWorkerThread() const { return workerContext; }
     G4StrVector GetCommandStack() const { return processedCommandStack; }
 
+    // The output action is owned by the run manager. Completed events are
+    // handed to it asynchronously if the master has a non-zero event
+    // pipeline depth, see G4TaskRunManager::SetEventPipelineDepth()
+    void SetUserEventOutputAction(G4UserEventOutputAction* userAction);
+    const G4UserEventOutputAction* GetUserEventOutputAction() const
+    {
+      return userEventOutputAction;
+    }
+
   protected:
     void StoreRNGStatus(const G4String& filenamePrefix) override;
 
   protected:
     void SetupDefaultRNGEngine() override;
 
+    // Releases the events already processed by the output stage
+    void StackProcessedEvents();
+
   protected:
     G4StrVector processedCommandStack;
+    G4UserEventOutputAction* userEventOutputAction = nullptr;
+    std::unique_ptr<G4EventOutputPipeline> eventOutputPipeline;
+    std::vector<G4Event*> processedOutputEvents;
+    G4int eventPipelineDepth = 0;
 };
 
 #endif  // G4WorkerTaskRunManager_h
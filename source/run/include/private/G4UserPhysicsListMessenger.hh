@@ -42,6 +42,7 @@
 //   storePhysicsTable    * store physics table into files
 //   retreivePhysicsTable * retrieve physics table from files
 //   setStoredInAscii * Switch on/off ascii mode in store/retrieve Physics Table
+//   setPhysicsTableImage * Switch on/off the mapped image of Physics Table
 
 // Original author: H.Kurashige, 9 January 1998
 // --------------------------------------------------------------------
@@ -88,6 +89,7 @@ class G4UserPhysicsListMessenger : public G4UImessenger
     G4UIcmdWithAString* storeCmd = nullptr;
     G4UIcmdWithAString* retrieveCmd = nullptr;
     G4UIcmdWithAnInteger* asciiCmd = nullptr;
+    G4UIcmdWithAnInteger* imageCmd = nullptr;
     G4UIcommand* applyCutsCmd = nullptr;
     G4UIcmdWithAString* dumpCutValuesCmd = nullptr;
     G4UIcmdWithAnInteger* dumpOrdParamCmd = nullptr;
@@ -5,6 +5,8 @@ geant4_add_module(G4run
   PUBLIC_HEADERS
     G4AdjointPrimaryGeneratorAction.hh
     G4AdjointSimManager.hh
+    G4EventOutputPipeline.hh
+    G4EventRNGStream.hh
     G4ExceptionHandler.hh
     G4MaterialScanner.hh
     G4MSSteppingAction.hh
@@ -20,9 +22,11 @@ geant4_add_module(G4run
     G4RunManagerFactory.hh
     G4RunManager.hh
     G4RunManagerKernel.hh
+    G4SubEventWorkQueue.hh
     G4SubEvtRunManager.hh
     G4TaskRunManager.hh
     G4TaskRunManagerKernel.hh
+    G4UserEventOutputAction.hh
     G4UserRunAction.hh
     G4UserSubEvtThreadInitialization.hh
     G4UserTaskInitialization.hh
@@ -55,6 +59,8 @@ geant4_add_module(G4run
     G4AdjointPrimaryGeneratorAction.cc
     G4AdjointSimManager.cc
     G4AdjointSimMessenger.cc
+    G4EventOutputPipeline.cc
+    G4EventRNGStream.cc
     G4ExceptionHandler.cc
     G4MaterialScanner.cc
     G4MatScanMessenger.cc
@@ -70,6 +76,7 @@ geant4_add_module(G4run
     G4RunManagerFactory.cc
     G4RunManagerKernel.cc
     G4RunMessenger.cc
+    G4SubEventWorkQueue.cc
     G4SubEvtRunManager.cc
     G4TaskRunManager.cc
     G4TaskRunManagerKernel.cc
@@ -0,0 +1,124 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventOutputPipeline implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4EventOutputPipeline.hh"
+
+#include "G4TaskManager.hh"
+#include "G4TaskRunManager.hh"
+#include "G4UserEventOutputAction.hh"
+
+// --------------------------------------------------------------------
+G4EventOutputPipeline::G4EventOutputPipeline(G4UserEventOutputAction* action)
+  : fState(std::make_shared<State>())
+{
+  fState->action = action;
+}
+
+// --------------------------------------------------------------------
+void G4EventOutputPipeline::Submit(G4Event* anEvent, G4int maxEventsInFlight)
+{
+  State& state = *fState;
+  std::unique_lock<std::mutex> lock(state.mutex);
+
+  // Back-pressure: bound the number of events kept alive by the stage
+  //
+  while (G4int(state.queue.size()) + (state.running ? 1 : 0) >= maxEventsInFlight)
+  {
+    if (!state.running) {
+      ProcessQueue(state, lock);
+    }
+    else {
+      state.processedCondition.wait(lock);
+    }
+  }
+
+  state.queue.push_back(anEvent);
+  if (state.running || state.taskScheduled) return;
+  state.taskScheduled = true;
+  lock.unlock();
+
+  G4TaskManager* taskManager = G4TaskRunManager::GetMasterRunManager()->GetTaskManager();
+  taskManager->async([pState = fState]() {
+    std::unique_lock<std::mutex> taskLock(pState->mutex);
+    pState->taskScheduled = false;
+    if (!pState->running) ProcessQueue(*pState, taskLock);
+  });
+}
+
+// --------------------------------------------------------------------
+void G4EventOutputPipeline::Collect(std::vector<G4Event*>& processed)
+{
+  std::lock_guard<std::mutex> lock(fState->mutex);
+  processed.insert(processed.end(), fState->processed.begin(), fState->processed.end());
+  fState->processed.clear();
+}
+
+// --------------------------------------------------------------------
+void G4EventOutputPipeline::Drain()
+{
+  // The events left in the queue are processed here rather than waiting
+  // for a scheduled task: the threads of the pool may all be blocked at
+  // the end of the event loop
+  //
+  State& state = *fState;
+  std::unique_lock<std::mutex> lock(state.mutex);
+  while (!state.queue.empty() || state.running) {
+    if (!state.running) {
+      ProcessQueue(state, lock);
+    }
+    else {
+      state.processedCondition.wait(lock);
+    }
+  }
+}
+
+// --------------------------------------------------------------------
+G4int G4EventOutputPipeline::GetNumberOfEventsInFlight() const
+{
+  std::lock_guard<std::mutex> lock(fState->mutex);
+  return G4int(fState->queue.size()) + (fState->running ? 1 : 0);
+}
+
+// --------------------------------------------------------------------
+void G4EventOutputPipeline::ProcessQueue(State& state, std::unique_lock<std::mutex>& lock)
+{
+  state.running = true;
+  while (!state.queue.empty()) {
+    G4Event* anEvent = state.queue.front();
+    state.queue.pop_front();
+    lock.unlock();
+    state.action->ProcessEvent(anEvent);
+    lock.lock();
+    state.processed.push_back(anEvent);
+    state.processedCondition.notify_all();
+  }
+  state.running = false;
+  state.processedCondition.notify_all();
+}
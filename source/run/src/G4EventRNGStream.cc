@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventRNGStream implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4EventRNGStream.hh"
+
+#include "Randomize.hh"
+
+#include "CLHEP/Random/MixMaxRng.h"
+
+#include <cstdint>
+
+namespace
+{
+// splitmix64 finalizer
+std::uint64_t Mix(std::uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+}  // namespace
+
+// --------------------------------------------------------------------
+void G4EventRNGStream::SeedEngine(G4long baseSeed, G4int runID, G4int eventID,
+                                  G4int subEventID)
+{
+  CLHEP::HepRandomEngine* engine = G4Random::getTheEngine();
+  if (dynamic_cast<CLHEP::MixMaxRng*>(engine) != nullptr) {
+    // seeds[0] is the stream ID, seeds[3] the cluster ID of MixMax
+    long seeds[5] = {long(eventID), long(subEventID), long(runID),
+                     long(std::uint64_t(baseSeed) & 0xffffffffULL), 0};
+    G4Random::setTheSeeds(seeds, 4);
+  }
+  else {
+    std::uint64_t h = Mix(std::uint64_t(baseSeed));
+    h = Mix(h ^ std::uint64_t(std::uint32_t(runID)));
+    h = Mix(h ^ std::uint64_t(std::uint32_t(eventID)));
+    h = Mix(h ^ std::uint64_t(std::uint32_t(subEventID)));
+    // non-zero seeds, zero terminates the seed list of some engines
+    long seeds[3] = {long(h >> 34) + 1, long((h & 0x3fffffffULL) + 1), 0};
+    G4Random::setTheSeeds(seeds, -1);
+  }
+}
@@ -59,6 +59,7 @@
 #include "G4SmartVoxelStat.hh"
 #include "G4SolidStore.hh"
 #include "G4StateManager.hh"
+#include "G4StepProfiler.hh"
 #include "G4Timer.hh"
 #include "G4TransportationManager.hh"
 #include "G4FieldBuilder.hh"
@@ -512,6 +513,10 @@ void G4RunManager::RunTermination()
       if (isScoreNtupleWriter) {
         G4VScoreNtupleWriter::Instance()->Write();
       }
+      // report of the tracking profiler, merged over the workers
+      if (runManagerType != workerRM && runManagerType != subEventWorkerRM) {
+        G4StepProfiler::Report(currentRun->GetRunID());
+      }
     }
     ++runIDCounter;
   }
@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// G4SubEventWorkQueue implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4SubEventWorkQueue.hh"
+
+G4bool G4SubEventWorkQueue::Push(G4SubEventSlice* slice)
+{
+  std::int64_t b = fBottom.load(std::memory_order_relaxed);
+  std::int64_t t = fTop.load(std::memory_order_acquire);
+  if (b - t >= kCapacity) { return false; }
+  fSlices[b % kCapacity].store(slice, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  fBottom.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+G4SubEventSlice* G4SubEventWorkQueue::Pop()
+{
+  std::int64_t b = fBottom.load(std::memory_order_relaxed) - 1;
+  fBottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t t = fTop.load(std::memory_order_relaxed);
+
+  G4SubEventSlice* slice = nullptr;
+  if (t <= b)
+  {
+    slice = fSlices[b % kCapacity].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+      // Last slice: race against the thieves
+      //
+      if (!fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+      {
+        slice = nullptr;
+      }
+      fBottom.store(b + 1, std::memory_order_relaxed);
+    }
+  }
+  else
+  {
+    fBottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return slice;
+}
+
+G4SubEventSlice* G4SubEventWorkQueue::Steal()
+{
+  std::int64_t t = fTop.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t b = fBottom.load(std::memory_order_acquire);
+  if (t >= b) { return nullptr; }
+
+  G4SubEventSlice* slice
+    = fSlices[t % kCapacity].load(std::memory_order_relaxed);
+  if (!fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed))
+  {
+    return nullptr;
+  }
+  return slice;
+}
@@ -657,6 +657,15 @@ void G4SubEvtRunManager::SetUpSeedsForSubEvent(G4long& s1, G4long& s2, G4long& s
 void G4SubEvtRunManager::SubEventFinished(const G4SubEvent* se,const G4Event* evt)
 {
   G4AutoLock l(&accessSubEventMutex);
+  MergeSubEventOutput(se,evt);
+  eventManager->TerminateSubEvent(se,evt);
+}
+
+//============================================================================//
+
+void G4SubEvtRunManager::MergeSubEventOutput(const G4SubEvent* se,const G4Event* evt)
+{
+  // To be invoked with accessSubEventMutex locked
   auto masterEvt = se->GetEvent();
   if(masterEvt==nullptr) {
     G4Exception("G4SubEvtRunManager::SubEventFinished()","SERM0001",
@@ -670,7 +679,66 @@ void G4SubEvtRunManager::SubEventFinished(const G4SubEvent* se,const G4Event* ev
   if(trajectoriesToBeMerged) MergeTrajectories(se,evt);
   UpdateScoringForSubEvent(se,evt);
   evt->ScoresRecorded();
-  eventManager->TerminateSubEvent(se,evt);
+}
+
+//============================================================================//
+
+void G4SubEvtRunManager::SubEventSlicesFinished(
+       const std::vector<std::pair<G4SubEventSlice*,G4Event*>>& results)
+{
+  G4AutoLock l(&accessSubEventMutex);
+  for(const auto& result : results)
+  {
+    G4SubEventSlice* slice = result.first;
+    MergeSubEventOutput(slice->subEvent,result.second);
+    // All the updates of the counter of pending slices are atomic; the last
+    // slice of a sub-event terminates it and releases the shared counter
+    if(slice->pendingSlices->fetch_sub(1) == 1)
+    {
+      eventManager->TerminateSubEvent(slice->subEvent,result.second);
+      delete slice->pendingSlices;
+    }
+    else
+    {
+      eventManager->MergeSubEvent(slice->subEvent,result.second);
+    }
+  }
+}
+
+//============================================================================//
+
+G4SubEventWorkQueue* G4SubEvtRunManager::RegisterWorkQueue(G4int ty)
+{
+  G4AutoLock l(&registerSubEvtWorkerMutex);
+  G4int n = fNumberOfWorkQueues.load();
+  if(n >= kMaxWorkQueues) return nullptr;
+  fOwnedWorkQueues.push_back(std::make_unique<G4SubEventWorkQueue>(ty));
+  fWorkQueues[n].store(fOwnedWorkQueues.back().get(),std::memory_order_release);
+  fNumberOfWorkQueues.store(n+1,std::memory_order_release);
+  return fOwnedWorkQueues.back().get();
+}
+
+//============================================================================//
+
+G4SubEventSlice* G4SubEvtRunManager::StealSubEventSlice(G4int ty,
+                                        const G4SubEventWorkQueue* self)
+{
+  G4int n = fNumberOfWorkQueues.load(std::memory_order_acquire);
+  if(n < 2) return nullptr;
+
+  // Start from a different victim at each attempt to spread the thieves
+  G4ThreadLocalStatic G4int start = 0;
+  start = (start + 1) % n;
+  for(G4int i = 0; i < n; ++i)
+  {
+    G4SubEventWorkQueue* victim
+      = fWorkQueues[(start + i) % n].load(std::memory_order_acquire);
+    if(victim == nullptr || victim == self) continue;
+    if(victim->GetSubEventType() != ty || victim->IsEmpty()) continue;
+    G4SubEventSlice* slice = victim->Steal();
+    if(slice != nullptr) return slice;
+  }
+  return nullptr;
 }
 
 //============================================================================//
@@ -469,7 +469,18 @@ void G4TaskRunManager::InitializeEventLoop(G4int n_event, const char* macroFile,
     // If user did not implement InitializeSeeds,
     // use default: nSeedsPerEvent seeds per event
 
-    if (n_event > 0) {
+    if (n_event > 0 && eventRNGStreams) {
+      // the workers seed each event from its key, no seed to pre-generate
+      eventRNGStreamSeedOfRun = eventRNGStreamSeed;
+      if (eventRNGStreamSeedOfRun < 0) {
+        eventRNGStreamSeedOfRun = (G4long)(100000000L * masterRNGEngine->flat()) + 1;
+      }
+      if (verboseLevel > 0) {
+        G4cout << "Events are seeded from RNG streams with base seed "
+               << eventRNGStreamSeedOfRun << G4endl;
+      }
+    }
+    else if (n_event > 0) {
       G4bool _overload = InitializeSeeds(n_event);
       G4bool _functor = false;
       if (!_overload) _functor = initSeedsCallback(n_event, nSeedsPerEvent, nSeedsFilled);
@@ -569,7 +580,7 @@ G4bool G4TaskRunManager::SetUpAnEvent(G4Event* evt, G4long& s1, G4long& s2, G4lo
 {
   G4AutoLock l(&setUpEventMutex);
   if (numberOfEventProcessed < numberOfEventToBeProcessed) {
-    evt->SetEventID(numberOfEventProcessed);
+    evt->SetEventID(firstEventID + numberOfEventProcessed);
     if (reseedRequired) {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
       G4int idx_rndm = nSeedsPerEvent * nSeedsUsed;
@@ -597,7 +608,7 @@ G4int G4TaskRunManager::SetUpNEvents(G4Event* evt, G4SeedsQueue* seedsQueue, G4b
       nevt = numberOfEventToBeProcessed - numberOfEventProcessed;
       nmod = numberOfEventToBeProcessed - numberOfEventProcessed;
     }
-    evt->SetEventID(numberOfEventProcessed);
+    evt->SetEventID(firstEventID + numberOfEventProcessed);
 
     if (reseedRequired) {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
@@ -156,6 +156,17 @@ G4UserPhysicsListMessenger::G4UserPhysicsListMessenger(G4VUserPhysicsList* pPart
   asciiCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
   asciiCmd->SetRange("ascii ==0 || ascii ==1");
 
+  //  /run/particle/setPhysicsTableImage command
+  imageCmd = new G4UIcmdWithAnInteger("/run/particle/setPhysicsTableImage", this);
+  imageCmd->SetGuidance("Switch on/off the single file image of Physics Table");
+  imageCmd->SetGuidance("  written by storePhysicsTable together with the files");
+  imageCmd->SetGuidance("  and mapped read-only in memory by retrievePhysicsTable");
+  imageCmd->SetGuidance("  Enter 0(off) or 1(on)");
+  imageCmd->SetParameterName("image", true);
+  imageCmd->SetDefaultValue(1);
+  imageCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  imageCmd->SetRange("image ==0 || image ==1");
+
   // Commnad    /run/particle/applyCuts command
   applyCutsCmd = new G4UIcommand("/run/particle/applyCuts", this);
   applyCutsCmd->SetGuidance("Set applyCuts flag for a particle.");
@@ -216,6 +227,7 @@ G4UserPhysicsListMessenger::~G4UserPhysicsListMessenger()
   delete storeCmd;
   delete retrieveCmd;
   delete asciiCmd;
+  delete imageCmd;
   delete applyCutsCmd;
   delete dumpCutValuesCmd;
   delete dumpOrdParamCmd;
@@ -307,6 +319,9 @@ void G4UserPhysicsListMessenger::SetNewValue(G4UIcommand* command, G4String newV
       thePhysicsList->SetStoredInAscii();
     }
   }
+  else if (command == imageCmd) {
+    thePhysicsList->SetPhysicsTableImage(imageCmd->GetNewIntValue(newValue) != 0);
+  }
   else if (command == applyCutsCmd) {
     G4Tokenizer next(newValue);
 
@@ -376,6 +391,9 @@ G4String G4UserPhysicsListMessenger::GetCurrentValue(G4UIcommand* command)
       cv = "0";
     }
   }
+  else if (command == imageCmd) {
+    cv = thePhysicsList->IsPhysicsTableImage() ? "1" : "0";
+  }
 
   return cv;
 }
@@ -31,6 +31,8 @@
 #include "G4VUserActionInitialization.hh"
 
 #include "G4RunManager.hh"
+#include "G4UserEventOutputAction.hh"
+#include "G4WorkerTaskRunManager.hh"
 
 // --------------------------------------------------------------------
 void G4VUserActionInitialization::SetUserAction(G4VUserPrimaryGeneratorAction* action) const
@@ -67,3 +69,17 @@ void G4VUserActionInitialization::SetUserAction(G4UserSteppingAction* action) co
 {
   G4RunManager::GetRunManager()->SetUserAction(action);
 }
+
+// --------------------------------------------------------------------
+void G4VUserActionInitialization::SetUserAction(G4UserEventOutputAction* action) const
+{
+  auto wrm = dynamic_cast<G4WorkerTaskRunManager*>(G4RunManager::GetRunManager());
+  if (wrm != nullptr) {
+    wrm->SetUserEventOutputAction(action);
+    return;
+  }
+  G4Exception("G4VUserActionInitialization::SetUserAction()", "Run0283", JustWarning,
+              "G4UserEventOutputAction is only supported by G4WorkerTaskRunManager.\n"
+              "The action is deleted.");
+  delete action;
+}
@@ -35,6 +35,7 @@
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleTable.hh"
 #include "G4PhysicsListHelper.hh"
+#include "G4PhysicsTableImage.hh"
 #include "G4ProcessManager.hh"
 #include "G4ProductionCuts.hh"
 #include "G4ProductionCutsTable.hh"
@@ -142,6 +143,7 @@ G4VUserPhysicsList::G4VUserPhysicsList(const G4VUserPhysicsList& right)
     isSetDefaultCutValue(right.isSetDefaultCutValue),
     fRetrievePhysicsTable(right.fRetrievePhysicsTable),
     fStoredInAscii(right.fStoredInAscii),
+    fPhysicsTableImage(right.fPhysicsTableImage),
     fIsCheckedForRetrievePhysicsTable(right.fIsCheckedForRetrievePhysicsTable),
     fIsRestoredCutValues(right.fIsRestoredCutValues),
     directoryPhysicsTable(right.directoryPhysicsTable),
@@ -176,6 +178,7 @@ G4VUserPhysicsList& G4VUserPhysicsList::operator=(const G4VUserPhysicsList& righ
     isSetDefaultCutValue = right.isSetDefaultCutValue;
     fRetrievePhysicsTable = right.fRetrievePhysicsTable;
     fStoredInAscii = right.fStoredInAscii;
+    fPhysicsTableImage = right.fPhysicsTableImage;
     fIsCheckedForRetrievePhysicsTable = right.fIsCheckedForRetrievePhysicsTable;
     fIsRestoredCutValues = right.fIsRestoredCutValues;
     directoryPhysicsTable = right.directoryPhysicsTable;
@@ -528,6 +531,17 @@ void G4VUserPhysicsList::BuildPhysicsTable()
                << "  Retrieve Cut Table successfully " << G4endl;
       }
 #endif
+      // tables found in the mapped image are not read from files
+      if (fPhysicsTableImage) {
+        G4String fileName =
+          directoryPhysicsTable + "/" + G4PhysicsTableImage::DefaultFileName();
+        if (!G4PhysicsTableImage::GetInstance()->Map(fileName)) {
+          G4String comment = "Fail to map physics table image " + fileName;
+          comment += ", physics tables are retrieved from files";
+          G4Exception("G4VUserPhysicsList::BuildPhysicsTable", "Run0256", JustWarning,
+                      comment);
+        }
+      }
     }
   }
   else {
@@ -823,6 +837,10 @@ G4bool G4VUserPhysicsList::StorePhysicsTable(const G4String& directory)
 
   G4bool success = true;
 
+  // the stored tables are also recorded in the image
+  G4PhysicsTableImage* image = G4PhysicsTableImage::GetInstance();
+  if (fPhysicsTableImage) image->StartRecording();
+
   // loop over all particles in G4ParticleTable
   theParticleIterator->reset();
   while ((*theParticleIterator)()) {
@@ -841,6 +859,15 @@ G4bool G4VUserPhysicsList::StorePhysicsTable(const G4String& directory)
     // end loop over processes
   }
   // end loop over particles
+
+  if (fPhysicsTableImage) {
+    G4String fileName = dir + "/" + G4PhysicsTableImage::DefaultFileName();
+    if (!image->Write(fileName)) {
+      G4Exception("G4VUserPhysicsList::StorePhysicsTable", "Run0284", JustWarning,
+                  "Fail to store physics table image");
+      success = false;
+    }
+  }
   return success;
 }
 
@@ -474,9 +474,37 @@ void G4WorkerSubEvtRunManager::DoWork()
 
   eventManager->UseSubEventParallelism(true);
 
+  // Work queue of this worker, for the sub-event slices that the other
+  // workers can steal (see G4SubEventWorkQueue)
+  G4int sliceSize = mrm->GetSubEventSliceSize();
+  if(sliceSize > 0 && !fWorkQueueRequested)
+  {
+    fWorkQueue = mrm->RegisterWorkQueue(fSubEventType);
+    fWorkQueueRequested = true;
+  }
+
   G4bool needMoreWork = true;
   while(needMoreWork)
   {
+    // Local work first, then work of the other workers. A worker steals
+    // only once it has been seeded with a sub-event from the master.
+    G4SubEventSlice* slice = nullptr;
+    if(fWorkQueue != nullptr)
+    {
+      slice = fWorkQueue->Pop();
+      if(slice == nullptr && !reseedRequired)
+      { slice = mrm->StealSubEventSlice(fSubEventType, fWorkQueue); }
+    }
+    if(slice != nullptr)
+    {
+      ProcessSubEventSlice(slice, sliceSize);
+      continue;
+    }
+
+    // No local work left: hand the buffered results over to the master,
+    // so that their events can complete, before asking for more work
+    FlushSubEventResults();
+
     G4bool notReady = false;
     G4long s1, s2, s3;
     auto subEv = mrm->GetSubEvent(fSubEventType, notReady, s1, s2, s3, reseedRequired);
@@ -501,45 +529,103 @@ void G4WorkerSubEvtRunManager::DoWork()
         reseedRequired = false;
       }
 
-      // create a G4Event object for this sub-event. This G4Event object will contain output
-      // to be merged into the master event.
-      auto masterEvent = subEv->GetEvent();
-      G4Event* ev = new G4Event(masterEvent->GetEventID());
-      ev->FlagAsSubEvent(masterEvent,fSubEventType);
-      ++numberOfEventProcessed;
+      slice = new G4SubEventSlice;
+      slice->subEvent = subEv;
+      slice->begin = 0;
+      slice->end = subEv->size();
+      slice->pendingSlices = new std::atomic<G4int>(1);
+      ProcessSubEventSlice(slice, sliceSize);
+    }
+  }
+  FlushSubEventResults();
 
-      // Create a G4TrackVector as the input
-      G4TrackVector* tv = new G4TrackVector();
-      for(auto& stackedTrack : *subEv)
+  if(verboseLevel>1) {
+    G4cout << "G4WorkerSubEvtRunManager::DoWork() completed.........." << G4endl;
+  }
+    
+}
+
+void G4WorkerSubEvtRunManager::ProcessSubEventSlice(G4SubEventSlice* slice,
+                                                   G4int sliceSize)
+{
+  // Split the slice in halves down to the slice size, keeping the first
+  // half each time and exposing the second one to the other workers
+  if(fWorkQueue != nullptr && sliceSize > 0)
+  {
+    while(slice->end - slice->begin >= 2*std::size_t(sliceSize))
+    {
+      auto half = new G4SubEventSlice;
+      half->subEvent = slice->subEvent;
+      half->begin = (slice->begin + slice->end)/2;
+      half->end = slice->end;
+      half->pendingSlices = slice->pendingSlices;
+      half->pendingSlices->fetch_add(1);
+      if(!fWorkQueue->Push(half))
       {
-        // tracks (and trajectories) stored in G4SubEvent object belong to the master thread
-        // and thus they must not be deleted by the worker thread. They must be cloned.
-        G4Track* tr = new G4Track();
-        tr->CopyTrackInfo(*(stackedTrack.GetTrack()),false);
-        tv->push_back(tr);
+        half->pendingSlices->fetch_sub(1);
+        delete half;
+        break;
       }
+      slice->end = half->begin;
+    }
+  }
+
+  auto subEv = slice->subEvent;
+  auto masterEvent = subEv->GetEvent();
 
-      // Process this sub-event
-      currentEvent = ev;
-      eventManager->ProcessOneEvent(tv,ev);
+  // Buffered results of another event are handed over first, so that
+  // events complete as soon as all their sub-events are processed
+  if(!fSliceResults.empty()
+     && fSliceResults.front().first->subEvent->GetEvent() != masterEvent)
+  {
+    FlushSubEventResults();
+  }
 
-      // We don't need following two lines, as they are taken care by the master
-      //////AnalyzeEvent(ev);
-      //////UpdateScoring();
+  // create a G4Event object for this sub-event. This G4Event object will contain output
+  // to be merged into the master event.
+  G4Event* ev = new G4Event(masterEvent->GetEventID());
+  ev->FlagAsSubEvent(masterEvent,fSubEventType);
+  ++numberOfEventProcessed;
 
-      // Report the results to the master
-      mrm->SubEventFinished(subEv,ev);
-     
-      // clean up
-      delete tv;
-      delete ev;
-    }
+  // Create a G4TrackVector as the input
+  G4TrackVector* tv = new G4TrackVector();
+  for(std::size_t i = slice->begin; i < slice->end; ++i)
+  {
+    // tracks (and trajectories) stored in G4SubEvent object belong to the master thread
+    // and thus they must not be deleted by the worker thread. They must be cloned.
+    G4Track* tr = new G4Track();
+    tr->CopyTrackInfo(*((*subEv)[i].GetTrack()),false);
+    tv->push_back(tr);
   }
 
-  if(verboseLevel>1) {
-    G4cout << "G4WorkerSubEvtRunManager::DoWork() completed.........." << G4endl;
+  // Process this slice
+  currentEvent = ev;
+  eventManager->ProcessOneEvent(tv,ev);
+  delete tv;
+
+  // Keep the results until the buffer is flushed to the master
+  fSliceResults.emplace_back(slice,ev);
+  auto mrm = G4SubEvtRunManager::GetMasterRunManager();
+  if((G4int)fSliceResults.size() >= mrm->GetResultBufferSize())
+  { FlushSubEventResults(); }
+}
+
+void G4WorkerSubEvtRunManager::FlushSubEventResults()
+{
+  if(fSliceResults.empty()) return;
+
+  // Report the results to the master
+  auto mrm = G4SubEvtRunManager::GetMasterRunManager();
+  mrm->SubEventSlicesFinished(fSliceResults);
+
+  // clean up
+  for(auto& result : fSliceResults)
+  {
+    delete result.second;
+    delete result.first;
   }
-    
+  fSliceResults.clear();
+  currentEvent = nullptr;
 }
 
 void G4WorkerSubEvtRunManager::SetSubEventType(G4int ty)
@@ -28,6 +28,8 @@
 #include "G4WorkerTaskRunManager.hh"
 
 #include "G4AutoLock.hh"
+#include "G4EventOutputPipeline.hh"
+#include "G4EventRNGStream.hh"
 #include "G4MTRunManager.hh"
 #include "G4ParallelWorldProcess.hh"
 #include "G4ParallelWorldProcessStore.hh"
@@ -39,6 +41,7 @@
 #include "G4Timer.hh"
 #include "G4TransportationManager.hh"
 #include "G4UImanager.hh"
+#include "G4UserEventOutputAction.hh"
 #include "G4UserRunAction.hh"
 #include "G4UserWorkerInitialization.hh"
 #include "G4UserWorkerThreadInitialization.hh"
@@ -57,6 +60,25 @@
 
 //============================================================================//
 
+G4WorkerTaskRunManager::G4WorkerTaskRunManager() = default;
+
+//============================================================================//
+
+G4WorkerTaskRunManager::~G4WorkerTaskRunManager()
+{
+  // Events still in the pipeline are deleted with the previous events
+  if (eventOutputPipeline != nullptr) {
+    eventOutputPipeline->Drain();
+    eventOutputPipeline->Collect(processedOutputEvents);
+    previousEvents->insert(previousEvents->end(), processedOutputEvents.cbegin(),
+                           processedOutputEvents.cend());
+  }
+  eventOutputPipeline.reset();
+  delete userEventOutputAction;
+}
+
+//============================================================================//
+
 G4WorkerTaskRunManager* G4WorkerTaskRunManager::GetWorkerRunManager()
 {
   return static_cast<G4WorkerTaskRunManager*>(G4RunManager::GetRunManager());
@@ -154,6 +176,11 @@ void G4WorkerTaskRunManager::RunInitialization()
     StoreRNGStatus(fileN);
   }
 
+  eventPipelineDepth = (userEventOutputAction != nullptr) ? mrm->GetEventPipelineDepth() : 0;
+  if (eventPipelineDepth > 0 && eventOutputPipeline == nullptr) {
+    eventOutputPipeline = std::make_unique<G4EventOutputPipeline>(userEventOutputAction);
+  }
+
   runAborted = false;
   numberOfEventProcessed = 0;
 }
@@ -213,6 +240,54 @@ void G4WorkerTaskRunManager::ProcessOneEvent(G4int i_event)
 
 //============================================================================//
 
+void G4WorkerTaskRunManager::TerminateOneEvent()
+{
+  if (userEventOutputAction == nullptr) {
+    G4RunManager::TerminateOneEvent();
+    return;
+  }
+
+  if (eventPipelineDepth > 0) {
+    // Hand the event to the output stage and release the events it
+    // already processed; the worker can then start the next event
+    StackProcessedEvents();
+    eventOutputPipeline->Submit(currentEvent, eventPipelineDepth);
+  }
+  else {
+    userEventOutputAction->ProcessEvent(currentEvent);
+    StackPreviousEvent(currentEvent);
+  }
+  currentEvent = nullptr;
+  ++numberOfEventProcessed;
+}
+
+//============================================================================//
+
+void G4WorkerTaskRunManager::StackProcessedEvents()
+{
+  if (eventOutputPipeline == nullptr) return;
+
+  eventOutputPipeline->Collect(processedOutputEvents);
+  for (auto evt : processedOutputEvents)
+    StackPreviousEvent(evt);
+  processedOutputEvents.clear();
+}
+
+//============================================================================//
+
+void G4WorkerTaskRunManager::SetUserEventOutputAction(G4UserEventOutputAction* userAction)
+{
+  if (eventOutputPipeline != nullptr) {
+    eventOutputPipeline->Drain();
+    StackProcessedEvents();
+    eventOutputPipeline.reset();
+  }
+  if (userEventOutputAction != userAction) delete userEventOutputAction;
+  userEventOutputAction = userAction;
+}
+
+//============================================================================//
+
 G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
 {
   auto anEvent = new G4Event(i_event);
@@ -222,6 +297,11 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
   G4bool eventHasToBeSeeded = true;
   if (G4MTRunManager::SeedOncePerCommunication() == 1 && runIsSeeded) eventHasToBeSeeded = false;
 
+  // Per-event RNG streams: no seed is taken from the master
+  G4TaskRunManager* mrm = G4TaskRunManager::GetMasterRunManager();
+  G4bool eventRNGStreams = (mrm != nullptr) && mrm->GetEventRNGStreams();
+  if (eventRNGStreams) eventHasToBeSeeded = false;
+
   if (i_event < 0) {
     G4int nevM = G4MTRunManager::GetMasterRunManager()->GetEventModulo();
     if (nevM == 1) {
@@ -271,6 +351,10 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
     G4Random::setTheSeeds(seeds, -1);
     runIsSeeded = true;
   }
+  else if (eventRNGStreams) {
+    G4EventRNGStream::SeedEngine(mrm->GetEventRNGStreamSeedOfRun(), currentRun->GetRunID(),
+                                 anEvent->GetEventID());
+  }
 
   // Read from file seed.
   // Andrea Dotti 4 November 2015
@@ -316,6 +400,10 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
   if (printModulo > 0 && anEvent->GetEventID() % printModulo == 0) {
     G4cout << "--> Event " << anEvent->GetEventID() << " starts";
     if (eventHasToBeSeeded) G4cout << " with initial seeds (" << s1 << "," << s2 << ")";
+    if (eventRNGStreams) {
+      G4cout << " with RNG stream (" << mrm->GetEventRNGStreamSeedOfRun() << ","
+             << currentRun->GetRunID() << "," << anEvent->GetEventID() << ")";
+    }
     G4cout << "." << G4endl;
   }
   userPrimaryGeneratorAction->GeneratePrimaries(anEvent);
@@ -326,6 +414,12 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
 
 void G4WorkerTaskRunManager::RunTermination()
 {
+  // All the events of this run must have been output before merging
+  if (eventOutputPipeline != nullptr) {
+    eventOutputPipeline->Drain();
+    if (currentRun != nullptr) StackProcessedEvents();
+  }
+
   if (!fakeRun && (currentRun != nullptr)) {
     MergePartialResults();
 
@@ -57,6 +57,7 @@
 #ifndef G4VParticleChange_hh
 #define G4VParticleChange_hh 1
 
+#include <utility>
 #include <vector>
 #include "globals.hh"
 #include "G4ios.hh"
@@ -152,6 +153,15 @@ class G4VParticleChange
     void AddSecondary(G4Track* aSecondary);
       // Adds a secondary particle to theListOfSecondaries
 
+    template <class... Args>
+    inline G4Track* CreateSecondary(Args&&... args);
+      // Creates a secondary track from the arguments of a G4Track
+      // constructor, e.g. (G4DynamicParticle*, time, position), adds it
+      // to theListOfSecondaries and returns it, so that the track can be
+      // completed without a look-up in the list. The track is allocated
+      // by the G4Track allocator of the thread, whose storage may be
+      // reserved with G4StackManager::ReserveTracks()
+
   // --- the following methods are for management of weights ---
 
     inline G4double GetWeight() const;
@@ -47,15 +47,11 @@ G4ParticleChangeForGamma::G4ParticleChangeForGamma()
 // --------------------------------------------------------------------
 void G4ParticleChangeForGamma::AddSecondary(G4DynamicParticle* aParticle)
 {
-  // create track
-  G4Track* aTrack = new G4Track(aParticle, theCurrentTrack->GetGlobalTime(),
-                                theCurrentTrack->GetPosition());
-
+  // create and add a secondary track at the current position,
   // touchable handle is copied to keep the pointer
+  G4Track* aTrack = CreateSecondary(aParticle,
+    theCurrentTrack->GetGlobalTime(), theCurrentTrack->GetPosition());
   aTrack->SetTouchableHandle(theCurrentTrack->GetTouchableHandle());
-
-  // add a secondary
-  G4VParticleChange::AddSecondary(aTrack);
 }
 
 // --------------------------------------------------------------------
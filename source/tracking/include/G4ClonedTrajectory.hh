@@ -31,7 +31,7 @@
 // singleton G4Allocator so that the master thread can safely
 // delete the object instantiated by worker threads in sub-event
 // parallel mode. This class object should be instantiated as
-// a clone of G4Trajectory object.
+// a clone of G4Trajectory or G4CompactTrajectory object.
 //
 // Makoto Asai (JLab) - Oct.2024
 // --------------------------------------------------------------------
@@ -56,6 +56,7 @@
 
 class G4Polyline;
 class G4Trajectory;
+class G4CompactTrajectory;
 
 class G4ClonedTrajectory : public G4VTrajectory
 {
@@ -66,6 +67,7 @@ class G4ClonedTrajectory : public G4VTrajectory
 
   G4ClonedTrajectory() = default;
   G4ClonedTrajectory(const G4Trajectory&);
+  G4ClonedTrajectory(const G4CompactTrajectory&);
   ~G4ClonedTrajectory() override;
 
   // Operators
@@ -0,0 +1,162 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4CompactTrajectory
+//
+// Class description:
+//
+// Trajectory with the same information as G4Trajectory, stored with a
+// reduced memory footprint for high multiplicity events. Instead of one
+// G4TrajectoryPoint allocated per step, the first point is kept in
+// double precision and the following points are stored as offsets from
+// it in a contiguous array of floats (12 bytes per point). The offsets
+// keep a relative precision of about 1.e-7 with respect to the distance
+// from the first point, which is adequate for visualisation and truth
+// information, but not for the reconstruction of the exact step points.
+//
+// The G4VTrajectoryPoint objects required by GetPoint() are lazily
+// created as G4TrajectoryPoint views of the stored positions, all at
+// once at the first call, and are discarded when points are appended or
+// merged: the returned pointers must not be kept across such calls.
+// GetPointPosition() gives direct access to the positions without views.
+// The trajectory is cloned for sub-event parallelism as a
+// G4ClonedTrajectory. It is selected with /tracking/storeTrajectory 5.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4CompactTrajectory_hh
+#define G4CompactTrajectory_hh 1
+
+#include "G4Allocator.hh"
+#include "G4ParticleDefinition.hh"  // Include from 'particle+matter'
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4TrajectoryPoint.hh"  // Include from 'tracking'
+#include "G4VTrajectory.hh"
+#include "G4ios.hh"  // Include from 'system'
+#include "globals.hh"  // Include from 'global'
+
+#include "trkgdefs.hh"
+
+#include <vector>
+
+class G4CompactTrajectory : public G4VTrajectory
+{
+ public:
+  // Constructors/Destructor
+
+  G4CompactTrajectory() = default;
+  G4CompactTrajectory(const G4Track* aTrack);
+  G4CompactTrajectory(G4CompactTrajectory&);
+  ~G4CompactTrajectory() override = default;
+
+  // Operators
+
+  inline void* operator new(size_t);
+  inline void operator delete(void*);
+  inline G4bool operator==(const G4CompactTrajectory& r) const { return (this == &r); }
+
+  // cloning with the master thread allocator, as a G4ClonedTrajectory
+  G4VTrajectory* CloneForMaster() const override;
+
+  // Get/Set functions
+
+  inline G4int GetTrackID() const override { return fTrackID; }
+  inline G4int GetParentID() const override { return fParentID; }
+  inline G4String GetParticleName() const override { return ParticleName; }
+  inline G4double GetCharge() const override { return PDGCharge; }
+  inline G4int GetPDGEncoding() const override { return PDGEncoding; }
+  inline G4double GetInitialKineticEnergy() const { return initialKineticEnergy; }
+  inline G4ThreeVector GetInitialMomentum() const override { return initialMomentum; }
+
+  // Other member functions
+
+  void ShowTrajectory(std::ostream& os = G4cout) const override;
+  void DrawTrajectory() const override;
+  void AppendStep(const G4Step* aStep) override;
+  G4int GetPointEntries() const override { return fNumberOfPoints; }
+  G4VTrajectoryPoint* GetPoint(G4int i) const override;
+  void MergeTrajectory(G4VTrajectory* secondTrajectory) override;
+
+  inline G4ThreeVector GetPointPosition(G4int i) const;
+  // Position of the i-th point, without creation of the point views
+
+  G4ParticleDefinition* GetParticleDefinition();
+
+  const std::map<G4String, G4AttDef>* GetAttDefs() const override;
+  std::vector<G4AttValue>* CreateAttValues() const override;
+
+ private:
+  inline void AddPoint(const G4ThreeVector& pos);
+
+  G4ThreeVector fOrigin;
+  std::vector<G4float> fOffsets;  // x, y, z of the points after the first
+  mutable std::vector<G4TrajectoryPoint> fPointViews;
+  G4int fNumberOfPoints = 0;
+  G4int fTrackID = 0;
+  G4int fParentID = 0;
+  G4int PDGEncoding = 0;
+  G4double PDGCharge = 0.0;
+  G4String ParticleName = "dummy";
+  G4double initialKineticEnergy = 0.0;
+  G4ThreeVector initialMomentum;
+};
+
+extern G4TRACKING_DLL G4Allocator<G4CompactTrajectory>*& aCompactTrajectoryAllocator();
+
+inline void* G4CompactTrajectory::operator new(size_t)
+{
+  if (aCompactTrajectoryAllocator() == nullptr) {
+    aCompactTrajectoryAllocator() = new G4Allocator<G4CompactTrajectory>;
+  }
+  return (void*)aCompactTrajectoryAllocator()->MallocSingle();
+}
+
+inline void G4CompactTrajectory::operator delete(void* aTrajectory)
+{
+  aCompactTrajectoryAllocator()->FreeSingle((G4CompactTrajectory*)aTrajectory);
+}
+
+inline G4ThreeVector G4CompactTrajectory::GetPointPosition(G4int i) const
+{
+  if (i == 0) return fOrigin;
+  const G4float* p = &fOffsets[3 * (i - 1)];
+  return {fOrigin.x() + p[0], fOrigin.y() + p[1], fOrigin.z() + p[2]};
+}
+
+inline void G4CompactTrajectory::AddPoint(const G4ThreeVector& pos)
+{
+  if (fNumberOfPoints == 0) {
+    fOrigin = pos;
+  }
+  else {
+    fOffsets.push_back(G4float(pos.x() - fOrigin.x()));
+    fOffsets.push_back(G4float(pos.y() - fOrigin.y()));
+    fOffsets.push_back(G4float(pos.z() - fOrigin.z()));
+  }
+  ++fNumberOfPoints;
+}
+
+#endif
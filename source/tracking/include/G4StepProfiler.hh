@@ -0,0 +1,139 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4StepProfiler
+//
+// Class description:
+//
+// Low overhead instrumentation of the stepping loop, aggregating the time
+// spent and the number of steps per particle type, process limiting the
+// step, region and logical volume, and the time and number of tracks per
+// particle type. One instance exists per thread: it is filled by the
+// G4TrackingManager and G4SteppingManager of the thread when profiling
+// is activated with /tracking/profile/activate, and costs a test of a
+// null pointer per step otherwise. Time is measured with the time stamp
+// counter where available (x86-64), with std::chrono::steady_clock
+// otherwise, and converted to seconds at the time of the report.
+//
+// At the end of each run the master merges the counters of all threads
+// by name and writes them with Report(), as CSV, as JSON if the file name
+// set with /tracking/profile/fileName ends with ".json", or as a table on
+// G4cout if no file name is set. The counters are then reset.
+
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+#ifndef G4StepProfiler_hh
+#define G4StepProfiler_hh 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <unordered_map>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4Region;
+class G4Step;
+class G4Track;
+class G4VProcess;
+
+class G4StepProfiler
+{
+ public:
+  using Ticks = std::uint64_t;
+
+  struct Counters
+  {
+    Ticks ticks = 0;
+    G4long steps = 0;
+    G4long calls = 0;
+  };
+
+  // Instance of the calling thread, created at the first call
+  static G4StepProfiler* GetInstance();
+
+  static Ticks Now();
+
+  // Accumulates the step ended now and started at 'start'
+  void RecordStep(const G4Step* aStep, Ticks start);
+
+  // Accumulates the track ended now and started at 'start'
+  void RecordTrack(const G4Track* aTrack, Ticks start);
+
+  // Merges the counters of all threads, writes them and resets them.
+  // To be called by the master when the workers are idle
+  static void Report(G4int runID);
+  static void Reset();
+
+  static void SetFileName(const G4String& name);
+  static const G4String& GetFileName();
+
+  G4StepProfiler(const G4StepProfiler&) = delete;
+  G4StepProfiler& operator=(const G4StepProfiler&) = delete;
+
+ private:
+  G4StepProfiler() = default;
+  ~G4StepProfiler() = default;
+
+  struct StepKey
+  {
+    const G4ParticleDefinition* particle;
+    const G4VProcess* process;
+    const G4Region* region;
+    const G4LogicalVolume* volume;
+
+    G4bool operator==(const StepKey& r) const
+    {
+      return particle == r.particle && process == r.process && region == r.region
+             && volume == r.volume;
+    }
+  };
+
+  struct StepKeyHash
+  {
+    std::size_t operator()(const StepKey& k) const
+    {
+      auto h = reinterpret_cast<std::uintptr_t>(k.particle);
+      h = h * 31 + reinterpret_cast<std::uintptr_t>(k.process);
+      h = h * 31 + reinterpret_cast<std::uintptr_t>(k.region);
+      h = h * 31 + reinterpret_cast<std::uintptr_t>(k.volume);
+      return std::size_t(h ^ (h >> 17));
+    }
+  };
+
+  void AddStep(const StepKey& key, Ticks dt);
+  void AddTrack(const G4ParticleDefinition* particle, G4long steps, Ticks dt);
+
+  std::unordered_map<StepKey, Counters, StepKeyHash> fSteps;
+  std::unordered_map<const G4ParticleDefinition*, Counters> fTracks;
+
+  // last accessed entry, most steps are in a row with the same key
+  StepKey fLastKey = {nullptr, nullptr, nullptr, nullptr};
+  Counters* fLastCounters = nullptr;
+
+  friend struct G4StepProfilerRegistry;
+};
+
+#endif
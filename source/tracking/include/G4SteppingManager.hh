@@ -68,6 +68,7 @@ using G4SelectedAtRestDoItVector = std::vector<G4int>;
 using G4SelectedAlongStepDoItVector = std::vector<G4int>;
 using G4SelectedPostStepDoItVector = std::vector<G4int>;
 
+class G4StepProfiler;
 class G4VSensitiveDetector;
 
 class G4SteppingManager
@@ -93,6 +94,7 @@ class G4SteppingManager
   void SetVerbose(G4VSteppingVerbose*);
   G4Step* GetStep() const;
   void SetNavigator(G4Navigator* value);
+  void SetProfiler(G4StepProfiler* value);
 
   // Other member functions
 
@@ -182,6 +184,8 @@ class G4SteppingManager
 
   G4VSteppingVerbose* fVerbose = nullptr;
 
+  G4StepProfiler* fProfiler = nullptr;
+
   G4double PhysicalStep = 0.0;
   G4double GeometricalStep = 0.0;
   G4double CorrectedStep = 0.0;
@@ -390,6 +394,8 @@ inline const G4TrackVector* G4SteppingManager::GetSecondary() const
 
 inline void G4SteppingManager::SetNavigator(G4Navigator* value) { fNavigator = value; }
 
+inline void G4SteppingManager::SetProfiler(G4StepProfiler* value) { fProfiler = value; }
+
 inline void G4SteppingManager::SetUserAction(G4UserSteppingAction* apAction)
 {
   fUserSteppingAction = apAction;
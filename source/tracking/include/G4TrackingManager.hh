@@ -42,6 +42,7 @@
 #ifndef G4TrackingManager_hh
 #define G4TrackingManager_hh 1
 
+#include "G4StepProfiler.hh"  // Include from 'tracking'
 #include "G4StepStatus.hh"  // Include from 'tracking'
 #include "G4SteppingManager.hh"  // Include from 'tracking'
 #include "G4Track.hh"  // Include from 'tracking'
@@ -92,6 +93,11 @@ class G4TrackingManager
   void SetVerboseLevel(G4int vLevel);
   G4int GetVerboseLevel() const;
 
+  void SetProfiling(G4bool value);
+  G4bool GetProfiling() const;
+  // Activates the accumulation of the time and number of steps and
+  // tracks in the G4StepProfiler of this thread
+
   // Other member functions
 
   void ProcessOneTrack(G4Track* apValueG4Track);
@@ -123,6 +129,7 @@ class G4TrackingManager
   G4int verboseLevel = 0;
   G4TrackingMessenger* messenger = nullptr;
   G4bool EventIsAborted = false;
+  G4StepProfiler* fpProfiler = nullptr;
 };
 
 //*******************************************************************
@@ -176,6 +183,14 @@ inline void G4TrackingManager::SetVerboseLevel(G4int vLevel)
 
 inline G4int G4TrackingManager::GetVerboseLevel() const { return verboseLevel; }
 
+inline void G4TrackingManager::SetProfiling(G4bool value)
+{
+  fpProfiler = value ? G4StepProfiler::GetInstance() : nullptr;
+  fpSteppingManager->SetProfiler(fpProfiler);
+}
+
+inline G4bool G4TrackingManager::GetProfiling() const { return fpProfiler != nullptr; }
+
 inline void G4TrackingManager::SetUserTrackInformation(G4VUserTrackInformation* aValue)
 {
   if (fpTrack != nullptr) fpTrack->SetUserInformation(aValue);
@@ -45,6 +45,7 @@ class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithABool;
+class G4UIcmdWithAString;
 class G4TrackingManager;
 class G4SteppingManager;
 class G4IdentityTrajectoryFilter;
@@ -68,6 +69,9 @@ class G4TrackingMessenger : public G4UImessenger
   G4UIcmdWithoutParameter* ResumeCmd = nullptr;
   G4UIcmdWithAnInteger* StoreTrajectoryCmd = nullptr;
   G4UIcmdWithAnInteger* VerboseCmd = nullptr;
+  G4UIdirectory* ProfileDirectory = nullptr;
+  G4UIcmdWithABool* ProfileActivateCmd = nullptr;
+  G4UIcmdWithAString* ProfileFileCmd = nullptr;
 };
 
 #endif
@@ -12,10 +12,12 @@ geant4_add_module(G4tracking
     G4ClonedSmoothTrajectoryPoint.hh
     G4ClonedTrajectory.hh
     G4ClonedTrajectoryPoint.hh
+    G4CompactTrajectory.hh
     G4RichTrajectory.hh
     G4RichTrajectoryPoint.hh
     G4SmoothTrajectory.hh
     G4SmoothTrajectoryPoint.hh
+    G4StepProfiler.hh
     G4SteppingManager.hh
     G4SteppingVerbose.hh
     G4SteppingVerboseWithUnits.hh
@@ -42,10 +44,12 @@ geant4_add_module(G4tracking
     G4ClonedSmoothTrajectoryPoint.cc
     G4ClonedTrajectory.cc
     G4ClonedTrajectoryPoint.cc
+    G4CompactTrajectory.cc
     G4RichTrajectory.cc
     G4RichTrajectoryPoint.cc
     G4SmoothTrajectory.cc
     G4SmoothTrajectoryPoint.cc
+    G4StepProfiler.cc
     G4SteppingManager.cc
     G4SteppingVerbose.cc
     G4SteppingVerboseWithUnits.cc
@@ -30,6 +30,7 @@
 
 #include "G4ClonedTrajectory.hh"
 #include "G4Trajectory.hh"
+#include "G4CompactTrajectory.hh"
 
 #include "G4AttDef.hh"
 #include "G4AttDefStore.hh"
@@ -68,6 +69,25 @@ G4ClonedTrajectory::G4ClonedTrajectory(const G4Trajectory& right)
   }
 }
 
+G4ClonedTrajectory::G4ClonedTrajectory(const G4CompactTrajectory& right)
+{
+  ParticleName = right.GetParticleName();
+  PDGCharge = right.GetCharge();
+  PDGEncoding = right.GetPDGEncoding();
+  fTrackID = right.GetTrackID();
+  fParentID = right.GetParentID();
+  initialKineticEnergy = right.GetInitialKineticEnergy();
+  initialMomentum = right.GetInitialMomentum();
+  positionRecord = new G4ClonedTrajectoryPointContainer();
+
+  G4int ent = right.GetPointEntries();
+  positionRecord->reserve(ent);
+  for (G4int i = 0; i < ent; ++i) {
+    G4TrajectoryPoint point(right.GetPointPosition(i));
+    positionRecord->push_back(new G4ClonedTrajectoryPoint(point));
+  }
+}
+
 G4ClonedTrajectory::~G4ClonedTrajectory()
 {
   if (positionRecord != nullptr) {
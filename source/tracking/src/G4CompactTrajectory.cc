@@ -0,0 +1,212 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4CompactTrajectory class implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4CompactTrajectory.hh"
+
+#include "G4AttDef.hh"
+#include "G4AttDefStore.hh"
+#include "G4AttValue.hh"
+#include "G4AutoLock.hh"
+#include "G4ClonedTrajectory.hh"
+#include "G4ParticleTable.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+
+namespace {
+ G4Mutex CloneCompactTrajectoryMutex = G4MUTEX_INITIALIZER;
+}
+
+// #define G4ATTDEBUG
+#ifdef G4ATTDEBUG
+#  include "G4AttCheck.hh"
+#endif
+
+G4Allocator<G4CompactTrajectory>*& aCompactTrajectoryAllocator()
+{
+  G4ThreadLocalStatic G4Allocator<G4CompactTrajectory>* _instance = nullptr;
+  return _instance;
+}
+
+G4CompactTrajectory::G4CompactTrajectory(const G4Track* aTrack)
+{
+  G4ParticleDefinition* fpParticleDefinition = aTrack->GetDefinition();
+  ParticleName = fpParticleDefinition->GetParticleName();
+  PDGCharge = fpParticleDefinition->GetPDGCharge();
+  PDGEncoding = fpParticleDefinition->GetPDGEncoding();
+  fTrackID = aTrack->GetTrackID();
+  fParentID = aTrack->GetParentID();
+  initialKineticEnergy = aTrack->GetKineticEnergy();
+  initialMomentum = aTrack->GetMomentum();
+
+  // Following is for the first trajectory point
+  AddPoint(aTrack->GetPosition());
+}
+
+G4CompactTrajectory::G4CompactTrajectory(G4CompactTrajectory& right)
+  : fOrigin(right.fOrigin),
+    fOffsets(right.fOffsets),
+    fNumberOfPoints(right.fNumberOfPoints),
+    fTrackID(right.fTrackID),
+    fParentID(right.fParentID),
+    PDGEncoding(right.PDGEncoding),
+    PDGCharge(right.PDGCharge),
+    ParticleName(right.ParticleName),
+    initialKineticEnergy(right.initialKineticEnergy),
+    initialMomentum(right.initialMomentum)
+{}
+
+G4VTrajectory* G4CompactTrajectory::CloneForMaster() const
+{
+  G4AutoLock lock(&CloneCompactTrajectoryMutex);
+  auto* cloned = new G4ClonedTrajectory(*this);
+  return cloned;
+}
+
+void G4CompactTrajectory::ShowTrajectory(std::ostream& os) const
+{
+  // Invoke the default implementation in G4VTrajectory...
+  G4VTrajectory::ShowTrajectory(os);
+
+  // ... or override with your own code here.
+}
+
+void G4CompactTrajectory::DrawTrajectory() const
+{
+  // Invoke the default implementation in G4VTrajectory...
+  G4VTrajectory::DrawTrajectory();
+
+  // ... or override with your own code here.
+}
+
+G4VTrajectoryPoint* G4CompactTrajectory::GetPoint(G4int i) const
+{
+  // The views of all points are created at once, so that the pointers
+  // stay valid until the next modification of the trajectory
+  if (G4int(fPointViews.size()) != fNumberOfPoints) {
+    fPointViews.clear();
+    fPointViews.reserve(fNumberOfPoints);
+    for (G4int j = 0; j < fNumberOfPoints; ++j) {
+      fPointViews.emplace_back(GetPointPosition(j));
+    }
+  }
+  return &fPointViews[i];
+}
+
+const std::map<G4String, G4AttDef>* G4CompactTrajectory::GetAttDefs() const
+{
+  G4bool isNew;
+  std::map<G4String, G4AttDef>* store =
+    G4AttDefStore::GetInstance("G4CompactTrajectory", isNew);
+  if (isNew) {
+    G4String ID("ID");
+    (*store)[ID] = G4AttDef(ID, "Track ID", "Physics", "", "G4int");
+
+    G4String PID("PID");
+    (*store)[PID] = G4AttDef(PID, "Parent ID", "Physics", "", "G4int");
+
+    G4String PN("PN");
+    (*store)[PN] = G4AttDef(PN, "Particle Name", "Physics", "", "G4String");
+
+    G4String Ch("Ch");
+    (*store)[Ch] = G4AttDef(Ch, "Charge", "Physics", "e+", "G4double");
+
+    G4String PDG("PDG");
+    (*store)[PDG] = G4AttDef(PDG, "PDG Encoding", "Physics", "", "G4int");
+
+    G4String IKE("IKE");
+    (*store)[IKE] = G4AttDef(IKE, "Initial kinetic energy", "Physics", "G4BestUnit", "G4double");
+
+    G4String IMom("IMom");
+    (*store)[IMom] = G4AttDef(IMom, "Initial momentum", "Physics", "G4BestUnit", "G4ThreeVector");
+
+    G4String IMag("IMag");
+    (*store)[IMag] =
+      G4AttDef(IMag, "Initial momentum magnitude", "Physics", "G4BestUnit", "G4double");
+
+    G4String NTP("NTP");
+    (*store)[NTP] = G4AttDef(NTP, "No. of points", "Physics", "", "G4int");
+  }
+  return store;
+}
+
+std::vector<G4AttValue>* G4CompactTrajectory::CreateAttValues() const
+{
+  auto values = new std::vector<G4AttValue>;
+
+  values->push_back(G4AttValue("ID", G4UIcommand::ConvertToString(fTrackID), ""));
+
+  values->push_back(G4AttValue("PID", G4UIcommand::ConvertToString(fParentID), ""));
+
+  values->push_back(G4AttValue("PN", ParticleName, ""));
+
+  values->push_back(G4AttValue("Ch", G4UIcommand::ConvertToString(PDGCharge), ""));
+
+  values->push_back(G4AttValue("PDG", G4UIcommand::ConvertToString(PDGEncoding), ""));
+
+  values->push_back(G4AttValue("IKE", G4BestUnit(initialKineticEnergy, "Energy"), ""));
+
+  values->push_back(G4AttValue("IMom", G4BestUnit(initialMomentum, "Energy"), ""));
+
+  values->push_back(G4AttValue("IMag", G4BestUnit(initialMomentum.mag(), "Energy"), ""));
+
+  values->push_back(G4AttValue("NTP", G4UIcommand::ConvertToString(GetPointEntries()), ""));
+
+#ifdef G4ATTDEBUG
+  G4cout << G4AttCheck(values, GetAttDefs());
+#endif
+
+  return values;
+}
+
+void G4CompactTrajectory::AppendStep(const G4Step* aStep)
+{
+  AddPoint(aStep->GetPostStepPoint()->GetPosition());
+}
+
+G4ParticleDefinition* G4CompactTrajectory::GetParticleDefinition()
+{
+  return (G4ParticleTable::GetParticleTable()->FindParticle(ParticleName));
+}
+
+void G4CompactTrajectory::MergeTrajectory(G4VTrajectory* secondTrajectory)
+{
+  if (secondTrajectory == nullptr) return;
+
+  auto seco = (G4CompactTrajectory*)secondTrajectory;
+  G4int ent = seco->GetPointEntries();
+  fOffsets.reserve(fOffsets.size() + 3 * std::size_t(ent > 0 ? ent - 1 : 0));
+  for (G4int i = 1; i < ent; ++i)  // initial pt of 2nd trajectory shouldn't be merged
+  {
+    AddPoint(seco->GetPointPosition(i));
+  }
+  seco->fOffsets.clear();
+  seco->fPointViews.clear();
+  seco->fNumberOfPoints = 0;
+}
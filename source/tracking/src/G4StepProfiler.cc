@@ -0,0 +1,322 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4StepProfiler class implementation
+//
+// 18.10.26 - Initial version
+// --------------------------------------------------------------------
+
+#include "G4StepProfiler.hh"
+
+#include "G4AutoLock.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Region.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#  include <x86intrin.h>
+#  define G4STEPPROFILER_USE_TSC 1
+#elif defined(_M_X64)
+#  include <intrin.h>
+#  define G4STEPPROFILER_USE_TSC 1
+#endif
+
+// --------------------------------------------------------------------
+// Owner of the instances of all threads; they are kept until the end of
+// the job, so that the master can read them after the threads are gone
+
+struct G4StepProfilerRegistry
+{
+  G4StepProfilerRegistry()
+    : startTicks(G4StepProfiler::Now()), startTime(std::chrono::steady_clock::now())
+  {}
+
+  ~G4StepProfilerRegistry()
+  {
+    for (auto ptr : instances) {
+      delete ptr;
+    }
+  }
+
+  G4Mutex mutex = G4MUTEX_INITIALIZER;
+  std::vector<G4StepProfiler*> instances;
+  G4String fileName = "";
+  G4StepProfiler::Ticks startTicks;
+  std::chrono::steady_clock::time_point startTime;
+};
+
+namespace
+{
+G4StepProfilerRegistry& Registry()
+{
+  static G4StepProfilerRegistry registry;
+  return registry;
+}
+
+G4String Name(const G4ParticleDefinition* p)
+{
+  return (p != nullptr) ? p->GetParticleName() : G4String("none");
+}
+
+G4String Name(const G4VProcess* p)
+{
+  return (p != nullptr) ? p->GetProcessName() : G4String("none");
+}
+
+G4String Name(const G4Region* p)
+{
+  return (p != nullptr) ? p->GetName() : G4String("none");
+}
+
+G4String Name(const G4LogicalVolume* p)
+{
+  return (p != nullptr) ? p->GetName() : G4String("none");
+}
+
+G4String Quoted(const G4String& s)
+{
+  G4String res = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') res += '\\';
+    res += c;
+  }
+  return res + "\"";
+}
+
+using G4StepRow = std::pair<std::array<G4String, 4>, G4StepProfiler::Counters>;
+}  // namespace
+
+// --------------------------------------------------------------------
+G4StepProfiler* G4StepProfiler::GetInstance()
+{
+  G4ThreadLocalStatic G4StepProfiler* instance = nullptr;
+  if (instance == nullptr) {
+    G4StepProfilerRegistry& reg = Registry();
+    G4AutoLock l(&reg.mutex);
+    instance = new G4StepProfiler();
+    reg.instances.push_back(instance);
+  }
+  return instance;
+}
+
+// --------------------------------------------------------------------
+G4StepProfiler::Ticks G4StepProfiler::Now()
+{
+#ifdef G4STEPPROFILER_USE_TSC
+  return __rdtsc();
+#else
+  return Ticks(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::RecordStep(const G4Step* aStep, Ticks start)
+{
+  Ticks dt = Now() - start;
+  const G4StepPoint* pre = aStep->GetPreStepPoint();
+  const G4VPhysicalVolume* pv = pre->GetPhysicalVolume();
+  const G4LogicalVolume* lv = (pv != nullptr) ? pv->GetLogicalVolume() : nullptr;
+  StepKey key = {aStep->GetTrack()->GetParticleDefinition(),
+                 aStep->GetPostStepPoint()->GetProcessDefinedStep(),
+                 (lv != nullptr) ? lv->GetRegion() : nullptr, lv};
+  if (fLastCounters != nullptr && key == fLastKey) {
+    fLastCounters->ticks += dt;
+    ++fLastCounters->steps;
+  }
+  else {
+    AddStep(key, dt);
+  }
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::RecordTrack(const G4Track* aTrack, Ticks start)
+{
+  AddTrack(aTrack->GetParticleDefinition(), aTrack->GetCurrentStepNumber(), Now() - start);
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::AddStep(const StepKey& key, Ticks dt)
+{
+  Counters& c = fSteps[key];
+  c.ticks += dt;
+  ++c.steps;
+  fLastKey = key;
+  fLastCounters = &c;
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::AddTrack(const G4ParticleDefinition* particle, G4long steps, Ticks dt)
+{
+  Counters& c = fTracks[particle];
+  c.ticks += dt;
+  c.steps += steps;
+  ++c.calls;
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::SetFileName(const G4String& name)
+{
+  G4StepProfilerRegistry& reg = Registry();
+  G4AutoLock l(&reg.mutex);
+  reg.fileName = name;
+}
+
+// --------------------------------------------------------------------
+const G4String& G4StepProfiler::GetFileName()
+{
+  return Registry().fileName;
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::Reset()
+{
+  G4StepProfilerRegistry& reg = Registry();
+  G4AutoLock l(&reg.mutex);
+  for (auto ptr : reg.instances) {
+    ptr->fSteps.clear();
+    ptr->fTracks.clear();
+    ptr->fLastCounters = nullptr;
+  }
+}
+
+// --------------------------------------------------------------------
+void G4StepProfiler::Report(G4int runID)
+{
+  G4StepProfilerRegistry& reg = Registry();
+  G4AutoLock l(&reg.mutex);
+
+  // Merge the threads by name, the processes are thread-local objects
+  std::map<std::array<G4String, 4>, Counters> steps;
+  std::map<G4String, Counters> tracks;
+  for (auto ptr : reg.instances) {
+    for (const auto& [key, c] : ptr->fSteps) {
+      Counters& s =
+        steps[{Name(key.particle), Name(key.process), Name(key.region), Name(key.volume)}];
+      s.ticks += c.ticks;
+      s.steps += c.steps;
+    }
+    for (const auto& [particle, c] : ptr->fTracks) {
+      Counters& s = tracks[Name(particle)];
+      s.ticks += c.ticks;
+      s.steps += c.steps;
+      s.calls += c.calls;
+    }
+    ptr->fSteps.clear();
+    ptr->fTracks.clear();
+    ptr->fLastCounters = nullptr;
+  }
+  if (tracks.empty()) return;
+
+  // Conversion of the ticks, calibrated since the start of the job
+  Ticks nticks = Now() - reg.startTicks;
+  std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - reg.startTime;
+  G4double secPerTick = (nticks > 0) ? elapsed.count() / G4double(nticks) : 0.0;
+
+  std::vector<G4StepRow> rows(steps.begin(), steps.end());
+  std::sort(rows.begin(), rows.end(), [](const G4StepRow& a, const G4StepRow& b) {
+    return a.second.ticks > b.second.ticks;
+  });
+
+  const G4String& fileName = reg.fileName;
+  if (fileName.empty()) {
+    G4double total = 0.0;
+    for (const auto& [name, c] : tracks) {
+      total += c.ticks * secPerTick;
+    }
+    G4long prec = G4cout.precision(4);
+    G4cout << "=== G4StepProfiler: run " << runID << ", " << total
+           << " s in tracking ===" << G4endl;
+    G4cout << std::setw(16) << "particle" << std::setw(12) << "tracks" << std::setw(14)
+           << "steps" << std::setw(12) << "time [s]" << G4endl;
+    for (const auto& [name, c] : tracks) {
+      G4cout << std::setw(16) << name << std::setw(12) << c.calls << std::setw(14) << c.steps
+             << std::setw(12) << c.ticks * secPerTick << G4endl;
+    }
+    G4cout << std::setw(16) << "particle" << std::setw(20) << "process" << std::setw(20)
+           << "region" << std::setw(20) << "volume" << std::setw(14) << "steps" << std::setw(12)
+           << "time [s]" << std::setw(8) << "[%]" << G4endl;
+    for (const auto& [key, c] : rows) {
+      G4double t = c.ticks * secPerTick;
+      G4cout << std::setw(16) << key[0] << std::setw(20) << key[1] << std::setw(20) << key[2]
+             << std::setw(20) << key[3] << std::setw(14) << c.steps << std::setw(12) << t
+             << std::setw(8) << ((total > 0.0) ? 100. * t / total : 0.0) << G4endl;
+    }
+    G4cout.precision(prec);
+    return;
+  }
+
+  std::ofstream out(fileName);
+  if (!out) {
+    G4ExceptionDescription ed;
+    ed << "Cannot open file <" << fileName << "> for writing, no report for run " << runID;
+    G4Exception("G4StepProfiler::Report()", "Tracking0016", JustWarning, ed);
+    return;
+  }
+  out << std::setprecision(9);
+  if (G4StrUtil::ends_with(fileName, ".json")) {
+    out << "{\n  \"run\": " << runID << ",\n  \"tracks\": [";
+    G4bool first = true;
+    for (const auto& [name, c] : tracks) {
+      out << (first ? "\n" : ",\n") << "    {\"particle\": " << Quoted(name)
+          << ", \"tracks\": " << c.calls << ", \"steps\": " << c.steps
+          << ", \"time\": " << c.ticks * secPerTick << "}";
+      first = false;
+    }
+    out << "\n  ],\n  \"steps\": [";
+    first = true;
+    for (const auto& [key, c] : rows) {
+      out << (first ? "\n" : ",\n") << "    {\"particle\": " << Quoted(key[0])
+          << ", \"process\": " << Quoted(key[1]) << ", \"region\": " << Quoted(key[2])
+          << ", \"volume\": " << Quoted(key[3]) << ", \"steps\": " << c.steps
+          << ", \"time\": " << c.ticks * secPerTick << "}";
+      first = false;
+    }
+    out << "\n  ]\n}\n";
+  }
+  else {
+    out << "scope,particle,process,region,volume,tracks,steps,time_s\n";
+    for (const auto& [name, c] : tracks) {
+      out << "track," << Quoted(name) << ",,,," << c.calls << ',' << c.steps << ','
+          << c.ticks * secPerTick << '\n';
+    }
+    for (const auto& [key, c] : rows) {
+      out << "step," << Quoted(key[0]) << ',' << Quoted(key[1]) << ',' << Quoted(key[2]) << ','
+          << Quoted(key[3]) << ",," << c.steps << ',' << c.ticks * secPerTick << '\n';
+    }
+  }
+}
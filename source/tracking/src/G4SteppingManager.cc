@@ -37,6 +37,7 @@
 #include "G4GPILSelection.hh"
 #include "G4GeometryTolerance.hh"
 #include "G4ParticleTable.hh"
+#include "G4StepProfiler.hh"
 #include "G4SteppingControl.hh"
 #include "G4SteppingVerbose.hh"
 #include "G4SteppingVerboseWithUnits.hh"
@@ -135,6 +136,8 @@ G4StepStatus G4SteppingManager::Stepping()
   }
 #endif
 
+  G4StepProfiler::Ticks startTicks = (fProfiler != nullptr) ? G4StepProfiler::Now() : 0;
+
   // Store last PostStepPoint to PreStepPoint, and swap current and nex
   // volume information of G4Track. Reset total energy deposit in one Step.
   //
@@ -259,6 +262,8 @@ G4StepStatus G4SteppingManager::Stepping()
 
   if (regionalAction != nullptr) regionalAction->UserSteppingAction(fStep);
 
+  if (fProfiler != nullptr) fProfiler->RecordStep(fStep, startTicks);
+
   // Stepping process finish. Return the value of the StepStatus
   //
   return fStepStatus;
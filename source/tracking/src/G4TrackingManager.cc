@@ -36,6 +36,7 @@
 #include "G4Trajectory.hh"
 #include "G4RichTrajectory.hh"
 #include "G4SmoothTrajectory.hh"
+#include "G4CompactTrajectory.hh"
 #include "G4ios.hh"
 
 //////////////////////////////////////
@@ -64,6 +65,7 @@ void G4TrackingManager::ProcessOneTrack(G4Track* apValueG4Track)
 
   fpTrack = apValueG4Track;
   EventIsAborted = false;
+  G4StepProfiler::Ticks startTicks = (fpProfiler != nullptr) ? G4StepProfiler::Now() : 0;
 
   // Clear secondary particle vector
   //
@@ -107,6 +109,9 @@ void G4TrackingManager::ProcessOneTrack(G4Track* apValueG4Track)
         case 4:
           fpTrajectory = new G4RichTrajectory(fpTrack);
           break;
+        case 5:
+          fpTrajectory = new G4CompactTrajectory(fpTrack);
+          break;
       }
     }
 #endif
@@ -153,6 +158,8 @@ void G4TrackingManager::ProcessOneTrack(G4Track* apValueG4Track)
     delete fpTrajectory;
     fpTrajectory = nullptr;
   }
+
+  if (fpProfiler != nullptr) fpProfiler->RecordTrack(fpTrack, startTicks);
 }
 
 //////////////////////////////////////
@@ -40,6 +40,9 @@
 #include "G4TrackStatus.hh"
 #include "G4TrackingManager.hh"
 #include "G4TransportationManager.hh"
+#include "G4StepProfiler.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIdirectory.hh"
@@ -78,9 +81,10 @@ G4TrackingMessenger::G4TrackingMessenger(G4TrackingManager* trMan)
   StoreTrajectoryCmd->SetGuidance(" 2 : Choose G4SmoothTrajectory as default.");
   StoreTrajectoryCmd->SetGuidance(" 3 : Choose G4RichTrajectory as default.");
   StoreTrajectoryCmd->SetGuidance(" 4 : Choose G4RichTrajectory with auxiliary points as default.");
+  StoreTrajectoryCmd->SetGuidance(" 5 : Choose G4CompactTrajectory as default.");
   StoreTrajectoryCmd->SetParameterName("Store", true);
   StoreTrajectoryCmd->SetDefaultValue(0);
-  StoreTrajectoryCmd->SetRange("Store >=0 && Store <= 4");
+  StoreTrajectoryCmd->SetRange("Store >=0 && Store <= 5");
 
   VerboseCmd = new G4UIcmdWithAnInteger("/tracking/verbose", this);
 #ifdef G4VERBOSE
@@ -101,6 +105,28 @@ G4TrackingMessenger::G4TrackingMessenger(G4TrackingManager* trMan)
 #else
   VerboseCmd->SetGuidance("You need to recompile the tracking category defining G4VERBOSE ");
 #endif
+
+  ProfileDirectory = new G4UIdirectory("/tracking/profile/");
+  ProfileDirectory->SetGuidance("Profiling of the time spent in tracking.");
+
+  ProfileActivateCmd = new G4UIcmdWithABool("/tracking/profile/activate", this);
+  ProfileActivateCmd->SetGuidance("Accumulate the time and number of steps per particle,");
+  ProfileActivateCmd->SetGuidance("process limiting the step, region and logical volume,");
+  ProfileActivateCmd->SetGuidance("and the time and number of tracks per particle.");
+  ProfileActivateCmd->SetGuidance("The counters of all threads are reported at end of run.");
+  ProfileActivateCmd->SetParameterName("flag", true);
+  ProfileActivateCmd->SetDefaultValue(true);
+  ProfileActivateCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  ProfileFileCmd = new G4UIcmdWithAString("/tracking/profile/fileName", this);
+  ProfileFileCmd->SetGuidance("Write the profiling report of each run to the given file,");
+  ProfileFileCmd->SetGuidance("in JSON format if the name ends with .json, in CSV otherwise.");
+  ProfileFileCmd->SetGuidance("The file is overwritten at each run.");
+  ProfileFileCmd->SetGuidance("Without file name the report is printed on G4cout.");
+  ProfileFileCmd->SetParameterName("fileName", true);
+  ProfileFileCmd->SetDefaultValue("");
+  ProfileFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  ProfileFileCmd->SetToBeBroadcasted(false);
 }
 
 ////////////////////////////////////////////
@@ -112,6 +138,9 @@ G4TrackingMessenger::~G4TrackingMessenger()
   delete ResumeCmd;
   delete StoreTrajectoryCmd;
   delete VerboseCmd;
+  delete ProfileActivateCmd;
+  delete ProfileFileCmd;
+  delete ProfileDirectory;
   delete auxiliaryPointsFilter;
 }
 
@@ -132,6 +161,14 @@ void G4TrackingMessenger::SetNewValue(G4UIcommand* command, G4String newValues)
     G4UImanager::GetUIpointer()->ApplyCommand("/control/exit");
   }
 
+  if (command == ProfileActivateCmd) {
+    trackingManager->SetProfiling(ProfileActivateCmd->ConvertToBool(newValues));
+  }
+
+  if (command == ProfileFileCmd) {
+    G4StepProfiler::SetFileName(newValues);
+  }
+
   if (command == StoreTrajectoryCmd) {
     G4int trajType = StoreTrajectoryCmd->ConvertToInt(newValues);
     if (trajType == 2 || trajType == 4) {
@@ -157,6 +194,7 @@ void G4TrackingMessenger::SetNewValue(G4UIcommand* command, G4String newValues)
       G4VTrajectoryPoint* trajp = nullptr;
       switch (trajType) {
        case 1:
+       case 5:
         if(!traj_1) {
           traj = new G4ClonedTrajectory();
           trajp = new G4ClonedTrajectoryPoint();
@@ -198,5 +236,11 @@ G4String G4TrackingMessenger::GetCurrentValue(G4UIcommand* command)
   if (command == StoreTrajectoryCmd) {
     return StoreTrajectoryCmd->ConvertToString(trackingManager->GetStoreTrajectory());
   }
+  if (command == ProfileActivateCmd) {
+    return ProfileActivateCmd->ConvertToString(trackingManager->GetProfiling());
+  }
+  if (command == ProfileFileCmd) {
+    return G4StepProfiler::GetFileName();
+  }
   return G4String(1, '\0');
 }
@@ -0,0 +1,211 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// benchG4ParticleGroupedTrackStack
+//
+// Electron showers in a Pb/lAr sampling calorimeter with G4EmStandardPhysics,
+// with the urgent tracks in last-in-first-out order and grouped by particle,
+// by particle and region, and by particle with a track limit. Each mode
+// starts from the same seed; the time per event, the number of tracks
+// processed per bucket switch and the maximum number of stacked tracks are
+// printed.
+//
+// Usage: benchG4ParticleGroupedTrackStack [nEvents] [energy in GeV]
+
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4EventManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGroupedTrackStack.hh"
+#include "G4ParticleGun.hh"
+#include "G4Region.hh"
+#include "G4RunManager.hh"
+#include "G4StackManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UImanager.hh"
+#include "G4UserSteppingAction.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+  // 40 layers of 2 mm Pb and 5 mm lAr, each material in its own region
+  class Calorimeter : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        const G4int nLayers = 40;
+        const G4double size = 40*cm;
+        const G4double absThickness = 2*mm;
+        const G4double gapThickness = 5*mm;
+        const G4double layerThickness = absThickness + gapThickness;
+
+        auto worldS = new G4Box("World", size, size, nLayers*layerThickness);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_Galactic"), "World");
+        auto absS = new G4Box("Absorber", 0.5*size, 0.5*size, 0.5*absThickness);
+        auto absL = new G4LogicalVolume(absS,
+          nist->FindOrBuildMaterial("G4_Pb"), "Absorber");
+        auto gapS = new G4Box("Gap", 0.5*size, 0.5*size, 0.5*gapThickness);
+        auto gapL = new G4LogicalVolume(gapS,
+          nist->FindOrBuildMaterial("G4_lAr"), "Gap");
+        (new G4Region("AbsorberRegion"))->AddRootLogicalVolume(absL);
+        (new G4Region("GapRegion"))->AddRootLogicalVolume(gapL);
+
+        G4double z = -0.5*nLayers*layerThickness;
+        for (G4int i = 0; i < nLayers; ++i)
+        {
+          new G4PVPlacement(nullptr, G4ThreeVector(0, 0, z + 0.5*absThickness),
+                            absL, "Absorber", worldL, false, i);
+          new G4PVPlacement(nullptr,
+            G4ThreeVector(0, 0, z + absThickness + 0.5*gapThickness),
+            gapL, "Gap", worldL, false, i);
+          z += layerThickness;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+  };
+
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      PhysicsList()
+      {
+        SetVerboseLevel(0);
+        RegisterPhysics(new G4EmStandardPhysics(0));
+      }
+  };
+
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      explicit PrimaryGenerator(G4double energy)
+      {
+        fGun.SetParticleDefinition(G4Electron::Definition());
+        fGun.SetParticleEnergy(energy);
+        fGun.SetParticlePosition(G4ThreeVector(0, 0, -15*cm));
+        fGun.SetParticleMomentumDirection(G4ThreeVector(0, 0, 1));
+      }
+
+      void GeneratePrimaries(G4Event* event) override
+      {
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+  };
+
+  class SteppingAction : public G4UserSteppingAction
+  {
+    public:
+      void UserSteppingAction(const G4Step* step) override
+      {
+        edep += step->GetTotalEnergyDeposit();
+      }
+
+      G4double edep = 0.;
+  };
+}
+
+int main(int argc, char** argv)
+{
+  const G4int nEvents = (argc > 1) ? std::atoi(argv[1]) : 100;
+  const G4double energy = ((argc > 2) ? std::atof(argv[2]) : 10.)*GeV;
+
+  auto runManager = new G4RunManager;
+  runManager->SetUserInitialization(new Calorimeter);
+  runManager->SetUserInitialization(new PhysicsList);
+  runManager->SetUserAction(new PrimaryGenerator(energy));
+  auto steppingAction = new SteppingAction;
+  runManager->SetUserAction(steppingAction);
+
+  G4UImanager* ui = G4UImanager::GetUIpointer();
+  ui->ApplyCommand("/process/em/verbose 0");
+  ui->ApplyCommand("/process/eLoss/verbose 0");
+  runManager->Initialize();
+  runManager->BeamOn(1);  // warm up
+
+  struct Mode { const char* name; const char* commands[3]; };
+  const Mode modes[] = {
+    { "last-in-first-out", { "/event/stack/groupByParticle false",
+                             nullptr, nullptr } },
+    { "grouped by particle", { "/event/stack/groupByParticle true",
+                               "/event/stack/groupByRegion false",
+                               "/event/stack/groupLimit 100000" } },
+    { "grouped by particle and region", { "/event/stack/groupByRegion true",
+                                          nullptr, nullptr } },
+    { "grouped by particle, limit 200", { "/event/stack/groupByRegion false",
+                                          "/event/stack/groupLimit 200",
+                                          nullptr } } };
+
+  G4StackManager* stackManager =
+    G4EventManager::GetEventManager()->GetStackManager();
+  G4cout << nEvents << " events of " << energy/GeV << " GeV e-" << G4endl;
+  for (const auto& mode : modes)
+  {
+    for (const char* command : mode.commands)
+    {
+      if (command != nullptr) { ui->ApplyCommand(command); }
+    }
+    G4ParticleGroupedTrackStack* grouped =
+      stackManager->GetParticleGroupedStack();
+    if (grouped != nullptr) { grouped->ResetStatistics(); }
+    steppingAction->edep = 0.;
+
+    G4Random::setTheSeed(20261018);
+    auto start = std::chrono::steady_clock::now();
+    runManager->BeamOn(nEvents);
+    std::chrono::duration<G4double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+    G4cout << mode.name << ": " << 1.e3*elapsed.count()/nEvents
+           << " ms/event, mean deposit "
+           << steppingAction->edep/nEvents/MeV << " MeV";
+    if (grouped != nullptr && grouped->GetNBucketSwitches() > 0)
+    {
+      G4cout << ", " << G4double(grouped->GetNPopped())
+                        /grouped->GetNBucketSwitches()
+             << " tracks per bucket switch, at most "
+             << grouped->GetMaxNTrack() << " stacked tracks";
+    }
+    G4cout << G4endl;
+  }
+
+  delete runManager;
+  return 0;
+}
@@ -0,0 +1,316 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4ParticleGroupedTrackStack
+//
+// Checks the pop order of G4ParticleGroupedTrackStack: one bucket at a
+// time, grouped by particle and optionally by region, most populated
+// bucket first and LIFO within a bucket. Checks that the track limit
+// bounds the number of stacked tracks in a cascade, and that
+// G4StackManager keeps the grouped tracks through the transfers between
+// its stacks.
+
+#include "G4Box.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NavigationHistory.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGroupedTrackStack.hh"
+#include "G4Positron.hh"
+#include "G4Region.hh"
+#include "G4StackManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Track.hh"
+#include "G4TrackStack.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  G4Track* MakeTrack(const G4ParticleDefinition* particle, G4int id,
+                     G4VPhysicalVolume* volume = nullptr)
+  {
+    auto dynamic = new G4DynamicParticle(particle, G4ThreeVector(0, 0, 1),
+                                         1*MeV);
+    auto track = new G4Track(dynamic, 0., G4ThreeVector());
+    track->SetTrackID(id);
+    if (volume != nullptr)
+    {
+      G4NavigationHistory history;
+      history.SetFirstEntry(volume);
+      track->SetTouchableHandle(new G4TouchableHistory(history));
+    }
+    return track;
+  }
+
+  // Pops every track, deleting it, and returns the track IDs
+  std::vector<G4int> PopAll(G4ParticleGroupedTrackStack& stack)
+  {
+    std::vector<G4int> ids;
+    while (stack.GetNTrack() > 0)
+    {
+      G4Track* track = stack.PopFromStack().GetTrack();
+      ids.push_back(track->GetTrackID());
+      delete track;
+    }
+    return ids;
+  }
+
+  const G4ParticleDefinition* Particle(G4int i)
+  {
+    static const G4ParticleDefinition* particles[] = {
+      G4Electron::Definition(), G4Gamma::Definition(),
+      G4Positron::Definition() };
+    return particles[i%3];
+  }
+}
+
+G4bool testGroupByParticle()
+{
+  const G4ParticleDefinition* e = G4Electron::Definition();
+  const G4ParticleDefinition* gamma = G4Gamma::Definition();
+  const G4ParticleDefinition* p = G4Positron::Definition();
+  G4bool ok = true;
+
+  G4ParticleGroupedTrackStack stack;
+  const G4ParticleDefinition* pushed[] = { e, gamma, gamma, p, e, gamma,
+                                           gamma, e, gamma };
+  G4int id = 0;
+  for (const auto particle : pushed)
+  {
+    stack.PushToStack(G4StackedTrack(MakeTrack(particle, ++id)));
+  }
+  ok &= Check(stack.GetNTrack() == 9 && stack.GetNBuckets() == 3,
+              "tracks and buckets after PushToStack()");
+
+  // gammas first, the most populated bucket, then e- and e+, each LIFO
+  const std::vector<G4int> expected = { 9, 7, 6, 3, 2, 8, 5, 1, 4 };
+  ok &= Check(PopAll(stack) == expected, "pop order by particle");
+  ok &= Check(stack.GetNBucketSwitches() == 3 && stack.GetNPopped() == 9,
+              "bucket switches by particle");
+
+  // the current bucket is emptied before a more populated one
+  stack.ResetStatistics();
+  stack.PushToStack(G4StackedTrack(MakeTrack(gamma, 10)));
+  stack.PushToStack(G4StackedTrack(MakeTrack(gamma, 11)));
+  stack.PushToStack(G4StackedTrack(MakeTrack(e, 12)));
+  G4Track* track = stack.PopFromStack().GetTrack();
+  ok &= Check(track->GetTrackID() == 11, "first pop of a new bucket");
+  delete track;
+  for (G4int i = 13; i < 16; ++i)
+  {
+    stack.PushToStack(G4StackedTrack(MakeTrack(i < 15 ? e : gamma, i)));
+  }
+  ok &= Check(PopAll(stack) == std::vector<G4int>{ 15, 10, 14, 13, 12 },
+              "current bucket emptied first");
+  ok &= Check(stack.GetNBucketSwitches() == 2,
+              "bucket switches, current bucket first");
+  return ok;
+}
+
+G4bool testGroupByRegion()
+{
+  G4bool ok = true;
+  auto box = new G4Box("Box", 1*m, 1*m, 1*m);
+  auto lv1 = new G4LogicalVolume(box, nullptr, "Volume1");
+  auto lv2 = new G4LogicalVolume(box, nullptr, "Volume2");
+  auto region1 = new G4Region("Region1");
+  auto region2 = new G4Region("Region2");
+  region1->AddRootLogicalVolume(lv1);
+  region2->AddRootLogicalVolume(lv2);
+  auto pv1 = new G4PVPlacement(nullptr, G4ThreeVector(), lv1, "Volume1",
+                               nullptr, false, 0);
+  auto pv2 = new G4PVPlacement(nullptr, G4ThreeVector(), lv2, "Volume2",
+                               nullptr, false, 0);
+
+  const G4ParticleDefinition* e = G4Electron::Definition();
+  const G4ParticleDefinition* gamma = G4Gamma::Definition();
+  struct Entry { const G4ParticleDefinition* particle; G4VPhysicalVolume* pv; };
+  const Entry pushed[] = { { gamma, pv1 }, { e, pv2 }, { gamma, pv2 },
+                           { gamma, pv1 }, { e, pv1 }, { gamma, pv2 },
+                           { gamma, pv1 }, { e, pv2 } };
+
+  for (G4bool byRegion : { false, true })
+  {
+    G4ParticleGroupedTrackStack stack;
+    stack.SetGroupByRegion(byRegion);
+    G4int id = 0;
+    for (const auto& entry : pushed)
+    {
+      stack.PushToStack(G4StackedTrack(
+        MakeTrack(entry.particle, ++id, entry.pv)));
+    }
+    ok &= Check(stack.GetNBuckets() == (byRegion ? 4u : 2u),
+                "number of buckets by region");
+    const std::vector<G4int> expected = byRegion
+      ? std::vector<G4int>{ 7, 4, 1, 8, 2, 6, 3, 5 }
+      : std::vector<G4int>{ 7, 6, 4, 3, 1, 8, 5, 2 };
+    ok &= Check(PopAll(stack) == expected,
+                byRegion ? "pop order by particle and region"
+                         : "pop order by particle, regions ignored");
+    ok &= Check(stack.GetNBucketSwitches() == stack.GetNBuckets(),
+                "bucket switches by region");
+  }
+
+  delete pv1;
+  delete pv2;
+  delete lv1;
+  delete lv2;
+  delete box;
+  delete region1;
+  delete region2;
+  return ok;
+}
+
+// A cascade where every track below the maximum depth creates three
+// secondaries of different types. Returns the maximum number of stacked
+// tracks and counts the processed tracks.
+template <typename Stack>
+std::size_t Cascade(Stack& stack, G4int maxDepth, G4int& nProcessed)
+{
+  std::vector<G4int> depth = { 0 };
+  std::size_t maxStacked = 0;
+  stack.PushToStack(G4StackedTrack(MakeTrack(Particle(0), 0)));
+  nProcessed = 0;
+  while (stack.GetNTrack() > 0)
+  {
+    G4Track* track = stack.PopFromStack().GetTrack();
+    const G4int d = depth[track->GetTrackID()];
+    delete track;
+    ++nProcessed;
+    if (d == maxDepth) { continue; }
+    for (G4int i = 0; i < 3; ++i)
+    {
+      auto id = (G4int)depth.size();
+      depth.push_back(d + 1);
+      stack.PushToStack(G4StackedTrack(MakeTrack(Particle(id + i), id)));
+    }
+    maxStacked = std::max(maxStacked, stack.GetNTrack());
+  }
+  return maxStacked;
+}
+
+G4bool testGroupLimit()
+{
+  G4bool ok = true;
+  const G4int maxDepth = 9;
+  const G4int nTracks = (59049 - 1)/2;  // 1 + 3 + ... + 3^9
+  G4int nProcessed;
+
+  G4TrackStack lifo;
+  const std::size_t maxLifo = Cascade(lifo, maxDepth, nProcessed);
+  ok &= Check(nProcessed == nTracks && maxLifo == 2*maxDepth + 1,
+              "depth-first cascade");
+
+  G4ParticleGroupedTrackStack unlimited(1000000);
+  const std::size_t maxUnlimited = Cascade(unlimited, maxDepth, nProcessed);
+  ok &= Check(nProcessed == nTracks, "cascade without limit");
+
+  const std::size_t limit = 100;
+  G4ParticleGroupedTrackStack limited(limit);
+  const std::size_t maxLimited = Cascade(limited, maxDepth, nProcessed);
+  ok &= Check(nProcessed == nTracks, "cascade with limit");
+  ok &= Check(limited.GetMaxNTrack() == maxLimited, "GetMaxNTrack()");
+
+  // Beyond the limit the newest track is popped, as in the depth-first
+  // order, so at most two tracks per generation are added to the limit
+  const std::size_t bound = limit + 2*maxDepth + 3;
+  ok &= Check(maxLimited <= bound, "stacked tracks bounded by the limit");
+  ok &= Check(maxUnlimited > 10*bound, "cascade exceeds the bound unlimited");
+  if (!ok)
+  {
+    G4cerr << "maximum stacked tracks: depth-first " << maxLifo
+           << ", grouped " << maxUnlimited << ", grouped with limit "
+           << maxLimited << " (bound " << bound << ")" << G4endl;
+  }
+  return ok;
+}
+
+G4bool testStackManager()
+{
+  G4bool ok = true;
+  const G4ParticleDefinition* e = G4Electron::Definition();
+  const G4ParticleDefinition* gamma = G4Gamma::Definition();
+
+  auto stackManager = new G4StackManager;
+  stackManager->SetParticleGroupedStack(true);
+  ok &= Check(stackManager->GetParticleGroupedStack() != nullptr,
+              "SetParticleGroupedStack()");
+
+  const G4ParticleDefinition* pushed[] = { e, gamma, e, gamma, gamma };
+  G4int id = 0;
+  for (const auto particle : pushed)
+  {
+    stackManager->PushOneTrack(MakeTrack(particle, ++id));
+  }
+  ok &= Check(stackManager->GetNUrgentTrack() == 5
+              && stackManager->GetNTotalTrack() == 5, "GetNUrgentTrack()");
+
+  // to the waiting stack and back, where the tracks are grouped again
+  stackManager->TransferStackedTracks(fUrgent, fWaiting);
+  ok &= Check(stackManager->GetNUrgentTrack() == 0
+              && stackManager->GetNWaitingTrack() == 5,
+              "TransferStackedTracks() of grouped tracks");
+
+  std::vector<G4int> ids;
+  G4VTrajectory* trajectory = nullptr;
+  while (G4Track* track = stackManager->PopNextTrack(&trajectory))
+  {
+    ids.push_back(track->GetTrackID());
+    delete track;
+  }
+  ok &= Check(ids == std::vector<G4int>{ 5, 4, 2, 3, 1 },
+              "PopNextTrack() groups the particles");
+  ok &= Check(stackManager->GetNTotalTrack() == 0, "empty stacks");
+
+  stackManager->SetParticleGroupedStack(false);
+  ok &= Check(stackManager->GetParticleGroupedStack() == nullptr,
+              "SetParticleGroupedStack(false)");
+  delete stackManager;
+  return ok;
+}
+
+int main()
+{
+  // the stack manager accepts only particles set up for tracking
+  for (G4int i = 0; i < 3; ++i)
+  {
+    const_cast<G4ParticleDefinition*>(Particle(i))->SetParticleDefinitionID();
+  }
+  G4bool ok = testGroupByParticle();
+  ok &= testGroupByRegion();
+  ok &= testGroupLimit();
+  ok &= testStackManager();
+  return ok ? 0 : 1;
+}
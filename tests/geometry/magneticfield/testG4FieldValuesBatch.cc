@@ -0,0 +1,259 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4FieldValuesBatch
+//
+// Checks the batched field evaluation: G4TrilinearMagField::GetFieldValues()
+// gives the same values as GetFieldValue() point by point, for points
+// inside the cells, on nodes, faces and edges of the cells, on the
+// boundary of the grid and outside it (including NaN and infinite
+// coordinates), and reproduces exactly a field that is trilinear in x, y,
+// z. G4ClassicalRK4::DumbStepperPair() and the default implementation of
+// G4MagErrorStepper give the same states as two calls to DumbStepper().
+
+#include "G4ClassicalRK4.hh"
+#include "G4Mag_UsualEqRhs.hh"
+#include "G4ChargeState.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SimpleRunge.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TrilinearMagField.hh"
+#include "globals.hh"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::mt19937_64 engine(8642);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  const G4ThreeVector corner(-1*m, -50*cm, -2*m);
+  const G4ThreeVector spacing(20*cm, 12.5*cm, 1*m);
+  const G4int nNodes[3] = { 11, 9, 5 };
+
+  // Trilinear in x, y and z, hence interpolated exactly
+  G4ThreeVector Trilinear(const G4ThreeVector& p)
+  {
+    const G4double x = p.x()/m, y = p.y()/m, z = p.z()/m;
+    return G4ThreeVector(0.5 + 0.2*x - 0.1*y + 0.05*x*y*z,
+                         -0.3 + 0.1*y*z + 0.02*x,
+                         1.5 - 0.2*z + 0.1*x*y - 0.03*x*z)*tesla;
+  }
+
+  G4ThreeVector Node(G4int i, G4int j, G4int k)
+  {
+    return corner + G4ThreeVector(i*spacing.x(), j*spacing.y(),
+                                  k*spacing.z());
+  }
+
+  G4TrilinearMagField* MakeField(G4bool random)
+  {
+    auto field = new G4TrilinearMagField(corner, spacing, nNodes[0],
+                                         nNodes[1], nNodes[2]);
+    for (G4int i = 0; i < nNodes[0]; ++i)
+    {
+      for (G4int j = 0; j < nNodes[1]; ++j)
+      {
+        for (G4int k = 0; k < nNodes[2]; ++k)
+        {
+          field->SetFieldValue(i, j, k, random
+            ? G4ThreeVector(Uniform(-2., 2.), Uniform(-2., 2.),
+                            Uniform(-2., 2.))*tesla
+            : Trilinear(Node(i, j, k)));
+        }
+      }
+    }
+    return field;
+  }
+
+  // Points inside the cells, on nodes, faces and edges, on the boundary
+  // of the grid, just outside it, far away and not a number
+  std::vector<G4ThreeVector> SamplePoints()
+  {
+    const G4ThreeVector far = Node(nNodes[0]-1, nNodes[1]-1, nNodes[2]-1);
+    std::vector<G4ThreeVector> points;
+    for (G4int n = 0; n < 2000; ++n)
+    {
+      points.emplace_back(Uniform(corner.x(), far.x()),
+                          Uniform(corner.y(), far.y()),
+                          Uniform(corner.z(), far.z()));
+    }
+    for (G4int n = 0; n < 1000; ++n)
+    {
+      G4int i = G4int(Uniform(0., nNodes[0])) % nNodes[0];
+      G4int j = G4int(Uniform(0., nNodes[1])) % nNodes[1];
+      G4int k = G4int(Uniform(0., nNodes[2])) % nNodes[2];
+      G4ThreeVector node = Node(i, j, k);
+      points.push_back(node);
+      G4ThreeVector face(Uniform(corner.x(), far.x()),
+                         Uniform(corner.y(), far.y()), node.z());
+      points.push_back(face);
+      G4ThreeVector edge(node.x(), node.y(), Uniform(corner.z(), far.z()));
+      points.push_back(edge);
+    }
+    const G4double inf = std::numeric_limits<G4double>::infinity();
+    const G4double nan = std::numeric_limits<G4double>::quiet_NaN();
+    const G4double eps = 1.e-9*mm;
+    const G4double odd[] = { -inf, -1.e300, -1.e10, 1.e10, 1.e300, inf, nan };
+    for (G4int k = 0; k < 3; ++k)
+    {
+      G4ThreeVector p = 0.5*(corner + far);
+      p[k] = corner[k] - eps;  points.push_back(p);
+      p[k] = far[k] + eps;     points.push_back(p);
+      for (const G4double value : odd)
+      {
+        p[k] = value;
+        points.push_back(p);
+      }
+    }
+    return points;
+  }
+
+  G4bool Inside(const G4ThreeVector& p)
+  {
+    const G4ThreeVector far = Node(nNodes[0]-1, nNodes[1]-1, nNodes[2]-1);
+    return p.x() >= corner.x() && p.x() <= far.x()
+        && p.y() >= corner.y() && p.y() <= far.y()
+        && p.z() >= corner.z() && p.z() <= far.z();
+  }
+}
+
+G4bool testFieldValues()
+{
+  const std::vector<G4ThreeVector> points = SamplePoints();
+  const G4int n = G4int(points.size());
+  std::vector<G4double> packed(4*n);
+  for (G4int i = 0; i < n; ++i)
+  {
+    packed[4*i] = points[i].x();
+    packed[4*i+1] = points[i].y();
+    packed[4*i+2] = points[i].z();
+    packed[4*i+3] = 0.;
+  }
+
+  G4bool ok = true;
+  for (const G4bool random : { false, true })
+  {
+    G4TrilinearMagField* field = MakeField(random);
+    const G4int ncomp = G4Field::MAX_NUMBER_OF_COMPONENTS;
+    std::vector<G4double> batch(ncomp*n);
+    field->GetFieldValues(packed.data(), batch.data(), n);
+
+    G4int nDiff = 0, nWrong = 0, nOutside = 0;
+    for (G4int i = 0; i < n; ++i)
+    {
+      G4double single[3];
+      field->GetFieldValue(&packed[4*i], single);
+      const G4double* b = &batch[ncomp*i];
+      if (b[0] != single[0] || b[1] != single[1] || b[2] != single[2])
+      {
+        if (nDiff++ == 0)
+        {
+          G4cerr << "point " << points[i] << ": batch (" << b[0] << ", "
+                 << b[1] << ", " << b[2] << "), single (" << single[0]
+                 << ", " << single[1] << ", " << single[2] << ")" << G4endl;
+        }
+      }
+      const G4ThreeVector B(b[0], b[1], b[2]);
+      if (!Inside(points[i]))
+      {
+        ++nOutside;
+        if (B != G4ThreeVector()) { ++nWrong; }
+      }
+      else if (!random && (B - Trilinear(points[i])).mag() > 1.e-12*tesla)
+      {
+        ++nWrong;
+      }
+    }
+    ok &= Check(nOutside == 6 + 3*7, "points outside the grid");
+    ok &= Check(nDiff == 0, "batched values equal single values");
+    ok &= Check(nWrong == 0, random ? "zero field outside the grid"
+                                    : "exact interpolation of a trilinear field");
+    delete field;
+  }
+  return ok;
+}
+
+G4bool testDumbStepperPair()
+{
+  G4TrilinearMagField* field = MakeField(true);
+  G4Mag_UsualEqRhs equation(field);
+  G4ClassicalRK4 rk4(&equation, 8);
+  G4SimpleRunge runge(&equation, 8);
+  G4MagErrorStepper* steppers[2] = { &rk4, &runge };
+
+  G4bool ok = true;
+  for (G4MagErrorStepper* stepper : steppers)
+  {
+    G4int nDiff = 0;
+    for (G4int n = 0; n < 500; ++n)
+    {
+      const G4double momentum = Uniform(10*MeV, 1*GeV);
+      const G4double mass = (n%2 == 0) ? electron_mass_c2 : proton_mass_c2;
+      equation.SetChargeMomentumMass(G4ChargeState((n%4 < 2) ? -1. : 1., 0., 0.5),
+                                     momentum, mass);
+      G4ThreeVector dir(Uniform(-1., 1.), Uniform(-1., 1.), Uniform(-1., 1.));
+      dir = dir.unit()*momentum;
+      G4double y[8] = { Uniform(-80*cm, 80*cm), Uniform(-40*cm, 40*cm),
+                        Uniform(-1.5*m, 1.5*m), dir.x(), dir.y(), dir.z(),
+                        0., 0. };
+      G4double dydx[8];
+      stepper->RightHandSide(y, dydx);
+
+      const G4double h = Uniform(1*mm, 50*cm);
+      G4double out1[8], out2[8], ref1[8], ref2[8];
+      stepper->DumbStepperPair(y, dydx, 0.5*h, out1, h, out2);
+      stepper->DumbStepper(y, dydx, 0.5*h, ref1);
+      stepper->DumbStepper(y, dydx, h, ref2);
+      for (G4int i = 0; i < 6; ++i)
+      {
+        if (out1[i] != ref1[i] || out2[i] != ref2[i]) { ++nDiff; break; }
+      }
+    }
+    ok &= Check(nDiff == 0, stepper == &rk4
+                ? "G4ClassicalRK4::DumbStepperPair() equals two steps"
+                : "default DumbStepperPair() equals two steps");
+  }
+  delete field;
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testFieldValues();
+  ok &= testDumbStepperPair();
+  return ok ? 0 : 1;
+}
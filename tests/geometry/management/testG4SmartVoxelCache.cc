@@ -0,0 +1,213 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4SmartVoxelCache
+//
+// Checks the persistency of the voxel optimisations: the voxel trees
+// stored by G4SmartVoxelCache and restored in place of the ones built
+// when closing the geometry are equal, slice by slice, no temporary file
+// is left behind, and a cache written for a different geometry is
+// rejected by its hash, leaving the optimisations untouched.
+
+#include "G4Box.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Material.hh"
+#include "G4Orb.hh"
+#include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SmartVoxelCache.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "G4SmartVoxelNode.hh"
+#include "G4SmartVoxelProxy.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  G4bool FileExists(const std::string& name)
+  {
+    return std::ifstream(name).good();
+  }
+
+  // Equal trees, including the equivalent slice numbers which are not
+  // compared by G4SmartVoxelHeader::operator==
+  G4bool SameTree(const G4SmartVoxelHeader* h1, const G4SmartVoxelHeader* h2)
+  {
+    if (!(*h1 == *h2)
+      || h1->GetMinEquivalentSliceNo() != h2->GetMinEquivalentSliceNo()
+      || h1->GetMaxEquivalentSliceNo() != h2->GetMaxEquivalentSliceNo())
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < h1->GetNoSlices(); ++i)
+    {
+      const G4SmartVoxelProxy* p1 = h1->GetSlice(i);
+      const G4SmartVoxelProxy* p2 = h2->GetSlice(i);
+      if (p1->IsHeader())
+      {
+        if (!SameTree(p1->GetHeader(), p2->GetHeader())) { return false; }
+      }
+      else
+      {
+        const G4SmartVoxelNode* n1 = p1->GetNode();
+        const G4SmartVoxelNode* n2 = p2->GetNode();
+        if (n1->GetMinEquivalentSliceNo() != n2->GetMinEquivalentSliceNo()
+          || n1->GetMaxEquivalentSliceNo() != n2->GetMaxEquivalentSliceNo())
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // A voxelised box of randomly placed boxes and orbs, next to a tube
+  // replicated in phi and z, each slice containing an orb
+  G4VPhysicalVolume* BuildGeometry(G4PVPlacement*& movable)
+  {
+    auto mat = new G4Material("Aluminium", 13., 26.98*g/mole, 2.7*g/cm3);
+    auto worldL = new G4LogicalVolume(new G4Box("World", 2*m, 2*m, 2*m),
+                                      mat, "World");
+    auto world = new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                   nullptr, false, 0);
+
+    auto mother = new G4LogicalVolume(new G4Box("Mother", 50*cm, 50*cm, 50*cm),
+                                      mat, "Mother");
+    new G4PVPlacement(nullptr, G4ThreeVector(-60*cm, 0, 0), mother, "Mother",
+                      worldL, false, 0);
+    auto boxL = new G4LogicalVolume(new G4Box("Box", 1*cm, 2*cm, 1.5*cm),
+                                    mat, "Box");
+    auto orbL = new G4LogicalVolume(new G4Orb("Orb", 1.5*cm), mat, "Orb");
+    std::mt19937_64 engine(13579);
+    std::uniform_real_distribution<G4double> pos(-45*cm, 45*cm);
+    for (G4int i = 0; i < 400; ++i)
+    {
+      // Keep the daughters apart on a coarse grid with random offsets
+      G4ThreeVector p(-45*cm + 10*cm*(i%10), -45*cm + 10*cm*((i/10)%10),
+                      -40*cm + 20*cm*(i/100));
+      p += G4ThreeVector(pos(engine), pos(engine), pos(engine))/20.;
+      auto pv = new G4PVPlacement(nullptr, p, (i%3 == 0) ? orbL : boxL,
+                                  "Daughter", mother, false, i);
+      if (i == 123) { movable = pv; }
+    }
+
+    auto tube = new G4LogicalVolume(
+      new G4Tubs("Tube", 10*cm, 40*cm, 50*cm, 0., twopi), mat, "Tube");
+    new G4PVPlacement(nullptr, G4ThreeVector(60*cm, 0, 0), tube, "Tube",
+                      worldL, false, 0);
+    auto sector = new G4LogicalVolume(
+      new G4Tubs("Sector", 10*cm, 40*cm, 50*cm, 0., twopi/8), mat, "Sector");
+    new G4PVReplica("Sector", sector, tube, kPhi, 8, twopi/8);
+    auto slice = new G4LogicalVolume(
+      new G4Tubs("Slice", 10*cm, 40*cm, 5*cm, 0., twopi/8), mat, "Slice");
+    new G4PVReplica("Slice", slice, sector, kZAxis, 10, 10*cm);
+    new G4PVPlacement(nullptr, G4ThreeVector(25*cm, 5*cm, 0), orbL, "Orb",
+                      slice, false, 0);
+    return world;
+  }
+}
+
+int main()
+{
+  G4PVPlacement* movable = nullptr;
+  BuildGeometry(movable);
+  G4GeometryManager* geomManager = G4GeometryManager::GetInstance();
+  geomManager->CloseGeometry(true);
+
+  const std::string fileName = "testG4SmartVoxelCache.voxels";
+  std::remove(fileName.c_str());
+  G4bool ok = Check(G4SmartVoxelCache::Store(fileName, true), "Store()");
+  ok &= Check(FileExists(fileName), "cache file written");
+  ok &= Check(!FileExists(fileName + ".tmp." + std::to_string(getpid())),
+              "temporary file renamed");
+
+  // Detach the optimisations built when closing, then restore them
+  //
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  std::vector<G4SmartVoxelHeader*> built;
+  std::size_t nVoxelised = 0;
+  for (auto volume : *store)
+  {
+    built.push_back(volume->GetVoxelHeader());
+    if (volume->GetVoxelHeader() != nullptr) { ++nVoxelised; }
+    volume->SetVoxelHeader(nullptr);
+  }
+  ok &= Check(nVoxelised >= 3, "mother, tube and sectors are voxelised");
+  ok &= Check(G4SmartVoxelCache::Restore(fileName, true), "Restore()");
+  for (std::size_t i = 0; i < store->size(); ++i)
+  {
+    const G4SmartVoxelHeader* restored = (*store)[i]->GetVoxelHeader();
+    G4bool same = (built[i] == nullptr)
+                ? restored == nullptr
+                : restored != nullptr && restored != built[i]
+                  && SameTree(built[i], restored);
+    if (!same)
+    {
+      G4cerr << "volume " << (*store)[i]->GetName() << G4endl;
+      ok &= Check(false, "restored voxels equal the built ones");
+    }
+    delete built[i];
+  }
+
+  // Moving one daughter changes the hash; the cache must be rejected
+  //
+  const std::uint64_t hash = G4SmartVoxelCache::ComputeGeometryHash(true);
+  geomManager->OpenGeometry();
+  movable->SetTranslation(movable->GetTranslation()
+                          + G4ThreeVector(0, 0, 1*mm));
+  geomManager->CloseGeometry(true);
+  ok &= Check(G4SmartVoxelCache::ComputeGeometryHash(true) != hash,
+              "hash depends on the placements");
+  std::vector<const G4SmartVoxelHeader*> current;
+  for (auto volume : *store) { current.push_back(volume->GetVoxelHeader()); }
+  ok &= Check(!G4SmartVoxelCache::Restore(fileName, true),
+              "cache of a different geometry rejected");
+  for (std::size_t i = 0; i < store->size(); ++i)
+  {
+    ok &= Check((*store)[i]->GetVoxelHeader() == current[i],
+                "rejected cache leaves the optimisations untouched");
+  }
+
+  geomManager->OpenGeometry();
+  std::remove(fileName.c_str());
+  return ok ? 0 : 1;
+}
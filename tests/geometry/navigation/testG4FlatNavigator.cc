@@ -0,0 +1,289 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4FlatNavigator
+//
+// Checks that locating points through the flat image of the geometry
+// (G4Navigator::EnableFlatGeometry()) gives the same histories, steps and
+// safeties as the standard navigation, on a geometry of rotated and
+// voxelised placements including a replicated level, both for random
+// points and along straight tracks crossing the boundaries. Also checks
+// that the image is rebuilt when the geometry is closed again.
+
+#include "G4Box.hh"
+#include "G4Tubs.hh"
+#include "G4FlatGeometry.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4NavigationHistory.hh"
+#include "G4Navigator.hh"
+#include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
+#include "G4RotationMatrix.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "globals.hh"
+
+#include <random>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::mt19937_64 engine(12345);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  G4ThreeVector RandomDirection()
+  {
+    G4double cost = Uniform(-1., 1.);
+    G4double sint = std::sqrt((1. - cost)*(1. + cost));
+    G4double phi = Uniform(0., twopi);
+    return { sint*std::cos(phi), sint*std::sin(phi), cost };
+  }
+
+  G4bool SameHistory(const G4Navigator* nav1, const G4Navigator* nav2,
+                     G4int* depth = nullptr)
+  {
+    G4TouchableHistory* t1 = nav1->CreateTouchableHistory();
+    G4TouchableHistory* t2 = nav2->CreateTouchableHistory();
+    const G4NavigationHistory* h1 = t1->GetHistory();
+    const G4NavigationHistory* h2 = t2->GetHistory();
+    G4bool same = (h1->GetDepth() == h2->GetDepth());
+    for (G4int i=0; same && i<=(G4int)h1->GetDepth(); ++i)
+    {
+      same = (h1->GetVolume(i) == h2->GetVolume(i))
+          && (h1->GetReplicaNo(i) == h2->GetReplicaNo(i))
+          && (h1->GetTransform(i).NetTranslation()
+              == h2->GetTransform(i).NetTranslation());
+    }
+    if (depth != nullptr) { *depth = (G4int)h1->GetDepth(); }
+    delete t1;
+    delete t2;
+    return same;
+  }
+}
+
+// World with a rotated tracker holding layers of rotated modules, each
+// module holding sensors and a tube; one layer is sliced by a replica.
+//
+G4VPhysicalVolume* BuildGeometry()
+{
+  auto vacuum = new G4Material("Vacuum", 1., 1.01*g/mole, 1.e-25*g/cm3,
+                               kStateGas, 2.73*kelvin, 3.e-18*pascal);
+  auto worldS = new G4Box("World", 2*m, 2*m, 2*m);
+  auto worldL = new G4LogicalVolume(worldS, vacuum, "World");
+  auto worldP = new G4PVPlacement(nullptr, G4ThreeVector(), worldL,
+                                  "World", nullptr, false, 0);
+
+  auto trackerS = new G4Box("Tracker", 1*m, 1*m, 1*m);
+  auto trackerL = new G4LogicalVolume(trackerS, vacuum, "Tracker");
+  auto trackerRot = new G4RotationMatrix();
+  trackerRot->rotateZ(10*deg);
+  trackerRot->rotateX(5*deg);
+  new G4PVPlacement(trackerRot, G4ThreeVector(5*cm, -3*cm, 2*cm),
+                    trackerL, "Tracker", worldL, false, 0);
+
+  auto sensorS = new G4Box("Sensor", 4*cm, 1*cm, 0.5*mm);
+  auto sensorL = new G4LogicalVolume(sensorS, vacuum, "Sensor");
+  auto pipeS = new G4Tubs("Pipe", 2*mm, 3*mm, 4*cm, 0., twopi);
+  auto pipeL = new G4LogicalVolume(pipeS, vacuum, "Pipe");
+  auto moduleS = new G4Box("Module", 4.5*cm, 4.5*cm, 5*mm);
+  auto moduleL = new G4LogicalVolume(moduleS, vacuum, "Module");
+  for (G4int i=0; i<4; ++i)
+  {
+    new G4PVPlacement(nullptr, G4ThreeVector(0, (-3 + 2*i)*cm, -2*mm),
+                      sensorL, "Sensor", moduleL, false, i);
+  }
+  auto pipeRot = new G4RotationMatrix();
+  pipeRot->rotateY(90*deg);
+  new G4PVPlacement(pipeRot, G4ThreeVector(0, 0, 2*mm),
+                    pipeL, "Pipe", moduleL, false, 0);
+
+  auto layerS = new G4Box("Layer", 90*cm, 90*cm, 1*cm);
+  auto layerL = new G4LogicalVolume(layerS, vacuum, "Layer");
+  G4int copyNo = 0;
+  for (G4int ix=-9; ix<9; ++ix)
+  {
+    for (G4int iy=-9; iy<9; ++iy)
+    {
+      auto moduleRot = new G4RotationMatrix();
+      moduleRot->rotateZ(((ix + iy)%3)*2*deg);
+      G4ThreeVector pos((ix + 0.5)*10*cm, (iy + 0.5)*10*cm, 0.);
+      new G4PVPlacement(moduleRot, pos, moduleL, "Module", layerL,
+                        false, copyNo++);
+    }
+  }
+  for (G4int i=0; i<4; ++i)
+  {
+    new G4PVPlacement(nullptr, G4ThreeVector(0, 0, (-60 + 30*i)*cm),
+                      layerL, "Layer", trackerL, false, i);
+  }
+
+  auto slicedS = new G4Box("Sliced", 90*cm, 90*cm, 1*cm);
+  auto slicedL = new G4LogicalVolume(slicedS, vacuum, "Sliced");
+  auto sliceS = new G4Box("Slice", 10*cm, 90*cm, 1*cm);
+  auto sliceL = new G4LogicalVolume(sliceS, vacuum, "Slice");
+  new G4PVReplica("Slice", sliceL, slicedL, kXAxis, 9, 20*cm);
+  new G4PVPlacement(nullptr, G4ThreeVector(0, 0, 60*cm),
+                    slicedL, "Sliced", trackerL, false, 0);
+  return worldP;
+}
+
+G4bool testLocation(G4Navigator* standard, G4Navigator* flat)
+{
+  G4bool ok = true;
+  G4int nDifferent = 0;
+  for (G4int i=0; i<20000; ++i)
+  {
+    G4ThreeVector p(Uniform(-1.2*m, 1.2*m), Uniform(-1.2*m, 1.2*m),
+                    Uniform(-1.2*m, 1.2*m));
+    if (i%2 == 0)
+    {
+      // Points concentrated in a layer, to sample the deepest volumes
+      p.setZ(Uniform(-35*cm, -25*cm));
+    }
+    G4VPhysicalVolume* v1 = standard->LocateGlobalPointAndSetup(p);
+    G4VPhysicalVolume* v2 = flat->LocateGlobalPointAndSetup(p);
+    if (v1 != v2 || !SameHistory(standard, flat)) { ++nDifferent; }
+  }
+  ok &= Check(nDifferent == 0, "same location of random points");
+
+  const G4FlatGeometry* image = flat->GetFlatGeometry();
+  ok &= Check(image != nullptr && image->GetNumberOfNodes() > 1,
+              "flat image built");
+  return ok;
+}
+
+G4bool testTracks(G4Navigator* standard, G4Navigator* flat)
+{
+  G4bool ok = true;
+  G4int nSteps = 0, nDifferent = 0, nDeep = 0;
+  for (G4int i=0; i<1000; ++i)
+  {
+    G4ThreeVector p(Uniform(-50*cm, 50*cm), Uniform(-50*cm, 50*cm),
+                    Uniform(-80*cm, 80*cm));
+    G4ThreeVector v = RandomDirection();
+    if (i%2 == 0)
+    {
+      // Tracks crossing the layers
+      v = G4ThreeVector(Uniform(-0.3, 0.3), Uniform(-0.3, 0.3), 1.).unit();
+      p.setZ(-95*cm);
+    }
+    G4VPhysicalVolume* v1 = standard->LocateGlobalPointAndSetup(p, &v);
+    G4VPhysicalVolume* v2 = flat->LocateGlobalPointAndSetup(p, &v);
+    for (G4int step=0; step<1000 && v1 != nullptr; ++step)
+    {
+      G4int depth = 0;
+      if (v1 != v2 || !SameHistory(standard, flat, &depth))
+      {
+        ++nDifferent;
+        break;
+      }
+      if (depth > 3) { ++nDeep; }
+      G4double safety1, safety2;
+      G4double s1 = standard->ComputeStep(p, v, kInfinity, safety1);
+      G4double s2 = flat->ComputeStep(p, v, kInfinity, safety2);
+      ++nSteps;
+      if (s1 != s2 || safety1 != safety2)
+      {
+        ++nDifferent;
+        break;
+      }
+      p += s1*v;
+      standard->SetGeometricallyLimitedStep();
+      flat->SetGeometricallyLimitedStep();
+      v1 = standard->LocateGlobalPointAndSetup(p, &v, true);
+      v2 = flat->LocateGlobalPointAndSetup(p, &v, true);
+    }
+  }
+  ok &= Check(nSteps > 10000 && nDeep > 1000, "tracks cross deep volumes");
+  ok &= Check(nDifferent == 0, "same steps, safeties and volumes on tracks");
+  return ok;
+}
+
+G4bool testRebuild(G4VPhysicalVolume* world, G4Navigator* flat)
+{
+  G4bool ok = true;
+  G4GeometryManager* manager = G4GeometryManager::GetInstance();
+  const G4FlatGeometry* image = flat->GetFlatGeometry();
+  G4int nNodes = image->GetNumberOfNodes();
+
+  manager->OpenGeometry();
+  G4int closure = G4GeometryManager::GetClosureCount();
+  manager->CloseGeometry(true);
+  ok &= Check(G4GeometryManager::GetClosureCount() == closure + 1,
+              "closure counted");
+
+  // Removing the pipe from the modules changes the image at the next
+  // location, which must not enter the removed volume anymore
+  G4LogicalVolume* moduleL = world->GetLogicalVolume()->GetDaughter(0)
+    ->GetLogicalVolume()->GetDaughter(0)->GetLogicalVolume()->GetDaughter(0)
+    ->GetLogicalVolume();
+  manager->OpenGeometry();
+  G4VPhysicalVolume* pipe = moduleL->GetDaughter(4);
+  moduleL->RemoveDaughter(pipe);
+  manager->CloseGeometry(true);
+  flat->LocateGlobalPointAndSetup(G4ThreeVector());
+  ok &= Check(image->GetNumberOfNodes() == nNodes - 4*18*18,
+              "image rebuilt after the geometry is closed again");
+
+  flat->EnableFlatGeometry(false);
+  ok &= Check(!flat->IsFlatGeometryEnabled()
+              && flat->GetFlatGeometry() == nullptr, "flat image disabled");
+  return ok;
+}
+
+int main()
+{
+  G4VPhysicalVolume* world = BuildGeometry();
+  G4GeometryManager::GetInstance()->CloseGeometry(true);
+
+  auto standard = new G4Navigator();
+  standard->SetWorldVolume(world);
+  auto flat = new G4Navigator();
+  flat->SetWorldVolume(world);
+  flat->EnableFlatGeometry();
+
+  G4bool ok = Check(flat->IsFlatGeometryEnabled()
+                    && !standard->IsFlatGeometryEnabled(), "opt-in switch");
+  ok &= testLocation(standard, flat);
+  ok &= testTracks(standard, flat);
+  ok &= testRebuild(world, flat);
+
+  delete flat;
+  delete standard;
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4GeomTestVolume
+//
+// Checks TestOverlapInTree() in parallel mode without a task-based run
+// manager: it must fall back to the sequential check. The incremental
+// report must find the overlap and be reproduced by a second run.
+
+#include "G4GeomTestVolume.hh"
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::string ReadFile(const G4String& fileName)
+  {
+    std::ifstream in(fileName);
+    std::ostringstream os;
+    os << in.rdbuf();
+    return os.str();
+  }
+}
+
+G4VPhysicalVolume* BuildGeometry()
+{
+  auto vacuum = new G4Material("Vacuum", 1., 1.01*g/mole, 1.e-25*g/cm3,
+                               kStateGas, 2.73*kelvin, 3.e-18*pascal);
+  auto worldS = new G4Box("World", 1*m, 1*m, 1*m);
+  auto worldL = new G4LogicalVolume(worldS, vacuum, "World");
+  auto worldP = new G4PVPlacement(nullptr, G4ThreeVector(), worldL,
+                                  "World", nullptr, false, 0);
+  auto motherS = new G4Box("Mother", 50*cm, 50*cm, 50*cm);
+  auto motherL = new G4LogicalVolume(motherS, vacuum, "Mother");
+  new G4PVPlacement(nullptr, G4ThreeVector(), motherL, "Mother",
+                    worldL, false, 0);
+
+  // two daughters overlapping by 10 cm along x
+  auto boxS = new G4Box("Box", 10*cm, 10*cm, 10*cm);
+  auto boxL = new G4LogicalVolume(boxS, vacuum, "Box");
+  new G4PVPlacement(nullptr, G4ThreeVector(-5*cm, 0, 0), boxL, "Box",
+                    motherL, false, 0);
+  new G4PVPlacement(nullptr, G4ThreeVector(5*cm, 0, 0), boxL, "Box",
+                    motherL, false, 1);
+  return worldP;
+}
+
+G4bool testOverlapInTree()
+{
+  G4bool ok = true;
+  const G4String reportFile = "testG4GeomTestVolume.report";
+  std::remove(reportFile.c_str());
+
+  G4GeomTestVolume test(BuildGeometry(), 0., 1000, false);
+  test.SetParallel(true);
+  test.SetReportFile(reportFile);
+  try
+  {
+    test.TestOverlapInTree();
+  }
+  catch (const std::exception& e)
+  {
+    G4cerr << "Exception: " << e.what() << G4endl;
+    return Check(false, "parallel check without thread pool");
+  }
+
+  std::map<G4String, G4int> overlaps;
+  std::ifstream in(reportFile);
+  G4String key;
+  std::string signature;
+  G4int n;
+  while (in >> key >> signature >> n) { overlaps[key] = n; }
+  ok &= Check(overlaps.size() == 2, "two mothers in the report");
+  ok &= Check(overlaps["World"] == 0, "no overlap in the world");
+  ok &= Check(overlaps["Mother"] > 0, "overlap found in the mother");
+
+  // unchanged geometry gives the same signatures
+  const std::string first = ReadFile(reportFile);
+  test.TestOverlapInTree();
+  ok &= Check(ReadFile(reportFile) == first, "report reproduced");
+
+  std::remove(reportFile.c_str());
+  return ok;
+}
+
+int main()
+{
+  return testOverlapInTree() ? 0 : 1;
+}
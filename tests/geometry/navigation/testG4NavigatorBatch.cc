@@ -0,0 +1,343 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4NavigatorBatch
+//
+// Checks that G4Navigator::ComputeStepBatch() gives the same results as
+// G4Navigator::ComputeStep() called track by track: step, safety,
+// entering and exiting flags and the volume entered, for blocks of
+// tracks in a mother volume navigated without voxels, in a voxelised
+// mother, in a parameterised mother and in the slices of a replica.
+// Part of the tracks propose steps shorter than the safety.
+
+#include "G4Box.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4NavigationBatch.hh"
+#include "G4NavigationHistory.hh"
+#include "G4Navigator.hh"
+#include "G4Orb.hh"
+#include "G4PVParameterised.hh"
+#include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4RotationMatrix.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Tubs.hh"
+#include "G4VPVParameterisation.hh"
+#include "globals.hh"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::mt19937_64 engine(24680);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  G4ThreeVector RandomDirection()
+  {
+    G4double cost = Uniform(-1., 1.);
+    G4double sint = std::sqrt((1. - cost)*(1. + cost));
+    G4double phi = Uniform(0., twopi);
+    return { sint*std::cos(phi), sint*std::sin(phi), cost };
+  }
+
+  G4bool SameHistory(const G4Navigator* nav1, const G4Navigator* nav2)
+  {
+    G4TouchableHistory* t1 = nav1->CreateTouchableHistory();
+    G4TouchableHistory* t2 = nav2->CreateTouchableHistory();
+    const G4NavigationHistory* h1 = t1->GetHistory();
+    const G4NavigationHistory* h2 = t2->GetHistory();
+    G4bool same = (h1->GetDepth() == h2->GetDepth());
+    for (G4int i=0; same && i<=(G4int)h1->GetDepth(); ++i)
+    {
+      same = (h1->GetVolume(i) == h2->GetVolume(i))
+          && (h1->GetReplicaNo(i) == h2->GetReplicaNo(i));
+    }
+    delete t1;
+    delete t2;
+    return same;
+  }
+
+  // Boxes on a 4x4x4 grid, of sizes varying with the copy number
+  class GridParameterisation : public G4VPVParameterisation
+  {
+    public:
+      void ComputeTransformation(const G4int copyNo,
+                                 G4VPhysicalVolume* physVol) const override
+      {
+        G4int ix = copyNo%4, iy = (copyNo/4)%4, iz = copyNo/16;
+        physVol->SetTranslation(G4ThreeVector((ix - 1.5)*10*cm,
+                                              (iy - 1.5)*10*cm,
+                                              (iz - 1.5)*10*cm));
+      }
+
+      void ComputeDimensions(G4Box& box, const G4int copyNo,
+                             const G4VPhysicalVolume*) const override
+      {
+        G4double half = (2. + copyNo%3)*cm;
+        box.SetXHalfLength(half);
+        box.SetYHalfLength(4*cm);
+        box.SetZHalfLength(5*cm - half/2);
+      }
+  };
+}
+
+// World with four mothers: one with a few daughters and no voxels, one
+// with many voxelised daughters, one holding a parameterised volume and
+// one divided by a replica whose slices hold an orb.
+//
+G4VPhysicalVolume* BuildGeometry()
+{
+  auto vacuum = new G4Material("Vacuum", 1., 1.01*g/mole, 1.e-25*g/cm3,
+                               kStateGas, 2.73*kelvin, 3.e-18*pascal);
+  auto worldS = new G4Box("World", 1*m, 1*m, 1*m);
+  auto worldL = new G4LogicalVolume(worldS, vacuum, "World");
+  auto worldP = new G4PVPlacement(nullptr, G4ThreeVector(), worldL,
+                                  "World", nullptr, false, 0);
+  auto motherS = new G4Box("Mother", 25*cm, 25*cm, 25*cm);
+
+  auto normalL = new G4LogicalVolume(motherS, vacuum, "Normal");
+  normalL->SetOptimisation(false);
+  auto rot = new G4RotationMatrix();
+  rot->rotateX(30*deg);
+  rot->rotateY(20*deg);
+  new G4PVPlacement(rot, G4ThreeVector(10*cm, 5*cm, 0),
+    new G4LogicalVolume(new G4Box("Box", 5*cm, 3*cm, 8*cm), vacuum, "Box"),
+    "Box", normalL, false, 0);
+  new G4PVPlacement(nullptr, G4ThreeVector(-10*cm, -8*cm, 5*cm),
+    new G4LogicalVolume(new G4Orb("Orb", 6*cm), vacuum, "Orb"),
+    "Orb", normalL, false, 0);
+  new G4PVPlacement(nullptr, G4ThreeVector(-8*cm, 10*cm, -10*cm),
+    new G4LogicalVolume(new G4Tubs("Tube", 2*cm, 5*cm, 6*cm, 0, 270*deg),
+                        vacuum, "Tube"), "Tube", normalL, false, 0);
+  new G4PVPlacement(nullptr, G4ThreeVector(0, 0, -20*cm), normalL, "Normal",
+                    worldL, false, 0);
+
+  auto voxelL = new G4LogicalVolume(motherS, vacuum, "Voxelised");
+  auto cellL = new G4LogicalVolume(new G4Box("Cell", 2*cm, 1.5*cm, 1*cm),
+                                   vacuum, "Cell");
+  auto ballL = new G4LogicalVolume(new G4Orb("Ball", 1.5*cm), vacuum, "Ball");
+  G4int copyNo = 0;
+  for (G4int ix=0; ix<5; ++ix)
+  {
+    for (G4int iy=0; iy<5; ++iy)
+    {
+      for (G4int iz=0; iz<4; ++iz)
+      {
+        G4ThreeVector pos((ix - 2)*9*cm, (iy - 2)*9*cm, (iz - 1.5)*11*cm);
+        if ((ix + iy + iz)%2 == 0)
+        {
+          auto cellRot = new G4RotationMatrix();
+          cellRot->rotateZ(copyNo*7*deg);
+          new G4PVPlacement(cellRot, pos, cellL, "Cell", voxelL, false,
+                            copyNo++);
+        }
+        else
+        {
+          new G4PVPlacement(nullptr, pos, ballL, "Ball", voxelL, false,
+                            copyNo++);
+        }
+      }
+    }
+  }
+  new G4PVPlacement(nullptr, G4ThreeVector(0, 0, 40*cm), voxelL, "Voxelised",
+                    worldL, false, 0);
+
+  auto paramL = new G4LogicalVolume(motherS, vacuum, "Parameterised");
+  auto paramBoxL = new G4LogicalVolume(new G4Box("ParamBox", 1, 1, 1),
+                                       vacuum, "ParamBox");
+  new G4PVParameterised("ParamBox", paramBoxL, paramL, kUndefined, 64,
+                        new GridParameterisation);
+  new G4PVPlacement(nullptr, G4ThreeVector(-60*cm, 0, 40*cm), paramL,
+                    "Parameterised", worldL, false, 0);
+
+  auto slicedL = new G4LogicalVolume(motherS, vacuum, "Sliced");
+  auto sliceL = new G4LogicalVolume(new G4Box("Slice", 5*cm, 25*cm, 25*cm),
+                                    vacuum, "Slice");
+  new G4PVPlacement(nullptr, G4ThreeVector(0, 3*cm, 0),
+    new G4LogicalVolume(new G4Orb("SliceOrb", 4*cm), vacuum, "SliceOrb"),
+    "SliceOrb", sliceL, false, 0);
+  new G4PVReplica("Slice", sliceL, slicedL, kXAxis, 5, 10*cm);
+  new G4PVPlacement(nullptr, G4ThreeVector(60*cm, 0, 40*cm), slicedL,
+                    "Sliced", worldL, false, 0);
+  return worldP;
+}
+
+// Compares batched and scalar steps for blocks of tracks around random
+// points of the given mother volume; counts the blocks located in
+// volumes with the given name
+G4bool testBlocks(G4Navigator* nav, G4Navigator* other,
+                  const G4ThreeVector& centre, const char* name,
+                  const char* what)
+{
+  G4int nBlocks = 0, nTracks = 0, nEntering = 0, nExiting = 0;
+  G4int nPhysics = 0, nDifferent = 0;
+  for (G4int block=0; block<400; ++block)
+  {
+    const G4ThreeVector p0 = centre + G4ThreeVector(Uniform(-24*cm, 24*cm),
+      Uniform(-24*cm, 24*cm), Uniform(-24*cm, 24*cm));
+    G4VPhysicalVolume* volume = nav->LocateGlobalPointAndSetup(p0, nullptr,
+                                                               false);
+    if (volume == nullptr || volume->GetName() != name) { continue; }
+
+    // Tracks near p0 located in the same volume, with the same history
+    std::vector<G4ThreeVector> points = { p0 };
+    for (G4int i=0; i<64 && points.size()<16; ++i)
+    {
+      G4ThreeVector p = p0 + G4ThreeVector(Uniform(-3*cm, 3*cm),
+        Uniform(-3*cm, 3*cm), Uniform(-3*cm, 3*cm));
+      other->LocateGlobalPointAndSetup(p, nullptr, false);
+      if (SameHistory(nav, other)) { points.push_back(p); }
+    }
+    const std::size_t n = points.size();
+    std::vector<G4ThreeVector> dirs(n);
+    std::vector<G4double> proposed(n);
+    G4NavigationBatch batch(n);
+    for (std::size_t i=0; i<n; ++i)
+    {
+      dirs[i] = RandomDirection();
+      proposed[i] = (i%4 == 3) ? Uniform(0.1*mm, 2*cm) : kInfinity;
+      batch.SetTrack(i, points[i], dirs[i], proposed[i]);
+    }
+    nav->ComputeStepBatch(batch);
+    ++nBlocks;
+
+    for (std::size_t i=0; i<n; ++i)
+    {
+      const G4ThreeVector& p = points[i];
+      const G4ThreeVector& v = dirs[i];
+      other->LocateGlobalPointAndSetup(p, nullptr, false);
+      G4TouchableHistory* start = other->CreateTouchableHistory();
+      const G4int depth = (G4int)start->GetHistoryDepth();
+      G4double safety;
+      G4double step = other->ComputeStep(p, v, proposed[i], safety);
+      G4bool entering = other->EnteredDaughterVolume();
+      G4bool exiting = other->ExitedMotherVolume();
+      ++nTracks;
+
+      G4bool same = (step == batch.GetStep(i))
+                 && (safety == batch.GetSafety(i))
+                 && (entering == batch.IsEntering(i))
+                 && (exiting == batch.IsExiting(i));
+      if (same && step < proposed[i] && step != kInfinity)
+      {
+        // Volume after the boundary, entered or left
+        other->SetGeometricallyLimitedStep();
+        other->LocateGlobalPointAndSetup(p + step*v, &v, true);
+        G4TouchableHistory* next = other->CreateTouchableHistory();
+        const G4NavigationHistory* h = next->GetHistory();
+        if (entering)
+        {
+          // placements have no replica number, but their copy number
+          ++nEntering;
+          G4VPhysicalVolume* candidate = batch.GetCandidateVolume(i);
+          G4int replicaNo = batch.GetCandidateReplicaNo(i);
+          if (replicaNo < 0 && candidate != nullptr)
+          {
+            replicaNo = candidate->GetCopyNo();
+          }
+          same = (G4int)h->GetDepth() > depth
+              && h->GetVolume(depth + 1) == candidate
+              && h->GetReplicaNo(depth + 1) == replicaNo;
+        }
+        else if (exiting)
+        {
+          ++nExiting;
+          same = (G4int)h->GetDepth() < depth
+              || h->GetVolume(depth) != start->GetVolume()
+              || h->GetReplicaNo(depth) != start->GetReplicaNumber();
+        }
+        delete next;
+      }
+      else if (same)
+      {
+        ++nPhysics;
+      }
+      if (!same && nDifferent++ == 0)
+      {
+        G4long oldPrec = G4cerr.precision(17);
+        G4cerr << what << ": p=" << p << " v=" << v << " proposed="
+               << proposed[i] << " scalar step=" << step << " safety="
+               << safety << " entering=" << entering << " exiting="
+               << exiting << ", batch step=" << batch.GetStep(i)
+               << " safety=" << batch.GetSafety(i) << " entering="
+               << batch.IsEntering(i) << " exiting=" << batch.IsExiting(i)
+               << G4endl;
+        G4cerr.precision(oldPrec);
+      }
+      delete start;
+    }
+  }
+  G4bool ok = Check(nBlocks > 20 && nTracks > 10*nBlocks
+                    && nEntering > 0 && nExiting > 0 && nPhysics > 0, what);
+  ok &= Check(nDifferent == 0, what);
+  if (!ok)
+  {
+    G4cerr << what << ": " << nBlocks << " blocks, " << nTracks
+           << " tracks, " << nEntering << " entering, " << nExiting
+           << " exiting, " << nPhysics << " physics limited, "
+           << nDifferent << " different" << G4endl;
+  }
+  return ok;
+}
+
+int main()
+{
+  G4VPhysicalVolume* world = BuildGeometry();
+  G4GeometryManager::GetInstance()->CloseGeometry(true);
+
+  auto nav = new G4Navigator();
+  nav->SetWorldVolume(world);
+  auto other = new G4Navigator();
+  other->SetWorldVolume(world);
+
+  G4bool ok = testBlocks(nav, other, G4ThreeVector(0, 0, -20*cm), "Normal",
+                         "mother without voxels");
+  ok &= testBlocks(nav, other, G4ThreeVector(0, 0, 40*cm), "Voxelised",
+                   "voxelised mother");
+  ok &= testBlocks(nav, other, G4ThreeVector(-60*cm, 0, 40*cm),
+                   "Parameterised", "parameterised mother");
+  ok &= testBlocks(nav, other, G4ThreeVector(60*cm, 0, 40*cm), "Slice",
+                   "replica slices");
+
+  delete other;
+  delete nav;
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  return ok ? 0 : 1;
+}
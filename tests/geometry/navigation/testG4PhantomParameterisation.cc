@@ -0,0 +1,145 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4PhantomParameterisation
+//
+// Checks that compaction of material indices and homogeneous regions
+// keep the material of every voxel of G4PhantomParameterisation, and
+// that both are rejected for G4PartialPhantomParameterisation, whose
+// indices refer to the filled voxels only.
+
+#include "G4PhantomParameterisation.hh"
+#include "G4PartialPhantomParameterisation.hh"
+#include "G4Box.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::vector<G4Material*> BuildMaterials()
+  {
+    std::vector<G4Material*> mates;
+    for (G4int i=0; i<3; ++i)
+    {
+      mates.push_back(new G4Material("Mate" + std::to_string(i), 1.,
+                                     1.01*g/mole, (i+1)*g/cm3));
+    }
+    return mates;
+  }
+}
+
+G4bool testPhantom(std::vector<G4Material*>& mates)
+{
+  G4bool ok = true;
+
+  // 4x4x4 voxels: the first 2x2x2 block is homogeneous, the others
+  // alternate between two materials
+  const std::size_t n = 4;
+  std::vector<std::size_t> indices(n*n*n);
+  for (std::size_t iz=0; iz<n; ++iz)
+    for (std::size_t iy=0; iy<n; ++iy)
+      for (std::size_t ix=0; ix<n; ++ix)
+      {
+        G4bool block = (ix < 2 && iy < 2 && iz < 2);
+        indices[ix+n*(iy+n*iz)] = block ? 0 : 1 + (ix+iy+iz)%2;
+      }
+
+  G4PhantomParameterisation param;
+  param.SetVoxelDimensions(1*mm, 1*mm, 1*mm);
+  param.SetNoVoxels(n, n, n);
+  param.SetMaterials(mates);
+  param.SetMaterialIndices(indices.data());
+  G4Box container("Container", 4*mm, 4*mm, 4*mm);
+  param.BuildContainerSolid(&container);
+
+  param.CompactMaterialIndices();
+  ok &= Check(param.HasCompactMaterialIndices(), "indices compacted");
+  ok &= Check(param.GetMaterialIndices() == nullptr, "user array released");
+  for (std::size_t i=0; i<indices.size(); ++i)
+  {
+    if (param.GetMaterial(i) != mates[indices[i]])
+    {
+      ok &= Check(false, "material kept by compaction");
+      break;
+    }
+  }
+
+  param.BuildHomogeneousRegions();
+  ok &= Check(param.HasHomogeneousRegions(), "regions built");
+  G4ThreeVector bmin, bmax;
+  ok &= Check(param.GetHomogeneousBlock(0, bmin, bmax)
+              && bmin == G4ThreeVector(-4*mm, -4*mm, -4*mm)
+              && bmax == G4ThreeVector(0., 0., 0.), "homogeneous block");
+  ok &= Check(!param.GetHomogeneousBlock(G4int(n*n*n-1), bmin, bmax),
+              "heterogeneous voxel");
+  return ok;
+}
+
+G4bool testPartialPhantom(std::vector<G4Material*>& mates)
+{
+  G4bool ok = true;
+
+  // indices of the filled voxels only
+  std::vector<std::size_t> indices = { 0, 1, 2, 1, 0 };
+  G4PartialPhantomParameterisation param;
+  param.SetVoxelDimensions(1*mm, 1*mm, 1*mm);
+  param.SetNoVoxels(indices.size(), 1, 1);
+  param.SetMaterials(mates);
+  param.SetMaterialIndices(indices.data());
+
+  // both are rejected with a warning, indices are kept
+  param.CompactMaterialIndices();
+  param.BuildHomogeneousRegions();
+  ok &= Check(!param.HasCompactMaterialIndices(), "partial not compacted");
+  ok &= Check(!param.HasHomogeneousRegions(), "partial without regions");
+  ok &= Check(param.GetMaterialIndices() == indices.data(),
+              "partial user array kept");
+  for (std::size_t i=0; i<indices.size(); ++i)
+  {
+    if (param.GetMaterialIndex(i) != indices[i])
+    {
+      ok &= Check(false, "partial material index kept");
+      break;
+    }
+  }
+  return ok;
+}
+
+int main()
+{
+  std::vector<G4Material*> mates = BuildMaterials();
+  G4bool ok = testPhantom(mates);
+  ok &= testPartialPhantom(mates);
+  return ok ? 0 : 1;
+}
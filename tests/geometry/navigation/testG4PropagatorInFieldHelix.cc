@@ -0,0 +1,214 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4PropagatorInFieldHelix
+//
+// Checks the exact helix of G4PropagatorInField for uniform magnetic
+// fields against the Runge-Kutta integration and against the analytic
+// helix: end points and momenta of steps of charged tracks of random
+// momenta and directions, for several step lengths and maximum chord
+// distances. The helix must agree with the analytic solution to rounding
+// and the integration within its accuracy parameters.
+
+#include "G4Box.hh"
+#include "G4ChargeState.hh"
+#include "G4ChordFinder.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4FieldManager.hh"
+#include "G4FieldTrack.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4Navigator.hh"
+#include "G4PVPlacement.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PropagatorInField.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
+#include "G4UniformMagField.hh"
+#include "globals.hh"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::mt19937_64 engine(97531);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  G4ThreeVector RandomDirection()
+  {
+    G4double cost = Uniform(-1., 1.);
+    G4double sint = std::sqrt((1. - cost)*(1. + cost));
+    G4double phi = Uniform(0., twopi);
+    return { sint*std::cos(phi), sint*std::sin(phi), cost };
+  }
+
+  // Analytic helix after a path length s: the direction rotates about
+  // the field by the angle -k*s, with curvature k = q*c*|B|/p
+  void Helix(const G4ThreeVector& x0, const G4ThreeVector& u0,
+             G4double charge, G4double momentum, const G4ThreeVector& field,
+             G4double s, G4ThreeVector& x, G4ThreeVector& u)
+  {
+    const G4ThreeVector b = field.unit();
+    const G4double k = charge*c_light*field.mag()/momentum;
+    const G4ThreeVector uPar = u0.dot(b)*b;
+    const G4ThreeVector uPerp = u0 - uPar;
+    const G4ThreeVector w = b.cross(uPerp);
+    const G4double phi = -k*s;
+    u = uPar + std::cos(phi)*uPerp + std::sin(phi)*w;
+    x = x0 + s*uPar - (std::sin(phi)/k)*uPerp + ((std::cos(phi) - 1.)/k)*w;
+  }
+
+  struct Deviation
+  {
+    G4double position = 0.;
+    G4double direction = 0.;
+    G4double momentum = 0.;  // Relative
+  };
+
+  // Propagates one step with the helix or the integration and returns
+  // the deviations from the analytic end point, direction and momentum
+  Deviation Propagate(G4PropagatorInField* propagator, G4Navigator* navigator,
+                      const G4ThreeVector& field, G4bool useHelix,
+                      const G4ThreeVector& x0, const G4ThreeVector& u0,
+                      G4double charge, G4double kinE, G4double mass,
+                      G4double length, G4bool& ok)
+  {
+    propagator->SetUseHelixForUniformField(useHelix);
+    propagator->ClearPropagatorState();
+    navigator->LocateGlobalPointAndSetup(x0, &u0, false, false);
+
+    const G4double momentum = std::sqrt(kinE*(kinE + 2*mass));
+    // The field manager, hence the chord finder, is selected by
+    // ComputeStep(); the equation is shared by the helix and the driver
+    propagator->GetCurrentEquationOfMotion()->SetChargeMomentumMass(
+      G4ChargeState(charge, 0., 0.5), momentum, mass);
+    G4FieldTrack track(x0, 0., u0, kinE, mass, charge, G4ThreeVector());
+
+    const G4long nHelix = propagator->GetNumberOfHelixSteps();
+    const G4long nIntegrated = propagator->GetNumberOfIntegratedSteps();
+    G4double safety = 0.;
+    G4double step = propagator->ComputeStep(track, length, safety);
+    ok &= Check(step == length, "step not limited in the empty world");
+    ok &= Check(useHelix
+      ? propagator->GetNumberOfHelixSteps() == nHelix + 1
+        && propagator->GetNumberOfIntegratedSteps() == nIntegrated
+      : propagator->GetNumberOfIntegratedSteps() == nIntegrated + 1
+        && propagator->GetNumberOfHelixSteps() == nHelix,
+      "chord finder selected for the step");
+
+    G4ThreeVector x, u;
+    Helix(x0, u0, charge, momentum, field, length, x, u);
+    Deviation d;
+    d.position = (propagator->EndPosition() - x).mag();
+    d.direction = std::max((propagator->EndMomentumDir() - u).mag(),
+                           (track.GetMomentum().unit() - u).mag());
+    d.momentum = std::abs(track.GetMomentum().mag() - momentum)/momentum;
+    return d;
+  }
+}
+
+int main()
+{
+  auto vacuum = new G4Material("Vacuum", 1., 1.01*g/mole,
+                               universe_mean_density, kStateGas,
+                               0.1*kelvin, 1.e-19*pascal);
+  auto worldL = new G4LogicalVolume(new G4Box("World", 20*m, 20*m, 20*m),
+                                    vacuum, "World");
+  auto world = new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+
+  G4TransportationManager* transportManager =
+    G4TransportationManager::GetTransportationManager();
+  G4Navigator* navigator = transportManager->GetNavigatorForTracking();
+  navigator->SetWorldVolume(world);
+
+  const G4ThreeVector field(0.3*tesla, -0.2*tesla, 1.5*tesla);
+  auto magField = new G4UniformMagField(field);
+  G4FieldManager* fieldManager = transportManager->GetFieldManager();
+  fieldManager->SetDetectorField(magField);
+  fieldManager->CreateChordFinder(magField);
+  const G4double deltaOneStep = fieldManager->GetDeltaOneStep();
+  G4PropagatorInField* propagator = transportManager->GetPropagatorInField();
+
+  G4bool ok = true;
+  G4double maxHelix = 0., maxHelixDir = 0.;
+  G4double maxHelixMom = 0.;
+  G4double maxRatio = 0., maxRKDir = 0., maxRKMom = 0.;
+  const G4double chords[] = { 0.05*mm, 0.25*mm, 1*mm, 5*mm };
+  const G4double lengths[] = { 1*cm, 10*cm, 1*m };
+  for (const G4double chord : chords)
+  {
+    fieldManager->GetChordFinder()->SetDeltaChord(chord);
+    for (G4int i = 0; i < 50; ++i)
+    {
+      const G4bool electron = (i%2 == 0);
+      const G4double mass = electron ? electron_mass_c2 : proton_mass_c2;
+      const G4double charge = electron ? -1. : 1.;
+      const G4double kinE = std::exp(Uniform(std::log(50*MeV),
+                                             std::log(5*GeV)));
+      const G4ThreeVector x0(Uniform(-1*m, 1*m), Uniform(-1*m, 1*m),
+                             Uniform(-1*m, 1*m));
+      const G4ThreeVector u0 = RandomDirection();
+      for (const G4double length : lengths)
+      {
+        Deviation helix = Propagate(propagator, navigator, field, true,
+                                    x0, u0, charge, kinE, mass, length, ok);
+        Deviation rk = Propagate(propagator, navigator, field, false,
+                                 x0, u0, charge, kinE, mass, length, ok);
+        maxHelix = std::max(maxHelix, helix.position/length);
+        maxHelixDir = std::max(maxHelixDir, helix.direction);
+        maxHelixMom = std::max(maxHelixMom, helix.momentum);
+        // The integration error is bounded by the relative accuracy
+        // epsilon = deltaOneStep/length, within [epsilonMin, epsilonMax]
+        const G4double epsilon = std::min(std::max(deltaOneStep/length,
+          fieldManager->GetMinimumEpsilonStep()),
+          fieldManager->GetMaximumEpsilonStep());
+        maxRatio = std::max(maxRatio, rk.position/(epsilon*length));
+        maxRKDir = std::max(maxRKDir, rk.direction/epsilon);
+        maxRKMom = std::max(maxRKMom, rk.momentum/epsilon);
+      }
+    }
+  }
+  G4cout << "Maximum deviations from the analytic helix: exact helix "
+         << maxHelix << " of the length, " << maxHelixDir
+         << " in direction, " << maxHelixMom << " in momentum; integration "
+         << maxRatio << ", " << maxRKDir << " and " << maxRKMom
+         << " of the accuracy" << G4endl;
+  ok &= Check(maxHelix < 1.e-9 && maxHelixDir < 1.e-9 && maxHelixMom < 1.e-12,
+              "exact helix equals the analytic helix");
+  ok &= Check(maxRatio < 10. && maxRKDir < 10. && maxRKMom < 1.,
+              "integration agrees with the helix within its accuracy");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4SafetyHelper
+//
+// Checks the safety cache of G4SafetyHelper: disabled by default, so the
+// safety of the navigator is returned; when enabled, the reused safety
+// never exceeds the navigator safety and the touchable is checked.
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4Navigator.hh"
+#include "G4PVPlacement.hh"
+#include "G4SafetyHelper.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
+#include "globals.hh"
+
+#include <cmath>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  G4bool Near(G4double a, G4double b)
+  {
+    return std::abs(a - b) < 1.e-9*mm;
+  }
+}
+
+G4VPhysicalVolume* BuildGeometry()
+{
+  auto vacuum = new G4Material("Vacuum", 1., 1.01*g/mole, 1.e-25*g/cm3,
+                               kStateGas, 2.73*kelvin, 3.e-18*pascal);
+  auto worldS = new G4Box("World", 1*m, 1*m, 1*m);
+  auto worldL = new G4LogicalVolume(worldS, vacuum, "World");
+  auto worldP = new G4PVPlacement(nullptr, G4ThreeVector(), worldL,
+                                  "World", nullptr, false, 0);
+  auto boxS = new G4Box("Box", 10*cm, 10*cm, 10*cm);
+  auto boxL = new G4LogicalVolume(boxS, vacuum, "Box");
+  new G4PVPlacement(nullptr, G4ThreeVector(), boxL, "Box", worldL, false, 0);
+  return worldP;
+}
+
+G4bool testSafetyHelper()
+{
+  G4bool ok = true;
+  G4TransportationManager* tm =
+    G4TransportationManager::GetTransportationManager();
+  G4Navigator* nav = tm->GetNavigatorForTracking();
+  nav->SetWorldVolume(BuildGeometry());
+
+  G4SafetyHelper* helper = tm->GetSafetyHelper();
+  helper->InitialiseHelper();
+
+  const G4ThreeVector p0(50*cm, 0, 0);  // safety 40 cm to the box
+  const G4ThreeVector p1(51*cm, 0, 0);  // safety 41 cm to the box
+  const G4ThreeVector p2(52*cm, 0, 0);  // safety 42 cm to the box
+  nav->LocateGlobalPointAndSetup(p0);
+
+  // cache is disabled by default: the navigator safety is returned
+  ok &= Check(!helper->IsSafetyCacheEnabled(), "cache disabled by default");
+  ok &= Check(Near(helper->ComputeSafety(p0), 40*cm), "safety at p0");
+  ok &= Check(Near(helper->ComputeSafety(p1, 1*cm), 41*cm),
+              "safety at p1 without cache");
+  ok &= Check(helper->GetSafetyCacheHits() == 0
+              && helper->GetSafetyCacheMisses() == 0,
+              "no counting without cache");
+
+  // enabled: a point inside the last sphere reuses the remaining safety
+  helper->EnableSafetyCache(true);
+  ok &= Check(Near(helper->ComputeSafety(p0), 40*cm), "safety at p0");
+  G4double safety = helper->ComputeSafety(p2, 1*cm);
+  ok &= Check(Near(safety, 38*cm), "remaining safety at p2");
+  ok &= Check(safety <= nav->ComputeSafety(p2), "reused safety is smaller");
+  ok &= Check(helper->GetSafetyCacheHits() == 1, "one hit");
+
+  // remaining safety below the radius of interest: navigator is called
+  ok &= Check(Near(helper->ComputeSafety(p1, 39.5*cm), 41*cm),
+              "safety at p1 above the remaining safety");
+  ok &= Check(helper->GetSafetyCacheHits() == 1
+              && helper->GetSafetyCacheMisses() == 1, "miss counted");
+
+  // sphere computed in another touchable is not reused
+  const G4ThreeVector q(5*cm, 0, 0);    // inside the box, safety 5 cm
+  helper->SetCurrentSafety(1*m, p0);
+  nav->LocateGlobalPointAndSetup(q);
+  ok &= Check(Near(helper->ComputeSafety(q, 1*cm), 5*cm),
+              "safety in another touchable");
+  ok &= Check(helper->GetSafetyCacheHits() == 1
+              && helper->GetSafetyCacheMisses() == 2,
+              "no hit in other touchable");
+
+  helper->ResetSafetyCacheStatistics();
+  ok &= Check(helper->GetSafetyCacheHits() == 0
+              && helper->GetSafetyCacheMisses() == 0, "counters reset");
+  return ok;
+}
+
+int main()
+{
+  return testSafetyHelper() ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// benchG4BoundingVolumeHierarchy
+//
+// Set-up time and time per call of Inside(), DistanceToIn/Out(p,v) and
+// DistanceToIn/Out(p) of a G4TessellatedSolid with facets crowded towards
+// one pole and of a G4MultiUnion with a dense cluster of small boxes among
+// a few orbs, with voxels and with the bounding volume hierarchy.
+//
+// Usage: benchG4BoundingVolumeHierarchy [nPoints]
+
+#include "G4Box.hh"
+#include "G4MultiUnion.hh"
+#include "G4Orb.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4TriangularFacet.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::mt19937_64 engine(97531);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  G4double Seconds(Clock::time_point start)
+  {
+    return std::chrono::duration<G4double>(Clock::now() - start).count();
+  }
+
+  G4ThreeVector RandomDirection()
+  {
+    G4double cost = Uniform(-1., 1.);
+    G4double sint = std::sqrt((1. - cost)*(1. + cost));
+    G4double phi = Uniform(0., twopi);
+    return { sint*std::cos(phi), sint*std::sin(phi), cost };
+  }
+
+  G4ThreeVector Vertex(G4int i, G4int j, G4int nTheta, G4int nPhi)
+  {
+    G4double u = G4double(i)/nTheta;
+    G4double theta = pi*u*u*u;
+    G4double phi = twopi*(j%nPhi)/nPhi;
+    G4double sinTheta = std::sin(theta);
+    G4double r = 100*mm*(1. + 0.2*std::sin(3*phi)*sinTheta*sinTheta);
+    return { r*sinTheta*std::cos(phi), r*sinTheta*std::sin(phi),
+             r*std::cos(theta) };
+  }
+
+  G4VSolid* MakeTessellated(G4bool useBVH)
+  {
+    const G4int nTheta = 200, nPhi = 200;
+    auto solid = new G4TessellatedSolid(useBVH ? "BVH" : "Voxels");
+    solid->SetUseBVH(useBVH);
+    for (G4int i = 0; i < nTheta; ++i)
+    {
+      for (G4int j = 0; j < nPhi; ++j)
+      {
+        G4ThreeVector v00 = Vertex(i, j, nTheta, nPhi);
+        G4ThreeVector v10 = Vertex(i + 1, j, nTheta, nPhi);
+        G4ThreeVector v11 = Vertex(i + 1, j + 1, nTheta, nPhi);
+        G4ThreeVector v01 = Vertex(i, j + 1, nTheta, nPhi);
+        if (i < nTheta - 1)
+        {
+          solid->AddFacet(new G4TriangularFacet(v00, v10, v11, ABSOLUTE));
+        }
+        if (i > 0)
+        {
+          solid->AddFacet(new G4TriangularFacet(v00, v11, v01, ABSOLUTE));
+        }
+      }
+    }
+    solid->SetSolidClosed(true);
+    return solid;
+  }
+
+  G4VSolid* MakeMultiUnion(G4bool useBVH)
+  {
+    std::mt19937_64 placement(2468);
+    auto uniform = [&](G4double a, G4double b)
+    {
+      return std::uniform_real_distribution<G4double>(a, b)(placement);
+    };
+    auto solid = new G4MultiUnion(useBVH ? "BVH" : "Voxels");
+    solid->SetUseBVH(useBVH);
+    auto box = new G4Box("Box", 1*mm, 2*mm, 1.5*mm);
+    auto orb = new G4Orb("Orb", 15*mm);
+    for (G4int i = 0; i < 120; ++i)
+    {
+      G4RotationMatrix rot;
+      rot.rotateX(uniform(0., pi));
+      rot.rotateZ(uniform(0., twopi));
+      G4ThreeVector pos(uniform(20*mm, 40*mm), uniform(20*mm, 40*mm),
+                        uniform(20*mm, 40*mm));
+      solid->AddNode(*box, G4Transform3D(rot, pos));
+    }
+    for (G4int i = 0; i < 8; ++i)
+    {
+      G4ThreeVector pos(uniform(-60*mm, 60*mm), uniform(-60*mm, 60*mm),
+                        uniform(-60*mm, 60*mm));
+      solid->AddNode(*orb, G4Transform3D(G4RotationMatrix(), pos));
+    }
+    solid->Voxelize();
+    return solid;
+  }
+
+  // Nanoseconds per call of query over the points
+  G4double Time(const std::vector<G4ThreeVector>& points,
+                const std::vector<G4ThreeVector>& dirs,
+                const std::function<G4double(const G4ThreeVector&,
+                                             const G4ThreeVector&)>& query,
+                G4double& sum)
+  {
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      sum += query(points[i], dirs[i]);
+    }
+    return 1.e9*Seconds(start)/points.size();
+  }
+
+  void Bench(const char* title,
+             const std::function<G4VSolid*(G4bool)>& make,
+             const G4ThreeVector& denseCentre, G4double denseSize,
+             std::size_t nPoints)
+  {
+    G4cout << title << G4endl;
+    G4VSolid* solids[2];
+    for (G4int k = 0; k < 2; ++k)
+    {
+      auto start = Clock::now();
+      solids[k] = make(k == 1);
+      G4cout << "  " << solids[k]->GetName() << " set-up: "
+             << 1.e3*Seconds(start) << " ms" << G4endl;
+    }
+
+    G4ThreeVector pMin, pMax;
+    solids[0]->BoundingLimits(pMin, pMax);
+    G4ThreeVector centre = 0.5*(pMin + pMax), half = 0.6*(pMax - pMin);
+    std::vector<G4ThreeVector> all, dirs, in, inDirs, out, outDirs;
+    for (std::size_t i = 0; i < nPoints; ++i)
+    {
+      G4ThreeVector p = (i%2 == 0)
+        ? centre + G4ThreeVector(Uniform(-1., 1.)*half.x(),
+                                 Uniform(-1., 1.)*half.y(),
+                                 Uniform(-1., 1.)*half.z())
+        : denseCentre + denseSize*G4ThreeVector(Uniform(-1., 1.),
+                                                Uniform(-1., 1.),
+                                                Uniform(-1., 1.));
+      G4ThreeVector v = RandomDirection();
+      all.push_back(p);
+      dirs.push_back(v);
+      EInside inside = solids[0]->Inside(p);
+      if (inside == kInside) { in.push_back(p); inDirs.push_back(v); }
+      if (inside == kOutside) { out.push_back(p); outDirs.push_back(v); }
+    }
+
+    G4double sum[2] = { 0., 0. };
+    for (G4int k = 0; k < 2; ++k)
+    {
+      const G4VSolid* s = solids[k];
+      G4double tInside = Time(all, dirs,
+        [s](const G4ThreeVector& p, const G4ThreeVector&)
+        { return G4double(s->Inside(p)); }, sum[k]);
+      G4double tToIn = Time(out, outDirs,
+        [s](const G4ThreeVector& p, const G4ThreeVector& v)
+        { G4double d = s->DistanceToIn(p, v); return d < kInfinity ? d : 0.; },
+        sum[k]);
+      G4double tToOut = Time(in, inDirs,
+        [s](const G4ThreeVector& p, const G4ThreeVector& v)
+        { return s->DistanceToOut(p, v); }, sum[k]);
+      G4double tSafeIn = Time(out, outDirs,
+        [s](const G4ThreeVector& p, const G4ThreeVector&)
+        { return s->DistanceToIn(p); }, sum[k]);
+      G4double tSafeOut = Time(in, inDirs,
+        [s](const G4ThreeVector& p, const G4ThreeVector&)
+        { return s->DistanceToOut(p); }, sum[k]);
+      G4cout << "  " << s->GetName() << " ns/call: Inside " << tInside
+             << ", DistanceToIn(p,v) " << tToIn
+             << ", DistanceToOut(p,v) " << tToOut
+             << ", DistanceToIn(p) " << tSafeIn
+             << ", DistanceToOut(p) " << tSafeOut << G4endl;
+    }
+    G4cout << "  " << in.size() << " points inside, " << out.size()
+           << " outside, checksums " << sum[0] << " " << sum[1] << G4endl;
+    delete solids[0];
+    delete solids[1];
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t nPoints = (argc > 1) ? std::atol(argv[1]) : 200000;
+  Bench("G4TessellatedSolid, 79600 facets crowded at the north pole",
+        MakeTessellated, G4ThreeVector(0, 0, 98*mm), 5*mm, nPoints);
+  Bench("G4MultiUnion, 120 boxes in a cluster among 8 orbs",
+        MakeMultiUnion, G4ThreeVector(30*mm, 30*mm, 30*mm), 12*mm, nPoints);
+  return 0;
+}
@@ -0,0 +1,295 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4BoundingVolumeHierarchy
+//
+// Checks that G4MultiUnion and G4TessellatedSolid give the same results
+// with the bounding volume hierarchy as with voxels: Inside(), the
+// distances along random directions from points outside and inside, and
+// the safeties. The accurate safeties must be equal; the fast estimates
+// from the bounding boxes must not exceed them.
+
+#include "G4Box.hh"
+#include "G4MultiUnion.hh"
+#include "G4Orb.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4TriangularFacet.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::mt19937_64 engine(1357);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  G4ThreeVector RandomDirection()
+  {
+    G4double cost = Uniform(-1., 1.);
+    G4double sint = std::sqrt((1. - cost)*(1. + cost));
+    G4double phi = Uniform(0., twopi);
+    return { sint*std::cos(phi), sint*std::sin(phi), cost };
+  }
+
+  void Report(const G4VSolid* solid, const char* method,
+              const G4ThreeVector& p, const G4ThreeVector& v,
+              G4double voxels, G4double bvh)
+  {
+    G4long oldPrec = G4cerr.precision(17);
+    G4cerr << solid->GetName() << "::" << method << " p=" << p
+           << " v=" << v << " voxels=" << voxels << " bvh=" << bvh << G4endl;
+    G4cerr.precision(oldPrec);
+  }
+
+  // Points in and around the bounding box, a fraction of them in the
+  // given dense region
+  std::vector<G4ThreeVector> Sample(const G4VSolid* solid,
+                                    const G4ThreeVector& denseCentre,
+                                    G4double denseSize)
+  {
+    G4ThreeVector pMin, pMax;
+    solid->BoundingLimits(pMin, pMax);
+    G4ThreeVector centre = 0.5*(pMin + pMax), half = 0.6*(pMax - pMin);
+    std::vector<G4ThreeVector> points;
+    for (G4int i = 0; i < 20000; ++i)
+    {
+      if (i%2 == 0)
+      {
+        points.push_back(centre + G4ThreeVector(Uniform(-1., 1.)*half.x(),
+                                                Uniform(-1., 1.)*half.y(),
+                                                Uniform(-1., 1.)*half.z()));
+      }
+      else
+      {
+        points.push_back(denseCentre + denseSize*G4ThreeVector(
+          Uniform(-1., 1.), Uniform(-1., 1.), Uniform(-1., 1.)));
+      }
+    }
+    for (G4int i = 0; i < 5000; ++i)
+    {
+      points.push_back(solid->GetPointOnSurface());
+    }
+    return points;
+  }
+
+  // Compares the solid using voxels with the one using the hierarchy;
+  // safeties of the reference are computed with AccurateSafetyToIn
+  template <typename AccurateSafetyToIn>
+  G4bool Compare(const G4VSolid* voxels, const G4VSolid* bvh,
+                 const std::vector<G4ThreeVector>& points,
+                 AccurateSafetyToIn accurateSafetyToIn)
+  {
+    G4int nDiff[5] = { 0, 0, 0, 0, 0 };
+    G4int nIn = 0, nOut = 0, nHits = 0;
+    for (const auto& p : points)
+    {
+      const G4ThreeVector v = RandomDirection();
+      EInside in1 = voxels->Inside(p);
+      EInside in2 = bvh->Inside(p);
+      if (in1 != in2)
+      {
+        if (nDiff[0]++ == 0) { Report(voxels, "Inside", p, v, in1, in2); }
+        continue;
+      }
+      if (in1 != kInside)
+      {
+        ++nOut;
+        G4double d1 = voxels->DistanceToIn(p, v);
+        G4double d2 = bvh->DistanceToIn(p, v);
+        if (d1 < kInfinity) { ++nHits; }
+        if (d1 != d2 && nDiff[1]++ == 0)
+        {
+          Report(voxels, "DistanceToIn(p,v)", p, v, d1, d2);
+        }
+        G4double s1 = accurateSafetyToIn(voxels, p);
+        G4double s2 = accurateSafetyToIn(bvh, p);
+        if (s1 != s2 && nDiff[2]++ == 0)
+        {
+          Report(voxels, "accurate DistanceToIn(p)", p, v, s1, s2);
+        }
+        G4double f1 = voxels->DistanceToIn(p);
+        G4double f2 = bvh->DistanceToIn(p);
+        if ((f1 < 0. || f1 > s1 || f2 < 0. || f2 > s2) && nDiff[2]++ == 0)
+        {
+          Report(voxels, "DistanceToIn(p) estimate", p, v, f1, f2);
+        }
+      }
+      if (in1 != kOutside)
+      {
+        ++nIn;
+        G4double d1 = voxels->DistanceToOut(p, v);
+        G4double d2 = bvh->DistanceToOut(p, v);
+        if (d1 != d2 && nDiff[3]++ == 0)
+        {
+          Report(voxels, "DistanceToOut(p,v)", p, v, d1, d2);
+        }
+        G4double s1 = voxels->DistanceToOut(p);
+        G4double s2 = bvh->DistanceToOut(p);
+        if (s1 != s2 && nDiff[4]++ == 0)
+        {
+          Report(voxels, "DistanceToOut(p)", p, v, s1, s2);
+        }
+      }
+    }
+    G4bool ok = Check(nIn > 1000 && nOut > 1000 && nHits > 1000,
+                      "points sample the solid");
+    ok &= Check(nDiff[0] == 0, "same Inside()");
+    ok &= Check(nDiff[1] == 0, "same DistanceToIn(p,v)");
+    ok &= Check(nDiff[2] == 0, "same DistanceToIn(p)");
+    ok &= Check(nDiff[3] == 0, "same DistanceToOut(p,v)");
+    ok &= Check(nDiff[4] == 0, "same DistanceToOut(p)");
+    return ok;
+  }
+
+  // Vertex of a bumped sphere, with rings crowded towards the north pole
+  G4ThreeVector Vertex(G4int i, G4int j, G4int nTheta, G4int nPhi)
+  {
+    G4double u = G4double(i)/nTheta;
+    G4double theta = pi*u*u;
+    G4double phi = twopi*(j%nPhi)/nPhi;  // closes the seam exactly
+    G4double sinTheta = std::sin(theta);
+    G4double r = 100*mm*(1. + 0.2*std::sin(3*phi)*sinTheta*sinTheta);
+    return { r*sinTheta*std::cos(phi), r*sinTheta*std::sin(phi),
+             r*std::cos(theta) };
+  }
+
+  G4TessellatedSolid* MakeTessellated(const G4String& name, G4bool useBVH)
+  {
+    const G4int nTheta = 60, nPhi = 90;
+    auto solid = new G4TessellatedSolid(name);
+    solid->SetUseBVH(useBVH);
+    for (G4int i = 0; i < nTheta; ++i)
+    {
+      for (G4int j = 0; j < nPhi; ++j)
+      {
+        G4ThreeVector v00 = Vertex(i, j, nTheta, nPhi);
+        G4ThreeVector v10 = Vertex(i + 1, j, nTheta, nPhi);
+        G4ThreeVector v11 = Vertex(i + 1, j + 1, nTheta, nPhi);
+        G4ThreeVector v01 = Vertex(i, j + 1, nTheta, nPhi);
+        if (i < nTheta - 1)
+        {
+          solid->AddFacet(new G4TriangularFacet(v00, v10, v11, ABSOLUTE));
+        }
+        if (i > 0)
+        {
+          solid->AddFacet(new G4TriangularFacet(v00, v11, v01, ABSOLUTE));
+        }
+      }
+    }
+    solid->SetSolidClosed(true);
+    return solid;
+  }
+
+  // Many small boxes in a cluster, a few large orbs around it
+  G4MultiUnion* MakeMultiUnion(const G4String& name, G4bool useBVH)
+  {
+    std::mt19937_64 placement(2468);
+    auto uniform = [&](G4double a, G4double b)
+    {
+      return std::uniform_real_distribution<G4double>(a, b)(placement);
+    };
+    auto solid = new G4MultiUnion(name);
+    solid->SetUseBVH(useBVH);
+    auto box = new G4Box("Box", 1*mm, 2*mm, 1.5*mm);
+    auto orb = new G4Orb("Orb", 15*mm);
+    for (G4int i = 0; i < 80; ++i)
+    {
+      G4RotationMatrix rot;
+      rot.rotateX(uniform(0., pi));
+      rot.rotateZ(uniform(0., twopi));
+      G4ThreeVector pos(uniform(20*mm, 40*mm), uniform(20*mm, 40*mm),
+                        uniform(20*mm, 40*mm));
+      solid->AddNode(*box, G4Transform3D(rot, pos));
+    }
+    for (G4int i = 0; i < 8; ++i)
+    {
+      G4ThreeVector pos(uniform(-60*mm, 60*mm), uniform(-60*mm, 60*mm),
+                        uniform(-60*mm, 60*mm));
+      solid->AddNode(*orb, G4Transform3D(G4RotationMatrix(), pos));
+    }
+    solid->Voxelize();
+    return solid;
+  }
+}
+
+G4bool testTessellatedSolid()
+{
+  G4TessellatedSolid* voxels = MakeTessellated("TessellatedVoxels", false);
+  G4TessellatedSolid* bvh = MakeTessellated("TessellatedBVH", true);
+  G4bool ok = Check(!voxels->GetUseBVH() && bvh->GetUseBVH(),
+                    "G4TessellatedSolid::SetUseBVH()");
+  auto points = Sample(voxels, G4ThreeVector(0, 0, 95*mm), 20*mm);
+  ok &= Compare(voxels, bvh, points,
+                [](const G4VSolid* solid, const G4ThreeVector& p)
+  {
+    return static_cast<const G4TessellatedSolid*>(solid)
+      ->SafetyFromOutside(p, true);
+  });
+  delete bvh;
+  delete voxels;
+  return ok;
+}
+
+G4bool testMultiUnion()
+{
+  G4MultiUnion* voxels = MakeMultiUnion("MultiUnionVoxels", false);
+  G4MultiUnion* bvh = MakeMultiUnion("MultiUnionBVH", true);
+  G4bool ok = Check(!voxels->GetUseBVH() && bvh->GetUseBVH(),
+                    "G4MultiUnion::SetUseBVH()");
+  auto points = Sample(voxels, G4ThreeVector(30*mm, 30*mm, 30*mm), 12*mm);
+  ok &= Compare(voxels, bvh, points,
+                [](const G4VSolid* solid, const G4ThreeVector& p)
+  {
+    auto multiUnion = const_cast<G4MultiUnion*>(
+      static_cast<const G4MultiUnion*>(solid));
+    multiUnion->SetAccurateSafety(true);
+    G4double safety = multiUnion->DistanceToIn(p);
+    multiUnion->SetAccurateSafety(false);
+    return safety;
+  });
+  delete bvh;
+  delete voxels;
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testTessellatedSolid();
+  ok &= testMultiUnion();
+  return ok ? 0 : 1;
+}
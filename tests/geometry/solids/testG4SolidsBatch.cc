@@ -0,0 +1,358 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// testG4SolidsBatch
+//
+// Checks that the batched methods of G4Box, G4Orb, G4Trd, G4Tubs and
+// G4Cons return, bit for bit, the results of the scalar methods: for
+// random points and directions, for points on and near the surfaces,
+// and for points on the edges of the solids with axis-aligned, radial
+// and tangent directions. Tubes and cones are checked with and without
+// inner radius and phi segment.
+
+#include "G4Box.hh"
+#include "G4Cons.hh"
+#include "G4Orb.hh"
+#include "G4ThreeVectorSoA.hh"
+#include "G4Trd.hh"
+#include "G4Tubs.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  std::mt19937_64 engine(4321);
+
+  G4double Uniform(G4double a, G4double b)
+  {
+    return std::uniform_real_distribution<G4double>(a, b)(engine);
+  }
+
+  G4ThreeVector RandomDirection()
+  {
+    G4double cost = Uniform(-1., 1.);
+    G4double sint = std::sqrt((1. - cost)*(1. + cost));
+    G4double phi = Uniform(0., twopi);
+    return { sint*std::cos(phi), sint*std::sin(phi), cost };
+  }
+
+  G4bool Same(G4double a, G4double b)
+  {
+    return std::memcmp(&a, &b, sizeof(G4double)) == 0;
+  }
+
+  void Report(const G4VSolid* solid, const char* method,
+              const G4ThreeVector& p, const G4ThreeVector& v,
+              G4double scalar, G4double batch)
+  {
+    G4long oldPrec = G4cerr.precision(17);
+    G4cerr << solid->GetName() << "::" << method << " p=" << p
+           << " v=" << v << " scalar=" << scalar
+           << " batch=" << batch << G4endl;
+    G4cerr.precision(oldPrec);
+  }
+}
+
+// Points and directions for one solid
+//
+void Sample(const G4VSolid* solid, const std::vector<G4ThreeVector>& edges,
+            std::vector<G4ThreeVector>& points,
+            std::vector<G4ThreeVector>& directions)
+{
+  G4double tol = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+  G4ThreeVector pMin, pMax;
+  solid->BoundingLimits(pMin, pMax);
+  G4ThreeVector centre = 0.5*(pMin + pMax), half = 0.5*(pMax - pMin);
+
+  // Random points in and around the bounding box, and far away
+  //
+  for (G4int i=0; i<20000; ++i)
+  {
+    G4double scale = (i%10 == 0) ? 1000. : 1.5;
+    G4ThreeVector p(Uniform(-scale, scale)*half.x(),
+                    Uniform(-scale, scale)*half.y(),
+                    Uniform(-scale, scale)*half.z());
+    points.push_back(centre + p);
+    directions.push_back(RandomDirection());
+  }
+
+  // Points on the surface, and displaced within and beyond tolerance
+  //
+  for (G4int i=0; i<20000; ++i)
+  {
+    G4ThreeVector p = solid->GetPointOnSurface();
+    G4ThreeVector v = RandomDirection();
+    G4double shift = 0.;
+    switch (i%5)
+    {
+      case 1: shift =  0.4*tol; break;
+      case 2: shift = -0.4*tol; break;
+      case 3: shift =  2.0*tol; break;
+      case 4: shift = -2.0*tol; break;
+      default: break;
+    }
+    G4ThreeVector normal = solid->SurfaceNormal(p);
+    points.push_back(p + shift*normal);
+    directions.push_back(v);
+
+    // Directions along, against and tangent to the normal
+    //
+    points.push_back(p);
+    directions.push_back((i%2 == 0) ? normal : -normal);
+    points.push_back(p);
+    directions.push_back(normal.orthogonal().unit());
+  }
+
+  // Edges and corners, with axis-aligned, radial and random directions
+  //
+  std::vector<G4ThreeVector> axes = {
+    G4ThreeVector(1,0,0), G4ThreeVector(-1,0,0), G4ThreeVector(0,1,0),
+    G4ThreeVector(0,-1,0), G4ThreeVector(0,0,1), G4ThreeVector(0,0,-1) };
+  for (const auto& edge : edges)
+  {
+    for (G4double shift : { 0., 0.4*tol, -0.4*tol })
+    {
+      G4ThreeVector p = edge + shift*G4ThreeVector(1,1,1).unit();
+      for (const auto& axis : axes)
+      {
+        points.push_back(p);
+        directions.push_back(axis);
+      }
+      G4ThreeVector rho(p.x(), p.y(), 0.);
+      if (rho.mag2() > 0)
+      {
+        points.push_back(p);
+        directions.push_back(rho.unit());
+        points.push_back(p);
+        directions.push_back(-rho.unit());
+        points.push_back(p);
+        directions.push_back(G4ThreeVector(-p.y(), p.x(), 0.).unit());
+      }
+      for (G4int k=0; k<20; ++k)
+      {
+        points.push_back(p);
+        directions.push_back(RandomDirection());
+      }
+    }
+  }
+}
+
+// Edges of tubes and cones: the radii at both z planes, at the phi
+// limits and in the middle of the phi segment, and the z axis
+//
+std::vector<G4ThreeVector> RoundEdges(G4double rmin1, G4double rmax1,
+                                      G4double rmin2, G4double rmax2,
+                                      G4double dz, G4double sphi,
+                                      G4double dphi)
+{
+  std::vector<G4ThreeVector> edges;
+  for (G4double phi : { sphi, sphi + 0.5*dphi, sphi + dphi })
+  {
+    G4ThreeVector u(std::cos(phi), std::sin(phi), 0.);
+    for (G4int k=0; k<2; ++k)
+    {
+      G4double z = (k == 0) ? -dz : dz;
+      G4double rmin = (k == 0) ? rmin1 : rmin2;
+      G4double rmax = (k == 0) ? rmax1 : rmax2;
+      for (G4double r : { rmin, rmax, 0.5*(rmin + rmax) })
+      {
+        edges.push_back(r*u + G4ThreeVector(0, 0, z));
+        edges.push_back(r*u);
+      }
+    }
+  }
+  edges.emplace_back(0, 0, 0);
+  edges.emplace_back(0, 0, dz);
+  edges.emplace_back(0, 0, -dz);
+  return edges;
+}
+
+G4bool testSolid(const G4VSolid* solid,
+                 const std::vector<G4ThreeVector>& edges)
+{
+  std::vector<G4ThreeVector> points, directions;
+  Sample(solid, edges, points, directions);
+
+  // Split the points according to their location, as the scalar
+  // intersection methods are defined from outside or from inside
+  //
+  G4ThreeVectorSoA all, allDir, in, inDir, out, outDir;
+  for (std::size_t i=0; i<points.size(); ++i)
+  {
+    all.PushBack(points[i]);
+    allDir.PushBack(directions[i]);
+    EInside location = solid->Inside(points[i]);
+    if (location != kInside)
+    {
+      out.PushBack(points[i]);
+      outDir.PushBack(directions[i]);
+    }
+    if (location != kOutside)
+    {
+      in.PushBack(points[i]);
+      inDir.PushBack(directions[i]);
+    }
+  }
+
+  G4int nDiff[5] = { 0, 0, 0, 0, 0 };
+  std::vector<EInside> inside(all.Size());
+  solid->InsideBatch(all, inside.data());
+  for (std::size_t i=0; i<all.Size(); ++i)
+  {
+    if (inside[i] != solid->Inside(all.Get(i)))
+    {
+      if (nDiff[0]++ == 0)
+      {
+        Report(solid, "InsideBatch", all.Get(i), G4ThreeVector(),
+               solid->Inside(all.Get(i)), inside[i]);
+      }
+    }
+  }
+
+  std::vector<G4double> dist(out.Size());
+  solid->DistanceToInBatch(out, outDir, dist.data());
+  for (std::size_t i=0; i<out.Size(); ++i)
+  {
+    G4double scalar = solid->DistanceToIn(out.Get(i), outDir.Get(i));
+    if (!Same(scalar, dist[i]) && nDiff[1]++ == 0)
+    {
+      Report(solid, "DistanceToInBatch", out.Get(i), outDir.Get(i),
+             scalar, dist[i]);
+    }
+  }
+  solid->SafetyToInBatch(out, dist.data());
+  for (std::size_t i=0; i<out.Size(); ++i)
+  {
+    G4double scalar = solid->DistanceToIn(out.Get(i));
+    if (!Same(scalar, dist[i]) && nDiff[2]++ == 0)
+    {
+      Report(solid, "SafetyToInBatch", out.Get(i), G4ThreeVector(),
+             scalar, dist[i]);
+    }
+  }
+
+  dist.resize(in.Size());
+  solid->DistanceToOutBatch(in, inDir, dist.data());
+  for (std::size_t i=0; i<in.Size(); ++i)
+  {
+    G4double scalar = solid->DistanceToOut(in.Get(i), inDir.Get(i));
+    if (!Same(scalar, dist[i]) && nDiff[3]++ == 0)
+    {
+      Report(solid, "DistanceToOutBatch", in.Get(i), inDir.Get(i),
+             scalar, dist[i]);
+    }
+  }
+  solid->SafetyToOutBatch(in, dist.data());
+  for (std::size_t i=0; i<in.Size(); ++i)
+  {
+    G4double scalar = solid->DistanceToOut(in.Get(i));
+    if (!Same(scalar, dist[i]) && nDiff[4]++ == 0)
+    {
+      Report(solid, "SafetyToOutBatch", in.Get(i), G4ThreeVector(),
+             scalar, dist[i]);
+    }
+  }
+
+  G4bool ok = Check(in.Size() > 10000 && out.Size() > 10000,
+                    "points sampled inside and outside");
+  ok &= Check(nDiff[0] == 0, "InsideBatch equals Inside");
+  ok &= Check(nDiff[1] == 0, "DistanceToInBatch equals DistanceToIn(p,v)");
+  ok &= Check(nDiff[2] == 0, "SafetyToInBatch equals DistanceToIn(p)");
+  ok &= Check(nDiff[3] == 0, "DistanceToOutBatch equals DistanceToOut(p,v)");
+  ok &= Check(nDiff[4] == 0, "SafetyToOutBatch equals DistanceToOut(p)");
+  if (!ok) { G4cerr << "  in solid " << solid->GetName() << G4endl; }
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = true;
+
+  G4Box box("Box", 10*mm, 20*mm, 30*mm);
+  std::vector<G4ThreeVector> boxEdges;
+  for (G4double x : { -10*mm, 0., 10*mm })
+  {
+    for (G4double y : { -20*mm, 0., 20*mm })
+    {
+      for (G4double z : { -30*mm, 0., 30*mm })
+      {
+        boxEdges.emplace_back(x, y, z);
+      }
+    }
+  }
+  ok &= testSolid(&box, boxEdges);
+
+  G4Orb orb("Orb", 25*mm);
+  ok &= testSolid(&orb, { G4ThreeVector(25*mm, 0, 0),
+                          G4ThreeVector(0, 0, -25*mm),
+                          G4ThreeVector(0, 0, 0) });
+
+  G4Trd trd("Trd", 10*mm, 30*mm, 15*mm, 5*mm, 20*mm);
+  std::vector<G4ThreeVector> trdEdges;
+  for (G4double sx : { -1., 1. })
+  {
+    for (G4double sy : { -1., 1. })
+    {
+      trdEdges.emplace_back(sx*10*mm, sy*15*mm, -20*mm);
+      trdEdges.emplace_back(sx*30*mm, sy*5*mm, 20*mm);
+      trdEdges.emplace_back(sx*20*mm, sy*10*mm, 0.);
+    }
+  }
+  ok &= testSolid(&trd, trdEdges);
+
+  struct Round { const char* name; G4double rmin, rmax, sphi, dphi; };
+  const Round rounds[] = {
+    { "Full", 0., 40*mm, 0., twopi },
+    { "Hollow", 15*mm, 40*mm, 0., twopi },
+    { "Segment", 0., 40*mm, 30*deg, 100*deg },
+    { "HollowSegment", 15*mm, 40*mm, -20*deg, 70*deg },
+    { "WideSegment", 15*mm, 40*mm, 45*deg, 270*deg } };
+  for (const auto& r : rounds)
+  {
+    G4Tubs tubs(G4String("Tubs") + r.name, r.rmin, r.rmax, 25*mm,
+                r.sphi, r.dphi);
+    ok &= testSolid(&tubs, RoundEdges(r.rmin, r.rmax, r.rmin, r.rmax,
+                                      25*mm, r.sphi, r.dphi));
+
+    G4double rmin2 = 0.5*r.rmin, rmax2 = 0.6*r.rmax;
+    G4Cons cons(G4String("Cons") + r.name, r.rmin, r.rmax, rmin2, rmax2,
+                25*mm, r.sphi, r.dphi);
+    ok &= testSolid(&cons, RoundEdges(r.rmin, r.rmax, rmin2, rmax2,
+                                      25*mm, r.sphi, r.dphi));
+  }
+  return ok ? 0 : 1;
+}
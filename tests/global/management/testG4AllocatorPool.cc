@@ -0,0 +1,121 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4AllocatorPool
+//
+// Checks G4AllocatorPool::Reserve(): an empty request is a no-op, a
+// reserved page serves the next allocations without growing the pool,
+// and requests exceeding the page size range are refused instead of
+// overflowing.
+
+#include "G4Allocator.hh"
+#include "G4AllocatorPool.hh"
+#include "globals.hh"
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  struct Payload
+  {
+    G4double data[4];
+  };
+}
+
+G4bool testReserve()
+{
+  G4bool ok = true;
+  G4AllocatorPool pool(sizeof(Payload));
+
+  pool.Reserve(0);
+  ok &= Check(pool.GetNoPages() == 0, "Reserve(0) allocates no page");
+
+  const std::size_t n = 1000;
+  pool.Reserve(n);
+  ok &= Check(pool.GetNoPages() == 1, "Reserve(n) allocates one page");
+
+  std::vector<void*> elements;
+  for (std::size_t i = 0; i < n; ++i) { elements.push_back(pool.Alloc()); }
+  ok &= Check(pool.GetNoPages() == 1, "n allocations do not grow the pool");
+
+  elements.push_back(pool.Alloc());
+  ok &= Check(pool.GetNoPages() == 2, "allocation n+1 grows the pool");
+
+  for (auto e : elements) { pool.Free(e); }
+  pool.Reset();
+  ok &= Check(pool.GetNoPages() == 0, "Reset() frees all pages");
+  return ok;
+}
+
+G4bool testReserveOverflow()
+{
+  G4bool ok = true;
+  G4AllocatorPool pool(16);
+
+  // 2^28 elements of 16 bytes wrap to 0 in unsigned int arithmetic
+  //
+  pool.Reserve(std::size_t(1) << 28);
+  ok &= Check(pool.GetNoPages() == 0, "wrapping request is refused");
+
+  pool.Reserve(std::numeric_limits<std::size_t>::max());
+  ok &= Check(pool.GetNoPages() == 0, "oversized request is refused");
+
+  void* e = pool.Alloc();
+  ok &= Check(e != nullptr && pool.GetNoPages() == 1,
+              "pool grows normally after a refused request");
+  pool.Free(e);
+  return ok;
+}
+
+G4bool testAllocatorReserve()
+{
+  G4bool ok = true;
+  G4Allocator<Payload> allocator;
+
+  allocator.Reserve(500);
+  ok &= Check(allocator.GetNoPages() == 1, "G4Allocator::Reserve()");
+
+  std::vector<Payload*> objects;
+  for (G4int i = 0; i < 500; ++i) { objects.push_back(allocator.MallocSingle()); }
+  ok &= Check(allocator.GetNoPages() == 1,
+              "reserved allocator does not grow");
+
+  for (auto o : objects) { allocator.FreeSingle(o); }
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testReserve();
+  ok &= testReserveOverflow();
+  ok &= testAllocatorReserve();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4EventArena
+//
+// Checks G4EventArena and G4EventArenaPool: allocations are aligned and
+// do not overlap, a release gives the pages back to the pool, which
+// reuses them without growing, and an arena filled by a worker thread
+// and released by another thread returns its pages to the pool of the
+// worker, where they are reused, while the accounting of both pools
+// stays consistent through ResetStorage().
+
+#include "G4EventArena.hh"
+#include "globals.hh"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  struct alignas(64) Aligned
+  {
+    G4double data[3];
+  };
+
+  // Fills the arena with objects of various sizes and alignments, each
+  // filled with its own pattern; the patterns survive if the objects do
+  // not overlap
+  G4bool Fill(G4EventArena& arena, G4int n)
+  {
+    G4bool ok = true;
+    std::vector<std::pair<char*, std::size_t>> objects;
+    for (G4int i = 0; i < n; ++i)
+    {
+      const std::size_t size = (i%3 == 0) ? sizeof(Aligned) : 8 + i%40;
+      const std::size_t align = (i%3 == 0) ? alignof(Aligned) : 8;
+      auto p = static_cast<char*>(arena.Allocate(size, align));
+      ok &= (reinterpret_cast<std::uintptr_t>(p)%align == 0);
+      std::memset(p, i%128, size);
+      objects.emplace_back(p, size);
+    }
+    for (G4int i = 0; i < n; ++i)
+    {
+      for (std::size_t k = 0; k < objects[i].second; ++k)
+      {
+        ok &= (objects[i].first[k] == char(i%128));
+      }
+    }
+    return ok;
+  }
+
+  // Hand-over between the worker and the main thread
+  std::mutex handMutex;
+  std::condition_variable handCondition;
+  G4int stage = 0;
+
+  void WaitFor(G4int value)
+  {
+    std::unique_lock<std::mutex> lock(handMutex);
+    handCondition.wait(lock, [value] { return stage >= value; });
+  }
+
+  void Advance(G4int value)
+  {
+    {
+      std::lock_guard<std::mutex> lock(handMutex);
+      stage = value;
+    }
+    handCondition.notify_all();
+  }
+}
+
+G4bool testAllocateReleaseReuse()
+{
+  G4bool ok = true;
+  G4EventArenaPool* pool = G4EventArenaPool::GetInstance();
+  const std::size_t pageSize = pool->GetPageSize();
+
+  G4EventArena arena;
+  ok &= Check(arena.GetNoPages() == 0 && arena.GetPool() == nullptr,
+              "empty arena holds no page");
+  ok &= Check(Fill(arena, 10000), "aligned, distinct allocations");
+  const G4int nPages = arena.GetNoPages();
+  ok &= Check(nPages > 1 && arena.GetPool() == pool,
+              "arena takes several pages from the pool of the thread");
+  ok &= Check(arena.GetUsedSize() <= arena.GetAllocatedSize()
+              && arena.GetAllocatedSize() == nPages*pageSize,
+              "used and allocated sizes");
+  void* large = arena.Allocate(3*pageSize);
+  ok &= Check(large != nullptr && arena.GetNoPages() == nPages + 1
+              && arena.GetAllocatedSize() > (nPages + 3)*pageSize,
+              "allocation larger than a page");
+
+  const std::size_t total = pool->GetAllocatedSize();
+  arena.Release();
+  ok &= Check(arena.GetNoPages() == 0 && arena.GetUsedSize() == 0
+              && arena.GetAllocatedSize() == 0 && arena.GetPool() == nullptr,
+              "release empties the arena");
+  ok &= Check(pool->GetNoFreePages() == nPages + 1
+              && pool->GetAllocatedSize() == total,
+              "release gives the pages back to the pool");
+
+  // The same allocations reuse the pages without growing the pool
+  ok &= Check(Fill(arena, 10000), "aligned, distinct allocations after release");
+  ok &= Check(pool->GetAllocatedSize() == total
+              && pool->GetNoPages() == nPages + 1,
+              "pages reused");
+  arena.Release();
+
+  pool->ResetStorage();
+  ok &= Check(pool->GetAllocatedSize() == 0 && pool->GetNoPages() == 0
+              && pool->GetNoFreePages() == 0, "ResetStorage() frees the pages");
+  return ok;
+}
+
+G4bool testCrossThreadRelease()
+{
+  G4bool ok = true;
+  G4EventArenaPool* mainPool = G4EventArenaPool::GetInstance();
+  mainPool->ResetStorage();
+
+  G4EventArena arena;
+  G4EventArenaPool* workerPool = nullptr;
+  G4int nPages = 0;
+  std::size_t workerTotal = 0;
+  G4bool workerOk = true;
+
+  std::thread worker([&]
+  {
+    // Stage 1: the worker fills the arena of an "event"
+    workerPool = G4EventArenaPool::GetInstance();
+    workerOk &= Check(Fill(arena, 5000), "allocations in the worker");
+    nPages = arena.GetNoPages();
+    workerTotal = workerPool->GetAllocatedSize();
+    Advance(1);
+
+    // Stage 3: after the release by the main thread, the pages are back
+    // in the pool of the worker and serve a new arena
+    WaitFor(2);
+    workerOk &= Check(workerPool->GetNoFreePages() == nPages,
+                      "pages returned to the pool of the worker");
+    G4EventArena next;
+    workerOk &= Check(Fill(next, 5000), "allocations after the release");
+    workerOk &= Check(workerPool->GetAllocatedSize() == workerTotal,
+                      "worker reuses the pages released by the master");
+    next.Release();
+    workerPool->ResetStorage();
+    workerOk &= Check(workerPool->GetAllocatedSize() == 0
+                      && workerPool->GetNoPages() == 0,
+                      "worker pool accounting after ResetStorage()");
+    Advance(3);
+  });
+
+  // Stage 2: the main thread deletes the "event"
+  WaitFor(1);
+  ok &= Check(nPages > 1 && arena.GetPool() == workerPool
+              && workerPool != mainPool, "arena owned by the worker pool");
+  arena.Release();
+  ok &= Check(mainPool->GetNoFreePages() == 0
+              && mainPool->GetAllocatedSize() == 0,
+              "no page given to the pool of the releasing thread");
+  Advance(2);
+  WaitFor(3);
+  worker.join();
+
+  mainPool->ResetStorage();
+  ok &= Check(mainPool->GetAllocatedSize() == 0
+              && mainPool->GetNoPages() == 0,
+              "main pool accounting after ResetStorage()");
+  return ok && workerOk;
+}
+
+int main()
+{
+  G4bool ok = testAllocateReleaseReuse();
+  ok &= testCrossThreadRelease();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4PhysicsTableImage
+//
+// Checks the physics table image: the vectors retrieved from a mapped
+// image interpolate as the stored ones, a mapped image stays valid when
+// its file is rewritten, and a modified copy of a mapped vector owns its
+// data. Also checks that packed vectors interpolate as unpacked ones.
+
+#include "G4PhysicsFreeVector.hh"
+#include "G4PhysicsLogVector.hh"
+#include "G4PhysicsTable.hh"
+#include "G4PhysicsTableImage.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+  const char* imageName = "testG4PhysicsTableImage.bin";
+
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  G4bool SameValues(const G4PhysicsVector& v1, const G4PhysicsVector& v2)
+  {
+    if (v1.GetVectorLength() != v2.GetVectorLength()) { return false; }
+    for (G4int i = 0; i <= 200; ++i)
+    {
+      G4double e = 0.5*keV*std::pow(4.e4, i/200.);
+      G4double y1 = v1.Value(e);
+      G4double y2 = v2.Value(e);
+      if (std::abs(y1 - y2) > 1.e-12*std::abs(y1)) { return false; }
+    }
+    return true;
+  }
+
+  G4PhysicsLogVector* MakeLogVector(G4double factor, G4bool spline)
+  {
+    auto v = new G4PhysicsLogVector(1*keV, 10*MeV, 40, spline);
+    for (std::size_t i = 0; i < v->GetVectorLength(); ++i)
+    {
+      G4double e = v->Energy(i);
+      v->PutValue(i, factor*std::sqrt(e)/(1. + e/MeV));
+    }
+    v->FillSecondDerivatives();
+    return v;
+  }
+
+  G4PhysicsFreeVector* MakeFreeVector(G4double factor)
+  {
+    auto v = new G4PhysicsFreeVector(8, true);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      G4double e = 1*keV*std::pow(10., 0.6*i);
+      v->PutValues(i, e, factor*std::log(e/eV));
+    }
+    v->FillSecondDerivatives();
+    return v;
+  }
+
+  void FillTable(G4PhysicsTable& table, G4double factor)
+  {
+    table.push_back(MakeLogVector(factor, true));
+    table.push_back(nullptr);
+    table.push_back(MakeFreeVector(factor));
+  }
+
+  G4bool WriteImage(const G4String& key, const G4PhysicsTable& table)
+  {
+    G4PhysicsTableImage* image = G4PhysicsTableImage::GetInstance();
+    image->StartRecording();
+    image->AddTable(key, table);
+    return image->Write(imageName);
+  }
+}
+
+G4bool testPackedLayout()
+{
+  G4bool ok = true;
+  G4PhysicsLogVector* v = MakeLogVector(1., true);
+  G4PhysicsLogVector packed(*v);
+  packed.Pack();
+  ok &= Check(packed.IsPacked() && !v->IsPacked(), "Pack()");
+  ok &= Check(SameValues(*v, packed), "packed vector values");
+
+  G4PhysicsLogVector copy(packed);
+  ok &= Check(copy.IsPacked() && SameValues(*v, copy),
+              "copy of a packed vector");
+
+  G4PhysicsFreeVector* f = MakeFreeVector(1.);
+  G4PhysicsFreeVector fpacked(*f);
+  fpacked.Pack();
+  fpacked.ScaleVector(1., 2.);
+  fpacked.InsertValues(2*keV, 1.);
+  fpacked.FillSecondDerivatives();
+  f->ScaleVector(1., 2.);
+  f->InsertValues(2*keV, 1.);
+  f->FillSecondDerivatives();
+  ok &= Check(fpacked.IsPacked() && SameValues(*f, fpacked),
+              "modified packed vector");
+  delete v;
+  delete f;
+  return ok;
+}
+
+G4bool testImage()
+{
+  G4bool ok = true;
+  G4PhysicsTableImage* image = G4PhysicsTableImage::GetInstance();
+
+  G4PhysicsTable table;
+  FillTable(table, 1.);
+  ok &= Check(WriteImage("tableA", table), "Write()");
+  ok &= Check(image->Map(imageName), "Map()");
+  ok &= Check(image->HasTable("tableA") && !image->HasTable("tableB"),
+              "HasTable()");
+
+  G4PhysicsTable mapped;
+  ok &= Check(image->RetrieveTable("tableA", mapped, true), "RetrieveTable()");
+  if (!ok) { return false; }
+  ok &= Check(mapped.size() == 3 && mapped[1] == nullptr, "table layout");
+  ok &= Check(mapped[0]->IsMapped() && mapped[2]->IsMapped(),
+              "retrieved vectors are mapped");
+  ok &= Check(SameValues(*table[0], *mapped[0]), "mapped log vector values");
+  ok &= Check(SameValues(*table[2], *mapped[2]), "mapped free vector values");
+
+  // the file is replaced while it is mapped
+  G4PhysicsTable other;
+  FillTable(other, 3.);
+  ok &= Check(WriteImage("tableB", other), "Write() of a mapped image");
+  ok &= Check(SameValues(*table[0], *mapped[0]) &&
+              SameValues(*table[2], *mapped[2]),
+              "mapped vectors after rewrite of the file");
+
+  // a modified copy owns its data, the mapped vector is unchanged
+  G4PhysicsLogVector copy(*static_cast<G4PhysicsLogVector*>(mapped[0]));
+  ok &= Check(copy.IsMapped(), "copy of a mapped vector");
+  copy.PutValue(0, -1.);
+  ok &= Check(!copy.IsMapped() && copy[0] == -1. && (*mapped[0])[0] != -1.,
+              "modified copy of a mapped vector");
+
+  mapped.clearAndDestroy();
+  other.clearAndDestroy();
+  table.clearAndDestroy();
+  std::remove(imageName);
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testPackedLayout();
+  ok &= testImage();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4PhysicsVectorPacked
+//
+// Checks that a packed G4PhysicsVector gives bit for bit the results of
+// the same vector with separate energy, value and second derivative
+// arrays: interpolation, bin search and inversion, second derivatives,
+// scaling, copy and assignment, and unpacking of a packed vector.
+
+#include "G4PhysicsFreeVector.hh"
+#include "G4PhysicsLinearVector.hh"
+#include "G4PhysicsLogVector.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+  std::mt19937_64 engine(2026);
+
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  G4bool Same(G4double a, G4double b)
+  {
+    return std::memcmp(&a, &b, sizeof(G4double)) == 0;
+  }
+
+  // Gives access to the protected Unpack()
+  class UnpackableLogVector : public G4PhysicsLogVector
+  {
+    public:
+      using G4PhysicsLogVector::G4PhysicsLogVector;
+      using G4PhysicsVector::Unpack;
+  };
+
+  // Energies covering the vector, its nodes and beyond its edges
+  std::vector<G4double> Energies(const G4PhysicsVector& v)
+  {
+    std::vector<G4double> energies;
+    const std::size_t n = v.GetVectorLength();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      G4double e = v.Energy(i);
+      energies.push_back(e);
+      energies.push_back(std::nextafter(e, 0.));
+      energies.push_back(std::nextafter(e, DBL_MAX));
+    }
+    const G4double logMin = std::log(0.5*v.GetMinEnergy());
+    const G4double logMax = std::log(2.*v.GetMaxEnergy());
+    std::uniform_real_distribution<G4double> flat(logMin, logMax);
+    for (G4int i = 0; i < 2000; ++i)
+    {
+      energies.push_back(std::exp(flat(engine)));
+    }
+    return energies;
+  }
+
+  // Compares everything readable from two vectors of the same type,
+  // logSearch if the free vectors have the log bin search enabled
+  G4bool SameVector(const G4PhysicsVector& a, const G4PhysicsVector& b,
+                    G4bool logSearch = false)
+  {
+    const std::size_t n = a.GetVectorLength();
+    if (n != b.GetVectorLength() || a.GetType() != b.GetType()
+        || a.GetSpline() != b.GetSpline()
+        || !Same(a.GetMinEnergy(), b.GetMinEnergy())
+        || !Same(a.GetMaxEnergy(), b.GetMaxEnergy())
+        || !Same(a.GetMinValue(), b.GetMinValue())
+        || !Same(a.GetMaxValue(), b.GetMaxValue()))
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (!Same(a.Energy(i), b.Energy(i)) || !Same(a[i], b[i])
+          || !Same(a(i), b(i)))
+      {
+        return false;
+      }
+    }
+    std::size_t idxa = 0, idxb = 0;
+    const G4bool isLog = (a.GetType() == T_G4PhysicsLogVector);
+    const G4bool isFree = (a.GetType() == T_G4PhysicsFreeVector) && logSearch;
+    for (const G4double e : Energies(a))
+    {
+      const G4double loge = std::log(e);
+      if (!Same(a.Value(e), b.Value(e))
+          || !Same(a.Value(e, idxa), b.Value(e, idxb)) || idxa != idxb
+          || a.FindBin(e, 0) != b.FindBin(e, 0))
+      {
+        return false;
+      }
+      if (isLog && !Same(a.LogVectorValue(e, loge), b.LogVectorValue(e, loge)))
+      {
+        return false;
+      }
+      if (isFree && !Same(a.LogFreeVectorValue(e, loge),
+                          b.LogFreeVectorValue(e, loge)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Growing function, so that GetEnergy() and FindLinearEnergy() apply
+  void Fill(G4PhysicsVector& v, G4double factor)
+  {
+    for (std::size_t i = 0; i < v.GetVectorLength(); ++i)
+    {
+      const G4double e = v.Energy(i);
+      v.PutValue(i, factor*std::sqrt(e/keV) + i);
+    }
+  }
+
+  G4bool SameInverse(const G4PhysicsVector& a, const G4PhysicsVector& b)
+  {
+    std::uniform_real_distribution<G4double> flat(-0.1, 1.1);
+    const G4double vmin = a.GetMinValue();
+    const G4double vmax = a.GetMaxValue();
+    for (G4int i = 0; i < 2000; ++i)
+    {
+      const G4double r = flat(engine);
+      const G4double val = vmin + r*(vmax - vmin);
+      if (!Same(a.GetEnergy(val), b.GetEnergy(val))) { return false; }
+      if (r >= 0. && r <= 1. && a.GetMaxValue() == 1.
+          && !Same(a.FindLinearEnergy(r), b.FindLinearEnergy(r)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename V>
+  G4bool testVector(V& v, const char* name, G4bool logSearch = false)
+  {
+    G4bool ok = true;
+    G4String what = G4String(name) + ": ";
+    Fill(v, 1.);
+    v.FillSecondDerivatives();
+
+    V packed(v);
+    packed.Pack();
+    ok &= Check(packed.IsPacked() && !v.IsPacked(), (what + "Pack()").c_str());
+    ok &= Check(SameVector(v, packed, logSearch),
+                (what + "packed values").c_str());
+    ok &= Check(SameInverse(v, packed), (what + "GetEnergy()").c_str());
+
+    // cumulative distribution for FindLinearEnergy()
+    {
+      V cdf(v), cdfPacked(v);
+      const G4double vmax = v.GetMaxValue();
+      G4PhysicsVector& values = cdf;
+      for (std::size_t i = 0; i < v.GetVectorLength(); ++i)
+      {
+        values.PutValue(i, v[i]/vmax);
+      }
+      cdfPacked = cdf;
+      cdfPacked.Pack();
+      ok &= Check(SameInverse(cdf, cdfPacked),
+                  (what + "FindLinearEnergy()").c_str());
+    }
+
+    // second derivatives recomputed from new values, all spline types
+    const G4SplineType types[] = { G4SplineType::Simple, G4SplineType::Base,
+                                   G4SplineType::FixedEdges };
+    for (const G4SplineType type : types)
+    {
+      Fill(v, 2.);
+      Fill(packed, 2.);
+      v.FillSecondDerivatives(type, 0.1, -0.2);
+      packed.FillSecondDerivatives(type, 0.1, -0.2);
+      ok &= Check(packed.IsPacked() && SameVector(v, packed, logSearch),
+                  (what + "FillSecondDerivatives()").c_str());
+    }
+
+    // the log bin search of a free vector is not rebuilt by ScaleVector()
+    const G4double factorE = logSearch ? 1. : 2.;
+    v.ScaleVector(factorE, 3.);
+    packed.ScaleVector(factorE, 3.);
+    ok &= Check(packed.IsPacked() && SameVector(v, packed, logSearch),
+                (what + "ScaleVector()").c_str());
+
+    // copy and assignment in both directions
+    V copy(packed);
+    ok &= Check(copy.IsPacked() && SameVector(v, copy, logSearch),
+                (what + "copy of a packed vector").c_str());
+    V assigned(v);
+    assigned = packed;
+    ok &= Check(assigned.IsPacked() && SameVector(v, assigned, logSearch),
+                (what + "assignment of a packed vector").c_str());
+    V unpacked(packed);
+    unpacked = v;
+    ok &= Check(!unpacked.IsPacked() && SameVector(v, unpacked, logSearch),
+                (what + "assignment to a packed vector").c_str());
+    return ok;
+  }
+}
+
+G4bool testVectorTypes()
+{
+  G4bool ok = true;
+  G4PhysicsLogVector logSpline(10*eV, 100*TeV, 140, true);
+  ok &= testVector(logSpline, "spline log vector");
+  G4PhysicsLogVector logLinear(10*eV, 100*TeV, 140, false);
+  ok &= testVector(logLinear, "log vector");
+  G4PhysicsLinearVector linear(1*keV, 10*MeV, 100, true);
+  ok &= testVector(linear, "linear vector");
+
+  G4PhysicsFreeVector free(60, true);
+  G4double e = 1*keV;
+  for (std::size_t i = 0; i < 60; ++i)
+  {
+    free.PutValues(i, e, 0.);
+    e *= 1.1 + 0.05*(i%3);
+  }
+  G4PhysicsFreeVector freeLog(free);
+  freeLog.EnableLogBinSearch();
+  ok &= testVector(free, "free vector");
+  ok &= testVector(freeLog, "free vector with log bin search", true);
+
+  // free vectors resized while packed
+  G4PhysicsFreeVector grown(free);
+  G4PhysicsFreeVector grownPacked(free);
+  grownPacked.Pack();
+  grown.InsertValues(3.5*keV, 1.);
+  grownPacked.InsertValues(3.5*keV, 1.);
+  grown.FillSecondDerivatives();
+  grownPacked.FillSecondDerivatives();
+  ok &= Check(grownPacked.IsPacked() && SameVector(grown, grownPacked),
+              "free vector: InsertValues()");
+  return ok;
+}
+
+G4bool testUnpack()
+{
+  G4bool ok = true;
+  UnpackableLogVector v(1*keV, 1*GeV, 84, true);
+  Fill(v, 1.);
+  v.FillSecondDerivatives();
+  UnpackableLogVector reference(v);
+
+  ok &= Check(!v.Unpack() && !v.IsPacked(), "Unpack() of an unpacked vector");
+  v.Pack();
+  ok &= Check(v.IsPacked(), "Pack() before Unpack()");
+  ok &= Check(v.Unpack() && !v.IsPacked(), "Unpack() after Pack()");
+  ok &= Check(SameVector(reference, v), "values after Unpack()");
+  v.Pack();
+  ok &= Check(v.IsPacked() && SameVector(reference, v),
+              "values after a second Pack()");
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testVectorTypes();
+  ok &= testUnpack();
+  return ok ? 0 : 1;
+}
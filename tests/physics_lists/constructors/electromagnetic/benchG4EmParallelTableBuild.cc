@@ -0,0 +1,306 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// benchG4EmParallelTableBuild
+//
+// Start-up time of G4EmStandardPhysics, or of option4, under a
+// G4TaskRunManager with /process/em/ParallelTableBuild off and on, each
+// in a child process. Each child then times the steps that the parallel
+// build distributes over the couples: the range and inverse range tables
+// of the energy loss processes and the second derivatives of their dE/dx
+// and lambda vectors, rebuilt in the master with the parallel build off
+// and on. The model calls that fill the dE/dx and lambda vectors stay
+// sequential, so the start-up gain is bounded by the time of these steps.
+//
+// Usage: benchG4EmParallelTableBuild [nThreads] [standard|option4]
+
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmParameters.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LossTableBuilder.hh"
+#include "G4LossTableManager.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGun.hh"
+#include "G4PhysicsLogVector.hh"
+#include "G4PhysicsTable.hh"
+#include "G4Positron.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Proton.hh"
+#include "G4Region.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TaskRunManager.hh"
+#include "G4UImanager.hh"
+#include "G4VEmProcess.hh"
+#include "G4VEnergyLossProcess.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserActionInitialization.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  G4double Milliseconds(Clock::time_point start)
+  {
+    return std::chrono::duration<G4double, std::milli>(Clock::now() - start)
+      .count();
+  }
+
+  // 20 materials, each in a region with default cuts and in one with
+  // fine cuts: 41 couples
+  class Materials : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        auto worldS = new G4Box("World", 3*m, 3*m, 3*m);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_Galactic"), "World");
+        auto region = new G4Region("FineCuts");
+        auto cuts = new G4ProductionCuts;
+        cuts->SetProductionCut(0.05*mm);
+        region->SetProductionCuts(cuts);
+        const char* names[] = {
+          "G4_WATER", "G4_AIR", "G4_Si", "G4_lAr", "G4_PbWO4", "G4_Pb",
+          "G4_Fe", "G4_Cu", "G4_W", "G4_Al", "G4_C", "G4_KAPTON",
+          "G4_POLYSTYRENE", "G4_CESIUM_IODIDE", "G4_BGO", "G4_GLASS_PLATE",
+          "G4_BONE_COMPACT_ICRU", "G4_TISSUE_SOFT_ICRP", "G4_U", "G4_Au" };
+        G4int i = 0;
+        for (const char* name : names)
+        {
+          for (G4int k = 0; k < 2; ++k)
+          {
+            auto boxS = new G4Box(name, 4*cm, 4*cm, 4*cm);
+            auto boxL = new G4LogicalVolume(boxS,
+              nist->FindOrBuildMaterial(name), name);
+            if (k == 1) { region->AddRootLogicalVolume(boxL); }
+            new G4PVPlacement(nullptr,
+              G4ThreeVector((-190 + 20*i)*cm, (-10 + 20*k)*cm, 0),
+              boxL, name, worldL, false, 2*i + k);
+          }
+          ++i;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+  };
+
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      explicit PhysicsList(G4bool option4)
+      {
+        SetVerboseLevel(0);
+        if (option4) { RegisterPhysics(new G4EmStandardPhysics_option4(0)); }
+        else         { RegisterPhysics(new G4EmStandardPhysics(0)); }
+      }
+  };
+
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      void GeneratePrimaries(G4Event* event) override
+      {
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+  };
+
+  class ActionInitialization : public G4VUserActionInitialization
+  {
+    public:
+      void Build() const override
+      {
+        SetUserAction(new PrimaryGenerator);
+      }
+  };
+
+  struct LossTables
+  {
+    const G4PhysicsTable* dedx;
+    const G4PhysicsTable* range;
+  };
+
+  void CollectTables(std::vector<LossTables>& loss,
+                     std::vector<const G4PhysicsVector*>& splines)
+  {
+    const G4ParticleDefinition* particles[] = {
+      G4Electron::Definition(), G4Positron::Definition(),
+      G4Gamma::Definition(), G4MuonMinus::Definition(),
+      G4MuonPlus::Definition(), G4Proton::Definition() };
+    auto addSplines = [&splines](const G4PhysicsTable* table)
+    {
+      if (table == nullptr) { return; }
+      for (const G4PhysicsVector* v : *table)
+      {
+        if (v != nullptr && v->GetType() == T_G4PhysicsLogVector)
+        {
+          splines.push_back(v);
+        }
+      }
+    };
+    for (const auto particle : particles)
+    {
+      G4ProcessVector* procs = particle->GetProcessManager()->GetProcessList();
+      for (G4int i = 0; i < (G4int)procs->size(); ++i)
+      {
+        G4VProcess* proc = (*procs)[i];
+        if (auto eloss = dynamic_cast<G4VEnergyLossProcess*>(proc))
+        {
+          if (eloss->IsIonisationProcess() && eloss->DEDXTable() != nullptr
+              && eloss->RangeTableForLoss() != nullptr)
+          {
+            loss.push_back({ eloss->DEDXTable(), eloss->RangeTableForLoss() });
+          }
+          addSplines(eloss->DEDXTable());
+          addSplines(eloss->LambdaTable());
+        }
+        else if (auto em = dynamic_cast<G4VEmProcess*>(proc))
+        {
+          addSplines(em->LambdaTable());
+          addSplines(em->LambdaTablePrim());
+        }
+      }
+    }
+  }
+
+  // Milliseconds per rebuild of the range, inverse range and second
+  // derivatives, as in the table build
+  G4double TimeParallelSteps(G4bool parallel, G4int nRepeat)
+  {
+    G4EmParameters::Instance()->SetParallelTableBuild(parallel);
+    G4LossTableBuilder* builder =
+      G4LossTableManager::Instance()->GetTableBuilder();
+    std::vector<LossTables> loss;
+    std::vector<const G4PhysicsVector*> splines;
+    CollectTables(loss, splines);
+
+    G4double time = 0.;
+    for (G4int r = 0; r < nRepeat; ++r)
+    {
+      std::vector<std::unique_ptr<G4PhysicsTable>> tables;
+      std::vector<std::unique_ptr<G4PhysicsVector>> copies;
+      for (const G4PhysicsVector* v : splines)
+      {
+        copies.emplace_back(new G4PhysicsLogVector(
+          *static_cast<const G4PhysicsLogVector*>(v)));
+      }
+
+      auto start = Clock::now();
+      for (const auto& tables0 : loss)
+      {
+        const std::size_t n = tables0.dedx->size();
+        auto range = new G4PhysicsTable(n);
+        auto inverse = new G4PhysicsTable(n);
+        range->resize(n, nullptr);
+        inverse->resize(n, nullptr);
+        builder->BuildRangeTable(tables0.dedx, range);
+        builder->BuildInverseRangeTable(tables0.range, inverse);
+        tables.emplace_back(range);
+        tables.emplace_back(inverse);
+      }
+      builder->ParallelFor(copies.size(), [&copies](std::size_t i)
+      {
+        copies[i]->FillSecondDerivatives();
+      });
+      time += Milliseconds(start);
+
+      for (auto& table : tables) { table->clearAndDestroy(); }
+    }
+    return time/nRepeat;
+  }
+
+  G4int Run(G4bool parallel, G4int nThreads, G4bool option4)
+  {
+    auto runManager = new G4TaskRunManager;
+    runManager->SetNumberOfThreads(nThreads);
+    runManager->SetUserInitialization(new Materials);
+    runManager->SetUserInitialization(new PhysicsList(option4));
+    runManager->SetUserInitialization(new ActionInitialization);
+
+    G4UImanager* ui = G4UImanager::GetUIpointer();
+    ui->ApplyCommand("/process/em/verbose 0");
+    ui->ApplyCommand("/process/eLoss/verbose 0");
+    ui->ApplyCommand(parallel ? "/process/em/ParallelTableBuild true"
+                              : "/process/em/ParallelTableBuild false");
+    auto start = Clock::now();
+    runManager->Initialize();
+    const G4double startup = Milliseconds(start);
+
+    // the tables alone, rebuilt after a physics modification
+    ui->ApplyCommand("/run/physicsModified");
+    start = Clock::now();
+    runManager->BeamOn(0);
+    const G4double rebuild = Milliseconds(start);
+
+    const G4int nRepeat = 20;
+    const G4double serialSteps = TimeParallelSteps(false, nRepeat);
+    const G4double parallelSteps = TimeParallelSteps(true, nRepeat);
+
+    G4cout << "ParallelTableBuild " << (parallel ? "on " : "off")
+           << ": start-up " << startup << " ms, table rebuild " << rebuild
+           << " ms; range, inverse range and"
+           << " splines " << serialSteps << " ms serial, " << parallelSteps
+           << " ms with " << nThreads << " threads" << G4endl;
+    delete runManager;
+    return 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const G4int nThreads = (argc > 1) ? std::atoi(argv[1]) : 4;
+  const std::string physics = (argc > 2) ? argv[2] : "standard";
+  if (argc > 3)
+  {
+    return Run(std::string(argv[3]) == "on", nThreads, physics == "option4");
+  }
+  for (const char* mode : { "off", "on" })
+  {
+    std::string command = std::string("\"") + argv[0] + "\" "
+                        + std::to_string(nThreads) + " " + physics + " "
+                        + mode;
+    if (std::system(command.c_str()) != 0) { return 1; }
+  }
+  return 0;
+}
@@ -0,0 +1,189 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// benchG4EmStandardTrackingManager
+//
+// Throughput of G4EmStandardPhysics with and without
+// /process/em/UseEmTrackingManager: 1 GeV electron showers in a Pb/lAr
+// sampling calorimeter, timed after the initialisation. As with the
+// tracking manager, the gamma processes are not combined in
+// G4GammaGeneralProcess in the processes mode. Each mode runs in
+// a child process, as the physics list is built once per process.
+//
+// Usage: benchG4EmStandardTrackingManager [nEvents]
+
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGun.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UImanager.hh"
+#include "G4UserSteppingAction.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+  // 20 layers of 2 mm Pb and 5 mm lAr
+  class Calorimeter : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        const G4int nLayers = 20;
+        const G4double size = 20*cm;
+        const G4double absThickness = 2*mm;
+        const G4double gapThickness = 5*mm;
+        const G4double layerThickness = absThickness + gapThickness;
+
+        auto worldS = new G4Box("World", size, size, nLayers*layerThickness);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_Galactic"), "World");
+        auto absS = new G4Box("Absorber", 0.5*size, 0.5*size, 0.5*absThickness);
+        absorber = new G4LogicalVolume(absS,
+          nist->FindOrBuildMaterial("G4_Pb"), "Absorber");
+        auto gapS = new G4Box("Gap", 0.5*size, 0.5*size, 0.5*gapThickness);
+        gap = new G4LogicalVolume(gapS,
+          nist->FindOrBuildMaterial("G4_lAr"), "Gap");
+
+        G4double z = -0.5*nLayers*layerThickness;
+        for (G4int i = 0; i < nLayers; ++i)
+        {
+          new G4PVPlacement(nullptr, G4ThreeVector(0, 0, z + 0.5*absThickness),
+                            absorber, "Absorber", worldL, false, i);
+          new G4PVPlacement(nullptr,
+            G4ThreeVector(0, 0, z + absThickness + 0.5*gapThickness),
+            gap, "Gap", worldL, false, i);
+          z += layerThickness;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+
+      G4LogicalVolume* absorber = nullptr;
+      G4LogicalVolume* gap = nullptr;
+  };
+
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      PhysicsList()
+      {
+        SetVerboseLevel(0);
+        RegisterPhysics(new G4EmStandardPhysics(0));
+      }
+  };
+
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      PrimaryGenerator()
+      {
+        fGun.SetParticleDefinition(G4Electron::Definition());
+        fGun.SetParticleEnergy(1*GeV);
+        fGun.SetParticlePosition(G4ThreeVector(0, 0, -9*cm));
+        fGun.SetParticleMomentumDirection(G4ThreeVector(0, 0, 1));
+      }
+
+      void GeneratePrimaries(G4Event* event) override
+      {
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+  };
+
+  class StepCounter : public G4UserSteppingAction
+  {
+    public:
+      void UserSteppingAction(const G4Step*) override { ++nSteps; }
+
+      G4long nSteps = 0;
+  };
+
+  void Simulate(G4bool useTrackingManager, G4int nEvents)
+  {
+    auto runManager = new G4RunManager;
+    runManager->SetUserInitialization(new Calorimeter);
+    runManager->SetUserInitialization(new PhysicsList);
+    runManager->SetUserAction(new PrimaryGenerator);
+    auto counter = new StepCounter;
+    runManager->SetUserAction(counter);
+
+    G4UImanager* ui = G4UImanager::GetUIpointer();
+    ui->ApplyCommand("/process/em/verbose 0");
+    ui->ApplyCommand("/process/eLoss/verbose 0");
+    ui->ApplyCommand("/process/em/UseGeneralProcess false");
+    ui->ApplyCommand(useTrackingManager
+                     ? "/process/em/UseEmTrackingManager true"
+                     : "/process/em/UseEmTrackingManager false");
+    runManager->Initialize();
+
+    // The first event is not timed, it touches the tables once
+    G4Random::setTheSeed(20261018);
+    runManager->BeamOn(1);
+    counter->nSteps = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    runManager->BeamOn(nEvents);
+    std::chrono::duration<G4double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+    G4cout << (useTrackingManager ? "tracking manager: " : "processes:        ")
+           << nEvents << " events in " << elapsed.count() << " s, "
+           << 1.e3*elapsed.count()/nEvents << " ms/event, "
+           << 1.e9*elapsed.count()/counter->nSteps << " ns/step" << G4endl;
+    delete runManager;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc == 3)
+  {
+    Simulate(std::string(argv[1]) == "tracking", std::atoi(argv[2]));
+    return 0;
+  }
+  const std::string nEvents = (argc == 2) ? argv[1] : "200";
+  for (const char* mode : { "processes", "tracking" })
+  {
+    std::string command = std::string("\"") + argv[0] + "\" " + mode
+                        + " " + nEvents;
+    if (std::system(command.c_str()) != 0) { return 1; }
+  }
+  return 0;
+}
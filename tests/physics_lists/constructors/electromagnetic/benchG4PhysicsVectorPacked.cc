@@ -0,0 +1,242 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// benchG4PhysicsVectorPacked
+//
+// Interpolation in the EM tables of G4EmStandardPhysics_option4, with the
+// separate energy, value and second derivative arrays and with the packed
+// nodes of G4PhysicsVector::Pack(). The tables of e-, e+, gamma and proton
+// are built for a few materials, copied in both layouts and sampled in a
+// random order of tables, couples and energies, as during tracking.
+//
+// Usage: benchG4PhysicsVectorPacked [nLookups]
+
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4Gamma.hh"
+#include "G4Log.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGun.hh"
+#include "G4PhysicsFreeVector.hh"
+#include "G4PhysicsLogVector.hh"
+#include "G4PhysicsTable.hh"
+#include "G4Positron.hh"
+#include "G4ProcessManager.hh"
+#include "G4Proton.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UImanager.hh"
+#include "G4VEmProcess.hh"
+#include "G4VEnergyLossProcess.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+  class Materials : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        auto worldS = new G4Box("World", 1*m, 1*m, 1*m);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_AIR"), "World");
+        const char* names[] = { "G4_WATER", "G4_Si", "G4_lAr", "G4_PbWO4",
+                                "G4_Pb", "G4_TISSUE_SOFT_ICRP" };
+        G4int i = 0;
+        for (const char* name : names)
+        {
+          auto boxS = new G4Box(name, 5*cm, 5*cm, 5*cm);
+          auto boxL = new G4LogicalVolume(boxS,
+            nist->FindOrBuildMaterial(name), name);
+          new G4PVPlacement(nullptr, G4ThreeVector(0, 0, (-50 + 20*i)*cm),
+                            boxL, name, worldL, false, i);
+          ++i;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+  };
+
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      PhysicsList()
+      {
+        SetVerboseLevel(0);
+        RegisterPhysics(new G4EmStandardPhysics_option4(0));
+      }
+  };
+
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      void GeneratePrimaries(G4Event* event) override
+      {
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+  };
+
+  using Vectors = std::vector<std::unique_ptr<G4PhysicsVector>>;
+
+  void AddTable(const G4PhysicsTable* table, Vectors& vectors, G4bool packed)
+  {
+    if (table == nullptr) { return; }
+    for (const G4PhysicsVector* v : *table)
+    {
+      if (v == nullptr || v->GetVectorLength() < 2) { continue; }
+      G4PhysicsVector* copy = nullptr;
+      if (v->GetType() == T_G4PhysicsLogVector)
+      {
+        copy = new G4PhysicsLogVector(
+          *static_cast<const G4PhysicsLogVector*>(v));
+      }
+      else if (v->GetType() == T_G4PhysicsFreeVector)
+      {
+        copy = new G4PhysicsFreeVector(
+          *static_cast<const G4PhysicsFreeVector*>(v));
+      }
+      else
+      {
+        continue;
+      }
+      if (packed) { copy->Pack(); }
+      vectors.emplace_back(copy);
+    }
+  }
+
+  // Lambda, dE/dx and range tables of the EM processes
+  void CollectTables(Vectors& vectors, G4bool packed)
+  {
+    const G4ParticleDefinition* particles[] = {
+      G4Electron::Definition(), G4Positron::Definition(),
+      G4Gamma::Definition(), G4Proton::Definition() };
+    for (const auto particle : particles)
+    {
+      G4ProcessVector* procs = particle->GetProcessManager()->GetProcessList();
+      for (G4int i = 0; i < (G4int)procs->size(); ++i)
+      {
+        G4VProcess* proc = (*procs)[i];
+        if (auto eloss = dynamic_cast<G4VEnergyLossProcess*>(proc))
+        {
+          AddTable(eloss->DEDXTable(), vectors, packed);
+          AddTable(eloss->RangeTableForLoss(), vectors, packed);
+          AddTable(eloss->InverseRangeTable(), vectors, packed);
+          AddTable(eloss->LambdaTable(), vectors, packed);
+        }
+        else if (auto em = dynamic_cast<G4VEmProcess*>(proc))
+        {
+          AddTable(em->LambdaTable(), vectors, packed);
+          AddTable(em->LambdaTablePrim(), vectors, packed);
+        }
+      }
+    }
+  }
+
+  // Sum of the interpolated values, so that the lookups are not elided
+  G4double Sample(const Vectors& vectors, const std::vector<std::size_t>& ids,
+                  const std::vector<G4double>& energies, G4double& seconds)
+  {
+    G4double sum = 0.;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      const G4PhysicsVector* v = vectors[ids[i]].get();
+      const G4double e = energies[i];
+      sum += (v->GetType() == T_G4PhysicsLogVector)
+             ? v->LogVectorValue(e, G4Log(e)) : v->Value(e);
+    }
+    std::chrono::duration<G4double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    seconds = elapsed.count();
+    return sum;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t nLookups = (argc > 1) ? std::atol(argv[1]) : 20000000;
+
+  auto runManager = new G4RunManager;
+  runManager->SetUserInitialization(new Materials);
+  runManager->SetUserInitialization(new PhysicsList);
+  runManager->SetUserAction(new PrimaryGenerator);
+  G4UImanager::GetUIpointer()->ApplyCommand("/process/em/verbose 0");
+  runManager->Initialize();
+  runManager->BeamOn(0);
+
+  Vectors separate, packed;
+  CollectTables(separate, false);
+  CollectTables(packed, true);
+
+  std::mt19937_64 engine(2026);
+  std::vector<std::size_t> ids(nLookups);
+  std::vector<G4double> energies(nLookups);
+  std::uniform_int_distribution<std::size_t> pick(0, separate.size() - 1);
+  std::uniform_real_distribution<G4double> unit(0., 1.);
+  for (std::size_t i = 0; i < nLookups; ++i)
+  {
+    ids[i] = pick(engine);
+    const G4PhysicsVector* v = separate[ids[i]].get();
+    const G4double lmin = G4Log(v->GetMinEnergy());
+    const G4double lmax = G4Log(v->GetMaxEnergy());
+    energies[i] = std::exp(lmin + unit(engine)*(lmax - lmin));
+  }
+
+  std::size_t nNodes = 0;
+  for (const auto& v : separate) { nNodes += v->GetVectorLength(); }
+  G4cout << separate.size() << " vectors, " << nNodes << " nodes, "
+         << nLookups << " lookups" << G4endl;
+
+  G4double tSeparate, tPacked;
+  Sample(separate, ids, energies, tSeparate);  // warm up
+  const G4double sumSeparate = Sample(separate, ids, energies, tSeparate);
+  Sample(packed, ids, energies, tPacked);
+  const G4double sumPacked = Sample(packed, ids, energies, tPacked);
+
+  G4cout << "separate arrays: " << 1.e9*tSeparate/nLookups << " ns/lookup"
+         << G4endl;
+  G4cout << "packed nodes:    " << 1.e9*tPacked/nLookups << " ns/lookup"
+         << G4endl;
+  const G4bool same = (sumSeparate == sumPacked);
+  if (!same) { G4cerr << "packed values differ" << G4endl; }
+
+  delete runManager;
+  return same ? 0 : 1;
+}
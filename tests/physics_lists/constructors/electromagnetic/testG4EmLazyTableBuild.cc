@@ -0,0 +1,464 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4EmLazyTableBuild
+//
+// Checks /process/em/LazyTableBuild with G4EmStandardPhysics under a
+// G4TaskRunManager: no lambda vector of the discrete processes is built
+// at initialisation; after a run, the couples built are exactly those in
+// which the particle of each process made steps, as also listed by
+// /process/em/printLazyTables; StorePhysicsTable() builds the other
+// couples. The lambda tables and the energies of the cross section
+// maximum are then written in binary, as for an eager build, and the two
+// files must be equal byte for byte. The physics list is built once per
+// process, so each mode is run by a child process.
+
+#include "G4AutoLock.hh"
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmLazyTable.hh"
+#include "G4EmParameters.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4MaterialCutsCouple.hh"
+#include "G4MuonMinus.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGun.hh"
+#include "G4PhysicsTable.hh"
+#include "G4PhysicsVector.hh"
+#include "G4Positron.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Proton.hh"
+#include "G4Region.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TaskRunManager.hh"
+#include "G4UIsession.hh"
+#include "G4UImanager.hh"
+#include "G4UserSteppingAction.hh"
+#include "G4VEmProcess.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserActionInitialization.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "globals.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  const G4int nThreads = 2;
+  const G4int nEvents = 20;
+
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  // Couples in which each particle made steps, in all threads
+  G4Mutex usedMutex = G4MUTEX_INITIALIZER;
+  std::set<std::pair<G4String, std::size_t>> usedCouples;
+
+  // Boxes of several materials along a line, and the same materials in
+  // a region with other cuts further away, so that the beam does not
+  // reach all the couples
+  class Materials : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        auto worldS = new G4Box("World", 1*m, 1*m, 1*m);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_AIR"), "World");
+        auto region = new G4Region("FineCuts");
+        auto cuts = new G4ProductionCuts;
+        cuts->SetProductionCut(0.05*mm);
+        region->SetProductionCuts(cuts);
+        const char* names[] = { "G4_WATER", "G4_Si", "G4_lAr", "G4_Pb",
+                                "G4_Fe" };
+        G4int i = 0;
+        for (const char* name : names)
+        {
+          for (G4int k = 0; k < 2; ++k)
+          {
+            auto boxS = new G4Box(name, 4*cm, 4*cm, 4*cm);
+            auto boxL = new G4LogicalVolume(boxS,
+              nist->FindOrBuildMaterial(name), name);
+            if (k == 1) { region->AddRootLogicalVolume(boxL); }
+            new G4PVPlacement(nullptr,
+              G4ThreeVector((-40 + 20*i)*cm, (-50 + 100*k)*cm, 0),
+              boxL, name, worldL, false, 2*i + k);
+          }
+          ++i;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+  };
+
+  // The Compton scattering is declared with a peaked cross section, so
+  // that the energies of the maximum are filled on demand as well
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      PhysicsList()
+      {
+        SetVerboseLevel(0);
+        RegisterPhysics(new G4EmStandardPhysics(0));
+      }
+
+      void ConstructProcess() override
+      {
+        G4VModularPhysicsList::ConstructProcess();
+        G4ProcessVector* procs =
+          G4Gamma::Definition()->GetProcessManager()->GetProcessList();
+        for (G4int i = 0; i < (G4int)procs->size(); ++i)
+        {
+          auto em = dynamic_cast<G4VEmProcess*>((*procs)[i]);
+          if (em != nullptr && em->GetProcessName() == "compt")
+          {
+            em->SetCrossSectionType(fEmOnePeak);
+          }
+        }
+      }
+  };
+
+  // Electrons and gammas through the boxes without the fine cuts
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      void GeneratePrimaries(G4Event* event) override
+      {
+        const G4bool electron = (fNEvents++%2 == 0);
+        if (electron) { fGun.SetParticleDefinition(G4Electron::Definition()); }
+        else          { fGun.SetParticleDefinition(G4Gamma::Definition()); }
+        fGun.SetParticleEnergy(electron ? 20*MeV : 2*MeV);
+        fGun.SetParticlePosition(G4ThreeVector(-60*cm, -50*cm, 0));
+        fGun.SetParticleMomentumDirection(G4ThreeVector(1, 0, 0));
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+      G4int fNEvents = 0;
+  };
+
+  class SteppingAction : public G4UserSteppingAction
+  {
+    public:
+      void UserSteppingAction(const G4Step* step) override
+      {
+        const G4MaterialCutsCouple* couple =
+          step->GetPreStepPoint()->GetMaterialCutsCouple();
+        const G4String& name =
+          step->GetTrack()->GetDefinition()->GetParticleName();
+        G4AutoLock l(&usedMutex);
+        usedCouples.emplace(name, couple->GetIndex());
+      }
+  };
+
+  class ActionInitialization : public G4VUserActionInitialization
+  {
+    public:
+      void Build() const override
+      {
+        SetUserAction(new PrimaryGenerator);
+        SetUserAction(new SteppingAction);
+      }
+  };
+
+  // Collects the output of the master thread
+  class Capture : public G4UIsession
+  {
+    public:
+      G4int ReceiveG4cout(const G4String& text) override
+      {
+        output += text;
+        return 0;
+      }
+
+      std::string output;
+  };
+
+  const G4ParticleDefinition* const* Particles(std::size_t& n)
+  {
+    static const G4ParticleDefinition* particles[] = {
+      G4Electron::Definition(), G4Positron::Definition(),
+      G4Gamma::Definition(), G4MuonMinus::Definition(),
+      G4Proton::Definition() };
+    n = sizeof(particles)/sizeof(particles[0]);
+    return particles;
+  }
+
+  template <typename Function>
+  void ForEachEmProcess(Function function)
+  {
+    std::size_t nParticles;
+    const G4ParticleDefinition* const* particles = Particles(nParticles);
+    for (std::size_t k = 0; k < nParticles; ++k)
+    {
+      G4ProcessVector* procs =
+        particles[k]->GetProcessManager()->GetProcessList();
+      for (G4int i = 0; i < (G4int)procs->size(); ++i)
+      {
+        if (auto em = dynamic_cast<G4VEmProcess*>((*procs)[i]))
+        {
+          function(particles[k], em);
+        }
+      }
+    }
+  }
+
+  // Writes the nodes of the vector and the values half way between them
+  std::size_t Write(std::ofstream& out, const G4PhysicsTable* table)
+  {
+    if (table == nullptr) { return 0; }
+    std::size_t nVectors = 0;
+    for (const G4PhysicsVector* v : *table)
+    {
+      const std::size_t n = (v == nullptr) ? 0 : v->GetVectorLength();
+      out.write(reinterpret_cast<const char*>(&n), sizeof n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        G4double node[3] = { v->Energy(i), (*v)[i], 0. };
+        if (i + 1 < n)
+        {
+          node[2] = v->Value(0.5*(v->Energy(i) + v->Energy(i + 1)));
+        }
+        out.write(reinterpret_cast<const char*>(node), sizeof node);
+      }
+      if (n > 0) { ++nVectors; }
+    }
+    return nVectors;
+  }
+
+  // Couples used by the particles of the processes sharing each table
+  // built on demand (e.g. the particle and its antiparticle)
+  std::map<const G4EmLazyTable*, std::set<std::size_t>> UsedByTable()
+  {
+    std::map<const G4EmLazyTable*, std::set<std::size_t>> used;
+    ForEachEmProcess([&](const G4ParticleDefinition* particle,
+                         G4VEmProcess* proc)
+    {
+      const G4EmLazyTable* lazy = proc->LazyTable();
+      if (lazy == nullptr) { return; }
+      std::set<std::size_t>& couples = used[lazy];
+      for (const auto& entry : usedCouples)
+      {
+        if (entry.first == particle->GetParticleName())
+        {
+          couples.insert(entry.second);
+        }
+      }
+    });
+    return used;
+  }
+
+  // Line of /process/em/printLazyTables expected for the table
+  std::string ExpectedReport(const G4EmLazyTable* lazy,
+                             const std::set<std::size_t>& used)
+  {
+    std::ostringstream line;
+    line << "  " << lazy->GetName() << ": " << used.size() << " of "
+         << lazy->NumberOfCouples() << " couples built on demand";
+    if (!used.empty())
+    {
+      line << ", indexes:";
+      for (const auto i : used) { line << " " << i; }
+    }
+    line << "\n";
+    return line.str();
+  }
+
+  // Checks the couples built on demand by the workers
+  G4bool CheckLazyBuild(PhysicsList* physicsList, G4TaskRunManager* runManager)
+  {
+    const std::size_t nCouples =
+      G4ProductionCutsTable::GetProductionCutsTable()->GetTableSize();
+    G4bool ok = true;
+    std::size_t nLazy = 0, nBuiltAtStart = 0;
+    ForEachEmProcess([&](const G4ParticleDefinition*, G4VEmProcess* proc)
+    {
+      if (proc->LazyTable() == nullptr) { return; }
+      ++nLazy;
+      nBuiltAtStart += proc->LazyTable()->NumberOfBuiltCouples();
+    });
+    ok &= Check(nLazy >= 5, "lambda tables built on demand");
+    ok &= Check(nBuiltAtStart == 0, "no couple built at initialisation");
+
+    runManager->BeamOn(nEvents);
+
+    Capture capture;
+    G4UImanager* ui = G4UImanager::GetUIpointer();
+    ui->SetCoutDestination(&capture);
+    ui->ApplyCommand("/process/em/printLazyTables");
+    ui->SetCoutDestination(nullptr);
+
+    std::size_t nBuilt = 0, nMismatch = 0, nReport = 0;
+    const auto usedByTable = UsedByTable();
+    for (const auto& entry : usedByTable)
+    {
+      const G4EmLazyTable* lazy = entry.first;
+      const std::set<std::size_t>& used = entry.second;
+      for (std::size_t i = 0; i < nCouples; ++i)
+      {
+        if (lazy->IsBuilt(i) != (used.count(i) > 0) && nMismatch++ == 0)
+        {
+          G4cerr << lazy->GetName() << " couple " << i
+                 << (lazy->IsBuilt(i) ? " built but not used"
+                                      : " used but not built") << G4endl;
+        }
+        if (lazy->IsBuilt(i)) { ++nBuilt; }
+      }
+      const std::string line = ExpectedReport(lazy, used);
+      if (capture.output.find(line) == std::string::npos && nReport++ == 0)
+      {
+        G4cerr << "missing: " << line;
+      }
+    }
+    ok &= Check(nBuilt > 0 && nBuilt < usedByTable.size()*nCouples,
+                "part of the couples built by the run");
+    ok &= Check(nMismatch == 0, "couples built are the couples used");
+    ok &= Check(nReport == 0, "/process/em/printLazyTables");
+
+    // Storing the tables builds all the couples
+    const std::string dir = "testG4EmLazyTableBuild.tables";
+    std::filesystem::create_directory(dir);
+    ok &= Check(physicsList->StorePhysicsTable(dir), "StorePhysicsTable()");
+    std::filesystem::remove_all(dir);
+    std::size_t nMissing = 0;
+    ForEachEmProcess([&](const G4ParticleDefinition*, G4VEmProcess* proc)
+    {
+      if (proc->LazyTable() != nullptr)
+      {
+        nMissing += nCouples - proc->LazyTable()->NumberOfBuiltCouples();
+      }
+    });
+    ok &= Check(nMissing == 0, "StorePhysicsTable() builds every couple");
+    return ok;
+  }
+
+  // Builds the tables in this process and writes them to the file
+  G4int Initialise(G4bool lazy, const char* fileName)
+  {
+    auto runManager = new G4TaskRunManager;
+    runManager->SetNumberOfThreads(nThreads);
+    auto physicsList = new PhysicsList;
+    runManager->SetUserInitialization(new Materials);
+    runManager->SetUserInitialization(physicsList);
+    runManager->SetUserInitialization(new ActionInitialization);
+
+    G4UImanager* ui = G4UImanager::GetUIpointer();
+    ui->ApplyCommand("/process/em/verbose 0");
+    ui->ApplyCommand("/process/eLoss/verbose 0");
+    // tables of the processes themselves, not of the general process
+    ui->ApplyCommand("/process/em/UseGeneralProcess false");
+    ui->ApplyCommand(lazy ? "/process/em/LazyTableBuild true"
+                          : "/process/em/LazyTableBuild false");
+    runManager->Initialize();
+
+    G4bool ok = Check(G4EmParameters::Instance()->LazyTableBuild() == lazy,
+                      "/process/em/LazyTableBuild");
+    if (lazy) { ok &= CheckLazyBuild(physicsList, runManager); }
+
+    std::ofstream out(fileName, std::ios::binary);
+    std::size_t nVectors = 0, nMax = 0;
+    ForEachEmProcess([&](const G4ParticleDefinition*, G4VEmProcess* proc)
+    {
+      nVectors += Write(out, proc->LambdaTable());
+      nVectors += Write(out, proc->LambdaTablePrim());
+      if (const std::vector<G4double>* emax = proc->EnergyOfCrossSectionMax())
+      {
+        const std::size_t n = emax->size();
+        out.write(reinterpret_cast<const char*>(&n), sizeof n);
+        out.write(reinterpret_cast<const char*>(emax->data()),
+                  n*sizeof(G4double));
+        nMax += n;
+      }
+    });
+    out.close();
+    ok &= Check(!out.fail(), "writing the tables");
+    ok &= Check(nVectors > 50 && nMax > 0, "tables are built");
+
+    delete runManager;
+    return ok ? 0 : 1;
+  }
+
+  G4bool RunChild(const char* self, const char* mode, const char* fileName)
+  {
+    std::string command = std::string("\"") + self + "\" " + mode + " "
+                        + fileName;
+    return std::system(command.c_str()) == 0;
+  }
+
+  std::string ReadFile(const char* fileName)
+  {
+    std::ifstream in(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  }
+}
+
+G4bool testEquality(const char* self)
+{
+  const char* eagerFile = "testG4EmLazyTableBuild.eager.dat";
+  const char* lazyFile = "testG4EmLazyTableBuild.lazy.dat";
+  G4bool ok = true;
+  ok &= Check(RunChild(self, "eager", eagerFile), "eager build");
+  ok &= Check(RunChild(self, "lazy", lazyFile), "build on demand");
+  if (!ok) { return false; }
+
+  const std::string eager = ReadFile(eagerFile);
+  const std::string lazy = ReadFile(lazyFile);
+  ok &= Check(!eager.empty() && eager == lazy, "identical tables");
+
+  std::remove(eagerFile);
+  std::remove(lazyFile);
+  return ok;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc == 3)
+  {
+    return Initialise(std::string(argv[1]) == "lazy", argv[2]);
+  }
+  return testEquality(argv[0]) ? 0 : 1;
+}
@@ -0,0 +1,274 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4EmParallelTableBuild
+//
+// Checks that /process/em/ParallelTableBuild does not change the EM tables:
+// G4EmStandardPhysics is initialised under a G4TaskRunManager with four
+// threads, with the parallel build on and off, and every vector of the
+// dE/dx, range, inverse range and lambda tables of the master processes
+// is written in binary, with the nodes and the interpolated values between
+// the nodes, which depend on the second derivatives. The two files must be
+// equal byte for byte. The physics list is built once per process, so each
+// mode is run by a child process.
+
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmParameters.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGun.hh"
+#include "G4PhysicsTable.hh"
+#include "G4PhysicsVector.hh"
+#include "G4Positron.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Proton.hh"
+#include "G4Region.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TaskRunManager.hh"
+#include "G4UImanager.hh"
+#include "G4VEmProcess.hh"
+#include "G4VEnergyLossProcess.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserActionInitialization.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "globals.hh"
+
+#include "PTL/TaskRunManager.hh"
+#include "PTL/ThreadPool.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+  const G4int nThreads = 4;
+
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  // Boxes of several materials, half of them in a region with other cuts,
+  // so that there are a dozen couples
+  class Materials : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        auto worldS = new G4Box("World", 1*m, 1*m, 1*m);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_AIR"), "World");
+        auto region = new G4Region("FineCuts");
+        auto cuts = new G4ProductionCuts;
+        cuts->SetProductionCut(0.05*mm);
+        region->SetProductionCuts(cuts);
+        const char* names[] = { "G4_WATER", "G4_Si", "G4_lAr", "G4_PbWO4",
+                                "G4_Pb", "G4_Fe" };
+        G4int i = 0;
+        for (const char* name : names)
+        {
+          for (G4int k = 0; k < 2; ++k)
+          {
+            auto boxS = new G4Box(name, 4*cm, 4*cm, 4*cm);
+            auto boxL = new G4LogicalVolume(boxS,
+              nist->FindOrBuildMaterial(name), name);
+            if (k == 1) { region->AddRootLogicalVolume(boxL); }
+            new G4PVPlacement(nullptr,
+              G4ThreeVector((-50 + 20*i)*cm, (-10 + 20*k)*cm, 0),
+              boxL, name, worldL, false, 2*i + k);
+          }
+          ++i;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+  };
+
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      PhysicsList()
+      {
+        SetVerboseLevel(0);
+        RegisterPhysics(new G4EmStandardPhysics(0));
+      }
+  };
+
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      void GeneratePrimaries(G4Event* event) override
+      {
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+  };
+
+  class ActionInitialization : public G4VUserActionInitialization
+  {
+    public:
+      void Build() const override
+      {
+        SetUserAction(new PrimaryGenerator);
+      }
+  };
+
+  // Writes the nodes of the vector and the values half way between them
+  std::size_t Write(std::ofstream& out, const G4PhysicsTable* table)
+  {
+    if (table == nullptr) { return 0; }
+    std::size_t nVectors = 0;
+    for (const G4PhysicsVector* v : *table)
+    {
+      if (v == nullptr) { continue; }
+      const std::size_t n = v->GetVectorLength();
+      out.write(reinterpret_cast<const char*>(&n), sizeof n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        G4double node[3] = { v->Energy(i), (*v)[i], 0. };
+        if (i + 1 < n)
+        {
+          node[2] = v->Value(0.5*(v->Energy(i) + v->Energy(i + 1)));
+        }
+        out.write(reinterpret_cast<const char*>(node), sizeof node);
+      }
+      ++nVectors;
+    }
+    return nVectors;
+  }
+
+  // Builds the tables in this process and writes them to the file
+  G4int Initialise(G4bool parallel, const char* fileName)
+  {
+    auto runManager = new G4TaskRunManager;
+    runManager->SetNumberOfThreads(nThreads);
+    runManager->SetUserInitialization(new Materials);
+    runManager->SetUserInitialization(new PhysicsList);
+    runManager->SetUserInitialization(new ActionInitialization);
+
+    G4UImanager* ui = G4UImanager::GetUIpointer();
+    ui->ApplyCommand("/process/em/verbose 0");
+    ui->ApplyCommand("/process/eLoss/verbose 0");
+    ui->ApplyCommand(parallel ? "/process/em/ParallelTableBuild true"
+                              : "/process/em/ParallelTableBuild false");
+    runManager->Initialize();
+
+    G4bool ok = Check(G4EmParameters::Instance()->ParallelTableBuild()
+                      == parallel, "/process/em/ParallelTableBuild");
+    auto mrm = PTL::TaskRunManager::GetMasterRunManager();
+    ok &= Check(mrm != nullptr && mrm->GetThreadPool() != nullptr
+                && mrm->GetThreadPool()->size() > 1, "thread pool");
+
+    std::ofstream out(fileName, std::ios::binary);
+    std::size_t nVectors = 0;
+    const G4ParticleDefinition* particles[] = {
+      G4Electron::Definition(), G4Positron::Definition(),
+      G4Gamma::Definition(), G4MuonMinus::Definition(),
+      G4MuonPlus::Definition(), G4Proton::Definition() };
+    for (const auto particle : particles)
+    {
+      G4ProcessVector* procs = particle->GetProcessManager()->GetProcessList();
+      for (G4int i = 0; i < (G4int)procs->size(); ++i)
+      {
+        G4VProcess* proc = (*procs)[i];
+        if (auto eloss = dynamic_cast<G4VEnergyLossProcess*>(proc))
+        {
+          nVectors += Write(out, eloss->DEDXTable());
+          nVectors += Write(out, eloss->DEDXunRestrictedTable());
+          nVectors += Write(out, eloss->IonisationTable());
+          nVectors += Write(out, eloss->RangeTableForLoss());
+          nVectors += Write(out, eloss->InverseRangeTable());
+          nVectors += Write(out, eloss->LambdaTable());
+        }
+        else if (auto em = dynamic_cast<G4VEmProcess*>(proc))
+        {
+          nVectors += Write(out, em->LambdaTable());
+          nVectors += Write(out, em->LambdaTablePrim());
+        }
+      }
+    }
+    out.close();
+    ok &= Check(!out.fail(), "writing the tables");
+    ok &= Check(nVectors > 100, "tables are built");
+
+    delete runManager;
+    return ok ? 0 : 1;
+  }
+
+  G4bool RunChild(const char* self, const char* mode, const char* fileName)
+  {
+    std::string command = std::string("\"") + self + "\" " + mode + " "
+                        + fileName;
+    return std::system(command.c_str()) == 0;
+  }
+
+  std::string ReadFile(const char* fileName)
+  {
+    std::ifstream in(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  }
+}
+
+G4bool testEquality(const char* self)
+{
+  const char* serialFile = "testG4EmParallelTableBuild.serial.dat";
+  const char* parallelFile = "testG4EmParallelTableBuild.parallel.dat";
+  G4bool ok = true;
+  ok &= Check(RunChild(self, "serial", serialFile), "serial build");
+  ok &= Check(RunChild(self, "parallel", parallelFile), "parallel build");
+  if (!ok) { return false; }
+
+  const std::string serial = ReadFile(serialFile);
+  const std::string parallel = ReadFile(parallelFile);
+  ok &= Check(!serial.empty() && serial == parallel, "identical tables");
+
+  std::remove(serialFile);
+  std::remove(parallelFile);
+  return ok;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc == 3)
+  {
+    return Initialise(std::string(argv[1]) == "parallel", argv[2]);
+  }
+  return testEquality(argv[0]) ? 0 : 1;
+}
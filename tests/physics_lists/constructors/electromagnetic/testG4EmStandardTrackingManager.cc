@@ -0,0 +1,315 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4EmStandardTrackingManager
+//
+// Checks that G4EmStandardPhysics gives the same showers with and without
+// /process/em/UseEmTrackingManager: with the same seed, every event of a
+// Pb/lAr sampling calorimeter has identical energy deposits and numbers
+// of charged and neutral steps. Both modes sample the gamma processes
+// separately, without G4GammaGeneralProcess. The physics list is built
+// once per process, so each mode is simulated by a child process.
+
+#include "G4Box.hh"
+#include "G4Electron.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleGun.hh"
+#include "G4Positron.hh"
+#include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UImanager.hh"
+#include "G4UserEventAction.hh"
+#include "G4UserSteppingAction.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const G4int nEvents = 20;
+
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  struct EventRecord
+  {
+    G4double edepAbsorber = 0.;
+    G4double edepGap = 0.;
+    G4long nChargedSteps = 0;
+    G4long nNeutralSteps = 0;
+  };
+
+  // 20 layers of 2 mm Pb and 5 mm lAr
+  class Calorimeter : public G4VUserDetectorConstruction
+  {
+    public:
+      G4VPhysicalVolume* Construct() override
+      {
+        G4NistManager* nist = G4NistManager::Instance();
+        const G4int nLayers = 20;
+        const G4double size = 20*cm;
+        const G4double absThickness = 2*mm;
+        const G4double gapThickness = 5*mm;
+        const G4double layerThickness = absThickness + gapThickness;
+
+        auto worldS = new G4Box("World", size, size, nLayers*layerThickness);
+        auto worldL = new G4LogicalVolume(worldS,
+          nist->FindOrBuildMaterial("G4_Galactic"), "World");
+        auto absS = new G4Box("Absorber", 0.5*size, 0.5*size, 0.5*absThickness);
+        absorber = new G4LogicalVolume(absS,
+          nist->FindOrBuildMaterial("G4_Pb"), "Absorber");
+        auto gapS = new G4Box("Gap", 0.5*size, 0.5*size, 0.5*gapThickness);
+        gap = new G4LogicalVolume(gapS,
+          nist->FindOrBuildMaterial("G4_lAr"), "Gap");
+
+        G4double z = -0.5*nLayers*layerThickness;
+        for (G4int i = 0; i < nLayers; ++i)
+        {
+          new G4PVPlacement(nullptr, G4ThreeVector(0, 0, z + 0.5*absThickness),
+                            absorber, "Absorber", worldL, false, i);
+          new G4PVPlacement(nullptr,
+            G4ThreeVector(0, 0, z + absThickness + 0.5*gapThickness),
+            gap, "Gap", worldL, false, i);
+          z += layerThickness;
+        }
+        return new G4PVPlacement(nullptr, G4ThreeVector(), worldL, "World",
+                                 nullptr, false, 0);
+      }
+
+      G4LogicalVolume* absorber = nullptr;
+      G4LogicalVolume* gap = nullptr;
+  };
+
+  class PhysicsList : public G4VModularPhysicsList
+  {
+    public:
+      PhysicsList()
+      {
+        SetVerboseLevel(0);
+        RegisterPhysics(new G4EmStandardPhysics(0));
+      }
+  };
+
+  class PrimaryGenerator : public G4VUserPrimaryGeneratorAction
+  {
+    public:
+      PrimaryGenerator()
+      {
+        fGun.SetParticleDefinition(G4Electron::Definition());
+        fGun.SetParticleEnergy(1*GeV);
+        fGun.SetParticlePosition(G4ThreeVector(0, 0, -9*cm));
+        fGun.SetParticleMomentumDirection(G4ThreeVector(0, 0, 1));
+      }
+
+      void GeneratePrimaries(G4Event* event) override
+      {
+        fGun.GeneratePrimaryVertex(event);
+      }
+
+    private:
+      G4ParticleGun fGun;
+  };
+
+  class EventAction : public G4UserEventAction
+  {
+    public:
+      void BeginOfEventAction(const G4Event*) override
+      {
+        records.emplace_back();
+      }
+
+      std::vector<EventRecord> records;
+  };
+
+  class SteppingAction : public G4UserSteppingAction
+  {
+    public:
+      SteppingAction(const Calorimeter* calo, EventAction* eventAction)
+        : fCalo(calo), fEventAction(eventAction) {}
+
+      void UserSteppingAction(const G4Step* step) override
+      {
+        EventRecord& record = fEventAction->records.back();
+        const G4LogicalVolume* lv = step->GetPreStepPoint()
+          ->GetPhysicalVolume()->GetLogicalVolume();
+        if (lv == fCalo->absorber)
+        {
+          record.edepAbsorber += step->GetTotalEnergyDeposit();
+        }
+        else if (lv == fCalo->gap)
+        {
+          record.edepGap += step->GetTotalEnergyDeposit();
+        }
+        if (step->GetTrack()->GetDefinition()->GetPDGCharge() != 0.)
+        {
+          ++record.nChargedSteps;
+        }
+        else
+        {
+          ++record.nNeutralSteps;
+        }
+      }
+
+    private:
+      const Calorimeter* fCalo;
+      EventAction* fEventAction;
+  };
+
+  // Simulates the showers in this process and writes one line per event
+  //
+  G4int Simulate(G4bool useTrackingManager, const char* fileName)
+  {
+    auto runManager = new G4RunManager;
+    auto calo = new Calorimeter;
+    runManager->SetUserInitialization(calo);
+    runManager->SetUserInitialization(new PhysicsList);
+    auto eventAction = new EventAction;
+    runManager->SetUserAction(new PrimaryGenerator);
+    runManager->SetUserAction(eventAction);
+    runManager->SetUserAction(new SteppingAction(calo, eventAction));
+
+    G4UImanager* ui = G4UImanager::GetUIpointer();
+    ui->ApplyCommand("/process/em/verbose 0");
+    ui->ApplyCommand("/process/eLoss/verbose 0");
+    // the tracking manager samples the gamma processes separately, the
+    // general process consumes random numbers differently
+    ui->ApplyCommand("/process/em/UseGeneralProcess false");
+    ui->ApplyCommand(useTrackingManager
+                     ? "/process/em/UseEmTrackingManager true"
+                     : "/process/em/UseEmTrackingManager false");
+    runManager->Initialize();
+
+    G4bool ok = true;
+    const G4ParticleDefinition* particles[] = {
+      G4Electron::Definition(), G4Positron::Definition(),
+      G4Gamma::Definition() };
+    for (const auto particle : particles)
+    {
+      ok &= Check((particle->GetTrackingManager() != nullptr)
+                  == useTrackingManager, "tracking manager registration");
+    }
+
+    G4Random::setTheSeed(20261018);
+    runManager->BeamOn(nEvents);
+
+    std::ofstream out(fileName);
+    out.precision(17);
+    for (const auto& record : eventAction->records)
+    {
+      out << record.edepAbsorber << ' ' << record.edepGap << ' '
+          << record.nChargedSteps << ' ' << record.nNeutralSteps << '\n';
+    }
+    out.close();
+    ok &= Check(!out.fail(), "writing the event records");
+
+    delete runManager;
+    return ok ? 0 : 1;
+  }
+
+  G4bool ReadRecords(const char* fileName, std::vector<EventRecord>& records)
+  {
+    std::ifstream in(fileName);
+    EventRecord record;
+    while (in >> record.edepAbsorber >> record.edepGap
+              >> record.nChargedSteps >> record.nNeutralSteps)
+    {
+      records.push_back(record);
+    }
+    return in.eof() && records.size() == std::size_t(nEvents);
+  }
+
+  G4bool RunChild(const char* self, const char* mode, const char* fileName)
+  {
+    std::string command = std::string("\"") + self + "\" " + mode + " "
+                        + fileName;
+    return std::system(command.c_str()) == 0;
+  }
+}
+
+G4bool testEquivalence(const char* self)
+{
+  const char* processesFile = "testG4EmStandardTrackingManager.processes.txt";
+  const char* trackingFile = "testG4EmStandardTrackingManager.tracking.txt";
+  G4bool ok = true;
+  ok &= Check(RunChild(self, "processes", processesFile),
+              "simulation with processes");
+  ok &= Check(RunChild(self, "tracking", trackingFile),
+              "simulation with the tracking manager");
+  if (!ok) { return false; }
+
+  std::vector<EventRecord> processes, tracking;
+  ok &= Check(ReadRecords(processesFile, processes), "records with processes");
+  ok &= Check(ReadRecords(trackingFile, tracking),
+              "records with the tracking manager");
+  if (!ok) { return false; }
+
+  G4long nSteps = 0;
+  for (std::size_t i = 0; i < processes.size(); ++i)
+  {
+    const EventRecord& p = processes[i];
+    const EventRecord& t = tracking[i];
+    if (p.edepAbsorber != t.edepAbsorber || p.edepGap != t.edepGap
+        || p.nChargedSteps != t.nChargedSteps
+        || p.nNeutralSteps != t.nNeutralSteps)
+    {
+      G4cerr.precision(17);
+      G4cerr << "event " << i << ": processes " << p.edepAbsorber << ' '
+             << p.edepGap << ' ' << p.nChargedSteps << ' ' << p.nNeutralSteps
+             << ", tracking manager " << t.edepAbsorber << ' ' << t.edepGap
+             << ' ' << t.nChargedSteps << ' ' << t.nNeutralSteps << G4endl;
+      return Check(false, "identical showers");
+    }
+    nSteps += p.nChargedSteps + p.nNeutralSteps;
+  }
+  ok &= Check(nSteps > 1000*nEvents, "showers are developed");
+
+  std::remove(processesFile);
+  std::remove(trackingFile);
+  return ok;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc == 3)
+  {
+    return Simulate(std::string(argv[1]) == "tracking", argv[2]);
+  }
+  return testEquivalence(argv[0]) ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4EmElementSelector
+//
+// Checks the element selection of G4EmElementSelector for materials with
+// 9 elements (G4_TISSUE_SOFT_ICRP) and 10 elements (G4_BLOOD_ICRP and
+// G4_CONCRETE), for which the cumulative probabilities are searched by
+// bisection. With the same random numbers, a linear scan of
+// the probabilities interpolated from the cross sections of the model
+// must select the same element at every node of the energy grid, between
+// the nodes and outside the grid.
+
+#include "G4EmElementSelector.hh"
+#include "G4Gamma.hh"
+#include "G4KleinNishinaCompton.hh"
+#include "G4NistManager.hh"
+#include "G4PhysicsLogVector.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+
+  // Normalised cumulative cross sections of the elements at the nodes of
+  // the grid, computed as in G4EmElementSelector::Initialise()
+  class LinearScan
+  {
+    public:
+      LinearScan(G4VEmModel* model, const G4ParticleDefinition* part,
+                 const G4Material* material, G4int nbins, G4double emin,
+                 G4double emax)
+        : fGrid(emin, emax, nbins, false),
+          fNElm((G4int)material->GetNumberOfElements())
+      {
+        const G4ElementVector* elements = material->GetElementVector();
+        const G4double* density = material->GetVecNbOfAtomsPerVolume();
+        for (G4int j = 0; j <= nbins; ++j)
+        {
+          const G4double e = fGrid.Energy(j);
+          G4double cross = 0.;
+          for (G4int i = 0; i < fNElm; ++i)
+          {
+            cross += density[i]*model->ComputeCrossSectionPerAtom(part,
+              (*elements)[i], e, 0., e);
+            fProb.push_back(cross);
+          }
+          for (G4int i = 0; i < fNElm - 1; ++i)
+          {
+            fProb[j*fNElm + i] /= cross;
+          }
+        }
+      }
+
+      G4bool IsMonotonic() const
+      {
+        // the last value of each node is the total cross section
+        for (std::size_t k = 0; k + 1 < fProb.size(); ++k)
+        {
+          if (G4int(k%fNElm) < fNElm - 2 && fProb[k] > fProb[k + 1])
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      G4int Select(G4double e, G4double x) const
+      {
+        G4double ekin = e;
+        std::size_t idx = 0;
+        if (e <= fGrid.Energy(0))
+        {
+          ekin = fGrid.Energy(0);
+        }
+        else if (e < fGrid.GetMaxEnergy())
+        {
+          idx = fGrid.ComputeLogVectorBin(G4Log(e));
+        }
+        else
+        {
+          ekin = fGrid.GetMaxEnergy();
+          idx = fGrid.GetVectorLength() - 2;
+        }
+        const G4double x1 = fGrid.Energy(idx);
+        const G4double a = (ekin - x1)/(fGrid.Energy(idx + 1) - x1);
+        const G4double* y1 = &fProb[idx*fNElm];
+        const G4double* y2 = y1 + fNElm;
+        G4int i = 0;
+        for (; i < fNElm - 1; ++i)
+        {
+          if (x <= y1[i] + a*(y2[i] - y1[i])) { break; }
+        }
+        return i;
+      }
+
+      const G4PhysicsLogVector& Grid() const { return fGrid; }
+
+    private:
+      G4PhysicsLogVector fGrid;
+      G4int fNElm;
+      std::vector<G4double> fProb;
+  };
+}
+
+G4bool testBinarySearch(const char* name)
+{
+  const G4Material* material =
+    G4NistManager::Instance()->FindOrBuildMaterial(name);
+  const G4ParticleDefinition* gamma = G4Gamma::Definition();
+  const G4int nbins = 56;
+  const G4double emin = 10*keV, emax = 100*GeV;
+
+  auto model = new G4KleinNishinaCompton();
+  G4EmElementSelector selector(model, material, nbins, emin, emax);
+  selector.Initialise(gamma);
+  LinearScan reference(model, gamma, material, nbins, emin, emax);
+
+  G4bool ok = Check(material->GetNumberOfElements() >= 9,
+                    "material with many elements");
+  ok &= Check(reference.IsMonotonic(), "monotonic probabilities");
+
+  // every node, points between the nodes and energies outside the grid
+  const G4PhysicsLogVector& grid = reference.Grid();
+  std::vector<G4double> energies = { 0.5*emin, emin, emax, 2*emax };
+  for (G4int j = 0; j <= nbins; ++j)
+  {
+    energies.push_back(grid.Energy(j));
+    if (j < nbins)
+    {
+      for (G4double f : { 0.01, 0.37, 0.5, 0.99 })
+      {
+        energies.push_back(grid.Energy(j)
+                           + f*(grid.Energy(j + 1) - grid.Energy(j)));
+      }
+    }
+  }
+
+  const G4ElementVector* elements = material->GetElementVector();
+  const G4int nSamples = 2000;
+  std::vector<G4int> nSelected(elements->size(), 0);
+  G4int nDiff = 0;
+  std::vector<G4double> x(nSamples);
+  for (std::size_t k = 0; k < energies.size(); ++k)
+  {
+    const G4double e = energies[k];
+    G4Random::setTheSeed(1000 + k);
+    for (G4int n = 0; n < nSamples; ++n) { x[n] = G4UniformRand(); }
+    G4Random::setTheSeed(1000 + k);
+    for (G4int n = 0; n < nSamples; ++n)
+    {
+      const G4Element* element = selector.SelectRandomAtom(e);
+      const G4int i = reference.Select(e, x[n]);
+      if (element != (*elements)[i] && nDiff++ == 0)
+      {
+        G4cerr << name << " E= " << e/MeV << " MeV x= " << x[n] << ": "
+               << element->GetName() << " instead of "
+               << (*elements)[i]->GetName() << G4endl;
+      }
+      ++nSelected[i];
+    }
+  }
+  ok &= Check(nDiff == 0, "same element as the linear scan");
+
+  // the search reaches every element, the first and the last included
+  G4bool reached = true;
+  for (G4int n : nSelected) { reached &= (n > 0); }
+  ok &= Check(reached, "every element is selected");
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testBinarySearch("G4_TISSUE_SOFT_ICRP");
+  ok &= testBinarySearch("G4_BLOOD_ICRP");
+  ok &= testBinarySearch("G4_CONCRETE");
+  return ok ? 0 : 1;
+}
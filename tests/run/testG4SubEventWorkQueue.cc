@@ -0,0 +1,186 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+// testG4SubEventWorkQueue
+//
+// Checks the Chase-Lev deque of sub-event slices: the owner pops in LIFO
+// order, thieves steal in FIFO order and a full queue refuses a push.
+// Under stress, the owner pushes and pops while several threads steal
+// concurrently, for many times the capacity of the ring buffer and with
+// the queue often full or down to its last slice: every slice must be
+// taken exactly once.
+
+#include "G4SubEventWorkQueue.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  G4bool Check(G4bool ok, const char* what)
+  {
+    if (!ok) { G4cerr << "FAILED: " << what << G4endl; }
+    return ok;
+  }
+}
+
+G4bool testSequential()
+{
+  const std::size_t capacity = G4SubEventWorkQueue::kCapacity;
+  G4SubEventWorkQueue queue(1);
+  std::vector<G4SubEventSlice> slices(capacity + 1);
+  for (std::size_t i = 0; i < slices.size(); ++i) { slices[i].begin = i; }
+
+  G4bool ok = Check(queue.IsEmpty() && queue.Pop() == nullptr
+                    && queue.Steal() == nullptr, "empty queue");
+  G4bool pushed = true;
+  for (std::size_t i = 0; i < capacity; ++i)
+  {
+    pushed &= queue.Push(&slices[i]);
+  }
+  ok &= Check(pushed, "push up to the capacity");
+  ok &= Check(!queue.Push(&slices[capacity]), "full queue refuses a push");
+  ok &= Check(queue.Steal() == &slices[0] && queue.Steal() == &slices[1],
+              "steal the oldest slices");
+  ok &= Check(queue.Pop() == &slices[capacity - 1]
+              && queue.Pop() == &slices[capacity - 2],
+              "pop the newest slices");
+
+  // Pushes after the steals wrap around the ring buffer
+  ok &= Check(queue.Push(&slices[capacity]), "push after the steals");
+  ok &= Check(queue.Pop() == &slices[capacity], "pop after the wrap");
+  G4bool order = true;
+  for (std::size_t i = 2; i < capacity - 2; ++i)
+  {
+    order &= (queue.Steal() == &slices[i]);
+  }
+  ok &= Check(order && queue.IsEmpty(), "steal in order until empty");
+  return ok;
+}
+
+G4bool testConcurrent()
+{
+  const G4int nThieves = 3;
+  const G4int nSlices = 200000;
+  std::vector<G4SubEventSlice> slices(nSlices);
+  std::unique_ptr<std::atomic<G4int>[]> taken(new std::atomic<G4int>[nSlices]);
+  for (G4int i = 0; i < nSlices; ++i)
+  {
+    slices[i].begin = i;
+    taken[i] = 0;
+  }
+
+  G4SubEventWorkQueue queue(1);
+  std::atomic<G4bool> done(false);
+  std::atomic<G4int> nStolen(0), nPopped(0), nRefused(0);
+  auto take = [&](G4SubEventSlice* slice)
+  {
+    taken[slice->begin].fetch_add(1, std::memory_order_relaxed);
+  };
+
+  std::vector<std::thread> thieves;
+  for (G4int k = 0; k < nThieves; ++k)
+  {
+    thieves.emplace_back([&]
+    {
+      while (!done.load(std::memory_order_acquire) || !queue.IsEmpty())
+      {
+        if (G4SubEventSlice* slice = queue.Steal())
+        {
+          take(slice);
+          nStolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // The owner pushes bursts of random length, filling the queue at
+  // times, and pops a random number of slices, emptying it at times
+  std::mt19937 engine(4321);
+  std::uniform_int_distribution<G4int> burst(1, 2*G4SubEventWorkQueue::kCapacity);
+  G4int next = 0;
+  while (next < nSlices)
+  {
+    const G4int nPush = burst(engine);
+    for (G4int i = 0; i < nPush && next < nSlices; ++i)
+    {
+      if (queue.Push(&slices[next]))
+      {
+        ++next;
+      }
+      else
+      {
+        nRefused.fetch_add(1, std::memory_order_relaxed);
+        break;
+      }
+    }
+    // leaves the thieves time to steal now and then
+    if (burst(engine) % 4 == 0) { std::this_thread::yield(); }
+    const G4int nPop = burst(engine)/2;
+    for (G4int i = 0; i < nPop; ++i)
+    {
+      G4SubEventSlice* slice = queue.Pop();
+      if (slice == nullptr) { break; }
+      take(slice);
+      nPopped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  while (G4SubEventSlice* slice = queue.Pop())
+  {
+    take(slice);
+    nPopped.fetch_add(1, std::memory_order_relaxed);
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& thief : thieves) { thief.join(); }
+
+  G4int nWrong = 0;
+  for (G4int i = 0; i < nSlices; ++i)
+  {
+    if (taken[i].load() != 1 && nWrong++ == 0)
+    {
+      G4cerr << "slice " << i << " taken " << taken[i].load() << " times"
+             << G4endl;
+    }
+  }
+  G4cout << nPopped.load() << " slices popped, " << nStolen.load()
+         << " stolen, " << nRefused.load() << " pushes refused" << G4endl;
+  G4bool ok = Check(nWrong == 0, "every slice taken exactly once");
+  ok &= Check(nPopped.load() + nStolen.load() == nSlices, "slice count");
+  return ok;
+}
+
+int main()
+{
+  G4bool ok = testSequential();
+  ok &= testConcurrent();
+  return ok ? 0 : 1;
+}